@@ -0,0 +1,228 @@
+/**************************************************************************/
+/*  timeline_profiler.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "timeline_profiler.h"
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+
+// Written only by its own thread, read when saving the trace. Buffers are kept
+// for the whole run once allocated, as threads hold on to them, and are freed
+// by cleanup() at exit.
+struct TimelineProfiler::ThreadBuffer {
+	Event *events = nullptr;
+	uint32_t mask = 0;
+	std::atomic<uint64_t> written = 0;
+	Thread::ID thread_id = 0;
+	const char *name = nullptr;
+	ThreadBuffer *next = nullptr;
+
+	static inline Mutex mutex;
+	static inline ThreadBuffer *first = nullptr;
+	static inline uint32_t events_per_thread = DEFAULT_EVENTS_PER_THREAD;
+	static inline uint64_t start_usec = 0;
+	static inline String path;
+	static inline uint32_t generation = 0; // Bumped by cleanup(), invalidating `current` in every thread.
+
+	static inline thread_local ThreadBuffer *current = nullptr;
+	static inline thread_local uint32_t current_generation = 0;
+	static inline thread_local const char *current_name = nullptr;
+};
+
+uint64_t TimelineProfiler::get_ticks_usec() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+TimelineProfiler::ThreadBuffer *TimelineProfiler::_get_thread_buffer() {
+	if (likely(ThreadBuffer::current && ThreadBuffer::current_generation == ThreadBuffer::generation)) {
+		return ThreadBuffer::current;
+	}
+
+	MutexLock lock(ThreadBuffer::mutex);
+
+	ThreadBuffer *buffer = memnew(ThreadBuffer);
+	buffer->mask = ThreadBuffer::events_per_thread - 1;
+	buffer->events = memnew_arr(Event, ThreadBuffer::events_per_thread);
+	buffer->thread_id = Thread::get_caller_id();
+	buffer->name = ThreadBuffer::current_name;
+	if (!buffer->name && Thread::is_main_thread()) {
+		buffer->name = "Main Thread";
+	}
+	buffer->next = ThreadBuffer::first;
+	ThreadBuffer::first = buffer;
+
+	ThreadBuffer::current = buffer;
+	ThreadBuffer::current_generation = ThreadBuffer::generation;
+	return buffer;
+}
+
+void TimelineProfiler::_record(const char *p_name, uint64_t p_begin_usec) {
+	const uint64_t end_usec = get_ticks_usec();
+	ThreadBuffer *buffer = _get_thread_buffer();
+
+	const uint64_t index = buffer->written.load(std::memory_order_relaxed);
+	Event &event = buffer->events[index & buffer->mask];
+	// Whoever sees any of these stores also sees `written` from the previous event, which tells them the slot is being overwritten.
+	std::atomic_thread_fence(std::memory_order_release);
+	event.name.store(p_name, std::memory_order_relaxed);
+	event.begin_usec.store(p_begin_usec, std::memory_order_relaxed);
+	event.end_usec.store(end_usec, std::memory_order_relaxed);
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void TimelineProfiler::start(const String &p_path, uint32_t p_events_per_thread) {
+	ERR_FAIL_COND_MSG(p_events_per_thread == 0, "The timeline profiler needs room for at least one event per thread.");
+
+	MutexLock lock(ThreadBuffer::mutex);
+
+	if (!ThreadBuffer::first) {
+		// Buffers can't be resized after being handed out to threads.
+		ThreadBuffer::events_per_thread = next_power_of_2(p_events_per_thread);
+	}
+	ThreadBuffer::path = p_path;
+	ThreadBuffer::start_usec = get_ticks_usec();
+	recording.store(true, std::memory_order_relaxed);
+}
+
+Error TimelineProfiler::finish() {
+	if (!is_recording()) {
+		return OK;
+	}
+	recording.store(false, std::memory_order_relaxed);
+
+	String path;
+	{
+		MutexLock lock(ThreadBuffer::mutex);
+		path = ThreadBuffer::path;
+		ThreadBuffer::path = String();
+	}
+	if (path.is_empty()) {
+		return OK;
+	}
+
+	const Error err = save_trace(path);
+	if (err == OK) {
+		print_line(vformat("Timeline trace saved to: %s", path));
+	}
+	return err;
+}
+
+void TimelineProfiler::set_thread_name(const char *p_name) {
+	ThreadBuffer::current_name = p_name;
+	if (ThreadBuffer::current && ThreadBuffer::current_generation == ThreadBuffer::generation) {
+		MutexLock lock(ThreadBuffer::mutex);
+		ThreadBuffer::current->name = p_name;
+	}
+}
+
+void TimelineProfiler::clear() {
+	MutexLock lock(ThreadBuffer::mutex);
+	// Events recorded before this point are skipped when saving.
+	ThreadBuffer::start_usec = get_ticks_usec();
+}
+
+void TimelineProfiler::cleanup() {
+	recording.store(false, std::memory_order_relaxed);
+
+	MutexLock lock(ThreadBuffer::mutex);
+	ThreadBuffer *buffer = ThreadBuffer::first;
+	while (buffer) {
+		ThreadBuffer *next = buffer->next;
+		memdelete_arr(buffer->events);
+		memdelete(buffer);
+		buffer = next;
+	}
+	ThreadBuffer::first = nullptr;
+	ThreadBuffer::generation++;
+}
+
+template <typename F>
+void TimelineProfiler::_write_trace(const F &p_write) {
+	MutexLock lock(ThreadBuffer::mutex);
+
+	p_write("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first_event = true;
+	for (ThreadBuffer *buffer = ThreadBuffer::first; buffer; buffer = buffer->next) {
+		const String thread_name = buffer->name ? String(buffer->name) : vformat("Thread %d", buffer->thread_id);
+		p_write(vformat("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", first_event ? "" : ",\n", buffer->thread_id, thread_name.json_escape()));
+		first_event = false;
+
+		const uint64_t written = buffer->written.load(std::memory_order_acquire);
+		const uint64_t capacity = uint64_t(buffer->mask) + 1;
+		for (uint64_t i = written > capacity ? written - capacity : 0; i < written; i++) {
+			const Event &event = buffer->events[i & buffer->mask];
+			const char *name = event.name.load(std::memory_order_relaxed);
+			const uint64_t begin_usec = event.begin_usec.load(std::memory_order_relaxed);
+			const uint64_t end_usec = event.end_usec.load(std::memory_order_relaxed);
+			// The thread keeps recording while this runs, skip the event if its slot may have been reused meanwhile.
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (i + capacity <= buffer->written.load(std::memory_order_relaxed)) {
+				continue;
+			}
+			if (begin_usec < ThreadBuffer::start_usec) {
+				continue;
+			}
+			StringBuilder line;
+			line.append(",\n{\"name\":\"");
+			line.append(String(name).json_escape());
+			line.append("\",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":0,\"tid\":");
+			line.append(itos(buffer->thread_id));
+			line.append(",\"ts\":");
+			line.append(itos(begin_usec - ThreadBuffer::start_usec));
+			line.append(",\"dur\":");
+			line.append(itos(end_usec - begin_usec));
+			line.append("}");
+			p_write(line.as_string());
+		}
+	}
+	p_write("\n]}\n");
+}
+
+String TimelineProfiler::get_trace_json() {
+	StringBuilder json;
+	_write_trace([&json](const String &p_text) {
+		json.append(p_text);
+	});
+	return json.as_string();
+}
+
+Error TimelineProfiler::save_trace(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't save timeline trace to: %s", p_path));
+
+	_write_trace([&f](const String &p_text) {
+		f->store_string(p_text);
+	});
+	return OK;
+}
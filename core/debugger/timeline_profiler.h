@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  timeline_profiler.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TIMELINE_PROFILER_H
+#define TIMELINE_PROFILER_H
+
+#include "core/string/ustring.h"
+
+#include <atomic>
+
+// Records scoped zones from any thread into per-thread ring buffers, and saves
+// them as a Chrome/Perfetto trace (JSON Trace Event Format) when finished.
+// Started with the `--profile-timeline <path>` command line argument.
+//
+// Zones are declared with TIMELINE_ZONE("Name"). The name must be a string with
+// static storage, it is stored as a pointer. While not recording, a zone costs a
+// single relaxed load and branch.
+class TimelineProfiler {
+public:
+	// Relaxed atomics, as saving the trace may read an event while its thread overwrites it.
+	struct Event {
+		std::atomic<const char *> name = nullptr;
+		std::atomic<uint64_t> begin_usec = 0;
+		std::atomic<uint64_t> end_usec = 0;
+	};
+
+	enum {
+		DEFAULT_EVENTS_PER_THREAD = 1 << 16,
+	};
+
+private:
+	struct ThreadBuffer;
+
+	static inline std::atomic<bool> recording = false;
+
+	static void _record(const char *p_name, uint64_t p_begin_usec);
+	static ThreadBuffer *_get_thread_buffer();
+	template <typename F>
+	static void _write_trace(const F &p_write);
+
+public:
+	class Zone {
+		const char *name = nullptr;
+		uint64_t begin_usec = 0;
+
+	public:
+		_FORCE_INLINE_ Zone(const char *p_name) {
+			if (unlikely(recording.load(std::memory_order_relaxed))) {
+				name = p_name;
+				begin_usec = get_ticks_usec();
+			}
+		}
+		_FORCE_INLINE_ ~Zone() {
+			if (unlikely(name)) {
+				_record(name, begin_usec);
+			}
+		}
+	};
+
+	_FORCE_INLINE_ static bool is_recording() { return recording.load(std::memory_order_relaxed); }
+	static uint64_t get_ticks_usec();
+
+	// Events older than the last `p_events_per_thread` of each thread are overwritten.
+	static void start(const String &p_path, uint32_t p_events_per_thread = DEFAULT_EVENTS_PER_THREAD);
+	// Stops recording and saves the trace to the path passed to start(), if any.
+	static Error finish();
+
+	// Shown as the thread name in the trace. Otherwise threads are named after their ID.
+	static void set_thread_name(const char *p_name);
+
+	static String get_trace_json();
+	static Error save_trace(const String &p_path);
+	static void clear();
+	// Frees all buffers. No other thread may be recording zones anymore.
+	static void cleanup();
+};
+
+#define TIMELINE_ZONE(m_name) TimelineProfiler::Zone _timeline_zone_(m_name)
+
+#endif // TIMELINE_PROFILER_H
@@ -114,6 +114,31 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 	return ret;
 }
 
+Ref<FileAccess> FileAccess::open_mapped(const String &p_path, Error *r_error) {
+	Ref<FileAccess> ret;
+	if (PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled()) {
+		ret = PackedData::get_singleton()->try_open_path(p_path);
+		if (ret.is_valid()) {
+			if (r_error) {
+				*r_error = OK;
+			}
+			return ret;
+		}
+	}
+
+	ret = create_for_path(p_path);
+	Error err = ret->open_mapped_internal(p_path);
+
+	if (r_error) {
+		*r_error = err;
+	}
+	if (err != OK) {
+		ret.unref();
+	}
+
+	return ret;
+}
+
 Ref<FileAccess> FileAccess::_open(const String &p_path, ModeFlags p_mode_flags) {
 	Error err = OK;
 	Ref<FileAccess> fa = open(p_path, p_mode_flags, &err);
@@ -471,6 +496,22 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+const uint8_t *FileAccess::get_mapped_buffer(uint64_t p_length) {
+	const uint8_t *data = get_mapped_data();
+	if (!data) {
+		return nullptr;
+	}
+
+	const uint64_t position = get_position();
+	const uint64_t length = get_length();
+	if (position > length || p_length > length - position) {
+		return nullptr;
+	}
+
+	seek(position + p_length);
+	return data + position;
+}
+
 String FileAccess::get_as_utf8_string(bool p_skip_cr) const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -676,19 +717,12 @@ void FileAccess::store_buffer(const Vector<uint8_t> &p_buffer) {
 }
 
 void FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
-
-	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	LocalVector<uint8_t> buff;
+	Error err = encode_variant(p_var, buff, p_full_objects);
 	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
 
-	store_32(len);
-	store_buffer(buff);
+	store_32(buff.size());
+	store_buffer(buff.ptr(), buff.size());
 }
 
 Vector<uint8_t> FileAccess::get_file_as_bytes(const String &p_path, Error *r_error) {
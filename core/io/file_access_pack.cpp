@@ -30,8 +30,11 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/compression.h"
 #include "core/io/file_access_encrypted.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/version.h"
 
@@ -47,7 +50,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_compressed) {
 	String simplified_path = p_path.simplify_path();
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -55,6 +58,7 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	PackedFile pf;
 	pf.encrypted = p_encrypted;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
@@ -96,6 +100,17 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	}
 }
 
+void PackedData::map_pack(const String &p_path) {
+	if (!use_mmap || mapped_packs.has(p_path)) {
+		return;
+	}
+
+	Ref<FileAccess> fa = FileAccess::open_mapped(p_path);
+	if (fa.is_valid() && fa->get_mapped_data()) {
+		mapped_packs[p_path] = fa;
+	}
+}
+
 void PackedData::add_pack_source(PackSource *p_source) {
 	if (p_source != nullptr) {
 		sources.push_back(p_source);
@@ -114,6 +129,7 @@ uint8_t *PackedData::get_file_hash(const String &p_path) {
 
 void PackedData::clear() {
 	files.clear();
+	mapped_packs.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -223,7 +239,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	f->get_32(); // patch number, not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION, false, "Pack version unsupported: " + itos(version) + ".");
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION && version != PACK_FORMAT_VERSION_COMPRESSED, false, "Pack version unsupported: " + itos(version) + ".");
 	ERR_FAIL_COND_V_MSG(ver_major > VERSION_MAJOR || (ver_major == VERSION_MAJOR && ver_minor > VERSION_MINOR), false, "Pack created with a newer version of the engine: " + itos(ver_major) + "." + itos(ver_minor) + ".");
 
 	uint32_t pack_flags = f->get_32();
@@ -275,9 +291,11 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
-		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED));
+		PackedData::get_singleton()->add_path(p_path, path, ofs + p_offset, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), (flags & PACK_FILE_COMPRESSED));
 	}
 
+	PackedData::get_singleton()->map_pack(p_path);
+
 	return true;
 }
 
@@ -293,7 +311,9 @@ Error FileAccessPack::open_internal(const String &p_path, int p_mode_flags) {
 }
 
 bool FileAccessPack::is_open() const {
-	if (f.is_valid()) {
+	if (mapped) {
+		return true;
+	} else if (f.is_valid()) {
 		return f->is_open();
 	} else {
 		return false;
@@ -301,7 +321,7 @@ bool FileAccessPack::is_open() const {
 }
 
 void FileAccessPack::seek(uint64_t p_position) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	if (p_position > pf.size) {
 		eof = true;
@@ -309,7 +329,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (f.is_valid() && !pf.compressed) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -330,7 +352,7 @@ bool FileAccessPack::eof_reached() const {
 }
 
 uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
-	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V_MSG(f.is_null() && !mapped, -1, "File must be opened before use.");
 	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
 
 	if (eof) {
@@ -343,21 +365,192 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 		to_read = (int64_t)pf.size - (int64_t)pos;
 	}
 
+	const uint64_t read_pos = pos;
 	pos += to_read;
 
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (pf.compressed) {
+		return _get_compressed_buffer(p_dst, read_pos, to_read);
+	}
+	if (mapped) {
+		memcpy(p_dst, mapped + read_pos, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::_read_stored(uint64_t p_ofs, uint64_t p_size, Vector<uint8_t> &r_buffer) const {
+	if (mapped) {
+		ERR_FAIL_COND_V(pf.offset + p_ofs + p_size > mapped_pack->get_length(), nullptr);
+		return mapped + p_ofs;
+	}
+
+	r_buffer.resize(p_size);
+	f->seek(off + p_ofs);
+	ERR_FAIL_COND_V(f->get_buffer(r_buffer.ptrw(), p_size) != p_size, nullptr);
+	return r_buffer.ptr();
+}
+
+bool FileAccessPack::_parse_block_index() {
+	Vector<uint8_t> buffer;
+	const uint8_t *header = _read_stored(0, 8, buffer);
+	ERR_FAIL_NULL_V(header, false);
+
+	block_size = decode_uint32(header);
+	const uint32_t block_count = decode_uint32(header + 4);
+	ERR_FAIL_COND_V(block_size == 0 || block_count != (pf.size + block_size - 1) / block_size, false);
+
+	const uint8_t *sizes = _read_stored(8, block_count * 4ull, buffer);
+	ERR_FAIL_NULL_V(sizes, false);
+
+	block_offsets.resize(block_count + 1);
+	uint64_t ofs = 8 + block_count * 4ull;
+	for (uint32_t i = 0; i < block_count; i++) {
+		const uint32_t stored = decode_uint32(sizes + i * 4);
+		ERR_FAIL_COND_V(stored == 0 || stored > _get_block_length(i), false);
+		block_offsets[i] = ofs;
+		ofs += stored;
+	}
+	block_offsets[block_count] = ofs;
+
+	block_cache.resize(block_size);
+	return true;
+}
+
+bool FileAccessPack::_decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const {
+	const uint32_t length = _get_block_length(p_block);
+	const uint32_t stored = block_offsets[p_block + 1] - block_offsets[p_block];
+	if (stored == length) {
+		memcpy(p_dst, p_src, length);
+		return true;
+	}
+	return Compression::decompress(p_dst, length, p_src, stored, Compression::MODE_ZSTD) == (int)length;
+}
+
+void FileAccessPack::DecompressJob::decompress(uint32_t p_index, const FileAccessPack *p_file) {
+	const uint32_t block = first_block + p_index;
+	const uint8_t *block_src = src + (p_file->block_offsets[block] - p_file->block_offsets[first_block]);
+	uint8_t *block_dst = dst + (uint64_t)p_index * p_file->block_size;
+	if (!p_file->_decompress_block(block, block_src, block_dst)) {
+		failed.set();
+	}
+}
+
+bool FileAccessPack::_decompress_blocks(uint32_t p_from, uint32_t p_to, uint8_t *p_dst) const {
+	// The stored blocks are contiguous, so they are fetched with a single read.
+	Vector<uint8_t> buffer;
+	const uint8_t *src = _read_stored(block_offsets[p_from], block_offsets[p_to] - block_offsets[p_from], buffer);
+	ERR_FAIL_NULL_V(src, false);
+
+	DecompressJob job;
+	job.src = src;
+	job.dst = p_dst;
+	job.first_block = p_from;
+
+	const uint32_t count = p_to - p_from;
+	// Pool threads would block waiting on the group, and loads running there are already parallel.
+	if (count >= 4 && WorkerThreadPool::get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&job, &DecompressJob::decompress, this, count, -1, true, SNAME("FileAccessPackDecompress"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	} else {
+		for (uint32_t i = 0; i < count; i++) {
+			job.decompress(i, this);
+		}
+	}
+
+	return !job.failed.is_set();
+}
+
+uint64_t FileAccessPack::_get_compressed_buffer(uint8_t *p_dst, uint64_t p_pos, uint64_t p_length) const {
+	const uint64_t end = p_pos + p_length;
+	const uint32_t first = p_pos / block_size;
+	const uint32_t last = (end - 1) / block_size;
+
+	// Blocks covered entirely by the read are decompressed straight into the destination.
+	const uint32_t full_from = (p_pos % block_size) ? first + 1 : first;
+	const uint32_t full_to = (end % block_size == 0 || end == pf.size) ? last + 1 : last;
+	if (full_from < full_to) {
+		ERR_FAIL_COND_V(!_decompress_blocks(full_from, full_to, p_dst + ((uint64_t)full_from * block_size - p_pos)), 0);
+	}
+
+	// Partial blocks go through the cache, so small sequential reads decompress each block once.
+	const uint32_t partial[2] = { first, last };
+	for (int i = 0; i < (first == last ? 1 : 2); i++) {
+		const uint32_t block = partial[i];
+		if (block >= full_from && block < full_to) {
+			continue;
+		}
+
+		if (cached_block != block) {
+			cached_block = -1;
+			Vector<uint8_t> buffer;
+			const uint8_t *src = _read_stored(block_offsets[block], block_offsets[block + 1] - block_offsets[block], buffer);
+			ERR_FAIL_COND_V(!src || !_decompress_block(block, src, block_cache.ptrw()), 0);
+			cached_block = block;
+		}
+
+		const uint64_t block_start = (uint64_t)block * block_size;
+		const uint64_t from = MAX(p_pos, block_start);
+		const uint64_t to = MIN(end, block_start + block_size);
+		memcpy(p_dst + (from - p_pos), block_cache.ptr() + (from - block_start), to - from);
+	}
+
+	return p_length;
+}
+
+Vector<uint8_t> FileAccessPack::compress_blocks(const uint8_t *p_data, uint64_t p_size, uint32_t p_block_size) {
+	ERR_FAIL_COND_V(p_block_size == 0, Vector<uint8_t>());
+
+	const uint64_t block_count = (p_size + p_block_size - 1) / p_block_size;
+	const uint64_t header_size = 8 + block_count * 4;
+	ERR_FAIL_COND_V(block_count > UINT32_MAX, Vector<uint8_t>());
+	if (header_size >= p_size) {
+		return Vector<uint8_t>();
+	}
+
+	// Every block is stored in at most its own size, so this is enough.
+	Vector<uint8_t> ret;
+	ret.resize(header_size + p_size);
+	uint8_t *w = ret.ptrw();
+	encode_uint32(p_block_size, w);
+	encode_uint32(block_count, w + 4);
+
+	Vector<uint8_t> block;
+	block.resize(Compression::get_max_compressed_buffer_size(p_block_size, Compression::MODE_ZSTD));
+
+	uint64_t ofs = header_size;
+	for (uint64_t i = 0; i < block_count; i++) {
+		const uint8_t *src = p_data + i * p_block_size;
+		const uint32_t length = MIN((uint64_t)p_block_size, p_size - i * p_block_size);
+		int stored = Compression::compress(block.ptrw(), src, length, Compression::MODE_ZSTD);
+		if (stored > 0 && stored < (int)length) {
+			memcpy(w + ofs, block.ptr(), stored);
+		} else {
+			stored = length;
+			memcpy(w + ofs, src, length);
+		}
+		encode_uint32(stored, w + 8 + i * 4);
+		ofs += stored;
+	}
+
+	if (ofs >= p_size) {
+		return Vector<uint8_t>();
+	}
+	ret.resize(ofs);
+	return ret;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
-	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
+	ERR_FAIL_COND_MSG(f.is_null() && !mapped, "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (f.is_valid()) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -381,34 +574,58 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped_pack = Ref<FileAccess>();
+	mapped = nullptr;
+	block_offsets.clear();
+	block_cache.clear();
+	cached_block = -1;
 }
 
 FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) :
-		pf(p_file),
-		f(FileAccess::open(pf.pack, FileAccess::READ)) {
-	ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
-
-	f->seek(pf.offset);
+		pf(p_file) {
+	pos = 0;
+	eof = false;
 	off = pf.offset;
 
-	if (pf.encrypted) {
-		Ref<FileAccessEncrypted> fae;
-		fae.instantiate();
-		ERR_FAIL_COND_MSG(fae.is_null(), "Can't open encrypted pack-referenced file '" + String(pf.pack) + "'.");
+	if (!pf.encrypted) {
+		// Read straight from the mapped pack, without opening it again.
+		// The stored size of compressed files is only known once their block index is parsed.
+		const Ref<FileAccess> *pack = PackedData::get_singleton()->mapped_packs.getptr(pf.pack);
+		if (pack && pf.offset + (pf.compressed ? 0 : pf.size) <= (*pack)->get_length()) {
+			mapped_pack = *pack;
+			mapped = mapped_pack->get_mapped_data() + pf.offset;
+		}
+	}
 
-		Vector<uint8_t> key;
-		key.resize(32);
-		for (int i = 0; i < key.size(); i++) {
-			key.write[i] = script_encryption_key[i];
+	if (!mapped) {
+		f = FileAccess::open(pf.pack, FileAccess::READ);
+		ERR_FAIL_COND_MSG(f.is_null(), "Can't open pack-referenced file '" + String(pf.pack) + "'.");
+
+		f->seek(pf.offset);
+		off = pf.offset;
+
+		if (pf.encrypted) {
+			Ref<FileAccessEncrypted> fae;
+			fae.instantiate();
+			ERR_FAIL_COND_MSG(fae.is_null(), "Can't open encrypted pack-referenced file '" + String(pf.pack) + "'.");
+
+			Vector<uint8_t> key;
+			key.resize(32);
+			for (int i = 0; i < key.size(); i++) {
+				key.write[i] = script_encryption_key[i];
+			}
+
+			Error err = fae->open_and_parse(f, key, FileAccessEncrypted::MODE_READ, false);
+			ERR_FAIL_COND_MSG(err, "Can't open encrypted pack-referenced file '" + String(pf.pack) + "'.");
+			f = fae;
+			off = 0;
 		}
+	}
 
-		Error err = fae->open_and_parse(f, key, FileAccessEncrypted::MODE_READ, false);
-		ERR_FAIL_COND_MSG(err, "Can't open encrypted pack-referenced file '" + String(pf.pack) + "'.");
-		f = fae;
-		off = 0;
+	if (pf.compressed && !_parse_block_index()) {
+		close();
+		ERR_FAIL_MSG("Can't read the block index of compressed pack-referenced file '" + String(pf.pack) + "'.");
 	}
-	pos = 0;
-	eof = false;
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -36,20 +36,33 @@
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
+#include "core/templates/safe_refcount.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 // The current packed file format version number.
 #define PACK_FORMAT_VERSION 2
+// Packs containing PACK_FILE_COMPRESSED entries use this version, so older engines reject them.
+#define PACK_FORMAT_VERSION_COMPRESSED 3
+// Default uncompressed size of the blocks in a PACK_FILE_COMPRESSED entry.
+#define PACK_COMPRESSED_BLOCK_SIZE (64 * 1024)
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
 	PACK_REL_FILEBASE = 1 << 1,
 };
 
+// A PACK_FILE_COMPRESSED entry is split into blocks compressed independently with zstd, so
+// seeks only decompress the block they land in. Its data (encrypted as a whole when
+// PACK_FILE_ENCRYPTED is also set) is laid out as:
+//   uint32 block_size, uint32 block_count, uint32 stored_size[block_count], blocks...
+// A block whose stored size equals its uncompressed size is stored raw. The size and MD5
+// in the directory are those of the uncompressed file.
 enum PackFileFlags {
-	PACK_FILE_ENCRYPTED = 1 << 0
+	PACK_FILE_ENCRYPTED = 1 << 0,
+	PACK_FILE_COMPRESSED = 1 << 1,
 };
 
 class PackSource;
@@ -67,6 +80,7 @@ public:
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
+		bool compressed = false;
 	};
 
 private:
@@ -101,21 +115,30 @@ private:
 
 	Vector<PackSource *> sources;
 
+	// Memory mapped packs, shared by the FileAccessPack instances reading from them.
+	HashMap<String, Ref<FileAccess>> mapped_packs;
+
 	PackedDir *root = nullptr;
 
 	static PackedData *singleton;
 	bool disabled = false;
+	bool use_mmap = true;
 
 	void _free_packed_dirs(PackedDir *p_dir);
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_compressed = false); // for PackSource
 	uint8_t *get_file_hash(const String &p_path);
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// Only affects packs added afterwards.
+	void set_use_mmap(bool p_enable) { use_mmap = p_enable; }
+	bool is_using_mmap() const { return use_mmap; }
+	void map_pack(const String &p_path);
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset);
 
@@ -152,6 +175,32 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	// When the pack is memory mapped, reads are served from it and `f` stays null.
+	Ref<FileAccess> mapped_pack;
+	const uint8_t *mapped = nullptr;
+
+	// Block index of PACK_FILE_COMPRESSED entries, offsets are relative to the entry start.
+	uint32_t block_size = 0;
+	LocalVector<uint64_t> block_offsets; // One more than the block count, to get the last block's stored size.
+	mutable Vector<uint8_t> block_cache;
+	mutable int64_t cached_block = -1;
+
+	struct DecompressJob {
+		const uint8_t *src = nullptr; // Stored data of the first block.
+		uint8_t *dst = nullptr; // Destination of the first block.
+		uint32_t first_block = 0;
+		SafeFlag failed;
+
+		void decompress(uint32_t p_index, const FileAccessPack *p_file);
+	};
+
+	uint32_t _get_block_length(uint32_t p_block) const { return MIN((uint64_t)block_size, pf.size - (uint64_t)p_block * block_size); }
+	bool _parse_block_index();
+	const uint8_t *_read_stored(uint64_t p_ofs, uint64_t p_size, Vector<uint8_t> &r_buffer) const;
+	bool _decompress_block(uint32_t p_block, const uint8_t *p_src, uint8_t *p_dst) const;
+	bool _decompress_blocks(uint32_t p_from, uint32_t p_to, uint8_t *p_dst) const;
+	uint64_t _get_compressed_buffer(uint8_t *p_dst, uint64_t p_pos, uint64_t p_length) const;
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -173,6 +222,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_data() const override { return pf.compressed ? nullptr : mapped; }
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -186,6 +236,9 @@ public:
 
 	virtual void close() override;
 
+	// Returns p_data as a PACK_FILE_COMPRESSED entry, or an empty vector if that isn't smaller.
+	static Vector<uint8_t> compress_blocks(const uint8_t *p_data, uint64_t p_size, uint32_t p_block_size = PACK_COMPRESSED_BLOCK_SIZE);
+
 	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
 };
 
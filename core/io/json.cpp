@@ -32,6 +32,7 @@
 
 #include "core/config/engine.h"
 #include "core/string/print_string.h"
+#include "core/variant/variant_internal.h"
 
 const char *JSON::tk_name[TK_MAX] = {
 	"'{'",
@@ -50,6 +51,17 @@ String JSON::_make_indent(const String &p_indent, int p_size) {
 	return p_indent.repeat(p_size);
 }
 
+String JSON::_stringify_float(double p_num, bool p_full_precision) {
+	if (p_full_precision) {
+		// Store unreliable digits (17) instead of just reliable
+		// digits (14) so that the value can be decoded exactly.
+		return String::num(p_num, 17 - (int)floor(log10(p_num)));
+	} else {
+		// Store only reliable digits (14) by default.
+		return String::num(p_num, 14 - (int)floor(log10(p_num)));
+	}
+}
+
 String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
 	ERR_FAIL_COND_V_MSG(p_cur_indent > Variant::MAX_RECURSION_DEPTH, "...", "JSON structure is too deep. Bailing.");
 
@@ -68,17 +80,8 @@ String JSON::_stringify(const Variant &p_var, const String &p_indent, int p_cur_
 			return p_var.operator bool() ? "true" : "false";
 		case Variant::INT:
 			return itos(p_var);
-		case Variant::FLOAT: {
-			double num = p_var;
-			if (p_full_precision) {
-				// Store unreliable digits (17) instead of just reliable
-				// digits (14) so that the value can be decoded exactly.
-				return String::num(num, 17 - (int)floor(log10(num)));
-			} else {
-				// Store only reliable digits (14) by default.
-				return String::num(num, 14 - (int)floor(log10(num)));
-			}
-		}
+		case Variant::FLOAT:
+			return _stringify_float(p_var, p_full_precision);
 		case Variant::PACKED_INT32_ARRAY:
 		case Variant::PACKED_INT64_ARRAY:
 		case Variant::PACKED_FLOAT32_ARRAY:
@@ -577,10 +580,625 @@ Variant JSON::parse_string(const String &p_json_string) {
 	return jason->get_data();
 }
 
+static _FORCE_INLINE_ void _append_utf8(LocalVector<uint8_t> &r_buffer, const char *p_str, uint32_t p_len) {
+	const uint32_t size = r_buffer.size();
+	r_buffer.resize(size + p_len);
+	memcpy(r_buffer.ptr() + size, p_str, p_len);
+}
+
+static void _append_code_point(LocalVector<uint8_t> &r_buffer, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buffer.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_buffer.push_back(0xc0 | (p_char >> 6));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x10000) {
+		r_buffer.push_back(0xe0 | (p_char >> 12));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x110000) {
+		r_buffer.push_back(0xf0 | (p_char >> 18));
+		r_buffer.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_buffer.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		_append_code_point(r_buffer, 0xfffd);
+	}
+}
+
+// Same escapes as String::json_escape().
+static void _append_json_string(LocalVector<uint8_t> &r_buffer, const String &p_str) {
+	r_buffer.push_back('"');
+	const char32_t *str = p_str.ptr();
+	for (int i = 0; i < p_str.length(); i++) {
+		const char32_t c = str[i];
+		switch (c) {
+			case '\\':
+				_append_utf8(r_buffer, "\\\\", 2);
+				break;
+			case '\b':
+				_append_utf8(r_buffer, "\\b", 2);
+				break;
+			case '\f':
+				_append_utf8(r_buffer, "\\f", 2);
+				break;
+			case '\n':
+				_append_utf8(r_buffer, "\\n", 2);
+				break;
+			case '\r':
+				_append_utf8(r_buffer, "\\r", 2);
+				break;
+			case '\t':
+				_append_utf8(r_buffer, "\\t", 2);
+				break;
+			case '\v':
+				_append_utf8(r_buffer, "\\v", 2);
+				break;
+			case '"':
+				_append_utf8(r_buffer, "\\\"", 2);
+				break;
+			default:
+				_append_code_point(r_buffer, c);
+		}
+	}
+	r_buffer.push_back('"');
+}
+
+static _FORCE_INLINE_ void _append_indent(LocalVector<uint8_t> &r_buffer, const CharString &p_indent, int p_size) {
+	for (int i = 0; i < p_size; i++) {
+		_append_utf8(r_buffer, p_indent.get_data(), p_indent.length());
+	}
+}
+
+void JSON::_stringify_utf8(const Variant &p_var, const CharString &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision, LocalVector<uint8_t> &r_buffer) {
+	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
+		_append_utf8(r_buffer, "...", 3);
+		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
+	}
+
+	const bool pretty = p_indent.length() > 0;
+
+	switch (p_var.get_type()) {
+		case Variant::NIL:
+			_append_utf8(r_buffer, "null", 4);
+			break;
+		case Variant::BOOL:
+			if (p_var.operator bool()) {
+				_append_utf8(r_buffer, "true", 4);
+			} else {
+				_append_utf8(r_buffer, "false", 5);
+			}
+			break;
+		case Variant::INT: {
+			const int64_t num = p_var;
+			char digits[21];
+			int ofs = sizeof(digits);
+			uint64_t n = num < 0 ? -(uint64_t)num : num;
+			do {
+				digits[--ofs] = '0' + n % 10;
+				n /= 10;
+			} while (n);
+			if (num < 0) {
+				digits[--ofs] = '-';
+			}
+			_append_utf8(r_buffer, digits + ofs, sizeof(digits) - ofs);
+		} break;
+		case Variant::FLOAT: {
+			// Only ASCII.
+			const String num = _stringify_float(p_var, p_full_precision);
+			for (int i = 0; i < num.length(); i++) {
+				r_buffer.push_back(num[i]);
+			}
+		} break;
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::ARRAY: {
+			Array a = p_var;
+			if (a.is_empty()) {
+				_append_utf8(r_buffer, "[]", 2);
+				break;
+			}
+			if (p_markers.has(a.id())) {
+				_append_utf8(r_buffer, "\"[...]\"", 7);
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			p_markers.insert(a.id());
+
+			r_buffer.push_back('[');
+			if (pretty) {
+				r_buffer.push_back('\n');
+			}
+
+			bool first = true;
+			for (const Variant &var : a) {
+				if (first) {
+					first = false;
+				} else {
+					r_buffer.push_back(',');
+					if (pretty) {
+						r_buffer.push_back('\n');
+					}
+				}
+				_append_indent(r_buffer, p_indent, p_cur_indent + 1);
+				// Like _stringify(), full precision only applies to the top-level value.
+				_stringify_utf8(var, p_indent, p_cur_indent + 1, p_sort_keys, p_markers, false, r_buffer);
+			}
+			if (pretty) {
+				r_buffer.push_back('\n');
+			}
+			_append_indent(r_buffer, p_indent, p_cur_indent);
+			r_buffer.push_back(']');
+			p_markers.erase(a.id());
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_var;
+			if (p_markers.has(d.id())) {
+				_append_utf8(r_buffer, "\"{...}\"", 7);
+				ERR_FAIL_MSG("Converting circular structure to JSON.");
+			}
+			p_markers.insert(d.id());
+
+			r_buffer.push_back('{');
+			if (pretty) {
+				r_buffer.push_back('\n');
+			}
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+
+			if (p_sort_keys) {
+				keys.sort();
+			}
+
+			bool first_key = true;
+			for (const Variant &E : keys) {
+				if (first_key) {
+					first_key = false;
+				} else {
+					r_buffer.push_back(',');
+					if (pretty) {
+						r_buffer.push_back('\n');
+					}
+				}
+				_append_indent(r_buffer, p_indent, p_cur_indent + 1);
+				_append_json_string(r_buffer, E);
+				r_buffer.push_back(':');
+				if (pretty) {
+					r_buffer.push_back(' ');
+				}
+				_stringify_utf8(d[E], p_indent, p_cur_indent + 1, p_sort_keys, p_markers, false, r_buffer);
+			}
+
+			if (pretty) {
+				r_buffer.push_back('\n');
+			}
+			_append_indent(r_buffer, p_indent, p_cur_indent);
+			r_buffer.push_back('}');
+			p_markers.erase(d.id());
+		} break;
+		default:
+			_append_json_string(r_buffer, p_var);
+	}
+}
+
+void JSON::stringify_utf8(const Variant &p_var, LocalVector<uint8_t> &r_buffer, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	HashSet<const void *> markers;
+	_stringify_utf8(p_var, p_indent.utf8(), 0, p_sort_keys, markers, p_full_precision, r_buffer);
+}
+
+PackedByteArray JSON::stringify_to_utf8_buffer(const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	LocalVector<uint8_t> buffer;
+	stringify_utf8(p_var, buffer, p_indent, p_sort_keys, p_full_precision);
+
+	PackedByteArray ret;
+	ret.resize(buffer.size());
+	if (buffer.size()) {
+		memcpy(ret.ptrw(), buffer.ptr(), buffer.size());
+	}
+	return ret;
+}
+
+// Reads UTF-8 JSON in place and reports it to a JSON::Handler, with the same
+// grammar (and leniencies) as the char32_t parser above. Containers are tracked
+// on an explicit stack instead of recursing.
+class JSONParserUTF8 {
+	const uint8_t *ptr = nullptr;
+	const uint8_t *end = nullptr;
+	JSON::Handler &handler;
+
+	LocalVector<uint8_t> containers; // '{' or '['.
+	LocalVector<uint8_t> unescaped;
+	bool value_due = false; // After opening a container, its first value.
+
+	_FORCE_INLINE_ bool _at_end() const { return ptr == end || *ptr == 0; }
+
+	_FORCE_INLINE_ void _skip_whitespace() {
+		while (ptr < end && *ptr <= 32 && *ptr != 0) {
+			if (*ptr == '\n') {
+				line++;
+			}
+			ptr++;
+		}
+	}
+
+	Error _error(const String &p_message) {
+		err_str = p_message;
+		return ERR_PARSE_ERROR;
+	}
+
+	Error _parse_hex(const uint8_t *p_from, char32_t &r_value) {
+		r_value = 0;
+		for (int i = 0; i < 4; i++) {
+			if (p_from + i >= end || p_from[i] == 0) {
+				return _error("Unterminated String");
+			}
+			const char32_t c = p_from[i];
+			if (!is_hex_digit(c)) {
+				return _error("Malformed hex constant in string");
+			}
+			r_value <<= 4;
+			if (is_digit(c)) {
+				r_value |= c - '0';
+			} else if (c >= 'a' && c <= 'f') {
+				r_value |= c - 'a' + 10;
+			} else {
+				r_value |= c - 'A' + 10;
+			}
+		}
+		return OK;
+	}
+
+	Error _parse_string(const char *&r_str, int &r_len) {
+		ptr++; // Opening quote.
+		const uint8_t *begin = ptr;
+		while (ptr < end && *ptr != '"' && *ptr != '\\' && *ptr != 0) {
+			if (*ptr == '\n') {
+				line++;
+			}
+			ptr++;
+		}
+		if (ptr < end && *ptr == '"') {
+			// No escapes, pass the string without copying it.
+			r_str = (const char *)begin;
+			r_len = ptr - begin;
+			ptr++;
+			return OK;
+		}
+
+		unescaped.clear();
+		_append_utf8(unescaped, (const char *)begin, ptr - begin);
+		while (true) {
+			if (_at_end()) {
+				return _error("Unterminated String");
+			}
+			const uint8_t c = *ptr;
+			if (c == '"') {
+				ptr++;
+				break;
+			} else if (c == '\\') {
+				ptr++;
+				if (_at_end()) {
+					return _error("Unterminated String");
+				}
+				switch (*ptr) {
+					case 'b':
+						unescaped.push_back(8);
+						break;
+					case 't':
+						unescaped.push_back(9);
+						break;
+					case 'n':
+						unescaped.push_back(10);
+						break;
+					case 'f':
+						unescaped.push_back(12);
+						break;
+					case 'r':
+						unescaped.push_back(13);
+						break;
+					case 'u': {
+						char32_t res;
+						Error err = _parse_hex(ptr + 1, res);
+						if (err) {
+							return err;
+						}
+						ptr += 4;
+
+						if ((res & 0xfffffc00) == 0xd800) {
+							if (end - ptr < 3 || ptr[1] != '\\' || ptr[2] != 'u') {
+								return _error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+							}
+							ptr += 2;
+							char32_t trail;
+							err = _parse_hex(ptr + 1, trail);
+							if (err) {
+								return err;
+							}
+							if ((trail & 0xfffffc00) != 0xdc00) {
+								return _error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+							}
+							res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+							ptr += 4;
+						} else if ((res & 0xfffffc00) == 0xdc00) {
+							return _error("Invalid UTF-16 sequence in string, unpaired trail surrogate");
+						}
+						_append_code_point(unescaped, res);
+					} break;
+					case '"':
+					case '\\':
+					case '/':
+						unescaped.push_back(*ptr);
+						break;
+					default:
+						return _error("Invalid escape sequence.");
+				}
+			} else {
+				if (c == '\n') {
+					line++;
+				}
+				unescaped.push_back(c);
+			}
+			ptr++;
+		}
+
+		r_str = (const char *)unescaped.ptr();
+		r_len = unescaped.size();
+		return OK;
+	}
+
+	Error _parse_key() {
+		_skip_whitespace();
+		if (_at_end() || *ptr != '"') {
+			return _error("Expected key");
+		}
+		const char *str;
+		int len;
+		Error err = _parse_string(str, len);
+		if (err) {
+			return err;
+		}
+		_skip_whitespace();
+		if (_at_end() || *ptr != ':') {
+			return _error("Expected ':'");
+		}
+		ptr++;
+		return handler.key(str, len) ? OK : ERR_SKIP;
+	}
+
+	// Reads a value, or opens a container whose contents follow.
+	Error _parse_value() {
+		_skip_whitespace();
+		if (_at_end()) {
+			return _error("Expected value, got EOF.");
+		}
+
+		const uint8_t c = *ptr;
+		bool ok = true;
+		if (c == '{' || c == '[') {
+			if (containers.size() >= Variant::MAX_RECURSION_DEPTH) {
+				err_str = "JSON structure is too deep. Bailing.";
+				return ERR_OUT_OF_MEMORY;
+			}
+			ptr++;
+			containers.push_back(c);
+			if (c == '[') {
+				value_due = true;
+				ok = handler.begin_array();
+			} else if (handler.begin_object()) {
+				// Empty objects are closed by the caller.
+				_skip_whitespace();
+				if (!_at_end() && *ptr != '}') {
+					value_due = true;
+					return _parse_key();
+				}
+			} else {
+				ok = false;
+			}
+		} else if (c == '"') {
+			const char *str;
+			int len;
+			Error err = _parse_string(str, len);
+			if (err) {
+				return err;
+			}
+			ok = handler.value_string(str, len);
+		} else if (c == '-' || is_digit(c)) {
+			int len = 0;
+			while (ptr + len < end) {
+				const uint8_t d = ptr[len];
+				if (!is_digit(d) && d != '-' && d != '+' && d != '.' && d != 'e' && d != 'E') {
+					break;
+				}
+				len++;
+			}
+			// Copied to be null-terminated, numbers are rarely long enough to need the heap.
+			char short_number[64];
+			CharString long_number;
+			char *number = short_number;
+			if (len >= (int)sizeof(short_number)) {
+				long_number.resize(len + 1);
+				number = long_number.ptrw();
+			}
+			memcpy(number, ptr, len);
+			number[len] = 0;
+
+			const char *number_end;
+			const double value = String::to_float(number, &number_end);
+			if (number_end == number) {
+				return _error("Unexpected character.");
+			}
+			ptr += number_end - number;
+			ok = handler.value_number(value);
+		} else if (is_ascii_alphabet_char(c)) {
+			const uint8_t *begin = ptr;
+			while (ptr < end && is_ascii_alphabet_char(*ptr)) {
+				ptr++;
+			}
+			const int len = ptr - begin;
+			if (len == 4 && memcmp(begin, "true", 4) == 0) {
+				ok = handler.value_bool(true);
+			} else if (len == 5 && memcmp(begin, "false", 5) == 0) {
+				ok = handler.value_bool(false);
+			} else if (len == 4 && memcmp(begin, "null", 4) == 0) {
+				ok = handler.value_null();
+			} else {
+				return _error("Expected 'true','false' or 'null', got '" + String::utf8((const char *)begin, len) + "'.");
+			}
+		} else if (c == '}' || c == ']' || c == ':' || c == ',') {
+			return _error(vformat("Expected value, got '%c'.", c));
+		} else {
+			return _error("Unexpected character.");
+		}
+
+		return ok ? OK : ERR_SKIP;
+	}
+
+public:
+	int line = 0;
+	String err_str;
+
+	Error parse() {
+		Error err = _parse_value();
+		while (err == OK && containers.size()) {
+			_skip_whitespace();
+			const bool object = containers[containers.size() - 1] == '{';
+			if (_at_end()) {
+				return _error(object ? "Expected '}'" : "Expected ']'");
+			}
+
+			const uint8_t c = *ptr;
+			if (c == (object ? '}' : ']') && !(object && value_due)) {
+				ptr++;
+				containers.resize(containers.size() - 1);
+				value_due = false;
+				err = (object ? handler.end_object() : handler.end_array()) ? OK : ERR_SKIP;
+				continue;
+			}
+
+			if (value_due) {
+				value_due = false;
+				err = _parse_value();
+				continue;
+			}
+
+			if (c != ',') {
+				return _error(object ? "Expected '}' or ','" : "Expected ','");
+			}
+			ptr++;
+			_skip_whitespace();
+			if (!_at_end() && *ptr == (object ? '}' : ']')) {
+				continue; // Trailing comma.
+			}
+			err = object ? _parse_key() : OK;
+			if (err == OK) {
+				err = _parse_value();
+			}
+		}
+
+		if (err == OK) {
+			_skip_whitespace();
+			if (!_at_end()) {
+				return _error("Expected 'EOF'");
+			}
+		} else if (err == ERR_SKIP && err_str.is_empty()) {
+			err_str = "Stopped by the handler.";
+		}
+		return err;
+	}
+
+	JSONParserUTF8(const uint8_t *p_utf8, int64_t p_len, JSON::Handler &p_handler) :
+			ptr(p_utf8), end(p_utf8 + p_len), handler(p_handler) {}
+};
+
+Error JSON::parse_utf8(const uint8_t *p_utf8, int64_t p_len, Handler &p_handler, String &r_err_str, int &r_err_line) {
+	JSONParserUTF8 parser(p_utf8, p_len, p_handler);
+	Error err = parser.parse();
+	r_err_str = parser.err_str;
+	r_err_line = parser.line;
+	return err;
+}
+
+// Builds the same Variant tree as _parse_value(), from parse_utf8() events.
+class JSONVariantBuilder : public JSON::Handler {
+	LocalVector<Variant> containers;
+	String current_key;
+
+	_FORCE_INLINE_ bool _add(const Variant &p_value) {
+		if (containers.is_empty()) {
+			root = p_value;
+		} else {
+			Variant &container = containers[containers.size() - 1];
+			if (container.get_type() == Variant::ARRAY) {
+				VariantInternal::get_array(&container)->push_back(p_value);
+			} else {
+				(*VariantInternal::get_dictionary(&container))[current_key] = p_value;
+			}
+		}
+		return true;
+	}
+
+public:
+	Variant root;
+
+	virtual bool begin_object() override {
+		Dictionary d;
+		_add(d);
+		containers.push_back(d);
+		return true;
+	}
+	virtual bool key(const char *p_utf8, int p_len) override {
+		current_key.parse_utf8(p_utf8, p_len);
+		return true;
+	}
+	virtual bool end_object() override {
+		containers.resize(containers.size() - 1);
+		return true;
+	}
+	virtual bool begin_array() override {
+		Array a;
+		_add(a);
+		containers.push_back(a);
+		return true;
+	}
+	virtual bool end_array() override {
+		containers.resize(containers.size() - 1);
+		return true;
+	}
+	virtual bool value_string(const char *p_utf8, int p_len) override {
+		String s;
+		s.parse_utf8(p_utf8, p_len);
+		return _add(s);
+	}
+	virtual bool value_number(double p_value) override { return _add(p_value); }
+	virtual bool value_bool(bool p_value) override { return _add(p_value); }
+	virtual bool value_null() override { return _add(Variant()); }
+};
+
+Error JSON::parse_utf8(const uint8_t *p_utf8, int64_t p_len, Variant &r_ret, String &r_err_str, int &r_err_line) {
+	JSONVariantBuilder builder;
+	Error err = parse_utf8(p_utf8, p_len, builder, r_err_str, r_err_line);
+	r_ret = err == OK ? builder.root : Variant();
+	return err;
+}
+
+Error JSON::parse_utf8_buffer(const PackedByteArray &p_buffer) {
+	text.clear();
+	Error err = parse_utf8(p_buffer.ptr(), p_buffer.size(), data, err_str, err_line);
+	if (err == Error::OK) {
+		err_line = 0;
+	}
+	return err;
+}
+
 void JSON::_bind_methods() {
 	ClassDB::bind_static_method("JSON", D_METHOD("stringify", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify, DEFVAL(""), DEFVAL(true), DEFVAL(false));
 	ClassDB::bind_static_method("JSON", D_METHOD("parse_string", "json_string"), &JSON::parse_string);
 	ClassDB::bind_method(D_METHOD("parse", "json_text", "keep_text"), &JSON::parse, DEFVAL(false));
+	ClassDB::bind_static_method("JSON", D_METHOD("stringify_to_utf8_buffer", "data", "indent", "sort_keys", "full_precision"), &JSON::stringify_to_utf8_buffer, DEFVAL(""), DEFVAL(true), DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("parse_utf8_buffer", "json_buffer"), &JSON::parse_utf8_buffer);
 
 	ClassDB::bind_method(D_METHOD("get_data"), &JSON::get_data);
 	ClassDB::bind_method(D_METHOD("set_data", "data"), &JSON::set_data);
@@ -34,11 +34,32 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 
 class JSON : public Resource {
 	GDCLASS(JSON, Resource);
 
+public:
+	// Receives the values read by parse_utf8() in document order, without building Variants.
+	// Strings are UTF-8, not null-terminated, and only valid during the call.
+	// Returning false stops parsing with ERR_SKIP.
+	class Handler {
+	public:
+		virtual bool begin_object() { return true; }
+		virtual bool key(const char *p_utf8, int p_len) { return true; }
+		virtual bool end_object() { return true; }
+		virtual bool begin_array() { return true; }
+		virtual bool end_array() { return true; }
+		virtual bool value_string(const char *p_utf8, int p_len) { return true; }
+		virtual bool value_number(double p_value) { return true; }
+		virtual bool value_bool(bool p_value) { return true; }
+		virtual bool value_null() { return true; }
+		virtual ~Handler() {}
+	};
+
+private:
+
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
@@ -74,6 +95,8 @@ class JSON : public Resource {
 
 	static String _make_indent(const String &p_indent, int p_size);
 	static String _stringify(const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision = false);
+	static String _stringify_float(double p_num, bool p_full_precision);
+	static void _stringify_utf8(const Variant &p_var, const CharString &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision, LocalVector<uint8_t> &r_buffer);
 	static Error _get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
 	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
@@ -90,6 +113,13 @@ public:
 	static String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	static Variant parse_string(const String &p_json_string);
 
+	// UTF-8 counterparts of the above, reading and writing bytes without going through String.
+	static Error parse_utf8(const uint8_t *p_utf8, int64_t p_len, Handler &p_handler, String &r_err_str, int &r_err_line);
+	static Error parse_utf8(const uint8_t *p_utf8, int64_t p_len, Variant &r_ret, String &r_err_str, int &r_err_line);
+	static void stringify_utf8(const Variant &p_var, LocalVector<uint8_t> &r_buffer, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	Error parse_utf8_buffer(const PackedByteArray &p_buffer);
+	static PackedByteArray stringify_to_utf8_buffer(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+
 	inline Variant get_data() const { return data; }
 	void set_data(const Variant &p_data);
 	inline int get_error_line() const { return err_line; }
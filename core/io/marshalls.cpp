@@ -35,6 +35,7 @@
 #include "core/object/script_language.h"
 #include "core/os/keyboard.h"
 #include "core/string/print_string.h"
+#include "core/variant/variant_internal.h"
 
 #include <limits.h>
 #include <stdio.h>
@@ -74,6 +75,66 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME (0b10 << 16)
 #define HEADER_DATA_FIELD_TYPED_ARRAY_SCRIPT (0b11 << 16)
 
+// Packed arrays are stored as consecutive little-endian scalars, which is also
+// the in-memory layout on little-endian hosts, so they are copied in bulk.
+template <typename S>
+static _FORCE_INLINE_ void _encode_scalars(uint8_t *r_dst, const S *p_src, int p_count) {
+	static_assert(sizeof(S) == 4 || sizeof(S) == 8);
+#ifdef BIG_ENDIAN_ENABLED
+	for (int i = 0; i < p_count; i++) {
+		if constexpr (sizeof(S) == 4) {
+			uint32_t u;
+			memcpy(&u, &p_src[i], 4);
+			encode_uint32(u, r_dst + i * 4);
+		} else {
+			uint64_t u;
+			memcpy(&u, &p_src[i], 8);
+			encode_uint64(u, r_dst + i * 8);
+		}
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(S));
+#endif
+}
+
+template <typename S>
+static _FORCE_INLINE_ void _decode_scalars(S *r_dst, const uint8_t *p_src, int p_count) {
+	static_assert(sizeof(S) == 4 || sizeof(S) == 8);
+#ifdef BIG_ENDIAN_ENABLED
+	for (int i = 0; i < p_count; i++) {
+		if constexpr (sizeof(S) == 4) {
+			uint32_t u = decode_uint32(p_src + i * 4);
+			memcpy(&r_dst[i], &u, 4);
+		} else {
+			uint64_t u = decode_uint64(p_src + i * 8);
+			memcpy(&r_dst[i], &u, 8);
+		}
+	}
+#else
+	memcpy(r_dst, p_src, p_count * sizeof(S));
+#endif
+}
+
+// Decodes vectors of N components stored as S, which only matches the layout of V
+// when S is real_t; otherwise each component is converted.
+template <typename S, int N, typename V>
+static _FORCE_INLINE_ void _decode_vectors(V *r_dst, const uint8_t *p_src, int p_count) {
+	if constexpr (std::is_same_v<S, real_t>) {
+		static_assert(sizeof(V) == sizeof(S) * N);
+		_decode_scalars((real_t *)r_dst, p_src, p_count * N);
+	} else {
+		for (int i = 0; i < p_count; i++) {
+			for (int j = 0; j < N; j++) {
+				S c;
+				_decode_scalars(&c, p_src + (i * N + j) * sizeof(S), 1);
+				r_dst[i][j] = c;
+			}
+		}
+	}
+}
+
+static_assert(sizeof(Color) == sizeof(float) * 4);
+
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 
@@ -909,9 +970,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int32_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_uint32(&buf[i * 4]);
-				}
+				_decode_scalars(w, buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -933,9 +992,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const int*rbuf=(const int*)buf;
 				data.resize(count);
 				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_uint64(&buf[i * 8]);
-				}
+				_decode_scalars(w, buf, count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -957,9 +1014,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				//const float*rbuf=(const float*)buf;
 				data.resize(count);
 				float *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_float(&buf[i * 4]);
-				}
+				_decode_scalars(w, buf, count);
 			}
 			r_variant = data;
 
@@ -981,9 +1036,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			if (count) {
 				data.resize(count);
 				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_double(&buf[i * 8]);
-				}
+				_decode_scalars(w, buf, count);
 			}
 			r_variant = data;
 
@@ -1037,10 +1090,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
-					}
+					_decode_vectors<double, 2>(w, buf, count);
 
 					int adv = sizeof(double) * 2 * count;
 
@@ -1062,10 +1112,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector2 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
-					}
+					_decode_vectors<float, 2>(w, buf, count);
 
 					int adv = sizeof(float) * 2 * count;
 
@@ -1097,11 +1144,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
-					}
+					_decode_vectors<double, 3>(w, buf, count);
 
 					int adv = sizeof(double) * 3 * count;
 
@@ -1123,11 +1166,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector3 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
-					}
+					_decode_vectors<float, 3>(w, buf, count);
 
 					int adv = sizeof(float) * 3 * count;
 
@@ -1160,13 +1199,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
-				for (int32_t i = 0; i < count; i++) {
-					// Colors should always be in single-precision.
-					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
-					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
-					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
-					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
-				}
+				// Colors should always be in single-precision.
+				_decode_scalars((float *)w, buf, count * 4);
 
 				int adv = 4 * 4 * count;
 
@@ -1199,12 +1233,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
-						w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
-					}
+					_decode_vectors<double, 4>(w, buf, count);
 
 					int adv = sizeof(double) * 4 * count;
 
@@ -1226,12 +1255,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					varray.resize(count);
 					Vector4 *w = varray.ptrw();
 
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
-						w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
-					}
+					_decode_vectors<float, 4>(w, buf, count);
 
 					int adv = sizeof(float) * 4 * count;
 
@@ -1253,30 +1277,64 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 	return OK;
 }
 
-static void _encode_string(const String &p_string, uint8_t *&buf, int &r_len) {
-	CharString utf8 = p_string.utf8();
-
-	if (buf) {
-		encode_uint32(utf8.length(), buf);
-		buf += 4;
-		memcpy(buf, utf8.get_data(), utf8.length());
-		buf += utf8.length();
+// Where encode_variant() writes: a buffer sized by the caller, a growable one,
+// or nowhere when only computing the encoded length.
+class EncodeBuffer {
+	uint8_t *fixed = nullptr;
+	LocalVector<uint8_t> *growable = nullptr;
+	uint32_t start = 0;
+	int len = 0;
+	int max_len = INT_MAX;
+
+public:
+	// Returns where to write the next p_size bytes, or nullptr when only measuring.
+	// A growable buffer stops growing past max_len, the rest is only measured.
+	_FORCE_INLINE_ uint8_t *reserve(int p_size) {
+		uint8_t *w = nullptr;
+		if (growable) {
+			if (likely(p_size <= max_len - len)) {
+				growable->resize(start + len + p_size);
+				w = growable->ptr() + start + len;
+			}
+		} else if (fixed) {
+			w = fixed + len;
+		}
+		len += p_size;
+		return w;
 	}
 
-	r_len += 4 + utf8.length();
-	while (r_len % 4) {
-		r_len++; //pad
-		if (buf) {
-			*(buf++) = 0;
+	_FORCE_INLINE_ void pad() {
+		if (len % 4) {
+			const int pad = 4 - len % 4;
+			uint8_t *w = reserve(pad);
+			if (w) {
+				memset(w, 0, pad);
+			}
 		}
 	}
+
+	_FORCE_INLINE_ int get_length() const { return len; }
+	_FORCE_INLINE_ bool is_truncated() const { return len > max_len; }
+
+	explicit EncodeBuffer(uint8_t *p_buffer) :
+			fixed(p_buffer) {}
+	EncodeBuffer(LocalVector<uint8_t> &p_buffer, int p_max_len) :
+			growable(&p_buffer), start(p_buffer.size()), max_len(p_max_len) {}
+};
+
+static void _encode_string(const String &p_string, EncodeBuffer &p_buf) {
+	CharString utf8 = p_string.utf8();
+
+	uint8_t *w = p_buf.reserve(4 + utf8.length());
+	if (w) {
+		encode_uint32(utf8.length(), w);
+		memcpy(w + 4, utf8.get_data(), utf8.length());
+	}
+	p_buf.pad();
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+static Error _encode_variant(const Variant &p_variant, EncodeBuffer &p_buf, bool p_full_objects, int p_depth) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
-	uint8_t *buf = r_buffer;
-
-	r_len = 0;
 
 	uint32_t header = p_variant.get_type();
 
@@ -1299,10 +1357,10 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			Object *obj = p_variant.get_validated_object();
 			if (!obj) {
 				// Object is invalid, send a nullptr instead.
-				if (buf) {
-					encode_uint32(Variant::NIL, buf);
+				uint8_t *w = p_buf.reserve(4);
+				if (w) {
+					encode_uint32(Variant::NIL, w);
 				}
-				r_len += 4;
 				return OK;
 			}
 
@@ -1347,74 +1405,66 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} // nothing to do at this stage
 	}
 
-	if (buf) {
-		encode_uint32(header, buf);
-		buf += 4;
+	{
+		uint8_t *w = p_buf.reserve(4);
+		if (w) {
+			encode_uint32(header, w);
+		}
 	}
-	r_len += 4;
 
 	switch (p_variant.get_type()) {
 		case Variant::NIL: {
 			//nothing to do
 		} break;
 		case Variant::BOOL: {
-			if (buf) {
-				encode_uint32(p_variant.operator bool(), buf);
+			uint8_t *w = p_buf.reserve(4);
+			if (w) {
+				encode_uint32(p_variant.operator bool(), w);
 			}
 
-			r_len += 4;
-
 		} break;
 		case Variant::INT: {
 			if (header & HEADER_DATA_FLAG_64) {
 				//64 bits
-				if (buf) {
-					encode_uint64(p_variant.operator int64_t(), buf);
+				uint8_t *w = p_buf.reserve(8);
+				if (w) {
+					encode_uint64(p_variant.operator int64_t(), w);
 				}
-
-				r_len += 8;
 			} else {
-				if (buf) {
-					encode_uint32(p_variant.operator int32_t(), buf);
+				uint8_t *w = p_buf.reserve(4);
+				if (w) {
+					encode_uint32(p_variant.operator int32_t(), w);
 				}
-
-				r_len += 4;
 			}
 		} break;
 		case Variant::FLOAT: {
 			if (header & HEADER_DATA_FLAG_64) {
-				if (buf) {
-					encode_double(p_variant.operator double(), buf);
+				uint8_t *w = p_buf.reserve(8);
+				if (w) {
+					encode_double(p_variant.operator double(), w);
 				}
-
-				r_len += 8;
-
 			} else {
-				if (buf) {
-					encode_float(p_variant.operator float(), buf);
+				uint8_t *w = p_buf.reserve(4);
+				if (w) {
+					encode_float(p_variant.operator float(), w);
 				}
-
-				r_len += 4;
 			}
 
 		} break;
 		case Variant::NODE_PATH: {
 			NodePath np = p_variant;
-			if (buf) {
-				encode_uint32(uint32_t(np.get_name_count()) | 0x80000000, buf); //for compatibility with the old format
-				encode_uint32(np.get_subname_count(), buf + 4);
+			uint8_t *w = p_buf.reserve(12);
+			if (w) {
+				encode_uint32(uint32_t(np.get_name_count()) | 0x80000000, w); //for compatibility with the old format
+				encode_uint32(np.get_subname_count(), w + 4);
 				uint32_t np_flags = 0;
 				if (np.is_absolute()) {
 					np_flags |= 1;
 				}
 
-				encode_uint32(np_flags, buf + 8);
-
-				buf += 12;
+				encode_uint32(np_flags, w + 8);
 			}
 
-			r_len += 12;
-
 			int total = np.get_name_count() + np.get_subname_count();
 
 			for (int i = 0; i < total; i++) {
@@ -1426,249 +1476,220 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					str = np.get_subname(i - np.get_name_count());
 				}
 
-				CharString utf8 = str.utf8();
-
-				int pad = 0;
-
-				if (utf8.length() % 4) {
-					pad = 4 - utf8.length() % 4;
-				}
-
-				if (buf) {
-					encode_uint32(utf8.length(), buf);
-					buf += 4;
-					memcpy(buf, utf8.get_data(), utf8.length());
-					buf += pad + utf8.length();
-				}
-
-				r_len += 4 + utf8.length() + pad;
+				_encode_string(str, p_buf);
 			}
 
 		} break;
 		case Variant::STRING:
 		case Variant::STRING_NAME: {
-			_encode_string(p_variant, buf, r_len);
+			_encode_string(p_variant, p_buf);
 
 		} break;
 
 		// math types
 		case Variant::VECTOR2: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(2 * sizeof(real_t));
+			if (w) {
 				Vector2 v2 = p_variant;
-				encode_real(v2.x, &buf[0]);
-				encode_real(v2.y, &buf[sizeof(real_t)]);
+				encode_real(v2.x, &w[0]);
+				encode_real(v2.y, &w[sizeof(real_t)]);
 			}
 
-			r_len += 2 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR2I: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(2 * 4);
+			if (w) {
 				Vector2i v2 = p_variant;
-				encode_uint32(v2.x, &buf[0]);
-				encode_uint32(v2.y, &buf[4]);
+				encode_uint32(v2.x, &w[0]);
+				encode_uint32(v2.y, &w[4]);
 			}
 
-			r_len += 2 * 4;
-
 		} break;
 		case Variant::RECT2: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(4 * sizeof(real_t));
+			if (w) {
 				Rect2 r2 = p_variant;
-				encode_real(r2.position.x, &buf[0]);
-				encode_real(r2.position.y, &buf[sizeof(real_t)]);
-				encode_real(r2.size.x, &buf[sizeof(real_t) * 2]);
-				encode_real(r2.size.y, &buf[sizeof(real_t) * 3]);
+				encode_real(r2.position.x, &w[0]);
+				encode_real(r2.position.y, &w[sizeof(real_t)]);
+				encode_real(r2.size.x, &w[sizeof(real_t) * 2]);
+				encode_real(r2.size.y, &w[sizeof(real_t) * 3]);
 			}
-			r_len += 4 * sizeof(real_t);
 
 		} break;
 		case Variant::RECT2I: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(4 * 4);
+			if (w) {
 				Rect2i r2 = p_variant;
-				encode_uint32(r2.position.x, &buf[0]);
-				encode_uint32(r2.position.y, &buf[4]);
-				encode_uint32(r2.size.x, &buf[8]);
-				encode_uint32(r2.size.y, &buf[12]);
+				encode_uint32(r2.position.x, &w[0]);
+				encode_uint32(r2.position.y, &w[4]);
+				encode_uint32(r2.size.x, &w[8]);
+				encode_uint32(r2.size.y, &w[12]);
 			}
-			r_len += 4 * 4;
 
 		} break;
 		case Variant::VECTOR3: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(3 * sizeof(real_t));
+			if (w) {
 				Vector3 v3 = p_variant;
-				encode_real(v3.x, &buf[0]);
-				encode_real(v3.y, &buf[sizeof(real_t)]);
-				encode_real(v3.z, &buf[sizeof(real_t) * 2]);
+				encode_real(v3.x, &w[0]);
+				encode_real(v3.y, &w[sizeof(real_t)]);
+				encode_real(v3.z, &w[sizeof(real_t) * 2]);
 			}
 
-			r_len += 3 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR3I: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(3 * 4);
+			if (w) {
 				Vector3i v3 = p_variant;
-				encode_uint32(v3.x, &buf[0]);
-				encode_uint32(v3.y, &buf[4]);
-				encode_uint32(v3.z, &buf[8]);
+				encode_uint32(v3.x, &w[0]);
+				encode_uint32(v3.y, &w[4]);
+				encode_uint32(v3.z, &w[8]);
 			}
 
-			r_len += 3 * 4;
-
 		} break;
 		case Variant::TRANSFORM2D: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(6 * sizeof(real_t));
+			if (w) {
 				Transform2D val = p_variant;
 				for (int i = 0; i < 3; i++) {
 					for (int j = 0; j < 2; j++) {
-						memcpy(&buf[(i * 2 + j) * sizeof(real_t)], &val.columns[i][j], sizeof(real_t));
+						memcpy(&w[(i * 2 + j) * sizeof(real_t)], &val.columns[i][j], sizeof(real_t));
 					}
 				}
 			}
 
-			r_len += 6 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR4: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(4 * sizeof(real_t));
+			if (w) {
 				Vector4 v4 = p_variant;
-				encode_real(v4.x, &buf[0]);
-				encode_real(v4.y, &buf[sizeof(real_t)]);
-				encode_real(v4.z, &buf[sizeof(real_t) * 2]);
-				encode_real(v4.w, &buf[sizeof(real_t) * 3]);
+				encode_real(v4.x, &w[0]);
+				encode_real(v4.y, &w[sizeof(real_t)]);
+				encode_real(v4.z, &w[sizeof(real_t) * 2]);
+				encode_real(v4.w, &w[sizeof(real_t) * 3]);
 			}
 
-			r_len += 4 * sizeof(real_t);
-
 		} break;
 		case Variant::VECTOR4I: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(4 * 4);
+			if (w) {
 				Vector4i v4 = p_variant;
-				encode_uint32(v4.x, &buf[0]);
-				encode_uint32(v4.y, &buf[4]);
-				encode_uint32(v4.z, &buf[8]);
-				encode_uint32(v4.w, &buf[12]);
+				encode_uint32(v4.x, &w[0]);
+				encode_uint32(v4.y, &w[4]);
+				encode_uint32(v4.z, &w[8]);
+				encode_uint32(v4.w, &w[12]);
 			}
 
-			r_len += 4 * 4;
-
 		} break;
 		case Variant::PLANE: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(4 * sizeof(real_t));
+			if (w) {
 				Plane p = p_variant;
-				encode_real(p.normal.x, &buf[0]);
-				encode_real(p.normal.y, &buf[sizeof(real_t)]);
-				encode_real(p.normal.z, &buf[sizeof(real_t) * 2]);
-				encode_real(p.d, &buf[sizeof(real_t) * 3]);
+				encode_real(p.normal.x, &w[0]);
+				encode_real(p.normal.y, &w[sizeof(real_t)]);
+				encode_real(p.normal.z, &w[sizeof(real_t) * 2]);
+				encode_real(p.d, &w[sizeof(real_t) * 3]);
 			}
 
-			r_len += 4 * sizeof(real_t);
-
 		} break;
 		case Variant::QUATERNION: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(4 * sizeof(real_t));
+			if (w) {
 				Quaternion q = p_variant;
-				encode_real(q.x, &buf[0]);
-				encode_real(q.y, &buf[sizeof(real_t)]);
-				encode_real(q.z, &buf[sizeof(real_t) * 2]);
-				encode_real(q.w, &buf[sizeof(real_t) * 3]);
+				encode_real(q.x, &w[0]);
+				encode_real(q.y, &w[sizeof(real_t)]);
+				encode_real(q.z, &w[sizeof(real_t) * 2]);
+				encode_real(q.w, &w[sizeof(real_t) * 3]);
 			}
 
-			r_len += 4 * sizeof(real_t);
-
 		} break;
 		case Variant::AABB: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(6 * sizeof(real_t));
+			if (w) {
 				AABB aabb = p_variant;
-				encode_real(aabb.position.x, &buf[0]);
-				encode_real(aabb.position.y, &buf[sizeof(real_t)]);
-				encode_real(aabb.position.z, &buf[sizeof(real_t) * 2]);
-				encode_real(aabb.size.x, &buf[sizeof(real_t) * 3]);
-				encode_real(aabb.size.y, &buf[sizeof(real_t) * 4]);
-				encode_real(aabb.size.z, &buf[sizeof(real_t) * 5]);
+				encode_real(aabb.position.x, &w[0]);
+				encode_real(aabb.position.y, &w[sizeof(real_t)]);
+				encode_real(aabb.position.z, &w[sizeof(real_t) * 2]);
+				encode_real(aabb.size.x, &w[sizeof(real_t) * 3]);
+				encode_real(aabb.size.y, &w[sizeof(real_t) * 4]);
+				encode_real(aabb.size.z, &w[sizeof(real_t) * 5]);
 			}
 
-			r_len += 6 * sizeof(real_t);
-
 		} break;
 		case Variant::BASIS: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(9 * sizeof(real_t));
+			if (w) {
 				Basis val = p_variant;
 				for (int i = 0; i < 3; i++) {
 					for (int j = 0; j < 3; j++) {
-						memcpy(&buf[(i * 3 + j) * sizeof(real_t)], &val.rows[i][j], sizeof(real_t));
+						memcpy(&w[(i * 3 + j) * sizeof(real_t)], &val.rows[i][j], sizeof(real_t));
 					}
 				}
 			}
 
-			r_len += 9 * sizeof(real_t);
-
 		} break;
 		case Variant::TRANSFORM3D: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(12 * sizeof(real_t));
+			if (w) {
 				Transform3D val = p_variant;
 				for (int i = 0; i < 3; i++) {
 					for (int j = 0; j < 3; j++) {
-						memcpy(&buf[(i * 3 + j) * sizeof(real_t)], &val.basis.rows[i][j], sizeof(real_t));
+						memcpy(&w[(i * 3 + j) * sizeof(real_t)], &val.basis.rows[i][j], sizeof(real_t));
 					}
 				}
 
-				encode_real(val.origin.x, &buf[sizeof(real_t) * 9]);
-				encode_real(val.origin.y, &buf[sizeof(real_t) * 10]);
-				encode_real(val.origin.z, &buf[sizeof(real_t) * 11]);
+				encode_real(val.origin.x, &w[sizeof(real_t) * 9]);
+				encode_real(val.origin.y, &w[sizeof(real_t) * 10]);
+				encode_real(val.origin.z, &w[sizeof(real_t) * 11]);
 			}
 
-			r_len += 12 * sizeof(real_t);
-
 		} break;
 		case Variant::PROJECTION: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(16 * sizeof(real_t));
+			if (w) {
 				Projection val = p_variant;
 				for (int i = 0; i < 4; i++) {
 					for (int j = 0; j < 4; j++) {
-						memcpy(&buf[(i * 4 + j) * sizeof(real_t)], &val.columns[i][j], sizeof(real_t));
+						memcpy(&w[(i * 4 + j) * sizeof(real_t)], &val.columns[i][j], sizeof(real_t));
 					}
 				}
 			}
 
-			r_len += 16 * sizeof(real_t);
-
 		} break;
 
 		// misc types
 		case Variant::COLOR: {
-			if (buf) {
+			uint8_t *w = p_buf.reserve(4 * 4); // Colors should always be in single-precision.
+			if (w) {
 				Color c = p_variant;
-				encode_float(c.r, &buf[0]);
-				encode_float(c.g, &buf[4]);
-				encode_float(c.b, &buf[8]);
-				encode_float(c.a, &buf[12]);
+				encode_float(c.r, &w[0]);
+				encode_float(c.g, &w[4]);
+				encode_float(c.b, &w[8]);
+				encode_float(c.a, &w[12]);
 			}
 
-			r_len += 4 * 4; // Colors should always be in single-precision.
-
 		} break;
 		case Variant::RID: {
 			RID rid = p_variant;
 
-			if (buf) {
-				encode_uint64(rid.get_id(), buf);
+			uint8_t *w = p_buf.reserve(8);
+			if (w) {
+				encode_uint64(rid.get_id(), w);
 			}
-			r_len += 8;
 		} break;
 		case Variant::OBJECT: {
 			if (p_full_objects) {
 				Object *obj = p_variant;
 				if (!obj) {
-					if (buf) {
-						encode_uint32(0, buf);
+					uint8_t *w = p_buf.reserve(4);
+					if (w) {
+						encode_uint32(0, w);
 					}
-					r_len += 4;
 
 				} else {
 					ERR_FAIL_COND_V(!ClassDB::can_instantiate(obj->get_class()), ERR_INVALID_PARAMETER);
 
-					_encode_string(obj->get_class(), buf, r_len);
+					_encode_string(obj->get_class(), p_buf);
 
 					List<PropertyInfo> props;
 					obj->get_property_list(&props);
@@ -1681,19 +1702,17 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 						pc++;
 					}
 
-					if (buf) {
-						encode_uint32(pc, buf);
-						buf += 4;
+					uint8_t *w = p_buf.reserve(4);
+					if (w) {
+						encode_uint32(pc, w);
 					}
 
-					r_len += 4;
-
 					for (const PropertyInfo &E : props) {
 						if (!(E.usage & PROPERTY_USAGE_STORAGE)) {
 							continue;
 						}
 
-						_encode_string(E.name, buf, r_len);
+						_encode_string(E.name, p_buf);
 
 						Variant value;
 
@@ -1708,28 +1727,22 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 							value = obj->get(E.name);
 						}
 
-						int len;
-						Error err = encode_variant(value, buf, len, p_full_objects, p_depth + 1);
+						Error err = _encode_variant(value, p_buf, p_full_objects, p_depth + 1);
 						ERR_FAIL_COND_V(err, err);
-						ERR_FAIL_COND_V(len % 4, ERR_BUG);
-						r_len += len;
-						if (buf) {
-							buf += len;
-						}
+						ERR_FAIL_COND_V(p_buf.get_length() % 4, ERR_BUG);
 					}
 				}
 			} else {
-				if (buf) {
+				uint8_t *w = p_buf.reserve(8);
+				if (w) {
 					Object *obj = p_variant.get_validated_object();
 					ObjectID id;
 					if (obj) {
 						id = obj->get_instance_id();
 					}
 
-					encode_uint64(id, buf);
+					encode_uint64(id, w);
 				}
-
-				r_len += 8;
 			}
 
 		} break;
@@ -1738,43 +1751,33 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		case Variant::SIGNAL: {
 			Signal signal = p_variant;
 
-			_encode_string(signal.get_name(), buf, r_len);
+			_encode_string(signal.get_name(), p_buf);
 
-			if (buf) {
-				encode_uint64(signal.get_object_id(), buf);
+			uint8_t *w = p_buf.reserve(8);
+			if (w) {
+				encode_uint64(signal.get_object_id(), w);
 			}
-			r_len += 8;
 		} break;
 		case Variant::DICTIONARY: {
 			Dictionary d = p_variant;
 
-			if (buf) {
-				encode_uint32(uint32_t(d.size()), buf);
-				buf += 4;
+			uint8_t *w = p_buf.reserve(4);
+			if (w) {
+				encode_uint32(uint32_t(d.size()), w);
 			}
-			r_len += 4;
 
 			List<Variant> keys;
 			d.get_key_list(&keys);
 
 			for (const Variant &E : keys) {
-				int len;
-				Error err = encode_variant(E, buf, len, p_full_objects, p_depth + 1);
+				Error err = _encode_variant(E, p_buf, p_full_objects, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
-				}
+				ERR_FAIL_COND_V(p_buf.get_length() % 4, ERR_BUG);
 				Variant *v = d.getptr(E);
 				ERR_FAIL_NULL_V(v, ERR_BUG);
-				err = encode_variant(*v, buf, len, p_full_objects, p_depth + 1);
+				err = _encode_variant(*v, p_buf, p_full_objects, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
-				}
+				ERR_FAIL_COND_V(p_buf.get_length() % 4, ERR_BUG);
 			}
 
 		} break;
@@ -1788,265 +1791,157 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 					if (p_full_objects) {
 						String path = script->get_path();
 						ERR_FAIL_COND_V_MSG(path.is_empty() || !path.begins_with("res://"), ERR_UNAVAILABLE, "Failed to encode a path to a custom script for an array type.");
-						_encode_string(path, buf, r_len);
+						_encode_string(path, p_buf);
 					} else {
-						_encode_string(EncodedObjectAsID::get_class_static(), buf, r_len);
+						_encode_string(EncodedObjectAsID::get_class_static(), p_buf);
 					}
 				} else if (array.get_typed_class_name() != StringName()) {
-					_encode_string(p_full_objects ? array.get_typed_class_name().operator String() : EncodedObjectAsID::get_class_static(), buf, r_len);
+					_encode_string(p_full_objects ? array.get_typed_class_name().operator String() : EncodedObjectAsID::get_class_static(), p_buf);
 				} else {
 					// No need to check `p_full_objects` since for `Variant::OBJECT`
 					// `array.get_typed_class_name()` should be non-empty.
-					if (buf) {
-						encode_uint32(array.get_typed_builtin(), buf);
-						buf += 4;
+					uint8_t *w = p_buf.reserve(4);
+					if (w) {
+						encode_uint32(array.get_typed_builtin(), w);
 					}
-					r_len += 4;
 				}
 			}
 
-			if (buf) {
-				encode_uint32(uint32_t(array.size()), buf);
-				buf += 4;
+			uint8_t *w = p_buf.reserve(4);
+			if (w) {
+				encode_uint32(uint32_t(array.size()), w);
 			}
-			r_len += 4;
 
 			for (const Variant &var : array) {
-				int len;
-				Error err = encode_variant(var, buf, len, p_full_objects, p_depth + 1);
+				Error err = _encode_variant(var, p_buf, p_full_objects, p_depth + 1);
 				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				if (buf) {
-					buf += len;
-				}
-				r_len += len;
+				ERR_FAIL_COND_V(p_buf.get_length() % 4, ERR_BUG);
 			}
 
 		} break;
 		// arrays
 		case Variant::PACKED_BYTE_ARRAY: {
-			Vector<uint8_t> data = p_variant;
+			const Vector<uint8_t> &data = *VariantInternal::get_byte_array(&p_variant);
 			int datalen = data.size();
-			int datasize = sizeof(uint8_t);
 
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const uint8_t *r = data.ptr();
-				if (r) {
-					memcpy(buf, &r[0], datalen * datasize);
-					buf += datalen * datasize;
-				}
-			}
-
-			r_len += 4 + datalen * datasize;
-			while (r_len % 4) {
-				r_len++;
-				if (buf) {
-					*(buf++) = 0;
+			uint8_t *w = p_buf.reserve(4 + datalen);
+			if (w) {
+				encode_uint32(datalen, w);
+				if (datalen) {
+					memcpy(w + 4, data.ptr(), datalen);
 				}
 			}
+			p_buf.pad();
 
 		} break;
 		case Variant::PACKED_INT32_ARRAY: {
-			Vector<int32_t> data = p_variant;
+			const Vector<int32_t> &data = *VariantInternal::get_int32_array(&p_variant);
 			int datalen = data.size();
-			int datasize = sizeof(int32_t);
 
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
+			uint8_t *w = p_buf.reserve(4 + datalen * sizeof(int32_t));
+			if (w) {
+				encode_uint32(datalen, w);
+				_encode_scalars(w + 4, data.ptr(), datalen);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
-			Vector<int64_t> data = p_variant;
+			const Vector<int64_t> &data = *VariantInternal::get_int64_array(&p_variant);
 			int datalen = data.size();
-			int datasize = sizeof(int64_t);
 
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
+			uint8_t *w = p_buf.reserve(4 + datalen * sizeof(int64_t));
+			if (w) {
+				encode_uint32(datalen, w);
+				_encode_scalars(w + 4, data.ptr(), datalen);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_FLOAT32_ARRAY: {
-			Vector<float> data = p_variant;
+			const Vector<float> &data = *VariantInternal::get_float32_array(&p_variant);
 			int datalen = data.size();
-			int datasize = sizeof(float);
 
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
+			uint8_t *w = p_buf.reserve(4 + datalen * sizeof(float));
+			if (w) {
+				encode_uint32(datalen, w);
+				_encode_scalars(w + 4, data.ptr(), datalen);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_FLOAT64_ARRAY: {
-			Vector<double> data = p_variant;
+			const Vector<double> &data = *VariantInternal::get_float64_array(&p_variant);
 			int datalen = data.size();
-			int datasize = sizeof(double);
 
-			if (buf) {
-				encode_uint32(datalen, buf);
-				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
+			uint8_t *w = p_buf.reserve(4 + datalen * sizeof(double));
+			if (w) {
+				encode_uint32(datalen, w);
+				_encode_scalars(w + 4, data.ptr(), datalen);
 			}
 
-			r_len += 4 + datalen * datasize;
-
 		} break;
 		case Variant::PACKED_STRING_ARRAY: {
-			Vector<String> data = p_variant;
+			const Vector<String> &data = *VariantInternal::get_string_array(&p_variant);
 			int len = data.size();
 
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
+			uint8_t *w = p_buf.reserve(4);
+			if (w) {
+				encode_uint32(len, w);
 			}
 
-			r_len += 4;
-
 			for (int i = 0; i < len; i++) {
-				CharString utf8 = data.get(i).utf8();
+				CharString utf8 = data[i].utf8();
 
-				if (buf) {
-					encode_uint32(utf8.length() + 1, buf);
-					buf += 4;
-					memcpy(buf, utf8.get_data(), utf8.length() + 1);
-					buf += utf8.length() + 1;
-				}
-
-				r_len += 4 + utf8.length() + 1;
-				while (r_len % 4) {
-					r_len++; //pad
-					if (buf) {
-						*(buf++) = 0;
-					}
+				w = p_buf.reserve(4 + utf8.length() + 1);
+				if (w) {
+					encode_uint32(utf8.length() + 1, w);
+					memcpy(w + 4, utf8.get_data(), utf8.length() + 1);
 				}
+				p_buf.pad();
 			}
 
 		} break;
 		case Variant::PACKED_VECTOR2_ARRAY: {
-			Vector<Vector2> data = p_variant;
+			const Vector<Vector2> &data = *VariantInternal::get_vector2_array(&p_variant);
 			int len = data.size();
 
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
+			uint8_t *w = p_buf.reserve(4 + sizeof(real_t) * 2 * len);
+			if (w) {
+				encode_uint32(len, w);
+				_encode_scalars(w + 4, (const real_t *)data.ptr(), len * 2);
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					buf += sizeof(real_t) * 2;
-				}
-			}
-
-			r_len += sizeof(real_t) * 2 * len;
-
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
-			Vector<Vector3> data = p_variant;
+			const Vector<Vector3> &data = *VariantInternal::get_vector3_array(&p_variant);
 			int len = data.size();
 
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
-			}
-
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					buf += sizeof(real_t) * 3;
-				}
+			uint8_t *w = p_buf.reserve(4 + sizeof(real_t) * 3 * len);
+			if (w) {
+				encode_uint32(len, w);
+				_encode_scalars(w + 4, (const real_t *)data.ptr(), len * 3);
 			}
 
-			r_len += sizeof(real_t) * 3 * len;
-
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
-			Vector<Color> data = p_variant;
+			const Vector<Color> &data = *VariantInternal::get_color_array(&p_variant);
 			int len = data.size();
 
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
+			uint8_t *w = p_buf.reserve(4 + 4 * 4 * len); // Colors should always be in single-precision.
+			if (w) {
+				encode_uint32(len, w);
+				_encode_scalars(w + 4, (const float *)data.ptr(), len * 4);
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4; // Colors should always be in single-precision.
-				}
-			}
-
-			r_len += 4 * 4 * len;
-
 		} break;
 		case Variant::PACKED_VECTOR4_ARRAY: {
-			Vector<Vector4> data = p_variant;
+			const Vector<Vector4> &data = *VariantInternal::get_vector4_array(&p_variant);
 			int len = data.size();
 
-			if (buf) {
-				encode_uint32(len, buf);
-				buf += 4;
-			}
-
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector4 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					encode_real(v.w, &buf[sizeof(real_t) * 3]);
-					buf += sizeof(real_t) * 4;
-				}
+			uint8_t *w = p_buf.reserve(4 + sizeof(real_t) * 4 * len);
+			if (w) {
+				encode_uint32(len, w);
+				_encode_scalars(w + 4, (const real_t *)data.ptr(), len * 4);
 			}
 
-			r_len += sizeof(real_t) * 4 * len;
-
 		} break;
 		default: {
 			ERR_FAIL_V(ERR_BUG);
@@ -2056,6 +1951,26 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+	EncodeBuffer buf(r_buffer);
+	Error err = _encode_variant(p_variant, buf, p_full_objects, p_depth);
+	r_len = buf.get_length();
+	return err;
+}
+
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, int p_depth, int p_max_len) {
+	const uint32_t size = r_buffer.size();
+	EncodeBuffer buf(r_buffer, p_max_len);
+	Error err = _encode_variant(p_variant, buf, p_full_objects, p_depth);
+	if (err == OK && buf.is_truncated()) {
+		err = ERR_OUT_OF_MEMORY;
+	}
+	if (err != OK) {
+		r_buffer.resize(size);
+	}
+	return err;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed vectors when sizeof(real_t) == 4.
@@ -33,6 +33,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
@@ -214,6 +215,9 @@ public:
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+// Appends the encoded variant to r_buffer in a single pass. Fails with ERR_OUT_OF_MEMORY if it's longer than p_max_len,
+// without growing r_buffer further.
+Error encode_variant(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects = false, int p_depth = 0, int p_max_len = INT_MAX);
 
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
 
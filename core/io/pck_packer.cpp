@@ -33,7 +33,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, FileAccessPack::compress_blocks
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -50,6 +50,8 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "pck_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -134,6 +136,14 @@ Error PCKPacker::add_file(const String &p_pck_path, const String &p_src, bool p_
 	pf.encrypted = p_encrypt;
 
 	uint64_t _size = pf.size;
+	if (compress) {
+		Vector<uint8_t> compressed = FileAccessPack::compress_blocks(data.ptr(), data.size());
+		if (!compressed.is_empty()) {
+			pf.compressed = true;
+			_size = compressed.size();
+			pf.compressed_data = compressed;
+		}
+	}
 	if (p_encrypt) { // Add encryption overhead.
 		if (_size % 16) { // Pad to encryption block size.
 			_size += 16 - (_size % 16);
@@ -195,6 +205,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -211,6 +224,13 @@ Error PCKPacker::flush(bool p_verbose) {
 	int64_t file_base = file->get_position();
 	file->seek(file_base_ofs);
 	file->store_64(file_base); // update files base
+	for (int i = 0; i < files.size(); i++) {
+		if (files[i].compressed) {
+			file->seek(4);
+			file->store_32(PACK_FORMAT_VERSION_COMPRESSED);
+			break;
+		}
+	}
 	file->seek(file_base);
 
 	const uint32_t buf_max = 65536;
@@ -231,6 +251,12 @@ Error PCKPacker::flush(bool p_verbose) {
 			ftmp = fae;
 		}
 
+		if (files[i].compressed) {
+			ftmp->store_buffer(files[i].compressed_data.ptr(), files[i].compressed_data.size());
+			files.write[i].compressed_data.clear();
+			to_write = 0;
+		}
+
 		while (to_write > 0) {
 			uint64_t read = src->get_buffer(buf, MIN(to_write, buf_max));
 			ftmp->store_buffer(buf, read);
@@ -259,3 +285,11 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	return OK;
 }
+
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compress = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compress;
+}
@@ -44,6 +44,7 @@ class PCKPacker : public RefCounted {
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	bool compress = false;
 
 	static void _bind_methods();
 
@@ -53,7 +54,9 @@ class PCKPacker : public RefCounted {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
 		bool encrypted = false;
+		bool compressed = false;
 		Vector<uint8_t> md5;
+		Vector<uint8_t> compressed_data; // Kept from add_file() until flush().
 	};
 	Vector<File> files;
 
@@ -62,6 +65,9 @@ public:
 	Error add_file(const String &p_pck_path, const String &p_src, bool p_encrypt = false);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+
 	PCKPacker() {}
 };
 
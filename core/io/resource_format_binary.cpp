@@ -405,6 +405,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 					if (using_named_scene_ids) { // New format.
 						ERR_FAIL_INDEX_V((int)index, internal_resources.size(), ERR_PARSE_ERROR);
 						path = internal_resources[index].path;
+						if (internal_dependencies) {
+							internal_dependencies->push_back(index);
+						}
 					} else {
 						path += res_path + "::" + itos(index);
 					}
@@ -448,6 +451,9 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 						WARN_PRINT("Broken external resource! (index out of size)");
 						r_v = Variant();
 					} else {
+						if (external_dependencies) {
+							external_dependencies->push_back(erindex);
+						}
 						Ref<ResourceLoader::LoadToken> &load_token = external_resources.write[erindex].load_token;
 						if (load_token.is_valid()) { // If not valid, it's OK since then we know this load accepts broken dependencies.
 							Error err;
@@ -709,106 +715,203 @@ Error ResourceLoaderBinary::load() {
 		}
 	}
 
-	for (int i = 0; i < internal_resources.size(); i++) {
-		bool main = i == (internal_resources.size() - 1);
-
-		//maybe it is loaded already
-		String path;
-		String id;
-
-		if (!main) {
-			path = internal_resources[i].path;
+	if (use_sub_threads && using_named_scene_ids && internal_resources.size() > 2) {
+		return _load_internal_resources_threaded();
+	}
+	return _load_internal_resources();
+}
 
-			if (path.begins_with("local://")) {
-				path = path.replace_first("local://", "");
-				id = path;
-				path = res_path + "::" + path;
+static void _set_resource_property(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const StringName &p_name, Variant &p_value, Dictionary &r_missing_resource_properties) {
+	bool set_valid = true;
+	if (p_value.get_type() == Variant::OBJECT && p_missing_resource != nullptr) {
+		// If the property being set is a missing resource (and the parent is not),
+		// then setting it will most likely not work.
+		// Instead, save it as metadata.
+
+		Ref<MissingResource> mr = p_value;
+		if (mr.is_valid()) {
+			r_missing_resource_properties[p_name] = mr;
+			set_valid = false;
+		}
+	}
 
-				internal_resources.write[i].path = path; // Update path.
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array set_array = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
+			Array get_array = get_value;
+			if (!set_array.is_same_typed(get_array)) {
+				p_value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
 			}
+		}
+	}
 
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached.is_valid()) {
-					//already loaded, don't do anything
-					error = OK;
-					internal_index_cache[path] = cached;
-					continue;
-				}
-			}
-		} else {
-			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
-				path = res_path;
+	if (p_value.get_type() == Variant::DICTIONARY) {
+		Dictionary set_dict = p_value;
+		bool is_get_valid = false;
+		Variant get_value = p_res->get(p_name, &is_get_valid);
+		if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
+			Dictionary get_dict = get_value;
+			if (!set_dict.is_same_typed(get_dict)) {
+				p_value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
+						get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
 			}
 		}
+	}
+
+	if (set_valid) {
+		p_res->set(p_name, p_value);
+	}
+}
 
-		uint64_t offset = internal_resources[i].offset;
+static void _finish_resource_setup(const Ref<Resource> &p_res, MissingResource *p_missing_resource, const Dictionary &p_missing_resource_properties) {
+	if (p_missing_resource) {
+		p_missing_resource->set_recording_properties(false);
+	}
 
-		f->seek(offset);
+	if (!p_missing_resource_properties.is_empty()) {
+		p_res->set_meta(META_MISSING_RESOURCES, p_missing_resource_properties);
+	}
 
-		String t = get_unicode_string();
+#ifdef TOOLS_ENABLED
+	p_res->set_edited(false);
+#endif
+}
 
-		Ref<Resource> res;
-		Resource *r = nullptr;
+void ResourceLoaderBinary::PendingResource::set_up() {
+	Dictionary missing_resource_properties;
+	for (Pair<StringName, Variant> &E : properties) {
+		_set_resource_property(resource, missing_resource, E.first, E.second, missing_resource_properties);
+	}
+	properties.clear();
+	_finish_resource_setup(resource, missing_resource, missing_resource_properties);
+}
 
-		MissingResource *missing_resource = nullptr;
+void ResourceLoaderBinary::_set_up_pending_resource(void *p_userdata, uint32_t p_index) {
+	PendingLevel *level = (PendingLevel *)p_userdata;
+	level->resources[level->indices[p_index]].set_up();
+}
 
-		if (main) {
-			res = ResourceLoader::get_resource_ref_override(local_path);
-			r = res.ptr();
+Error ResourceLoaderBinary::_create_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource) {
+	bool main = p_index == (internal_resources.size() - 1);
+
+	//maybe it is loaded already
+	String path;
+	String id;
+
+	if (!main) {
+		path = internal_resources[p_index].path;
+
+		if (path.begins_with("local://")) {
+			path = path.replace_first("local://", "");
+			id = path;
+			path = res_path + "::" + path;
+
+			internal_resources.write[p_index].path = path; // Update path.
 		}
-		if (!r) {
-			if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
-				//use the existing one
-				Ref<Resource> cached = ResourceCache::get_ref(path);
-				if (cached->get_class() == t) {
-					cached->reset_state();
-					res = cached;
-				}
+
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(path)) {
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached.is_valid()) {
+				//already loaded, don't do anything
+				error = OK;
+				internal_index_cache[path] = cached;
+				return OK;
 			}
+		}
+	} else {
+		if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE && !ResourceCache::has(res_path)) {
+			path = res_path;
+		}
+	}
 
-			if (res.is_null()) {
-				//did not replace
+	uint64_t offset = internal_resources[p_index].offset;
 
-				Object *obj = ClassDB::instantiate(t);
-				if (!obj) {
-					if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
-						//create a missing resource
-						missing_resource = memnew(MissingResource);
-						missing_resource->set_original_class(t);
-						missing_resource->set_recording_properties(true);
-						obj = missing_resource;
-					} else {
-						error = ERR_FILE_CORRUPT;
-						ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
-					}
-				}
+	f->seek(offset);
 
-				r = Object::cast_to<Resource>(obj);
-				if (!r) {
-					String obj_class = obj->get_class();
-					error = ERR_FILE_CORRUPT;
-					memdelete(obj); //bye
-					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
-				}
+	String t = get_unicode_string();
 
-				res = Ref<Resource>(r);
+	Ref<Resource> res;
+	Resource *r = nullptr;
+
+	MissingResource *missing_resource = nullptr;
+
+	if (main) {
+		res = ResourceLoader::get_resource_ref_override(local_path);
+		r = res.ptr();
+	}
+	if (!r) {
+		if (cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE && ResourceCache::has(path)) {
+			//use the existing one
+			Ref<Resource> cached = ResourceCache::get_ref(path);
+			if (cached->get_class() == t) {
+				cached->reset_state();
+				res = cached;
 			}
 		}
 
-		if (r) {
-			if (!path.is_empty()) {
-				if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
-					r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+		if (res.is_null()) {
+			//did not replace
+
+			Object *obj = ClassDB::instantiate(t);
+			if (!obj) {
+				if (ResourceLoader::is_creating_missing_resources_if_class_unavailable_enabled()) {
+					//create a missing resource
+					missing_resource = memnew(MissingResource);
+					missing_resource->set_original_class(t);
+					missing_resource->set_recording_properties(true);
+					obj = missing_resource;
 				} else {
-					r->set_path_cache(path);
+					error = ERR_FILE_CORRUPT;
+					ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource of unrecognized type in file: " + t + ".");
 				}
 			}
-			r->set_scene_unique_id(id);
+
+			r = Object::cast_to<Resource>(obj);
+			if (!r) {
+				String obj_class = obj->get_class();
+				error = ERR_FILE_CORRUPT;
+				memdelete(obj); //bye
+				ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, local_path + ":Resource type in resource field not a resource, type is: " + obj_class + ".");
+			}
+
+			res = Ref<Resource>(r);
 		}
+	}
 
-		if (!main) {
-			internal_index_cache[path] = res;
+	if (r) {
+		if (!path.is_empty()) {
+			if (cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE) {
+				r->set_path(path, cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE); // If got here because the resource with same path has different type, replace it.
+			} else {
+				r->set_path_cache(path);
+			}
+		}
+		r->set_scene_unique_id(id);
+	}
+
+	if (!main) {
+		internal_index_cache[path] = res;
+	}
+
+	r_res = res;
+	r_missing_resource = missing_resource;
+	return OK;
+}
+
+Error ResourceLoaderBinary::_load_internal_resources() {
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+
+		Ref<Resource> res;
+		MissingResource *missing_resource = nullptr;
+		error = _create_internal_resource(i, res, missing_resource);
+		if (error) {
+			return error;
+		}
+		if (res.is_null()) {
+			continue; // Already loaded.
 		}
 
 		int pc = f->get_32();
@@ -832,77 +935,158 @@ Error ResourceLoaderBinary::load() {
 				return error;
 			}
 
-			bool set_valid = true;
-			if (value.get_type() == Variant::OBJECT && missing_resource != nullptr) {
-				// If the property being set is a missing resource (and the parent is not),
-				// then setting it will most likely not work.
-				// Instead, save it as metadata.
+			_set_resource_property(res, missing_resource, name, value, missing_resource_properties);
+		}
+
+		_finish_resource_setup(res, missing_resource, missing_resource_properties);
 
-				Ref<MissingResource> mr = value;
-				if (mr.is_valid()) {
-					missing_resource_properties[name] = mr;
-					set_valid = false;
-				}
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size());
+		}
+
+		resource_cache.push_back(res);
+
+		if (main) {
+			f.unref();
+			resource = res;
+			resource->set_as_translation_remapped(translation_remapped);
+			error = OK;
+			return OK;
+		}
+	}
+
+	return ERR_FILE_EOF;
+}
+
+Error ResourceLoaderBinary::_load_internal_resources_threaded() {
+	// The file is read in order on this thread, which keeps resource identity and paths as in a
+	// sequential load. Properties are set afterwards on sub-tasks: a resource only needs the ones
+	// it references set up first, so the references found while parsing tell which resources can
+	// be set up concurrently (e.g., the meshes, animations and images of a scene).
+	LocalVector<PendingResource> pending;
+	pending.resize(internal_resources.size());
+	LocalVector<int> levels;
+	levels.resize(internal_resources.size());
+	int level_count = 0;
+
+	// Setters may update what they reference (e.g., meshes asking their material for its shader),
+	// which isn't thread-safe. Resources referencing the same one are kept on separate levels,
+	// this is the last level each internal, then external, resource was referenced from.
+	LocalVector<int> referenced_levels;
+	referenced_levels.resize(internal_resources.size() + external_resources.size());
+	for (int &referenced_level : referenced_levels) {
+		referenced_level = -1;
+	}
+
+	LocalVector<uint32_t> dependencies;
+	LocalVector<uint32_t> ext_dependencies;
+	internal_dependencies = &dependencies;
+	external_dependencies = &ext_dependencies;
+
+	for (int i = 0; i < internal_resources.size(); i++) {
+		bool main = i == (internal_resources.size() - 1);
+		levels[i] = -1; // Not set up by this load.
+
+		PendingResource &pr = pending[i];
+		error = _create_internal_resource(i, pr.resource, pr.missing_resource);
+		if (error) {
+			internal_dependencies = nullptr;
+			external_dependencies = nullptr;
+			return error;
+		}
+		if (pr.resource.is_null()) {
+			continue; // Already loaded.
+		}
+
+		int pc = f->get_32();
+		dependencies.clear();
+		ext_dependencies.clear();
+
+		for (int j = 0; j < pc; j++) {
+			StringName name = _get_string();
+
+			if (name == StringName()) {
+				internal_dependencies = nullptr;
+				external_dependencies = nullptr;
+				error = ERR_FILE_CORRUPT;
+				ERR_FAIL_V(ERR_FILE_CORRUPT);
 			}
 
-			if (value.get_type() == Variant::ARRAY) {
-				Array set_array = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::ARRAY) {
-					Array get_array = get_value;
-					if (!set_array.is_same_typed(get_array)) {
-						value = Array(set_array, get_array.get_typed_builtin(), get_array.get_typed_class_name(), get_array.get_typed_script());
-					}
-				}
+			Variant value;
+
+			error = parse_variant(value);
+			if (error) {
+				internal_dependencies = nullptr;
+				external_dependencies = nullptr;
+				return error;
 			}
 
-			if (value.get_type() == Variant::DICTIONARY) {
-				Dictionary set_dict = value;
-				bool is_get_valid = false;
-				Variant get_value = res->get(name, &is_get_valid);
-				if (is_get_valid && get_value.get_type() == Variant::DICTIONARY) {
-					Dictionary get_dict = get_value;
-					if (!set_dict.is_same_typed(get_dict)) {
-						value = Dictionary(set_dict, get_dict.get_typed_key_builtin(), get_dict.get_typed_key_class_name(), get_dict.get_typed_key_script(),
-								get_dict.get_typed_value_builtin(), get_dict.get_typed_value_class_name(), get_dict.get_typed_value_script());
-					}
+			pr.properties.push_back(Pair<StringName, Variant>(name, value));
+		}
+
+		if (progress) {
+			*progress = (i + 1) / float(internal_resources.size() * 2);
+		}
+
+		resource_cache.push_back(pr.resource);
+
+		if (!main) {
+			// References to resources further on can't be resolved, as in a sequential load.
+			levels[i] = 0;
+			for (uint32_t dependency : dependencies) {
+				if ((int)dependency < i && levels[dependency] >= 0) {
+					levels[i] = MAX(levels[i], levels[dependency] + 1);
 				}
+				levels[i] = MAX(levels[i], referenced_levels[dependency] + 1);
 			}
-
-			if (set_valid) {
-				res->set(name, value);
+			for (uint32_t dependency : ext_dependencies) {
+				levels[i] = MAX(levels[i], referenced_levels[internal_resources.size() + dependency] + 1);
+			}
+			for (uint32_t dependency : dependencies) {
+				referenced_levels[dependency] = levels[i];
 			}
+			for (uint32_t dependency : ext_dependencies) {
+				referenced_levels[internal_resources.size() + dependency] = levels[i];
+			}
+			level_count = MAX(level_count, levels[i] + 1);
 		}
+	}
 
-		if (missing_resource) {
-			missing_resource->set_recording_properties(false);
-		}
+	internal_dependencies = nullptr;
+	external_dependencies = nullptr;
+	f.unref();
 
-		if (!missing_resource_properties.is_empty()) {
-			res->set_meta(META_MISSING_RESOURCES, missing_resource_properties);
+	LocalVector<uint32_t> indices;
+	for (int l = 0; l < level_count; l++) {
+		indices.clear();
+		for (uint32_t i = 0; i < levels.size(); i++) {
+			if (levels[i] == l) {
+				indices.push_back(i);
+			}
 		}
 
-#ifdef TOOLS_ENABLED
-		res->set_edited(false);
-#endif
+		PendingLevel level;
+		level.resources = pending.ptr();
+		level.indices = indices.ptr();
+		ResourceLoader::run_load_sub_tasks(&ResourceLoaderBinary::_set_up_pending_resource, &level, indices.size(), SNAME("ResourceLoaderBinary"));
 
 		if (progress) {
-			*progress = (i + 1) / float(internal_resources.size());
+			*progress = 0.5 + 0.5 * (l + 1) / float(level_count + 1);
 		}
+	}
 
-		resource_cache.push_back(res);
+	// The main resource is set up last, on the loading thread.
+	PendingResource &main = pending[pending.size() - 1];
+	main.set_up();
 
-		if (main) {
-			f.unref();
-			resource = res;
-			resource->set_as_translation_remapped(translation_remapped);
-			error = OK;
-			return OK;
-		}
+	if (progress) {
+		*progress = 1.0;
 	}
 
-	return ERR_FILE_EOF;
+	resource = main.resource;
+	resource->set_as_translation_remapped(translation_remapped);
+	error = OK;
+	return OK;
 }
 
 void ResourceLoaderBinary::set_translation_remapped(bool p_remapped) {
@@ -933,8 +1117,14 @@ String ResourceLoaderBinary::get_unicode_string() {
 	if (len == 0) {
 		return String();
 	}
-	f->get_buffer((uint8_t *)&str_buf[0], len);
 	String s;
+	const uint8_t *mapped = f->get_mapped_buffer(len);
+	if (mapped) {
+		// Parse in place, bounded since the terminator can't be trusted here.
+		s.parse_utf8((const char *)mapped, len);
+		return s;
+	}
+	f->get_buffer((uint8_t *)&str_buf[0], len);
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
@@ -35,6 +35,8 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 
+class MissingResource;
+
 class ResourceLoaderBinary {
 	bool translation_remapped = false;
 	String local_path;
@@ -78,6 +80,28 @@ class ResourceLoaderBinary {
 	Vector<IntResource> internal_resources;
 	HashMap<String, Ref<Resource>> internal_index_cache;
 
+	// An internal resource created while reading the file, whose properties are set afterwards.
+	struct PendingResource {
+		Ref<Resource> resource;
+		MissingResource *missing_resource = nullptr;
+		LocalVector<Pair<StringName, Variant>> properties;
+
+		void set_up();
+	};
+
+	struct PendingLevel {
+		PendingResource *resources = nullptr;
+		const uint32_t *indices = nullptr;
+	};
+
+	LocalVector<uint32_t> *internal_dependencies = nullptr; // Internal resources referenced by parse_variant(), if tracked.
+	LocalVector<uint32_t> *external_dependencies = nullptr; // Same for external resources.
+
+	static void _set_up_pending_resource(void *p_userdata, uint32_t p_index);
+	Error _create_internal_resource(int p_index, Ref<Resource> &r_res, MissingResource *&r_missing_resource);
+	Error _load_internal_resources();
+	Error _load_internal_resources_threaded();
+
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
 
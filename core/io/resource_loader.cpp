@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/core_bind.h"
+#include "core/debugger/timeline_profiler.h"
 #include "core/io/file_access.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
@@ -267,6 +268,9 @@ ResourceLoader::LoadToken::~LoadToken() {
 }
 
 Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress) {
+	MEMORY_TAG_SCOPE(Memory::TAG_RESOURCES);
+	TIMELINE_ZONE("ResourceLoader::load");
+
 	const String &original_path = p_original_path.is_empty() ? p_path : p_original_path;
 	load_nesting++;
 	if (load_paths_stack.size()) {
@@ -923,6 +927,89 @@ void ResourceLoader::resource_changed_emit(Resource *p_source) {
 	}
 }
 
+void ResourceLoader::_run_load_sub_tasks(void *p_userdata) {
+	LoadSubTasks &sub_tasks = *(LoadSubTasks *)p_userdata;
+
+	// Take part in the load that posted the tasks, as if running in its own thread.
+	ThreadLoadTask *curr_load_task_backup = curr_load_task;
+	curr_load_task = sub_tasks.load_task;
+	load_nesting++;
+
+	// Deferred calls are kept for the loading thread, as they would if it did this work itself.
+	// Each pool thread gets its own queue, since a queue is only lock-free for its own thread.
+	CallQueue *&call_queue = sub_tasks.call_queues[WorkerThreadPool::get_thread_index()];
+	if (!call_queue) {
+		call_queue = memnew(CallQueue);
+	}
+	CallQueue *call_queue_backup = MessageQueue::get_singleton() != MessageQueue::get_main_singleton() ? MessageQueue::get_singleton() : nullptr;
+	MessageQueue::set_thread_singleton_override(call_queue);
+
+	while (true) {
+		uint32_t index = sub_tasks.index.postincrement();
+		if (index >= sub_tasks.count) {
+			break;
+		}
+		sub_tasks.func(sub_tasks.userdata, index);
+	}
+
+	MessageQueue::set_thread_singleton_override(call_queue_backup);
+	load_nesting--;
+	curr_load_task = curr_load_task_backup;
+}
+
+void ResourceLoader::run_load_sub_tasks(void (*p_func)(void *, uint32_t), void *p_userdata, uint32_t p_count, const String &p_description) {
+	// Only a load running in the pool waits collaboratively, so its tasks can't starve it.
+	if (p_count < 2 || !curr_load_task || WorkerThreadPool::get_thread_index() == -1) {
+		if (!curr_load_task) {
+			for (uint32_t i = 0; i < p_count; i++) {
+				p_func(p_userdata, i);
+			}
+			return;
+		}
+
+		// Deferred calls are flushed once the elements are done, as when running on tasks,
+		// so what runs next sees the same state either way.
+		CallQueue call_queue;
+		CallQueue *call_queue_backup = MessageQueue::get_singleton() != MessageQueue::get_main_singleton() ? MessageQueue::get_singleton() : nullptr;
+		MessageQueue::set_thread_singleton_override(&call_queue);
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_func(p_userdata, i);
+		}
+		MessageQueue::set_thread_singleton_override(call_queue_backup);
+		call_queue.flush();
+		return;
+	}
+
+	LoadSubTasks sub_tasks;
+	sub_tasks.func = p_func;
+	sub_tasks.userdata = p_userdata;
+	sub_tasks.count = p_count;
+	sub_tasks.load_task = curr_load_task;
+	sub_tasks.call_queues.resize(WorkerThreadPool::get_singleton()->get_thread_count());
+	for (CallQueue *&call_queue : sub_tasks.call_queues) {
+		call_queue = nullptr;
+	}
+
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	const uint32_t task_count = MIN(p_count, sub_tasks.call_queues.size());
+	for (uint32_t i = 0; i < task_count; i++) {
+		task_ids.push_back(WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_run_load_sub_tasks, &sub_tasks, false, p_description));
+	}
+
+	PREPARE_FOR_WTP_WAIT
+	for (WorkerThreadPool::TaskID task_id : task_ids) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+	}
+	RESTORE_AFTER_WTP_WAIT
+
+	for (CallQueue *call_queue : sub_tasks.call_queues) {
+		if (call_queue) {
+			call_queue->flush();
+			memdelete(call_queue);
+		}
+	}
+}
+
 Ref<Resource> ResourceLoader::ensure_resource_ref_override_for_outer_load(const String &p_path, const String &p_res_type) {
 	ERR_FAIL_COND_V(load_nesting == 0, Ref<Resource>()); // It makes no sense to use this from nesting level 0.
 	const String &local_path = _validate_local_path(p_path);
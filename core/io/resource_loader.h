@@ -37,6 +37,7 @@
 #include "core/os/semaphore.h"
 #include "core/os/thread.h"
 
+class CallQueue;
 class ConditionVariable;
 
 template <int Tag>
@@ -200,6 +201,17 @@ private:
 
 	static void _run_load_task(void *p_userdata);
 
+	struct LoadSubTasks {
+		void (*func)(void *, uint32_t) = nullptr;
+		void *userdata = nullptr;
+		uint32_t count = 0;
+		SafeNumeric<uint32_t> index;
+		ThreadLoadTask *load_task = nullptr;
+		LocalVector<CallQueue *> call_queues; // One per pool thread, flushed by the load once the tasks are done.
+	};
+
+	static void _run_load_sub_tasks(void *p_userdata);
+
 	static thread_local int load_nesting;
 	static thread_local HashMap<int, HashMap<String, Ref<Resource>>> res_ref_overrides; // Outermost key is nesting level.
 	static thread_local Vector<String> load_paths_stack;
@@ -228,6 +240,13 @@ public:
 	static void resource_changed_disconnect(Resource *p_source, const Callable &p_callable);
 	static void resource_changed_emit(Resource *p_source);
 
+	// Calls p_func for each of p_count elements on WorkerThreadPool tasks, on behalf of the load
+	// in progress on the calling thread, which helps process them while waiting. Resources set up
+	// there defer their signals and calls the same way the load does, and their deferred calls are
+	// flushed before returning. Runs them in order on the calling thread instead if the load isn't
+	// running in the pool.
+	static void run_load_sub_tasks(void (*p_func)(void *, uint32_t), void *p_userdata, uint32_t p_count, const String &p_description = String());
+
 	static Ref<Resource> load(const String &p_path, const String &p_type_hint = "", ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE, Error *r_error = nullptr);
 	static bool exists(const String &p_path, const String &p_type_hint = "");
 
@@ -604,9 +604,22 @@ private:
 			List<Connection>::Element *cE = nullptr;
 		};
 
+		// Copy of the slots used by `emit_signalp()`. It's shared (copy-on-write)
+		// with running emissions, dropped when `slot_map` changes and rebuilt
+		// lazily, so connecting or disconnecting while emitting doesn't affect them.
+		struct EmitSlot {
+			Callable callable;
+			uint32_t flags = 0;
+		};
+
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
+		Vector<EmitSlot> emit_slots;
+		uint32_t one_shot_count = 0;
+		bool emit_slots_dirty = false;
 		bool removable = false;
+
+		void update_emit_slots();
 	};
 
 	HashMap<StringName, SignalData> signal_map;
@@ -898,6 +911,8 @@ public:
 #ifdef TOOLS_ENABLED
 	void set_edited(bool p_edited);
 	bool is_edited() const;
+	// What set() does on every assignment, for callers that reach a property setter directly.
+	_FORCE_INLINE_ void _mark_edited() { _edited = true; }
 	// This function is used to check when something changed beyond a point, it's used mainly for generating previews.
 	uint32_t get_edited_version() const;
 #endif
@@ -1053,4 +1068,25 @@ public:
 	static int get_object_count();
 };
 
+#ifdef DEBUG_ENABLED
+
+// Held by Object::callp() while a method runs, so the object can't be freed from inside it.
+// Script VMs that dispatch to a resolved method without going through callp() hold it too.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+
+#endif
+
 #endif // OBJECT_H
@@ -30,12 +30,15 @@
 
 #include "worker_thread_pool.h"
 
+#include "core/debugger/timeline_profiler.h"
 #include "core/object/script_language.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/os/thread_safe.h"
 
 WorkerThreadPool::Task *const WorkerThreadPool::ThreadData::YIELDING = (Task *)1;
+WorkerThreadPool::Task *const WorkerThreadPool::ThreadData::AWAITING_GRAPH = (Task *)2;
 
 void WorkerThreadPool::Task::free_template_userdata() {
 	ERR_FAIL_NULL(template_userdata);
@@ -51,6 +54,11 @@ thread_local WorkerThreadPool::UnlockableLocks WorkerThreadPool::unlockable_lock
 #endif
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	// Frame scratch memory allocated by the task is released when it's done.
+	FrameArena::Scope frame_arena_scope;
+	MEMORY_TAG_SCOPE(p_task->memory_tag);
+	TIMELINE_ZONE(p_task->group ? "WorkerThreadPool group task" : "WorkerThreadPool task");
+
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
@@ -70,14 +78,24 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// about to be run uses scripting, guarantees are held.
 		ScriptServer::thread_enter();
 
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
 		prev_task = curr_thread.current_task;
 		curr_thread.current_task = p_task;
-		if (p_task->pending_notify_yield_over) {
-			curr_thread.yield_is_over = true;
+		curr_thread.running_task.set();
+		curr_thread.running_low_priority_task.set_to(p_task->low_priority);
+
+		if (p_task->self != INVALID_TASK_ID) {
+			// Only tasks with an ID can be notified that their yield is over.
+			TaskShard &shard = task_shards[p_task->shard];
+			shard.mutex.lock();
+			p_task->pool_thread_index = pool_thread_index;
+			bool yield_is_over = p_task->pending_notify_yield_over;
+			shard.mutex.unlock();
+
+			if (yield_is_over) {
+				MutexLock task_lock(task_mutex);
+				curr_thread.yield_is_over = true;
+			}
 		}
-		task_mutex.unlock();
 	}
 #endif
 
@@ -129,9 +147,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		// For groups, tasks get rid of themselves.
-
-		task_mutex.lock();
-		task_allocator.free(p_task);
+		_free_task(p_task);
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -142,17 +158,29 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.call();
 		}
 
-		task_mutex.lock();
-		p_task->completed = true;
-		p_task->pool_thread_index = -1;
-		if (p_task->waiting_user) {
-			p_task->done_semaphore.post(p_task->waiting_user);
-		}
-		// Let awaiters know.
-		for (uint32_t i = 0; i < threads.size(); i++) {
-			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
+		if (p_task->is_task_graph_node) {
+			// Nobody can await it; its graph tracks completion.
+			_free_task(p_task);
+		} else {
+			TaskShard &shard = task_shards[p_task->shard];
+			shard.mutex.lock();
+			p_task->completed = true;
+			p_task->pool_thread_index = -1;
+			if (p_task->waiting_user) {
+				p_task->done_semaphore.post(p_task->waiting_user);
+			}
+			bool awaited_by_pool = p_task->waiting_pool > 0;
+			shard.mutex.unlock();
+
+			if (awaited_by_pool) {
+				// Let awaiters know. The task may be freed by now, but only its address is compared.
+				MutexLock task_lock(task_mutex);
+				for (uint32_t i = 0; i < threads.size(); i++) {
+					if (threads[i].awaited_task == p_task) {
+						threads[i].cond_var.notify_one();
+						threads[i].signaled = true;
+					}
+				}
 			}
 		}
 	}
@@ -160,7 +188,10 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 #ifdef THREADS_ENABLED
 	{
 		curr_thread.current_task = prev_task;
+		curr_thread.running_task.set_to(prev_task != nullptr);
+		curr_thread.running_low_priority_task.set_to(prev_task && prev_task->low_priority);
 		if (low_priority) {
+			MutexLock task_lock(task_mutex);
 			low_priority_threads_used--;
 
 			if (_try_promote_low_priority_task()) {
@@ -169,8 +200,6 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				}
 			}
 		}
-
-		task_mutex.unlock();
 	}
 
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
@@ -180,10 +209,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
+	TimelineProfiler::set_thread_name("WorkerThreadPool");
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Local and stolen work doesn't need the task mutex.
+		Task *task_to_process = singleton->_pop_or_steal_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 
 			bool exit = singleton->_handle_runlevel(thread_data, lock);
@@ -197,7 +228,16 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
+				// Local queues are pushed to without the mutex. Announcing the intent to sleep
+				// before checking them pairs with the fence in _try_post_task_locally(), so either
+				// the task is seen here or the poster sees this thread has to be notified.
+				// If any is non-empty, a steal just failed because of contention; try again instead.
+				singleton->sleeping_threads.increment();
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!singleton->_has_local_tasks()) {
+					thread_data->cond_var.wait(lock);
+				}
+				singleton->sleeping_threads.decrement();
 			}
 		}
 
@@ -208,6 +248,12 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 }
 
 void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock) {
+#ifdef MEMORY_TAGS_ENABLED
+	for (uint32_t i = 0; i < p_count; i++) {
+		p_tasks[i]->memory_tag = Memory::get_current_tag();
+	}
+#endif
+
 	// Fall back to processing on the calling thread if there are no worker threads.
 	// Separated into its own variable to make it easier to extend this logic
 	// in custom builds.
@@ -230,10 +276,16 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// Tasks posted from a pool thread are kept in its local queue, so they are likely
+	// to be run by the same thread. Idle threads will steal them otherwise.
+	bool post_locally = work_stealing_enabled.is_set() && caller_pool_thread;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (!post_locally || !caller_pool_thread->work_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -272,9 +324,9 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.current_task) {
+		if (th.running_task.is_set()) {
 			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
+			if (to_promote && th.awaited_task && th.running_low_priority_task.is_set()) {
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
@@ -312,6 +364,45 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_or_steal_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->work_queue.pop(task)) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (victim.work_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_try_post_task_locally(ThreadData *p_caller_pool_thread, Task *p_task) {
+	if (!work_stealing_enabled.is_set() || !p_caller_pool_thread->work_queue.push(p_task)) {
+		return false;
+	}
+
+	// Pairs with the fence issued by threads about to sleep.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (sleeping_threads.get()) {
+		MutexLock task_lock(task_mutex);
+		_notify_threads(p_caller_pool_thread, 1, 0);
+	}
+	return true;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].work_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -324,24 +415,69 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::ThreadData *WorkerThreadPool::_get_caller_pool_thread() const {
+	const int *index = thread_ids.getptr(Thread::get_caller_id());
+	return index ? const_cast<ThreadData *>(&threads[*index]) : nullptr;
+}
+
+uint32_t WorkerThreadPool::_get_caller_task_shard_index() const {
+	const ThreadData *caller_pool_thread = _get_caller_pool_thread();
+	return caller_pool_thread ? (caller_pool_thread->index + 1) % TASK_SHARDS : 0;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_alloc_task(uint32_t p_shard_index) {
+	TaskShard &shard = task_shards[p_shard_index];
+	MutexLock shard_lock(shard.mutex);
+	Task *task = shard.allocator.alloc();
+	task->shard = p_shard_index;
+	return task;
+}
+
+void WorkerThreadPool::_free_task(Task *p_task) {
+	TaskShard &shard = task_shards[p_task->shard];
+	MutexLock shard_lock(shard.mutex);
+	shard.allocator.free(p_task);
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
 WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
-	MutexLock<BinaryMutex> lock(task_mutex);
+	ThreadData *caller_pool_thread = _get_caller_pool_thread();
+	uint32_t shard_index = caller_pool_thread ? (caller_pool_thread->index + 1) % TASK_SHARDS : 0;
+	// IDs still grow with every task, which deadlock prevention relies on.
+	TaskID id = (TaskID)(last_task.postincrement() * TASK_SHARDS + shard_index);
 
 	// Get a free task
-	Task *task = task_allocator.alloc();
-	TaskID id = last_task++;
-	task->self = id;
-	task->callable = p_callable;
-	task->native_func = p_func;
-	task->native_func_userdata = p_userdata;
-	task->description = p_description;
-	task->template_userdata = p_template_userdata;
-	tasks.insert(id, task);
+	Task *task = nullptr;
+	{
+		TaskShard &shard = task_shards[shard_index];
+		MutexLock shard_lock(shard.mutex);
+		task = shard.allocator.alloc();
+		task->self = id;
+		task->shard = shard_index;
+		task->callable = p_callable;
+		task->native_func = p_func;
+		task->native_func_userdata = p_userdata;
+		task->description = p_description;
+		task->template_userdata = p_template_userdata;
+		shard.tasks.insert(id, task);
+	}
+
+	// High priority tasks posted from pool threads don't need any bookkeeping,
+	// so they skip the task mutex unless there are threads to wake up.
+	if (caller_pool_thread && p_high_priority) {
+#ifdef MEMORY_TAGS_ENABLED
+		task->memory_tag = Memory::get_current_tag();
+#endif
+		task->low_priority = false;
+		if (_try_post_task_locally(caller_pool_thread, task)) {
+			return id;
+		}
+	}
 
+	MutexLock<BinaryMutex> lock(task_mutex);
 	_post_tasks(&task, 1, p_high_priority, lock);
 
 	return id;
@@ -352,8 +488,9 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_task(const Callable &p_action, bo
 }
 
 bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
-	MutexLock task_lock(task_mutex);
-	const Task *const *taskp = tasks.getptr(p_task_id);
+	TaskShard &shard = _get_task_shard(p_task_id);
+	MutexLock shard_lock(shard.mutex);
+	const Task *const *taskp = shard.tasks.getptr(p_task_id);
 	if (!taskp) {
 		ERR_FAIL_V_MSG(false, "Invalid Task ID"); // Invalid task
 	}
@@ -362,24 +499,25 @@ bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 }
 
 Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
-	task_mutex.lock();
-	Task **taskp = tasks.getptr(p_task_id);
+	TaskShard &shard = _get_task_shard(p_task_id);
+	shard.mutex.lock();
+	Task **taskp = shard.tasks.getptr(p_task_id);
 	if (!taskp) {
-		task_mutex.unlock();
+		shard.mutex.unlock();
 		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Invalid Task ID"); // Invalid task
 	}
 	Task *task = *taskp;
 
 	if (task->completed) {
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
-			tasks.erase(p_task_id);
-			task_allocator.free(task);
+			shard.tasks.erase(p_task_id);
+			shard.allocator.free(task);
 		}
-		task_mutex.unlock();
+		shard.mutex.unlock();
 		return OK;
 	}
 
-	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
+	ThreadData *caller_pool_thread = _get_caller_pool_thread();
 	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
@@ -392,7 +530,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 		// Taking into account there's no feasible solution for every possible case
 		// with the current design, we just simply reject attempts to await on older tasks,
 		// with a specific error code that signals the situation so the caller can handle it.
-		task_mutex.unlock();
+		shard.mutex.unlock();
 		return ERR_BUSY;
 	}
 
@@ -403,26 +541,26 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	if (caller_pool_thread) {
-		task_mutex.unlock();
+		shard.mutex.unlock();
 		_wait_collaboratively(caller_pool_thread, task);
-		task_mutex.lock();
+		shard.mutex.lock();
 		task->waiting_pool--;
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
-			tasks.erase(p_task_id);
-			task_allocator.free(task);
+			shard.tasks.erase(p_task_id);
+			shard.allocator.free(task);
 		}
 	} else {
-		task_mutex.unlock();
+		shard.mutex.unlock();
 		task->done_semaphore.wait();
-		task_mutex.lock();
+		shard.mutex.lock();
 		task->waiting_user--;
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
-			tasks.erase(p_task_id);
-			task_allocator.free(task);
+			shard.tasks.erase(p_task_id);
+			shard.allocator.free(task);
 		}
 	}
 
-	task_mutex.unlock();
+	shard.mutex.unlock();
 	return OK;
 }
 
@@ -446,7 +584,7 @@ void WorkerThreadPool::_unlock_unlockable_mutexes() {
 #endif
 }
 
-void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task) {
+void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task, TaskGraphRun *p_graph_run) {
 	// Keep processing tasks until the condition to stop waiting is met.
 
 	while (true) {
@@ -469,7 +607,13 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					p_caller_pool_thread->yield_is_over = false;
 					wait_is_over = true;
 				}
+			} else if (p_task == ThreadData::AWAITING_GRAPH) {
+				if (p_graph_run->completed.is_set()) {
+					wait_is_over = true;
+				}
 			} else {
+				TaskShard &shard = task_shards[p_task->shard];
+				MutexLock shard_lock(shard.mutex);
 				if (p_task->completed) {
 					wait_is_over = true;
 				}
@@ -479,7 +623,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->work_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -497,20 +641,30 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (singleton->task_queue.first()) {
+			// Own tasks first; most likely the awaited one is among them.
+			task_to_process = _pop_or_steal_task(p_caller_pool_thread);
+			if (!task_to_process && task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				task_queue.remove(task_queue.first());
 			}
 
 			if (!task_to_process) {
-				p_caller_pool_thread->awaited_task = p_task;
+				// See _thread_function() about the handshake with threads posting locally.
+				sleeping_threads.increment();
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (!_has_local_tasks()) {
+					p_caller_pool_thread->awaited_task = p_task;
+					p_caller_pool_thread->awaited_graph_run = p_graph_run;
 
-				_unlock_unlockable_mutexes();
-				relock_unlockables = true;
+					_unlock_unlockable_mutexes();
+					relock_unlockables = true;
 
-				p_caller_pool_thread->cond_var.wait(lock);
+					p_caller_pool_thread->cond_var.wait(lock);
 
-				p_caller_pool_thread->awaited_task = nullptr;
+					p_caller_pool_thread->awaited_task = nullptr;
+					p_caller_pool_thread->awaited_graph_run = nullptr;
+				}
+				sleeping_threads.decrement();
 			}
 		}
 
@@ -543,7 +697,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -587,7 +741,9 @@ void WorkerThreadPool::yield() {
 
 void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	MutexLock task_lock(task_mutex);
-	Task **taskp = tasks.getptr(p_task_id);
+	TaskShard &shard = _get_task_shard(p_task_id);
+	MutexLock shard_lock(shard.mutex); // Always locked after the task mutex.
+	Task **taskp = shard.tasks.getptr(p_task_id);
 	if (!taskp) {
 		ERR_FAIL_MSG("Invalid Task ID.");
 	}
@@ -612,10 +768,12 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		p_tasks = MAX(1u, threads.size());
 	}
 
+	uint32_t shard_index = _get_caller_task_shard_index();
+
 	MutexLock<BinaryMutex> lock(task_mutex);
 
 	Group *group = group_allocator.alloc();
-	GroupID id = last_task++;
+	GroupID id = last_task.postincrement();
 	group->max = p_elements;
 	group->self = id;
 
@@ -634,7 +792,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		group->tasks_used = p_tasks;
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
-			Task *task = task_allocator.alloc();
+			Task *task = _alloc_task(shard_index);
 			task->native_group_func = p_func;
 			task->native_func_userdata = p_userdata;
 			task->description = p_description;
@@ -709,6 +867,272 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #endif
 }
 
+void WorkerThreadPool::set_work_stealing_enabled(bool p_enabled) {
+	// Tasks already in local queues will still be drained, so this is safe to toggle anytime.
+	work_stealing_enabled.set_to(p_enabled);
+}
+
+bool WorkerThreadPool::is_work_stealing_enabled() const {
+	return work_stealing_enabled.is_set();
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::_add_node(const Callable &p_callable, void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, int p_tasks, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	NodeID id = nodes.size();
+
+	TaskGraphNode node;
+	node.callable = p_callable;
+	node.native_func = p_func;
+	node.native_group_func = p_group_func;
+	node.native_func_userdata = p_userdata;
+	node.template_userdata = p_template_userdata;
+	node.description = p_description;
+	node.is_group = p_is_group;
+	node.elements = MAX(0, p_elements);
+	node.tasks = p_tasks;
+	nodes.push_back(node);
+
+	for (NodeID predecessor : p_predecessors) {
+		// Only nodes already in the graph can be depended upon, so cycles are impossible.
+		ERR_CONTINUE_MSG(predecessor >= id, vformat("Invalid predecessor %d for task graph node %d.", predecessor, id));
+		if (nodes[predecessor].successors.has(id)) {
+			continue;
+		}
+		nodes[predecessor].successors.push_back(id);
+		nodes[id].predecessor_count++;
+	}
+
+	return id;
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	return _add_node(Callable(), p_func, nullptr, p_userdata, nullptr, false, 0, 1, p_predecessors, p_description);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_task(const Callable &p_action, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	return _add_node(p_action, nullptr, nullptr, nullptr, nullptr, false, 0, 1, p_predecessors, p_description);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	return _add_node(Callable(), nullptr, p_func, p_userdata, nullptr, true, p_elements, p_tasks, p_predecessors, p_description);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_group_task(const Callable &p_action, int p_elements, int p_tasks, const LocalVector<NodeID> &p_predecessors, const String &p_description) {
+	return _add_node(p_action, nullptr, nullptr, nullptr, nullptr, true, p_elements, p_tasks, p_predecessors, p_description);
+}
+
+void WorkerThreadPool::TaskGraph::clear() {
+	for (TaskGraphNode &node : nodes) {
+		if (node.template_userdata) {
+			memdelete(node.template_userdata);
+		}
+	}
+	nodes.clear();
+}
+
+WorkerThreadPool::TaskGraph::~TaskGraph() {
+	clear();
+}
+
+WorkerThreadPool::TaskGraphRun::~TaskGraphRun() {
+	// Only nodes that never ran may still own their userdata.
+	for (TaskGraphNode &node : nodes) {
+		if (node.template_userdata) {
+			memdelete(node.template_userdata);
+		}
+	}
+}
+
+void WorkerThreadPool::_task_graph_node_func(void *p_userdata) {
+	TaskGraphRun::NodeState *state = (TaskGraphRun::NodeState *)p_userdata;
+	const TaskGraphNode &node = state->run->nodes[state->node];
+
+	if (node.is_group) {
+		while (true) {
+			uint32_t work_index = state->index.postincrement();
+			if (work_index >= node.elements) {
+				break;
+			}
+			if (node.native_group_func) {
+				node.native_group_func(node.native_func_userdata, work_index);
+			} else if (node.template_userdata) {
+				node.template_userdata->callback_indexed(work_index);
+			} else {
+				node.callable.call(work_index);
+			}
+		}
+
+		if (state->finished_tasks.increment() != (uint32_t)node.tasks) {
+			return; // The last task of the group to finish completes the node.
+		}
+	} else {
+		if (node.native_func) {
+			node.native_func(node.native_func_userdata);
+		} else if (node.template_userdata) {
+			node.template_userdata->callback();
+		} else {
+			node.callable.call();
+		}
+	}
+
+	singleton->_task_graph_node_completed(state);
+}
+
+void WorkerThreadPool::_post_task_graph_nodes(TaskGraphRun *p_run, const uint32_t *p_nodes, uint32_t p_count, MutexLock<BinaryMutex> &p_lock) {
+	uint32_t shard_index = _get_caller_task_shard_index();
+	LocalVector<Task *> tasks_posted;
+	for (uint32_t i = 0; i < p_count; i++) {
+		const TaskGraphNode &node = p_run->nodes[p_nodes[i]];
+		for (int j = 0; j < node.tasks; j++) {
+			Task *task = _alloc_task(shard_index);
+			task->native_func = &WorkerThreadPool::_task_graph_node_func;
+			task->native_func_userdata = &p_run->states[p_nodes[i]];
+			task->description = node.description;
+			task->is_task_graph_node = true;
+			tasks_posted.push_back(task);
+		}
+	}
+
+	_post_tasks(tasks_posted.ptr(), tasks_posted.size(), p_run->high_priority, p_lock);
+}
+
+void WorkerThreadPool::_task_graph_node_completed(TaskGraphRun::NodeState *p_state) {
+	TaskGraphRun *run = p_state->run;
+	TaskGraphNode &node = run->nodes[p_state->node];
+
+	if (node.template_userdata) {
+		memdelete(node.template_userdata); // This is no longer needed at this point, so get rid of it.
+		node.template_userdata = nullptr;
+	}
+
+	// Fire the continuations that were only waiting for this one.
+	uint32_t *ready = (uint32_t *)alloca(sizeof(uint32_t) * MAX(1u, node.successors.size()));
+	uint32_t ready_count = 0;
+	for (uint32_t successor : node.successors) {
+		if (run->states[successor].pending_predecessors.decrement() == 0) {
+			ready[ready_count++] = successor;
+		}
+	}
+	if (ready_count) {
+		MutexLock lock(task_mutex);
+		_post_task_graph_nodes(run, ready, ready_count, lock);
+	}
+
+	// Successors are already accounted for, so this can only reach zero with the last node.
+	if (run->pending_nodes.decrement() == 0) {
+		run->completed.set();
+		run->done_semaphore.post();
+		{
+			// Pool threads await graphs collaboratively, so they need to be woken up.
+			MutexLock lock(task_mutex);
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				if (threads[i].awaited_graph_run == run) {
+					threads[i].cond_var.notify_one();
+					threads[i].signaled = true;
+				}
+			}
+		}
+		if (run->finished.increment() == 2) {
+			memdelete(run);
+		}
+	}
+}
+
+WorkerThreadPool::TaskGraphID WorkerThreadPool::add_task_graph(TaskGraph &p_graph, bool p_high_priority) {
+	TaskGraphRun *run = memnew(TaskGraphRun);
+	run->high_priority = p_high_priority;
+	run->nodes = p_graph.nodes;
+	p_graph.nodes.clear(); // Ownership of template userdata is now the run's.
+
+	const uint32_t node_count = run->nodes.size();
+	const int default_tasks = MAX(1u, threads.size());
+	run->states.resize(node_count);
+	run->pending_nodes.set(node_count);
+
+	LocalVector<uint32_t> roots;
+	for (uint32_t i = 0; i < node_count; i++) {
+		TaskGraphNode &node = run->nodes[i];
+		if (node.is_group) {
+			if (node.tasks < 0) {
+				node.tasks = default_tasks;
+			}
+			// An empty group still gets one task, so it completes through the usual path.
+			node.tasks = CLAMP(node.tasks, 1, (int)MAX(1u, node.elements));
+		} else {
+			node.tasks = 1;
+		}
+
+		TaskGraphRun::NodeState &state = run->states[i];
+		state.run = run;
+		state.node = i;
+		state.pending_predecessors.set(node.predecessor_count);
+		if (node.predecessor_count == 0) {
+			roots.push_back(i);
+		}
+	}
+
+	MutexLock<BinaryMutex> lock(task_mutex);
+
+	TaskGraphID id = last_task.postincrement();
+	run->self = id;
+	task_graphs.insert(id, run);
+
+	if (node_count == 0) {
+		run->completed.set();
+		run->done_semaphore.post();
+		run->finished.increment();
+	} else {
+		_post_task_graph_nodes(run, roots.ptr(), roots.size(), lock);
+	}
+
+	return id;
+}
+
+bool WorkerThreadPool::is_task_graph_completed(TaskGraphID p_graph) const {
+	MutexLock task_lock(task_mutex);
+	TaskGraphRun *const *runp = task_graphs.getptr(p_graph);
+	if (!runp) {
+		ERR_FAIL_V_MSG(false, "Invalid Task Graph ID.");
+	}
+	return (*runp)->completed.is_set();
+}
+
+void WorkerThreadPool::wait_for_task_graph_completion(TaskGraphID p_graph) {
+	task_mutex.lock();
+	TaskGraphRun **runp = task_graphs.getptr(p_graph);
+	if (!runp) {
+		task_mutex.unlock();
+		ERR_FAIL_MSG("Invalid Task Graph ID.");
+	}
+	TaskGraphRun *run = *runp;
+
+	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
+	if (caller_pool_thread) {
+		const Task *current_task = caller_pool_thread->current_task;
+		if (current_task && current_task->is_task_graph_node && ((TaskGraphRun::NodeState *)current_task->native_func_userdata)->run == run) {
+			task_mutex.unlock();
+			ERR_FAIL_MSG("A task graph can't be awaited from one of its own nodes.");
+		}
+	}
+
+	task_graphs.erase(p_graph);
+	task_mutex.unlock();
+
+	if (caller_pool_thread) {
+		// Blocking here could starve the graph of the tasks this thread has queued locally,
+		// so keep processing tasks until it's done.
+		_wait_collaboratively(caller_pool_thread, ThreadData::AWAITING_GRAPH, run);
+	} else {
+		_unlock_unlockable_mutexes();
+		run->done_semaphore.wait();
+		_lock_unlockable_mutexes();
+	}
+
+	// The completing thread may still be posting the semaphore, so whoever is last frees the run.
+	if (run->finished.increment() == 2) {
+		memdelete(run);
+	}
+}
+
 int WorkerThreadPool::get_thread_index() {
 	Thread::ID tid = Thread::get_caller_id();
 	return singleton->thread_ids.has(tid) ? singleton->thread_ids[tid] : -1;
@@ -811,11 +1235,20 @@ void WorkerThreadPool::finish() {
 		data.thread.wait_to_finish();
 	}
 
+	for (TaskShard &shard : task_shards) {
+		MutexLock shard_lock(shard.mutex);
+		for (KeyValue<TaskID, Task *> &E : shard.tasks) {
+			shard.allocator.free(E.value);
+		}
+		shard.tasks.clear();
+	}
+
 	{
 		MutexLock lock(task_mutex);
-		for (KeyValue<TaskID, Task *> &E : tasks) {
-			task_allocator.free(E.value);
+		for (KeyValue<TaskGraphID, TaskGraphRun *> &E : task_graphs) {
+			memdelete(E.value);
 		}
+		task_graphs.clear();
 	}
 
 	threads.clear();
@@ -40,6 +40,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -50,6 +51,7 @@ public:
 
 	typedef int64_t TaskID;
 	typedef int64_t GroupID;
+	typedef int64_t TaskGraphID;
 
 private:
 	struct Task;
@@ -79,8 +81,10 @@ private:
 		void *native_func_userdata = nullptr;
 		String description;
 		Semaphore done_semaphore; // For user threads awaiting.
+		// The completion and waiting state is guarded by the mutex of the shard the task belongs to.
 		bool completed : 1;
 		bool pending_notify_yield_over : 1;
+		bool is_task_graph_node : 1; // Not tracked by ID; freed as soon as it's run.
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
@@ -88,18 +92,74 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t shard = 0;
+#ifdef MEMORY_TAGS_ENABLED
+		Memory::Tag memory_tag = Memory::TAG_UNTAGGED; // Inherited from the posting thread.
+#endif
 
 		void free_template_userdata();
 		Task() :
 				completed(false),
 				pending_notify_yield_over(false),
+				is_task_graph_node(false),
 				task_elem(this) {}
 	};
 
-	static const uint32_t TASKS_PAGE_SIZE = 1024;
+	struct TaskGraphNode {
+		Callable callable;
+		void (*native_func)(void *) = nullptr;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		BaseTemplateUserdata *template_userdata = nullptr;
+		String description;
+		bool is_group = false;
+		uint32_t elements = 0;
+		int tasks = 1;
+		uint32_t predecessor_count = 0;
+		LocalVector<uint32_t> successors;
+	};
+
+	struct TaskGraphRun {
+		struct NodeState {
+			TaskGraphRun *run = nullptr;
+			uint32_t node = 0;
+			SafeNumeric<uint32_t> pending_predecessors;
+			SafeNumeric<uint32_t> index; // Next element to process, for groups.
+			SafeNumeric<uint32_t> finished_tasks;
+		};
+
+		TaskGraphID self = -1;
+		bool high_priority = false;
+		LocalVector<TaskGraphNode> nodes;
+		TightLocalVector<NodeState> states;
+		SafeNumeric<uint32_t> pending_nodes;
+		Semaphore done_semaphore;
+		SafeFlag completed;
+		SafeNumeric<uint32_t> finished; // Completion and waiter; the last one frees the run.
+
+		~TaskGraphRun();
+	};
+
+	static const uint32_t TASKS_PAGE_SIZE = 256;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
 
-	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
+	// Tasks are allocated and tracked in shards, so posting and completing them doesn't
+	// need the task mutex. Each pool thread gets its own shard and the rest share the first.
+	// Task IDs tell their shard apart, so it can be found from the ID alone.
+	static const uint32_t TASK_SHARDS = 32;
+	struct TaskShard {
+		BinaryMutex mutex;
+		PagedAllocator<Task, false, TASKS_PAGE_SIZE> allocator;
+		HashMap<
+				TaskID,
+				Task *,
+				HashMapHasherDefault,
+				HashMapComparatorDefault<TaskID>,
+				PagedAllocator<HashMapElement<TaskID, Task *>, false, TASKS_PAGE_SIZE>>
+				tasks;
+	};
+	TaskShard task_shards[TASK_SHARDS];
+
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
@@ -109,6 +169,7 @@ private:
 
 	struct ThreadData {
 		static Task *const YIELDING; // Too bad constexpr doesn't work here.
+		static Task *const AWAITING_GRAPH;
 
 		uint32_t index = 0;
 		Thread thread;
@@ -116,9 +177,13 @@ private:
 		bool yield_is_over : 1;
 		bool pre_exited_languages : 1;
 		bool exited_languages : 1;
-		Task *current_task = nullptr;
-		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
+		Task *current_task = nullptr; // Only accessed by the thread itself.
+		SafeFlag running_task; // For other threads to know about the current task without the task mutex.
+		SafeFlag running_low_priority_task;
+		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING, AWAITING_GRAPH).
+		TaskGraphRun *awaited_graph_run = nullptr;
 		ConditionVariable cond_var;
+		WorkStealingDeque<Task *> work_queue; // Tasks posted by this thread. Only pushed by the thread itself; popped and stolen lock-free.
 
 		ThreadData() :
 				signaled(false),
@@ -145,13 +210,6 @@ private:
 	ConditionVariable control_cond_var;
 
 	HashMap<Thread::ID, int> thread_ids;
-	HashMap<
-			TaskID,
-			Task *,
-			HashMapHasherDefault,
-			HashMapComparatorDefault<TaskID>,
-			PagedAllocator<HashMapElement<TaskID, Task *>, false, TASKS_PAGE_SIZE>>
-			tasks;
 	HashMap<
 			GroupID,
 			Group *,
@@ -159,22 +217,39 @@ private:
 			HashMapComparatorDefault<GroupID>,
 			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
 			groups;
+	HashMap<TaskGraphID, TaskGraphRun *> task_graphs;
 
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	SafeNumeric<uint32_t> sleeping_threads; // Threads about to wait on their condition variable.
+
+	SafeNumeric<uint64_t> last_task{ 1 };
 
-	uint64_t last_task = 1;
+	SafeFlag work_stealing_enabled{ true };
 
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	Task *_pop_or_steal_task(ThreadData *p_thread_data);
+	bool _has_local_tasks() const;
+	bool _try_post_task_locally(ThreadData *p_caller_pool_thread, Task *p_task);
+
+	ThreadData *_get_caller_pool_thread() const;
+	_FORCE_INLINE_ TaskShard &_get_task_shard(TaskID p_task_id) const { return const_cast<TaskShard &>(task_shards[(uint64_t)p_task_id % TASK_SHARDS]); }
+	uint32_t _get_caller_task_shard_index() const;
+	Task *_alloc_task(uint32_t p_shard_index);
+	void _free_task(Task *p_task);
 
 	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority, MutexLock<BinaryMutex> &p_lock);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
 
+	static void _task_graph_node_func(void *p_userdata);
+	void _post_task_graph_nodes(TaskGraphRun *p_run, const uint32_t *p_nodes, uint32_t p_count, MutexLock<BinaryMutex> &p_lock);
+	void _task_graph_node_completed(TaskGraphRun::NodeState *p_state);
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
@@ -209,7 +284,7 @@ private:
 		}
 	};
 
-	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task);
+	void _wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task, TaskGraphRun *p_graph_run = nullptr);
 
 	void _switch_runlevel(Runlevel p_runlevel);
 	bool _handle_runlevel(ThreadData *p_thread_data, MutexLock<BinaryMutex> &p_lock);
@@ -225,6 +300,53 @@ protected:
 	static void _bind_methods();
 
 public:
+	// A set of tasks and group tasks with dependencies among them.
+	// Nodes are added with their predecessors, which must have been added before,
+	// so the graph is acyclic by construction. Once submitted with add_task_graph(),
+	// every node is posted as soon as all its predecessors have completed, from the
+	// thread that completed the last one, and the whole graph is awaited at once.
+	class TaskGraph {
+		friend class WorkerThreadPool;
+
+	public:
+		typedef uint32_t NodeID;
+
+	private:
+		LocalVector<TaskGraphNode> nodes;
+
+		NodeID _add_node(const Callable &p_callable, void (*p_func)(void *), void (*p_group_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_is_group, int p_elements, int p_tasks, const LocalVector<NodeID> &p_predecessors, const String &p_description);
+
+	public:
+		template <typename C, typename M, typename U>
+		NodeID add_template_task(C *p_instance, M p_method, U p_userdata, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String()) {
+			typedef TaskUserData<C, M, U> TUD;
+			TUD *ud = memnew(TUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(Callable(), nullptr, nullptr, nullptr, ud, false, 0, 1, p_predecessors, p_description);
+		}
+		NodeID add_native_task(void (*p_func)(void *), void *p_userdata, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+		NodeID add_task(const Callable &p_action, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+
+		template <typename C, typename M, typename U>
+		NodeID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String()) {
+			typedef GroupUserData<C, M, U> GroupUD;
+			GroupUD *ud = memnew(GroupUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(Callable(), nullptr, nullptr, nullptr, ud, true, p_elements, p_tasks, p_predecessors, p_description);
+		}
+		NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+		NodeID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, const LocalVector<NodeID> &p_predecessors = LocalVector<NodeID>(), const String &p_description = String());
+
+		_FORCE_INLINE_ uint32_t get_node_count() const { return nodes.size(); }
+		void clear();
+
+		~TaskGraph();
+	};
+
 	template <typename C, typename M, typename U>
 	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
 		typedef TaskUserData<C, M, U> TUD;
@@ -258,8 +380,16 @@ public:
 	bool is_group_task_completed(GroupID p_group) const;
 	void wait_for_group_task_completion(GroupID p_group);
 
+	// Takes over the nodes of the graph, which is left empty and can be reused.
+	TaskGraphID add_task_graph(TaskGraph &p_graph, bool p_high_priority = false);
+	bool is_task_graph_completed(TaskGraphID p_graph) const;
+	void wait_for_task_graph_completion(TaskGraphID p_graph);
+
 	_FORCE_INLINE_ int get_thread_count() const { return threads.size(); }
 
+	void set_work_stealing_enabled(bool p_enabled);
+	bool is_work_stealing_enabled() const;
+
 	static WorkerThreadPool *get_singleton() { return singleton; }
 	static int get_thread_index();
 	static TaskID get_caller_task_id();
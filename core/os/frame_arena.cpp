@@ -0,0 +1,135 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include <string.h>
+
+thread_local FrameArena::ThreadArena FrameArena::thread_arena;
+
+SafeNumeric<uint64_t> FrameArena::max_usage;
+SafeNumeric<uint64_t> FrameArena::reserved;
+
+FrameArena::ThreadArena::~ThreadArena() {
+	Chunk *chunk = first;
+	while (chunk) {
+		Chunk *next = chunk->next;
+		reserved.sub(chunk->size);
+		Memory::free_static(chunk);
+		chunk = next;
+	}
+}
+
+void *FrameArena::_alloc_slow(size_t p_bytes) {
+	ThreadArena &arena = thread_arena;
+	size_t needed = HEADER_SIZE + ((p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+
+	Chunk *next = arena.current ? arena.current->next : arena.first;
+	if (!next || next->size < needed) {
+		// Grow geometrically, so a thread settles on a few chunks after its first frames.
+		size_t size = MAX(MAX(MIN_CHUNK_SIZE, needed), arena.current ? arena.current->size * 2 : 0);
+		Chunk *chunk = (Chunk *)Memory::alloc_static(HEADER_SIZE + size);
+		ERR_FAIL_NULL_V(chunk, nullptr);
+		memnew_placement(chunk, Chunk);
+		chunk->size = size;
+		chunk->next = next;
+		if (arena.current) {
+			arena.current->next = chunk;
+		} else {
+			arena.first = chunk;
+		}
+		reserved.add(size);
+		next = chunk;
+	}
+
+	if (arena.current) {
+		arena.used += arena.current->size - arena.offset; // The tail of the previous chunk is wasted until the next reset.
+	}
+	arena.current = next;
+	arena.offset = 0;
+
+	return alloc(p_bytes);
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	if (!p_memory) {
+		return alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		free(p_memory);
+		return nullptr;
+	}
+
+	ThreadArena &arena = thread_arena;
+	uint64_t *size_ptr = (uint64_t *)((uint8_t *)p_memory - HEADER_SIZE);
+	size_t old_bytes = *size_ptr;
+
+	if (p_memory == arena.last_allocation) {
+		// Grow or shrink in place if it still fits in the chunk.
+		size_t old_needed = (old_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		size_t new_needed = (p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		if (arena.offset - old_needed + new_needed <= arena.current->size) {
+			arena.offset = arena.offset - old_needed + new_needed;
+			arena.used = arena.used - old_needed + new_needed;
+			*size_ptr = p_bytes;
+			return p_memory;
+		}
+	}
+
+	void *mem = alloc(p_bytes);
+	ERR_FAIL_NULL_V(mem, nullptr);
+	memcpy(mem, p_memory, MIN(old_bytes, p_bytes));
+	return mem;
+}
+
+FrameArena::Mark FrameArena::get_mark() {
+	const ThreadArena &arena = thread_arena;
+	Mark mark;
+	mark.chunk = arena.current;
+	mark.offset = arena.offset;
+	mark.used = arena.used;
+	return mark;
+}
+
+void FrameArena::restore(const Mark &p_mark) {
+	ThreadArena &arena = thread_arena;
+	DEV_ASSERT(p_mark.used <= arena.used);
+	if (arena.used > p_mark.used) {
+		max_usage.exchange_if_greater(arena.used);
+	}
+	arena.current = p_mark.chunk;
+	arena.offset = p_mark.offset;
+	arena.used = p_mark.used;
+	arena.last_allocation = nullptr;
+}
+
+void FrameArena::reset() {
+	restore(Mark());
+}
@@ -0,0 +1,132 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include "core/os/memory.h"
+#include "core/templates/safe_refcount.h"
+
+// Per-thread bump allocator for short-lived scratch memory.
+//
+// Allocating is just bumping a pointer and freeing is (almost always) a no-op:
+// memory is reclaimed in bulk when a Scope ends or when the thread's arena is reset.
+// The main thread's arena is reset at the end of every frame, and every WorkerThreadPool
+// task runs in its own Scope, so memory from here is only valid until then.
+// Any other thread using it must wrap its work in a Scope.
+//
+// It can back containers via their allocator hook, e.g. `LocalVector<T, uint32_t, false, false, FrameArena>`,
+// as long as they don't outlive the frame or Scope they were filled in.
+class FrameArena {
+	static constexpr size_t ALIGNMENT = alignof(max_align_t);
+	static constexpr size_t HEADER_SIZE = ALIGNMENT; // Holds the allocation size, for realloc().
+	static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+	struct Chunk {
+		Chunk *next = nullptr;
+		size_t size = 0;
+		_FORCE_INLINE_ uint8_t *get_data() { return (uint8_t *)this + HEADER_SIZE; }
+	};
+	static_assert(sizeof(Chunk) <= HEADER_SIZE);
+
+	struct ThreadArena {
+		Chunk *first = nullptr;
+		Chunk *current = nullptr;
+		size_t offset = 0; // Within the current chunk.
+		size_t used = 0; // Across all chunks, including what's skipped at the end of them.
+		uint8_t *last_allocation = nullptr;
+
+		~ThreadArena();
+	};
+
+	static thread_local ThreadArena thread_arena;
+
+	static SafeNumeric<uint64_t> max_usage;
+	static SafeNumeric<uint64_t> reserved;
+
+	static void *_alloc_slow(size_t p_bytes);
+
+public:
+	struct Mark {
+		Chunk *chunk = nullptr;
+		size_t offset = 0;
+		size_t used = 0;
+	};
+
+	_FORCE_INLINE_ static void *alloc(size_t p_bytes) {
+		ThreadArena &arena = thread_arena;
+		size_t needed = HEADER_SIZE + ((p_bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+		if (unlikely(!arena.current || arena.offset + needed > arena.current->size)) {
+			return _alloc_slow(p_bytes);
+		}
+		uint8_t *mem = arena.current->get_data() + arena.offset;
+		*(uint64_t *)mem = p_bytes;
+		arena.offset += needed;
+		arena.used += needed;
+		arena.last_allocation = mem + HEADER_SIZE;
+		return arena.last_allocation;
+	}
+
+	static void *realloc(void *p_memory, size_t p_bytes);
+
+	// Only the most recent allocation is actually given back; others wait until the Scope ends.
+	_FORCE_INLINE_ static void free(void *p_memory) {
+		ThreadArena &arena = thread_arena;
+		if (p_memory && p_memory == arena.last_allocation) {
+			size_t size = *(uint64_t *)((uint8_t *)p_memory - HEADER_SIZE);
+			size_t needed = HEADER_SIZE + ((size + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+			arena.offset -= needed;
+			arena.used -= needed;
+			arena.last_allocation = nullptr;
+		}
+	}
+
+	static Mark get_mark();
+	// Releases everything allocated on this thread since the mark was taken.
+	static void restore(const Mark &p_mark);
+	// Releases everything allocated on this thread. Chunks are kept for reuse.
+	static void reset();
+
+	// Peak bytes in use by any one thread between resets.
+	static uint64_t get_max_usage() { return max_usage.get(); }
+	// Bytes held by the arenas of all threads.
+	static uint64_t get_reserved() { return reserved.get(); }
+
+	class Scope {
+		Mark mark;
+
+	public:
+		_FORCE_INLINE_ Scope() :
+				mark(FrameArena::get_mark()) {}
+		_FORCE_INLINE_ ~Scope() { FrameArena::restore(mark); }
+	};
+};
+
+#endif // FRAME_ARENA_H
@@ -66,6 +66,11 @@ SafeNumeric<uint64_t> Memory::max_usage;
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
+#ifdef MEMORY_TAGS_ENABLED
+Memory::TagStats Memory::tag_stats[Memory::TAG_MAX];
+thread_local Memory::Tag Memory::current_tag = Memory::TAG_UNTAGGED;
+#endif
+
 inline bool is_power_of_2(size_t x) { return x && ((x & (x - 1U)) == 0U); }
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
@@ -99,7 +104,7 @@ void Memory::free_aligned_static(void *p_memory) {
 }
 
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TAGS_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -117,6 +122,13 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
 		*s = p_bytes;
 
+#ifdef MEMORY_TAGS_ENABLED
+		Tag tag = current_tag;
+		*s |= (uint64_t)tag << TAG_SHIFT;
+		_tag_add(tag, p_bytes);
+		tag_stats[tag].alloc_count.increment();
+#endif
+
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
 		max_usage.exchange_if_greater(new_mem_usage);
@@ -134,7 +146,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TAGS_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -144,27 +156,45 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
+#ifdef MEMORY_TAGS_ENABLED
+		// The allocation keeps the tag it was created with.
+		const uint64_t tag_bits = *s & ~SIZE_MASK;
+		const Tag tag = Tag(*s >> TAG_SHIFT);
+		const uint64_t prev_bytes = *s & SIZE_MASK;
+		if (p_bytes > prev_bytes) {
+			_tag_add(tag, p_bytes - prev_bytes);
+		} else {
+			tag_stats[tag].mem_usage.sub(prev_bytes - p_bytes);
+		}
+#else
+		const uint64_t tag_bits = 0;
+		const uint64_t prev_bytes = *s;
+#endif
+
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
+		if (p_bytes > prev_bytes) {
+			uint64_t new_mem_usage = mem_usage.add(p_bytes - prev_bytes);
 			max_usage.exchange_if_greater(new_mem_usage);
 		} else {
-			mem_usage.sub(*s - p_bytes);
+			mem_usage.sub(prev_bytes - p_bytes);
 		}
 #endif
 
 		if (p_bytes == 0) {
+#ifdef MEMORY_TAGS_ENABLED
+			tag_stats[tag].alloc_count.decrement();
+#endif
 			free(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
+			*s = p_bytes | tag_bits;
 
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
 
-			*s = p_bytes;
+			*s = p_bytes | tag_bits;
 
 			return mem + DATA_OFFSET;
 		}
@@ -182,7 +212,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TAGS_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -193,7 +223,16 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
+#ifdef MEMORY_TAGS_ENABLED
+		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+		const Tag tag = Tag(*s >> TAG_SHIFT);
+		const uint64_t bytes = *s & SIZE_MASK;
+		tag_stats[tag].mem_usage.sub(bytes);
+		tag_stats[tag].alloc_count.decrement();
 #ifdef DEBUG_ENABLED
+		mem_usage.sub(bytes);
+#endif
+#elif defined(DEBUG_ENABLED)
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 		mem_usage.sub(*s);
 #endif
@@ -224,6 +263,46 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+const char *Memory::get_tag_name(Tag p_tag) {
+	static const char *names[TAG_MAX] = {
+		"untagged",
+		"physics",
+		"navigation",
+		"scripting",
+		"resources",
+		"rendering",
+	};
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	return names[p_tag];
+}
+
+uint64_t Memory::get_tag_mem_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef MEMORY_TAGS_ENABLED
+	return tag_stats[p_tag].mem_usage.get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_mem_max_usage(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef MEMORY_TAGS_ENABLED
+	return tag_stats[p_tag].max_usage.get();
+#else
+	return 0;
+#endif
+}
+
+uint64_t Memory::get_tag_alloc_count(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+#ifdef MEMORY_TAGS_ENABLED
+	return tag_stats[p_tag].alloc_count.get();
+#else
+	return 0;
+#endif
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
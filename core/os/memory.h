@@ -39,6 +39,20 @@
 #include <type_traits>
 
 class Memory {
+public:
+	// Subsystems allocations can be attributed to, when built with `memory_tags=yes`.
+	// Allocations made while a MEMORY_TAG_SCOPE is active on the calling thread get its tag.
+	enum Tag : uint8_t {
+		TAG_UNTAGGED,
+		TAG_PHYSICS,
+		TAG_NAVIGATION,
+		TAG_SCRIPTING,
+		TAG_RESOURCES,
+		TAG_RENDERING,
+		TAG_MAX
+	};
+
+private:
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
@@ -46,6 +60,25 @@ class Memory {
 
 	static SafeNumeric<uint64_t> alloc_count;
 
+#ifdef MEMORY_TAGS_ENABLED
+	// The tag is kept in the top bits of the size stored before the data.
+	static constexpr int TAG_SHIFT = 56;
+	static constexpr uint64_t SIZE_MASK = (UINT64_C(1) << TAG_SHIFT) - 1;
+
+	struct TagStats {
+		SafeNumeric<uint64_t> mem_usage;
+		SafeNumeric<uint64_t> max_usage;
+		SafeNumeric<uint64_t> alloc_count;
+	};
+	static TagStats tag_stats[TAG_MAX];
+	static thread_local Tag current_tag;
+
+	_FORCE_INLINE_ static void _tag_add(Tag p_tag, uint64_t p_bytes) {
+		uint64_t new_usage = tag_stats[p_tag].mem_usage.add(p_bytes);
+		tag_stats[p_tag].max_usage.exchange_if_greater(new_usage);
+	}
+#endif
+
 public:
 	// Alignment:  ↓ max_align_t        ↓ uint64_t          ↓ max_align_t
 	//             ┌─────────────────┬──┬────────────────┬──┬───────────...
@@ -89,11 +122,42 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+
+	static const char *get_tag_name(Tag p_tag);
+	// These return 0 unless built with `memory_tags=yes`.
+	static uint64_t get_tag_mem_usage(Tag p_tag);
+	static uint64_t get_tag_mem_max_usage(Tag p_tag);
+	static uint64_t get_tag_alloc_count(Tag p_tag);
+
+#ifdef MEMORY_TAGS_ENABLED
+	_FORCE_INLINE_ static Tag get_current_tag() { return current_tag; }
+	_FORCE_INLINE_ static void set_current_tag(Tag p_tag) { current_tag = p_tag; }
+#endif
 };
 
+#ifdef MEMORY_TAGS_ENABLED
+class MemoryTagScope {
+	Memory::Tag prev_tag;
+
+public:
+	_FORCE_INLINE_ MemoryTagScope(Memory::Tag p_tag) {
+		prev_tag = Memory::get_current_tag();
+		Memory::set_current_tag(p_tag);
+	}
+	_FORCE_INLINE_ ~MemoryTagScope() {
+		Memory::set_current_tag(prev_tag);
+	}
+};
+
+#define MEMORY_TAG_SCOPE(m_tag) MemoryTagScope _memory_tag_scope_(m_tag)
+#else
+#define MEMORY_TAG_SCOPE(m_tag)
+#endif
+
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return Memory::realloc_static(p_ptr, p_memory, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
@@ -38,62 +38,83 @@ StringBuilder &StringBuilder::append(const String &p_string) {
 	}
 
 	strings.push_back(p_string);
-	appended_strings.push_back(-1);
 
-	string_length += p_string.length();
+	Segment segment;
+	segment.string = p_string.ptr();
+	segment.length = p_string.length();
+	segments.push_back(segment);
+
+	string_length += segment.length;
 
 	return *this;
 }
 
 StringBuilder &StringBuilder::append(const char *p_cstring) {
-	int32_t len = strlen(p_cstring);
-
-	c_strings.push_back(p_cstring);
-	appended_strings.push_back(len);
+	Segment segment;
+	segment.c_string = p_cstring;
+	segment.length = strlen(p_cstring);
+	segment.type = Segment::TYPE_C_STRING;
+	segments.push_back(segment);
 
-	string_length += len;
+	string_length += segment.length;
 
 	return *this;
 }
 
-String StringBuilder::as_string() const {
-	if (string_length == 0) {
-		return "";
-	}
-
-	char32_t *buffer = memnew_arr(char32_t, string_length);
-
-	int current_position = 0;
+StringBuilder &StringBuilder::append(char32_t p_char) {
+	Segment segment;
+	segment.character = p_char;
+	segment.length = 1;
+	segment.type = Segment::TYPE_CHAR;
+	segments.push_back(segment);
 
-	int godot_string_elem = 0;
-	int c_string_elem = 0;
+	string_length += 1;
 
-	for (int i = 0; i < appended_strings.size(); i++) {
-		if (appended_strings[i] == -1) {
-			// Godot string
-			const String &s = strings[godot_string_elem];
+	return *this;
+}
 
-			memcpy(buffer + current_position, s.ptr(), s.length() * sizeof(char32_t));
+StringBuilder &StringBuilder::append(const StrRange &p_range) {
+	if (p_range.len <= 0) {
+		return *this;
+	}
 
-			current_position += s.length();
+	Segment segment;
+	segment.string = p_range.c_str;
+	segment.length = p_range.len;
+	segments.push_back(segment);
 
-			godot_string_elem++;
-		} else {
-			const char *s = c_strings[c_string_elem];
+	string_length += segment.length;
 
-			for (int32_t j = 0; j < appended_strings[i]; j++) {
-				buffer[current_position + j] = s[j];
-			}
+	return *this;
+}
 
-			current_position += appended_strings[i];
+String StringBuilder::as_string() const {
+	if (string_length == 0) {
+		return "";
+	}
 
-			c_string_elem++;
+	// Written in place, without an intermediate buffer.
+	String final_string;
+	final_string.resize(string_length + 1);
+	char32_t *buffer = final_string.ptrw();
+
+	for (const Segment &segment : segments) {
+		switch (segment.type) {
+			case Segment::TYPE_STRING: {
+				memcpy(buffer, segment.string, segment.length * sizeof(char32_t));
+			} break;
+			case Segment::TYPE_C_STRING: {
+				for (uint32_t j = 0; j < segment.length; j++) {
+					buffer[j] = segment.c_string[j];
+				}
+			} break;
+			case Segment::TYPE_CHAR: {
+				buffer[0] = segment.character;
+			} break;
 		}
+		buffer += segment.length;
 	}
-
-	String final_string = String(buffer, string_length);
-
-	memdelete_arr(buffer);
+	*buffer = 0;
 
 	return final_string;
 }
@@ -32,21 +32,37 @@
 #define STRING_BUILDER_H
 
 #include "core/string/ustring.h"
-#include "core/templates/vector.h"
+#include "core/templates/local_vector.h"
 
 class StringBuilder {
-	uint32_t string_length = 0;
+	// One piece of the final string, copied only once by as_string().
+	struct Segment {
+		enum Type : uint8_t {
+			TYPE_STRING, // Points into `strings`, or to caller-owned characters for StrRange.
+			TYPE_C_STRING,
+			TYPE_CHAR,
+		};
+
+		union {
+			const char32_t *string;
+			const char *c_string;
+			char32_t character;
+		};
+		uint32_t length = 0;
+		Type type = TYPE_STRING;
+	};
 
-	Vector<String> strings;
-	Vector<const char *> c_strings;
+	uint32_t string_length = 0;
 
-	// -1 means it's a Godot String
-	// a natural number means C string.
-	Vector<int32_t> appended_strings;
+	LocalVector<String> strings; // Keeps appended Strings alive.
+	LocalVector<Segment> segments;
 
 public:
 	StringBuilder &append(const String &p_string);
 	StringBuilder &append(const char *p_cstring);
+	StringBuilder &append(char32_t p_char);
+	// Zero-copy, the characters must stay alive and unmodified until as_string() is called.
+	StringBuilder &append(const StrRange &p_range);
 
 	_FORCE_INLINE_ StringBuilder &operator+(const String &p_string) {
 		return append(p_string);
@@ -56,6 +72,10 @@ public:
 		return append(p_cstring);
 	}
 
+	_FORCE_INLINE_ StringBuilder &operator+(const StrRange &p_range) {
+		return append(p_range);
+	}
+
 	_FORCE_INLINE_ void operator+=(const String &p_string) {
 		append(p_string);
 	}
@@ -64,14 +84,26 @@ public:
 		append(p_cstring);
 	}
 
+	_FORCE_INLINE_ void operator+=(char32_t p_char) {
+		append(p_char);
+	}
+
+	_FORCE_INLINE_ void operator+=(const StrRange &p_range) {
+		append(p_range);
+	}
+
 	_FORCE_INLINE_ int num_strings_appended() const {
-		return appended_strings.size();
+		return segments.size();
 	}
 
 	_FORCE_INLINE_ uint32_t get_string_length() const {
 		return string_length;
 	}
 
+	void reserve(uint32_t p_segments) {
+		segments.reserve(p_segments);
+	}
+
 	String as_string() const;
 
 	_FORCE_INLINE_ operator String() const {
@@ -32,6 +32,7 @@
 
 #include "core/os/os.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 
 StaticCString StaticCString::create(const char *p_ptr) {
 	StaticCString scs;
@@ -67,25 +68,267 @@ StringName _scs_create(const char *p_chr, bool p_static) {
 	return (p_chr[0] ? StringName(StaticCString::create(p_chr), p_static) : StringName());
 }
 
+// Lookups of existing names run without taking the mutex: the bucket chains are
+// walked with acquire loads and a reference is taken with SafeRefCount::ref(),
+// which fails for entries whose last reference is being released. Insertions,
+// removals and resizes are serialized by the mutex.
+//
+// Entries unlinked by unref() and bucket arrays replaced by a resize may still be
+// visited by concurrent lookups, so they are retired instead of freed. Readers
+// register in one of two per-slot counters picked by the parity of
+// `reader_epoch`; reclamation bumps the epoch and waits until the counters of
+// the previous parity drain before freeing what was retired until then.
+//
+// A resize relinks the existing entries into the new buckets, so lookups running
+// concurrently may miss entries that are present. `table_version` is odd while a
+// resize is in progress, and a lookup only trusts a miss if the version did not
+// change in the meantime. Hits are always valid.
+
+struct StringName::_Table {
+	std::atomic<_Data *> *buckets = nullptr;
+	uint32_t mask = 0;
+	uint32_t entry_count = 0;
+
+	static inline LocalVector<_Data *> retired_entries;
+	static inline LocalVector<_Table *> retired_tables;
+	static inline uint32_t resize_count = 0;
+
+	_FORCE_INLINE_ std::atomic<_Data *> &get_bucket(uint32_t p_hash) { return buckets[p_hash & mask]; }
+
+	_Table(uint32_t p_bits) {
+		mask = (1u << p_bits) - 1;
+		buckets = memnew_arr(std::atomic<_Data *>, mask + 1);
+		for (uint32_t i = 0; i <= mask; i++) {
+			buckets[i].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+	~_Table() {
+		memdelete_arr(buckets);
+	}
+};
+
+// Retired entries are reclaimed in batches, each one costs a wait for readers.
+static constexpr uint32_t STRING_NAME_RETIRE_BATCH = 256;
+static constexpr uint32_t STRING_NAME_READER_SLOTS = 64;
+
+struct alignas(64) StringNameReaderSlot {
+	std::atomic<uint32_t> active[2];
+};
+
+static StringNameReaderSlot string_name_reader_slots[STRING_NAME_READER_SLOTS];
+static std::atomic<uint32_t> string_name_reader_epoch = 0;
+static std::atomic<uint32_t> string_name_next_reader_slot = 0;
+static std::atomic<uint32_t> string_name_table_version = 0;
+static thread_local uint32_t string_name_reader_slot = UINT32_MAX;
+
+class StringNameReadSection {
+	std::atomic<uint32_t> *active = nullptr;
+
+public:
+	_FORCE_INLINE_ StringNameReadSection() {
+		if (unlikely(string_name_reader_slot == UINT32_MAX)) {
+			string_name_reader_slot = string_name_next_reader_slot.fetch_add(1, std::memory_order_relaxed) % STRING_NAME_READER_SLOTS;
+		}
+		StringNameReaderSlot &slot = string_name_reader_slots[string_name_reader_slot];
+		while (true) {
+			uint32_t epoch = string_name_reader_epoch.load(std::memory_order_seq_cst);
+			active = &slot.active[epoch & 1];
+			active->fetch_add(1, std::memory_order_seq_cst);
+			// If reclamation started in between, it may not have seen this reader.
+			if (likely(string_name_reader_epoch.load(std::memory_order_seq_cst) == epoch)) {
+				break;
+			}
+			active->fetch_sub(1, std::memory_order_release);
+		}
+	}
+
+	_FORCE_INLINE_ ~StringNameReadSection() {
+		active->fetch_sub(1, std::memory_order_release);
+	}
+};
+
+template <typename T>
+StringName::_Data *StringName::_find_lock_free(uint32_t p_hash, const T &p_name, bool &r_conclusive) {
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Counting references for the ranking requires the mutex.
+		r_conclusive = false;
+		return nullptr;
+	}
+#endif
+
+	StringNameReadSection read_section;
+
+	uint32_t version = string_name_table_version.load(std::memory_order_acquire);
+	if (unlikely(version & 1)) {
+		// Resizing, the chains may be incomplete.
+		r_conclusive = false;
+		return nullptr;
+	}
+
+	_Data *data = _table.load(std::memory_order_acquire)->get_bucket(p_hash).load(std::memory_order_acquire);
+	while (data) {
+		// Compare hash first. An entry that fails to reference is being released,
+		// a live duplicate may follow it.
+		if (data->hash == p_hash && data->operator==(p_name) && data->refcount.ref()) {
+			r_conclusive = true;
+			return data;
+		}
+		data = data->next.load(std::memory_order_acquire);
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	r_conclusive = string_name_table_version.load(std::memory_order_relaxed) == version;
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_lock_free(uint32_t p_hash, const T &p_name) {
+	// For callers that insert on a miss, they take the mutex either way.
+	bool conclusive = false;
+	return _find_lock_free(p_hash, p_name, conclusive);
+}
+
+template <typename T>
+StringName::_Data *StringName::_find_locked(uint32_t p_hash, const T &p_name) {
+	_Data *data = _table.load(std::memory_order_relaxed)->get_bucket(p_hash).load(std::memory_order_relaxed);
+	while (data) {
+		if (data->hash == p_hash && data->operator==(p_name) && data->refcount.ref()) {
+			return data;
+		}
+		data = data->next.load(std::memory_order_relaxed);
+	}
+	return nullptr;
+}
+
+void StringName::_insert_locked(_Data *p_data) {
+	_Table *table = _table.load(std::memory_order_relaxed);
+	std::atomic<_Data *> &bucket = table->get_bucket(p_data->hash);
+	_Data *head = bucket.load(std::memory_order_relaxed);
+
+	p_data->prev = nullptr;
+	p_data->next.store(head, std::memory_order_relaxed);
+	if (head) {
+		head->prev = p_data;
+	}
+	// Publishes the fully constructed entry to lock-free lookups.
+	bucket.store(p_data, std::memory_order_release);
+
+	table->entry_count++;
+	if (table->entry_count > table->mask + 1 && table->mask < (1u << STRING_TABLE_MAX_BITS) - 1) {
+		_resize_locked();
+	}
+}
+
+void StringName::_resize_locked() {
+	_Table *old_table = _table.load(std::memory_order_relaxed);
+	uint32_t bits = 0;
+	while ((1u << bits) <= old_table->mask) {
+		bits++;
+	}
+	_Table *new_table = memnew(_Table(bits + 1));
+	new_table->entry_count = old_table->entry_count;
+
+	uint32_t version = string_name_table_version.load(std::memory_order_relaxed);
+	string_name_table_version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// Entries move to the head of their new chain, so a lookup racing with the
+	// relinking can never loop: moved entries only ever point at moved entries.
+	for (uint32_t i = 0; i <= old_table->mask; i++) {
+		_Data *data = old_table->buckets[i].load(std::memory_order_relaxed);
+		while (data) {
+			_Data *next = data->next.load(std::memory_order_relaxed);
+			std::atomic<_Data *> &bucket = new_table->get_bucket(data->hash);
+			_Data *head = bucket.load(std::memory_order_relaxed);
+			data->prev = nullptr;
+			data->next.store(head, std::memory_order_release);
+			if (head) {
+				head->prev = data;
+			}
+			bucket.store(data, std::memory_order_release);
+			data = next;
+		}
+	}
+
+	_table.store(new_table, std::memory_order_release);
+	string_name_table_version.store(version + 2, std::memory_order_release);
+
+	_Table::resize_count++;
+	_Table::retired_tables.push_back(old_table);
+	_reclaim_locked();
+}
+
+void StringName::_reclaim_locked() {
+	if (_Table::retired_entries.is_empty() && _Table::retired_tables.is_empty()) {
+		return;
+	}
+
+	// New readers register with the new parity and can no longer reach anything
+	// retired so far. Wait for the ones that registered before.
+	uint32_t parity = string_name_reader_epoch.fetch_add(1, std::memory_order_seq_cst) & 1;
+	for (uint32_t i = 0; i < STRING_NAME_READER_SLOTS; i++) {
+		while (string_name_reader_slots[i].active[parity].load(std::memory_order_seq_cst) != 0) {
+			if (OS::get_singleton()) {
+				OS::get_singleton()->yield();
+			}
+		}
+	}
+
+	for (_Data *data : _Table::retired_entries) {
+		memdelete(data);
+	}
+	_Table::retired_entries.clear();
+	for (_Table *table : _Table::retired_tables) {
+		memdelete(table);
+	}
+	_Table::retired_tables.clear();
+}
+
+StringName::TableStats StringName::get_table_stats() {
+	TableStats stats;
+	ERR_FAIL_COND_V(!configured, stats);
+
+	MutexLock lock(mutex);
+
+	_Table *table = _table.load(std::memory_order_relaxed);
+	stats.entry_count = table->entry_count;
+	stats.bucket_count = table->mask + 1;
+	stats.resize_count = _Table::resize_count;
+	stats.retired_count = _Table::retired_entries.size();
+	for (uint32_t i = 0; i <= table->mask; i++) {
+		uint32_t chain = 0;
+		for (_Data *data = table->buckets[i].load(std::memory_order_relaxed); data; data = data->next.load(std::memory_order_relaxed)) {
+			chain++;
+		}
+		if (chain) {
+			stats.used_buckets++;
+			stats.longest_chain = MAX(stats.longest_chain, chain);
+		}
+	}
+
+	return stats;
+}
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		_table[i] = nullptr;
-	}
+	_table.store(memnew(_Table(STRING_TABLE_INITIAL_BITS)), std::memory_order_release);
 	configured = true;
 }
 
 void StringName::cleanup() {
 	MutexLock lock(mutex);
 
+	_Table *table = _table.load(std::memory_order_relaxed);
+
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
-		for (int i = 0; i < STRING_TABLE_LEN; i++) {
-			_Data *d = _table[i];
+		for (uint32_t i = 0; i <= table->mask; i++) {
+			_Data *d = table->buckets[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -105,12 +348,15 @@ void StringName::cleanup() {
 
 		print_line(vformat("\nOut of %d StringNames, %d StringNames were never referenced during this run (0 times) (%.2f%%).", data.size(), unreferenced_stringnames, unreferenced_stringnames / float(data.size()) * 100));
 		print_line(vformat("Out of %d StringNames, %d StringNames were rarely referenced during this run (1-4 times) (%.2f%%).", data.size(), rarely_referenced_stringnames, rarely_referenced_stringnames / float(data.size()) * 100));
+
+		TableStats stats = get_table_stats();
+		print_line(vformat("StringName table: %d entries in %d buckets (%d used, longest chain %d, %d resizes).", stats.entry_count, stats.bucket_count, stats.used_buckets, stats.longest_chain, stats.resize_count));
 	}
 #endif
 	int lost_strings = 0;
-	for (int i = 0; i < STRING_TABLE_LEN; i++) {
-		while (_table[i]) {
-			_Data *d = _table[i];
+	for (uint32_t i = 0; i <= table->mask; i++) {
+		_Data *d = table->buckets[i].load(std::memory_order_relaxed);
+		while (d) {
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -121,13 +367,18 @@ void StringName::cleanup() {
 				}
 			}
 
-			_table[i] = _table[i]->next;
+			_Data *next = d->next.load(std::memory_order_relaxed);
 			memdelete(d);
+			d = next;
 		}
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
+
+	_reclaim_locked();
+	_table.store(nullptr, std::memory_order_relaxed);
+	memdelete(table);
 	configured = false;
 }
 
@@ -144,19 +395,29 @@ void StringName::unref() {
 				ERR_PRINT("BUG: Unreferenced static string to 0: " + String(_data->name));
 			}
 		}
+		// The entry keeps its `next` pointer so that lookups currently on it can
+		// continue down the chain.
+		_Table *table = _table.load(std::memory_order_relaxed);
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_release);
 		} else {
-			if (_table[_data->idx] != _data) {
+			std::atomic<_Data *> &bucket = table->get_bucket(_data->hash);
+			if (bucket.load(std::memory_order_relaxed) != _data) {
 				ERR_PRINT("BUG!");
 			}
-			_table[_data->idx] = _data->next;
+			bucket.store(next, std::memory_order_release);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
+		}
+		table->entry_count--;
+
+		_Table::retired_entries.push_back(_data);
+		if (_Table::retired_entries.size() >= STRING_NAME_RETIRE_BATCH) {
+			_reclaim_locked();
 		}
-		memdelete(_data);
 	}
 
 	_data = nullptr;
@@ -275,56 +536,42 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_data = _find_lock_free(hash, p_name);
 
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	if (!_data) {
+		MutexLock lock(mutex);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
+		_data = _find_locked(hash, p_name);
+		if (!_data) {
+			_data = memnew(_Data);
+			_data->name = p_name;
+			_data->refcount.init();
+			_data->static_count.set(p_static ? 1 : 0);
+			_data->hash = hash;
+			_data->cname = nullptr;
+#ifdef DEBUG_ENABLED
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				_data->refcount.ref();
+				_data->static_count.increment();
+			}
+#endif
+			_insert_locked(_data);
+			return;
 		}
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
 			_data->debug_references++;
 		}
 #endif
-		return;
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
+	// exists
+	if (p_static) {
 		_data->static_count.increment();
 	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const StaticCString &p_static_string, bool p_static) {
@@ -334,55 +581,41 @@ StringName::StringName(const StaticCString &p_static_string, bool p_static) {
 
 	ERR_FAIL_COND(!p_static_string.ptr || !p_static_string.ptr[0]);
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_static_string.ptr);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
+	_data = _find_lock_free(hash, p_static_string.ptr);
 
-	_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_static_string.ptr)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	if (!_data) {
+		MutexLock lock(mutex);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
+		_data = _find_locked(hash, p_static_string.ptr);
+		if (!_data) {
+			_data = memnew(_Data);
+			_data->refcount.init();
+			_data->static_count.set(p_static ? 1 : 0);
+			_data->hash = hash;
+			_data->cname = p_static_string.ptr;
+#ifdef DEBUG_ENABLED
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				_data->refcount.ref();
+				_data->static_count.increment();
+			}
+#endif
+			_insert_locked(_data);
+			return;
 		}
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
 			_data->debug_references++;
 		}
 #endif
-		return;
 	}
 
-	_data = memnew(_Data);
-
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = p_static_string.ptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
+	// exists
+	if (p_static) {
 		_data->static_count.increment();
 	}
-#endif
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -394,54 +627,42 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
-	uint32_t idx = hash & STRING_TABLE_MASK;
 
-	_data = _table[idx];
+	_data = _find_lock_free(hash, p_name);
 
-	while (_data) {
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
-	}
+	if (!_data) {
+		MutexLock lock(mutex);
 
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
+		_data = _find_locked(hash, p_name);
+		if (!_data) {
+			_data = memnew(_Data);
+			_data->name = p_name;
+			_data->refcount.init();
+			_data->static_count.set(p_static ? 1 : 0);
+			_data->hash = hash;
+			_data->cname = nullptr;
+#ifdef DEBUG_ENABLED
+			if (unlikely(debug_stringname)) {
+				// Keep in memory, force static.
+				_data->refcount.ref();
+				_data->static_count.increment();
+			}
+#endif
+			_insert_locked(_data);
+			return;
 		}
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
 			_data->debug_references++;
 		}
 #endif
-		return;
 	}
 
-	_data = memnew(_Data);
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->idx = idx;
-	_data->cname = nullptr;
-	_data->next = _table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
+	// exists
+	if (p_static) {
 		_data->static_count.increment();
 	}
-#endif
-
-	if (_table[idx]) {
-		_table[idx]->prev = _data;
-	}
-	_table[idx] = _data;
 }
 
 StringName StringName::search(const char *p_name) {
@@ -452,28 +673,26 @@ StringName StringName::search(const char *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
 
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
+	bool conclusive = false;
+	_Data *_data = _find_lock_free(hash, p_name, conclusive);
+	if (_data) {
+		return StringName(_data);
 	}
+	if (conclusive) {
+		return StringName(); //does not exist
+	}
+
+	MutexLock lock(mutex);
 
-	if (_data && _data->refcount.ref()) {
+	_data = _find_locked(hash, p_name);
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
 			_data->debug_references++;
 		}
 #endif
-
 		return StringName(_data);
 	}
 
@@ -488,23 +707,21 @@ StringName StringName::search(const char32_t *p_name) {
 		return StringName();
 	}
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = String::hash(p_name);
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
+	bool conclusive = false;
+	_Data *_data = _find_lock_free(hash, p_name, conclusive);
+	if (_data) {
+		return StringName(_data);
+	}
+	if (conclusive) {
+		return StringName(); //does not exist
 	}
 
-	if (_data && _data->refcount.ref()) {
+	MutexLock lock(mutex);
+
+	_data = _find_locked(hash, p_name);
+	if (_data) {
 		return StringName(_data);
 	}
 
@@ -514,23 +731,21 @@ StringName StringName::search(const char32_t *p_name) {
 StringName StringName::search(const String &p_name) {
 	ERR_FAIL_COND_V(p_name.is_empty(), StringName());
 
-	MutexLock lock(mutex);
-
 	uint32_t hash = p_name.hash();
 
-	uint32_t idx = hash & STRING_TABLE_MASK;
-
-	_Data *_data = _table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->operator==(p_name)) {
-			break;
-		}
-		_data = _data->next;
+	bool conclusive = false;
+	_Data *_data = _find_lock_free(hash, p_name, conclusive);
+	if (_data) {
+		return StringName(_data);
 	}
+	if (conclusive) {
+		return StringName(); //does not exist
+	}
+
+	MutexLock lock(mutex);
 
-	if (_data && _data->refcount.ref()) {
+	_data = _find_locked(hash, p_name);
+	if (_data) {
 #ifdef DEBUG_ENABLED
 		if (unlikely(debug_stringname)) {
 			_data->debug_references++;
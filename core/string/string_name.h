@@ -46,9 +46,8 @@ struct StaticCString {
 
 class StringName {
 	enum {
-		STRING_TABLE_BITS = 16,
-		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_INITIAL_BITS = 14,
+		STRING_TABLE_MAX_BITS = 24,
 	};
 
 	struct _Data {
@@ -65,14 +64,26 @@ class StringName {
 		bool operator==(const char *p_name) const;
 		bool operator!=(const char *p_name) const;
 
-		int idx = 0;
 		uint32_t hash = 0;
-		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		_Data *prev = nullptr; // Only accessed with the mutex held.
+		std::atomic<_Data *> next = nullptr; // Also walked by lock-free lookups.
 		_Data() {}
 	};
 
-	static inline _Data *_table[STRING_TABLE_LEN];
+	// Defined in string_name.cpp. Lookups read the current table without
+	// locking, all modifications happen with the mutex held.
+	struct _Table;
+	static inline std::atomic<_Table *> _table = nullptr;
+
+	template <typename T>
+	static _Data *_find_lock_free(uint32_t p_hash, const T &p_name, bool &r_conclusive);
+	template <typename T>
+	static _Data *_find_lock_free(uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *_find_locked(uint32_t p_hash, const T &p_name);
+	static void _insert_locked(_Data *p_data);
+	static void _resize_locked();
+	static void _reclaim_locked();
 
 	_Data *_data = nullptr;
 
@@ -160,6 +171,17 @@ public:
 		return String();
 	}
 
+	struct TableStats {
+		uint32_t entry_count = 0;
+		uint32_t bucket_count = 0;
+		uint32_t used_buckets = 0;
+		uint32_t longest_chain = 0;
+		uint32_t resize_count = 0;
+		uint32_t retired_count = 0; // Released entries waiting for concurrent readers to leave.
+	};
+
+	static TableStats get_table_stats();
+
 	static StringName search(const char *p_name);
 	static StringName search(const char32_t *p_name);
 	static StringName search(const String &p_name);
@@ -499,8 +499,19 @@ void String::operator=(const wchar_t *p_str) {
 }
 
 String String::operator+(const String &p_str) const {
-	String res = *this;
-	res += p_str;
+	const int lhs_len = length();
+	const int rhs_len = p_str.length();
+	if (lhs_len == 0 || rhs_len == 0) {
+		return lhs_len == 0 ? p_str : *this;
+	}
+
+	// Build the result in a single allocation instead of copying `*this` first.
+	String res;
+	res.resize(lhs_len + rhs_len + 1);
+	char32_t *dst = res.ptrw();
+	memcpy(dst, ptr(), lhs_len * sizeof(char32_t));
+	memcpy(dst + lhs_len, p_str.ptr(), rhs_len * sizeof(char32_t));
+	dst[lhs_len + rhs_len] = _null;
 	return res;
 }
 
@@ -556,6 +567,26 @@ String &String::operator+=(const String &p_str) {
 	return *this;
 }
 
+String &String::operator+=(const StrRange &p_str_range) {
+	const int rhs_len = p_str_range.len;
+	if (rhs_len <= 0) {
+		return *this;
+	}
+
+	const int lhs_len = length();
+	if (unlikely(p_str_range.c_str >= ptr() && p_str_range.c_str < ptr() + lhs_len)) {
+		// The range points into this string, which may be reallocated below.
+		return operator+=(String(p_str_range));
+	}
+
+	resize(lhs_len + rhs_len + 1);
+	char32_t *dst = ptrw() + lhs_len;
+	memcpy(dst, p_str_range.c_str, rhs_len * sizeof(char32_t));
+	dst[rhs_len] = _null;
+
+	return *this;
+}
+
 String &String::operator+=(const char *p_str) {
 	if (!p_str || p_str[0] == 0) {
 		return *this;
@@ -718,6 +749,36 @@ bool String::operator==(const String &p_str) const {
 	return true;
 }
 
+StrRange StrRange::substr(int p_from, int p_chars) const {
+	if (p_chars == -1) {
+		p_chars = len - p_from;
+	}
+
+	if (p_from < 0 || p_from >= len || p_chars <= 0) {
+		return StrRange(c_str, 0);
+	}
+
+	if ((p_from + p_chars) > len) {
+		p_chars = len - p_from;
+	}
+
+	return StrRange(c_str + p_from, p_chars);
+}
+
+uint32_t StrRange::hash() const {
+	return String::hash(c_str, len);
+}
+
+bool StrRange::operator==(const StrRange &p_str_range) const {
+	if (len != p_str_range.len) {
+		return false;
+	}
+	if (len == 0 || c_str == p_str_range.c_str) {
+		return true;
+	}
+	return memcmp(c_str, p_str_range.c_str, len * sizeof(char32_t)) == 0;
+}
+
 bool String::operator==(const StrRange &p_str_range) const {
 	int len = p_str_range.len;
 
@@ -1464,6 +1525,49 @@ Vector<String> String::split(const char *p_splitter, bool p_allow_empty, int p_m
 	return ret;
 }
 
+Vector<StrRange> String::split_ranges(const String &p_splitter, bool p_allow_empty, int p_maxsplit) const {
+	Vector<StrRange> ret;
+	const char32_t *src = get_data();
+
+	if (is_empty()) {
+		if (p_allow_empty) {
+			ret.push_back(StrRange(src, 0));
+		}
+		return ret;
+	}
+
+	int from = 0;
+	int len = length();
+
+	while (true) {
+		int end;
+		if (p_splitter.is_empty()) {
+			end = from + 1;
+		} else {
+			end = find(p_splitter, from);
+			if (end < 0) {
+				end = len;
+			}
+		}
+		if (p_allow_empty || (end > from)) {
+			if (p_maxsplit > 0 && p_maxsplit == ret.size()) {
+				// Put rest of the string and leave cycle.
+				ret.push_back(StrRange(src + from, len - from));
+				break;
+			}
+			ret.push_back(StrRange(src + from, end - from));
+		}
+
+		if (end == len) {
+			break;
+		}
+
+		from = end + p_splitter.length();
+	}
+
+	return ret;
+}
+
 Vector<String> String::rsplit(const String &p_splitter, bool p_allow_empty, int p_maxsplit) const {
 	Vector<String> ret;
 	const int len = length();
@@ -2953,8 +3057,8 @@ done:
 #define READING_EXP 3
 #define READING_DONE 4
 
-double String::to_float(const char *p_str) {
-	return built_in_strtod<char>(p_str);
+double String::to_float(const char *p_str, const char **r_end) {
+	return built_in_strtod<char>(p_str, (char **)r_end);
 }
 
 double String::to_float(const char32_t *p_str, const char32_t **r_end) {
@@ -3278,6 +3382,10 @@ String String::substr(int p_from, int p_chars) const {
 	return s;
 }
 
+StrRange String::substr_range(int p_from, int p_chars) const {
+	return StrRange(get_data(), length()).substr(p_from, p_chars);
+}
+
 int String::find(const String &p_str, int p_from) const {
 	if (p_from < 0) {
 		return -1;
@@ -5407,7 +5515,18 @@ String String::path_join(const String &p_file) const {
 	if (operator[](length() - 1) == '/' || (p_file.size() > 0 && p_file.operator[](0) == '/')) {
 		return *this + p_file;
 	}
-	return *this + "/" + p_file;
+
+	// Single allocation, `*this + "/" + p_file` would create a temporary.
+	const int lhs_len = length();
+	const int rhs_len = p_file.length();
+	String joined;
+	joined.resize(lhs_len + 1 + rhs_len + 1);
+	char32_t *dst = joined.ptrw();
+	memcpy(dst, ptr(), lhs_len * sizeof(char32_t));
+	dst[lhs_len] = '/';
+	memcpy(dst + lhs_len + 1, p_file.ptr(), rhs_len * sizeof(char32_t));
+	dst[lhs_len + 1 + rhs_len] = _null;
+	return joined;
 }
 
 String String::property_name_encode() const {
@@ -170,10 +170,25 @@ protected:
 /*  String                                                               */
 /*************************************************************************/
 
+// Non-owning view of a run of characters, usually part of a String. It is only
+// valid as long as the characters it points to are alive and unmodified.
 struct StrRange {
 	const char32_t *c_str;
 	int len;
 
+	_FORCE_INLINE_ int length() const { return len; }
+	_FORCE_INLINE_ bool is_empty() const { return len == 0; }
+	_FORCE_INLINE_ const char32_t &operator[](int p_index) const {
+		CRASH_BAD_INDEX(p_index, len);
+		return c_str[p_index];
+	}
+
+	StrRange substr(int p_from, int p_chars = -1) const;
+	uint32_t hash() const; // Same as the hash of an equal String.
+
+	bool operator==(const StrRange &p_str_range) const;
+	_FORCE_INLINE_ bool operator!=(const StrRange &p_str_range) const { return !operator==(p_str_range); }
+
 	StrRange(const char32_t *p_c_str = nullptr, int p_len = 0) {
 		c_str = p_c_str;
 		len = p_len;
@@ -237,6 +252,7 @@ public:
 	String &operator+=(const char *p_str);
 	String &operator+=(const wchar_t *p_str);
 	String &operator+=(const char32_t *p_str);
+	String &operator+=(const StrRange &p_str_range);
 
 	/* Compatibility Operators */
 
@@ -285,6 +301,7 @@ public:
 
 	/* complex helpers */
 	String substr(int p_from, int p_chars = -1) const;
+	StrRange substr_range(int p_from, int p_chars = -1) const;
 	int find(const String &p_str, int p_from = 0) const; ///< return <0 if failed
 	int find(const char *p_str, int p_from = 0) const; ///< return <0 if failed
 	int find_char(const char32_t &p_char, int p_from = 0) const; ///< return <0 if failed
@@ -350,7 +367,7 @@ public:
 	static int64_t to_int(const wchar_t *p_str, int p_len = -1);
 	static int64_t to_int(const char32_t *p_str, int p_len = -1, bool p_clamp = false);
 
-	static double to_float(const char *p_str);
+	static double to_float(const char *p_str, const char **r_end = nullptr);
 	static double to_float(const wchar_t *p_str, const wchar_t **r_end = nullptr);
 	static double to_float(const char32_t *p_str, const char32_t **r_end = nullptr);
 	static uint32_t num_characters(int64_t p_int);
@@ -369,6 +386,7 @@ public:
 
 	Vector<String> split(const String &p_splitter = "", bool p_allow_empty = true, int p_maxsplit = 0) const;
 	Vector<String> split(const char *p_splitter = "", bool p_allow_empty = true, int p_maxsplit = 0) const;
+	Vector<StrRange> split_ranges(const String &p_splitter = "", bool p_allow_empty = true, int p_maxsplit = 0) const;
 	Vector<String> rsplit(const String &p_splitter = "", bool p_allow_empty = true, int p_maxsplit = 0) const;
 	Vector<String> rsplit(const char *p_splitter = "", bool p_allow_empty = true, int p_maxsplit = 0) const;
 	Vector<String> split_spaces() const;
@@ -39,3 +39,212 @@ CommandQueueMT::CommandQueueMT() {
 
 CommandQueueMT::~CommandQueueMT() {
 }
+
+Semaphore &CommandQueueMPSC::_get_sync_semaphore() {
+	// A thread can only wait for one sync command at a time.
+	static thread_local Semaphore semaphore;
+	return semaphore;
+}
+
+uint8_t *CommandQueueMPSC::_alloc_chunk() {
+	{
+		MutexLock lock(chunk_pool_mutex);
+		if (chunk_pool.size()) {
+			uint8_t *chunk = chunk_pool[chunk_pool.size() - 1];
+			chunk_pool.resize(chunk_pool.size() - 1);
+			return chunk;
+		}
+	}
+	uint8_t *chunk = reinterpret_cast<uint8_t *>(Memory::alloc_static(CHUNK_SIZE));
+	memset(chunk, 0, CHUNK_SIZE);
+	return chunk;
+}
+
+void CommandQueueMPSC::_free_chunk(uint8_t *p_chunk) {
+	// Headers must read as unpublished the next time the chunk is used.
+	memset(p_chunk, 0, CHUNK_SIZE);
+	MutexLock lock(chunk_pool_mutex);
+	chunk_pool.push_back(p_chunk);
+}
+
+void CommandQueueMPSC::_notify_consumer() {
+	const WorkerThreadPool::TaskID task_id = pump_task_id.load(std::memory_order_acquire);
+	if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+	}
+}
+
+uint8_t *CommandQueueMPSC::_reserve_slow(uint32_t p_chunk, uint32_t p_offset, uint32_t p_size) {
+	while (true) {
+		if (p_offset <= CHUNK_SIZE) {
+			// This is the first reservation that didn't fit, so it's up to this thread to close the chunk.
+			if (p_offset + HEADER_SIZE <= CHUNK_SIZE) {
+				uint8_t *chunk = chunks[p_chunk & CHUNK_MASK].load(std::memory_order_acquire);
+				_get_header(chunk + p_offset)->store(HEADER_CHUNK_END, std::memory_order_release);
+			}
+
+			const uint32_t next_slot = (p_chunk + 1) & CHUNK_MASK;
+			if (chunks[next_slot].load(std::memory_order_acquire) != nullptr) {
+				// The consumer is a whole ring behind. Waiting for it could last forever if nothing flushes
+				// until this thread is done, so leave the cursor on the closed chunk and spill over.
+				MutexLock lock(spill_mutex);
+				spilling.store(true, std::memory_order_release);
+				return _reserve_spill(p_size);
+			}
+			chunks[next_slot].store(_alloc_chunk(), std::memory_order_release);
+
+			uint64_t expected = write_cursor.load(std::memory_order_relaxed);
+			while (!write_cursor.compare_exchange_weak(expected, uint64_t(p_chunk + 1) << 32, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+			}
+		} else {
+			// Another thread is closing the chunk.
+			while (uint32_t(write_cursor.load(std::memory_order_acquire) >> 32) == p_chunk) {
+				if (spilling.load(std::memory_order_acquire)) {
+					MutexLock lock(spill_mutex);
+					if (spilling.load(std::memory_order_relaxed)) {
+						return _reserve_spill(p_size);
+					}
+				}
+				OS::get_singleton()->yield();
+			}
+		}
+
+		const uint64_t cursor = write_cursor.fetch_add(p_size, std::memory_order_acq_rel);
+		p_chunk = cursor >> 32;
+		p_offset = (uint32_t)cursor;
+		if (likely(p_offset + p_size <= CHUNK_SIZE)) {
+			return chunks[p_chunk & CHUNK_MASK].load(std::memory_order_acquire) + p_offset;
+		}
+	}
+}
+
+uint8_t *CommandQueueMPSC::_reserve_spill(uint32_t p_size) {
+	// Called with spill_mutex locked, so reservation order is the order of the lock.
+	if (spill_chunks.is_empty() || spill_offset + p_size > CHUNK_SIZE) {
+		if (!spill_chunks.is_empty() && spill_offset + HEADER_SIZE <= CHUNK_SIZE) {
+			_get_header(spill_chunks[spill_chunks.size() - 1] + spill_offset)->store(HEADER_CHUNK_END, std::memory_order_release);
+		}
+		spill_chunks.push_back(_alloc_chunk());
+		spill_offset = 0;
+	}
+	uint8_t *entry = spill_chunks[spill_chunks.size() - 1] + spill_offset;
+	spill_offset += p_size;
+	return entry;
+}
+
+void CommandQueueMPSC::_run_command(uint8_t *p_entry, MutexLock<BinaryMutex> &p_lock) {
+	CommandBase *cmd = reinterpret_cast<CommandBase *>(p_entry + HEADER_SIZE);
+	uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(p_lock);
+	cmd->call();
+	WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
+
+	Semaphore *done = cmd->sync ? static_cast<SyncCommand *>(cmd)->done : nullptr;
+	cmd->~CommandBase();
+	if (done) {
+		done->post();
+	}
+}
+
+bool CommandQueueMPSC::_flush_spill(MutexLock<BinaryMutex> &p_lock) {
+	while (true) {
+		uint8_t *chunk;
+		{
+			MutexLock lock(spill_mutex);
+			if (spill_chunks.is_empty() || (spill_read_chunk + 1 == spill_chunks.size() && spill_read_offset == spill_offset)) {
+				// Everything that spilled over ran, producers can go back to the ring.
+				for (uint8_t *E : spill_chunks) {
+					_free_chunk(E);
+				}
+				spill_chunks.clear();
+				spill_offset = 0;
+				spill_read_chunk = 0;
+				spill_read_offset = 0;
+
+				chunks[(read_chunk + 1) & CHUNK_MASK].store(_alloc_chunk(), std::memory_order_release);
+				uint64_t expected = write_cursor.load(std::memory_order_relaxed);
+				while (!write_cursor.compare_exchange_weak(expected, uint64_t(read_chunk + 1) << 32, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+				}
+				spilling.store(false, std::memory_order_release);
+				return true;
+			}
+			chunk = spill_chunks[spill_read_chunk];
+		}
+
+		if (spill_read_offset + HEADER_SIZE <= CHUNK_SIZE) {
+			const uint32_t header = _get_header(chunk + spill_read_offset)->load(std::memory_order_acquire);
+			if (header == 0) {
+				return false; // Not published yet.
+			}
+			if (header != HEADER_CHUNK_END) {
+				_run_command(chunk + spill_read_offset, p_lock);
+				spill_read_offset += header;
+				continue;
+			}
+		}
+		// Producers only close a spill chunk when they add the next one.
+		spill_read_chunk++;
+		spill_read_offset = 0;
+	}
+}
+
+void CommandQueueMPSC::_flush() {
+	if (unlikely(flushing)) {
+		// Re-entrant call.
+		return;
+	}
+
+	MutexLock lock(flush_mutex);
+	flushing = true;
+
+	// Reset before reading, so pushes that this flush may miss notify again.
+	consumer_notified.exchange(false, std::memory_order_acq_rel);
+
+	while (true) {
+		uint8_t *chunk = chunks[read_chunk & CHUNK_MASK].load(std::memory_order_acquire);
+
+		if (read_offset + HEADER_SIZE <= CHUNK_SIZE) {
+			const uint32_t header = _get_header(chunk + read_offset)->load(std::memory_order_acquire);
+			if (header == 0) {
+				break; // Not published yet, the rest will be flushed next time.
+			}
+			if (header != HEADER_CHUNK_END) {
+				_run_command(chunk + read_offset, lock);
+				read_offset += header;
+				continue;
+			}
+		}
+
+		// End of this chunk, move to the next one if producers already did.
+		// If they spilled over instead, what they pushed since comes first.
+		if (uint32_t(write_cursor.load(std::memory_order_acquire) >> 32) == read_chunk) {
+			if (!spilling.load(std::memory_order_acquire) || !_flush_spill(lock)) {
+				break;
+			}
+		}
+		chunks[read_chunk & CHUNK_MASK].store(nullptr, std::memory_order_release);
+		_free_chunk(chunk);
+		read_chunk++;
+		read_offset = 0;
+	}
+
+	flushing = false;
+}
+
+CommandQueueMPSC::CommandQueueMPSC() {
+	chunks[0].store(_alloc_chunk());
+}
+
+CommandQueueMPSC::~CommandQueueMPSC() {
+	for (uint32_t i = 0; i < MAX_CHUNKS; i++) {
+		uint8_t *chunk = chunks[i].load();
+		if (chunk) {
+			Memory::free_static(chunk);
+		}
+	}
+	for (uint8_t *chunk : spill_chunks) {
+		Memory::free_static(chunk);
+	}
+	for (uint8_t *chunk : chunk_pool) {
+		Memory::free_static(chunk);
+	}
+}
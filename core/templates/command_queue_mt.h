@@ -35,11 +35,14 @@
 #include "core/os/condition_variable.h"
 #include "core/os/memory.h"
 #include "core/os/mutex.h"
+#include "core/os/semaphore.h"
 #include "core/string/print_string.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/typedefs.h"
 
+#include <atomic>
+
 #define COMMA(N) _COMMA_##N
 #define _COMMA_0
 #define _COMMA_1 ,
@@ -449,6 +452,217 @@ public:
 	~CommandQueueMT();
 };
 
+#define DECL_MPSC_PUSH(N)                                                        \
+	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)> \
+	void push(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		CMD_TYPE(N) *cmd = _allocate<CMD_TYPE(N)>();                         \
+		cmd->instance = p_instance;                                          \
+		cmd->method = p_method;                                              \
+		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                 \
+		_commit(cmd);                                                        \
+	}
+
+#define DECL_MPSC_PUSH_AND_RET(N)                                                              \
+	template <typename T, typename M, COMMA_SEP_LIST(TYPE_PARAM, N) COMMA(N) typename R>       \
+	void push_and_ret(T *p_instance, M p_method, COMMA_SEP_LIST(PARAM, N) COMMA(N) R *r_ret) { \
+		CMD_RET_TYPE(N) *cmd = _allocate<CMD_RET_TYPE(N)>();                                   \
+		cmd->instance = p_instance;                                                            \
+		cmd->method = p_method;                                                                \
+		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                                   \
+		cmd->ret = r_ret;                                                                      \
+		Semaphore &done = _get_sync_semaphore();                                               \
+		cmd->done = &done;                                                                     \
+		_commit(cmd);                                                                          \
+		done.wait();                                                                           \
+	}
+
+#define DECL_MPSC_PUSH_AND_SYNC(N)                                                    \
+	template <typename T, typename M COMMA(N) COMMA_SEP_LIST(TYPE_PARAM, N)>          \
+	void push_and_sync(T *p_instance, M p_method COMMA(N) COMMA_SEP_LIST(PARAM, N)) { \
+		CMD_SYNC_TYPE(N) *cmd = _allocate<CMD_SYNC_TYPE(N)>();                        \
+		cmd->instance = p_instance;                                                   \
+		cmd->method = p_method;                                                       \
+		SEMIC_SEP_LIST(CMD_ASSIGN_PARAM, N);                                          \
+		Semaphore &done = _get_sync_semaphore();                                      \
+		cmd->done = &done;                                                            \
+		_commit(cmd);                                                                 \
+		done.wait();                                                                  \
+	}
+
+// Drop-in alternative to CommandQueueMT where pushing doesn't take any lock.
+//
+// Commands are written into a ring of fixed size chunks. Producers reserve
+// space with a single atomic add on a (chunk, offset) cursor, construct the
+// command in place and then publish it by setting its header. The first
+// producer whose reservation goes past the end of a chunk closes it and moves
+// the cursor to the next one. The consumer executes commands in reservation
+// order and stops at the first one that is not published yet, so ordering
+// between threads is preserved the same way as with a mutex.
+//
+// The pump task is only notified for the first push after each flush instead
+// of on every push, which is what makes batches of thousands of commands per
+// frame cheap. Sync commands wait on a per-thread semaphore instead of a
+// condition variable shared by all the waiters.
+//
+// Flushing (consuming) is still serialized with a mutex, and must happen from
+// one thread at a time, like CommandQueueMT. If producers get a full ring of
+// chunks ahead of the consumer, they spill over into a list of chunks guarded
+// by a mutex rather than waiting for it, since the consumer may be waiting on
+// them or only flush once per frame. The consumer moves the ring on once it
+// went through all of that.
+class CommandQueueMPSC {
+	struct CommandBase {
+		bool sync = false;
+		virtual void call() = 0;
+		virtual ~CommandBase() = default;
+	};
+
+	struct SyncCommand : public CommandBase {
+		Semaphore *done = nullptr;
+		virtual void call() override {}
+		SyncCommand() {
+			sync = true;
+		}
+	};
+
+	DECL_CMD(0)
+	SPACE_SEP_LIST(DECL_CMD, 15)
+
+	// Commands that return.
+	DECL_CMD_RET(0)
+	SPACE_SEP_LIST(DECL_CMD_RET, 15)
+
+	/* commands that don't return but sync */
+	DECL_CMD_SYNC(0)
+	SPACE_SEP_LIST(DECL_CMD_SYNC, 15)
+
+	/***** BASE *******/
+
+	static constexpr uint32_t CHUNK_SIZE = 64 * 1024;
+	static constexpr uint32_t MAX_CHUNKS = 256; // Must be a power of two.
+	static constexpr uint32_t CHUNK_MASK = MAX_CHUNKS - 1;
+	static constexpr uint32_t HEADER_SIZE = 8;
+	// Header value that marks the end of the used part of a chunk.
+	static constexpr uint32_t HEADER_CHUNK_END = UINT32_MAX;
+
+	// Upper 32 bits are the chunk index, lower 32 bits the offset in that chunk.
+	std::atomic<uint64_t> write_cursor = 0;
+	uint8_t padding[64 - sizeof(std::atomic<uint64_t>)];
+	std::atomic<uint8_t *> chunks[MAX_CHUNKS] = {};
+	std::atomic<bool> consumer_notified = false;
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	// Consumer side.
+	BinaryMutex flush_mutex;
+	uint32_t read_chunk = 0;
+	uint32_t read_offset = 0;
+	bool flushing = false;
+
+	BinaryMutex chunk_pool_mutex;
+	LocalVector<uint8_t *> chunk_pool;
+
+	// Commands pushed while the ring is full.
+	std::atomic<bool> spilling = false;
+	BinaryMutex spill_mutex;
+	LocalVector<uint8_t *> spill_chunks;
+	uint32_t spill_offset = 0;
+	uint32_t spill_read_chunk = 0; // Consumer side.
+	uint32_t spill_read_offset = 0;
+
+	static _FORCE_INLINE_ std::atomic<uint32_t> *_get_header(uint8_t *p_entry) {
+		return reinterpret_cast<std::atomic<uint32_t> *>(p_entry);
+	}
+
+	static Semaphore &_get_sync_semaphore();
+
+	uint8_t *_alloc_chunk();
+	void _free_chunk(uint8_t *p_chunk);
+	uint8_t *_reserve_slow(uint32_t p_chunk, uint32_t p_offset, uint32_t p_size);
+	uint8_t *_reserve_spill(uint32_t p_size);
+	void _notify_consumer();
+
+	template <typename T>
+	static constexpr uint32_t _get_entry_size() {
+		return HEADER_SIZE + ((sizeof(T) + 8 - 1) & ~(8 - 1));
+	}
+
+	template <typename T>
+	T *_allocate() {
+		static_assert(_get_entry_size<T>() <= CHUNK_SIZE / 4, "Command is too big for CommandQueueMPSC.");
+		constexpr uint32_t size = _get_entry_size<T>();
+
+		const uint64_t cursor = write_cursor.fetch_add(size, std::memory_order_acq_rel);
+		const uint32_t chunk = cursor >> 32;
+		const uint32_t offset = (uint32_t)cursor;
+		uint8_t *entry;
+		if (likely(offset + size <= CHUNK_SIZE)) {
+			entry = chunks[chunk & CHUNK_MASK].load(std::memory_order_acquire) + offset;
+		} else {
+			entry = _reserve_slow(chunk, offset, size);
+		}
+		return memnew_placement(entry + HEADER_SIZE, T);
+	}
+
+	template <typename T>
+	_FORCE_INLINE_ void _commit(T *p_cmd) {
+		uint8_t *entry = reinterpret_cast<uint8_t *>(p_cmd) - HEADER_SIZE;
+		_get_header(entry)->store(_get_entry_size<T>(), std::memory_order_release);
+		if (!consumer_notified.exchange(true, std::memory_order_acq_rel)) {
+			_notify_consumer();
+		}
+	}
+
+	void _run_command(uint8_t *p_entry, MutexLock<BinaryMutex> &p_lock);
+	bool _flush_spill(MutexLock<BinaryMutex> &p_lock);
+	void _flush();
+
+	void _no_op() {}
+
+public:
+	/* NORMAL PUSH COMMANDS */
+	DECL_MPSC_PUSH(0)
+	SPACE_SEP_LIST(DECL_MPSC_PUSH, 15)
+
+	/* PUSH AND RET COMMANDS */
+	DECL_MPSC_PUSH_AND_RET(0)
+	SPACE_SEP_LIST(DECL_MPSC_PUSH_AND_RET, 15)
+
+	/* PUSH AND RET SYNC COMMANDS*/
+	DECL_MPSC_PUSH_AND_SYNC(0)
+	SPACE_SEP_LIST(DECL_MPSC_PUSH_AND_SYNC, 15)
+
+	_FORCE_INLINE_ void flush_if_pending() {
+		if (unlikely(write_cursor.load(std::memory_order_acquire) != ((uint64_t(read_chunk) << 32) | read_offset))) {
+			_flush();
+		}
+	}
+
+	void flush_all() {
+		_flush();
+	}
+
+	void sync() {
+		push_and_sync(this, &CommandQueueMPSC::_no_op);
+	}
+
+	void wait_and_flush() {
+		ERR_FAIL_COND(pump_task_id.load() == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id.load());
+		_flush();
+	}
+
+	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
+		pump_task_id.store(p_task_id);
+	}
+
+	CommandQueueMPSC();
+	~CommandQueueMPSC();
+};
+
+#undef DECL_MPSC_PUSH
+#undef DECL_MPSC_PUSH_AND_RET
+#undef DECL_MPSC_PUSH_AND_SYNC
+
 #undef ARG
 #undef PARAM
 #undef TYPE_PARAM
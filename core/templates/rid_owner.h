@@ -361,6 +361,423 @@ public:
 	}
 };
 
+// Like RID_Alloc, but each element is split into a hot part, which is meant to be
+// swept every frame (e.g. transforms, bounds, flags), and a cold part with
+// everything else. Both are stored in parallel chunk arrays indexed by the
+// same slot, and validators live in their own array, so iterating over the hot
+// parts with for_each() only touches the memory it needs.
+//
+// Iteration uses an occupancy bitmask per chunk to skip free slots, and visits
+// elements in slot order, which is also memory order.
+template <typename THot, typename TCold, bool THREAD_SAFE = false>
+class RID_HotColdAlloc : public RID_AllocBase {
+	static constexpr uint32_t INVALID_VALIDATOR = 0xFFFFFFFF;
+	static constexpr uint32_t UNINITIALIZED_BIT = 0x80000000;
+
+	THot **hot_chunks = nullptr;
+	TCold **cold_chunks = nullptr;
+	uint32_t **validator_chunks = nullptr;
+	uint64_t **occupancy_chunks = nullptr; // One bit per initialized element.
+	uint32_t **free_list_chunks = nullptr;
+
+	uint32_t elements_in_chunk; // Always a multiple of 64.
+	uint32_t max_alloc = 0;
+	uint32_t alloc_count = 0;
+	uint32_t chunk_limit = 0;
+
+	const char *description = nullptr;
+
+	mutable Mutex mutex;
+
+	// Occupancy words are shared by 64 slots, so with THREAD_SAFE this must be
+	// called with the mutex held.
+	_FORCE_INLINE_ void _set_occupied(uint32_t p_idx, bool p_occupied) {
+		const uint32_t idx_element = p_idx % elements_in_chunk;
+		uint64_t &word = occupancy_chunks[p_idx / elements_in_chunk][idx_element / 64];
+		if (p_occupied) {
+			word |= uint64_t(1) << (idx_element % 64);
+		} else {
+			word &= ~(uint64_t(1) << (idx_element % 64));
+		}
+	}
+
+	// Called once the element is constructed, so for_each() never sees it half-built.
+	_FORCE_INLINE_ void _mark_initialized(uint32_t p_idx) {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+		_set_occupied(p_idx, true);
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+
+		if (alloc_count == max_alloc) {
+			//allocate a new chunk
+			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
+			if (THREAD_SAFE && chunk_count == chunk_limit) {
+				mutex.unlock();
+				if (description != nullptr) {
+					ERR_FAIL_V_MSG(RID(), vformat("Element limit for RID of type '%s' reached.", String(description)));
+				} else {
+					ERR_FAIL_V_MSG(RID(), "Element limit reached.");
+				}
+			}
+
+			//grow chunks
+			if constexpr (!THREAD_SAFE) {
+				hot_chunks = (THot **)memrealloc(hot_chunks, sizeof(THot *) * (chunk_count + 1));
+				cold_chunks = (TCold **)memrealloc(cold_chunks, sizeof(TCold *) * (chunk_count + 1));
+				validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
+				occupancy_chunks = (uint64_t **)memrealloc(occupancy_chunks, sizeof(uint64_t *) * (chunk_count + 1));
+				free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
+			}
+			hot_chunks[chunk_count] = (THot *)memalloc(sizeof(THot) * elements_in_chunk); //but don't initialize
+			cold_chunks[chunk_count] = (TCold *)memalloc(sizeof(TCold) * elements_in_chunk);
+			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+			occupancy_chunks[chunk_count] = (uint64_t *)memalloc(sizeof(uint64_t) * (elements_in_chunk / 64));
+			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
+
+			//initialize
+			for (uint32_t i = 0; i < elements_in_chunk; i++) {
+				validator_chunks[chunk_count][i] = INVALID_VALIDATOR;
+				free_list_chunks[chunk_count][i] = alloc_count + i;
+			}
+			for (uint32_t i = 0; i < elements_in_chunk / 64; i++) {
+				occupancy_chunks[chunk_count][i] = 0;
+			}
+
+			max_alloc += elements_in_chunk;
+		}
+
+		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+
+		uint32_t validator = (uint32_t)(_gen_id() & 0x7FFFFFFF);
+		CRASH_COND_MSG(validator == 0x7FFFFFFF, "Overflow in RID validator");
+		uint64_t id = validator;
+		id <<= 32;
+		id |= free_index;
+
+		validator_chunks[free_index / elements_in_chunk][free_index % elements_in_chunk] = validator | UNINITIALIZED_BIT;
+
+		alloc_count++;
+
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+
+		return _make_from_id(id);
+	}
+
+	// Returns the slot index of a valid RID, or UINT32_MAX.
+	_FORCE_INLINE_ uint32_t _get_index(const RID &p_rid, bool p_initialize = false) {
+		if (p_rid == RID()) {
+			return UINT32_MAX;
+		}
+
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		if (unlikely(idx >= max_alloc)) {
+			return UINT32_MAX;
+		}
+
+		uint32_t validator = uint32_t(id >> 32);
+		uint32_t &v = validator_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+		if (unlikely(p_initialize)) {
+			if (unlikely(!(v & UNINITIALIZED_BIT))) {
+				ERR_FAIL_V_MSG(UINT32_MAX, "Initializing already initialized RID");
+			}
+
+			if (unlikely((v & 0x7FFFFFFF) != validator)) {
+				ERR_FAIL_V_MSG(UINT32_MAX, "Attempting to initialize the wrong RID");
+			}
+
+			v &= 0x7FFFFFFF; //initialized
+
+		} else if (unlikely(v != validator)) {
+			if ((v & UNINITIALIZED_BIT) && v != INVALID_VALIDATOR) {
+				ERR_FAIL_V_MSG(UINT32_MAX, "Attempting to use an uninitialized RID");
+			}
+			return UINT32_MAX;
+		}
+
+		return idx;
+	}
+
+public:
+	RID make_rid() {
+		RID rid = _allocate_rid();
+		initialize_rid(rid);
+		return rid;
+	}
+	RID make_rid(const THot &p_hot, const TCold &p_cold) {
+		RID rid = _allocate_rid();
+		initialize_rid(rid, p_hot, p_cold);
+		return rid;
+	}
+
+	//allocate but don't initialize, use initialize_rid afterwards
+	RID allocate_rid() {
+		return _allocate_rid();
+	}
+
+	void initialize_rid(RID p_rid) {
+		uint32_t idx = _get_index(p_rid, true);
+		ERR_FAIL_COND(idx == UINT32_MAX);
+		memnew_placement(&hot_chunks[idx / elements_in_chunk][idx % elements_in_chunk], THot);
+		memnew_placement(&cold_chunks[idx / elements_in_chunk][idx % elements_in_chunk], TCold);
+		_mark_initialized(idx);
+	}
+	void initialize_rid(RID p_rid, const THot &p_hot, const TCold &p_cold) {
+		uint32_t idx = _get_index(p_rid, true);
+		ERR_FAIL_COND(idx == UINT32_MAX);
+		memnew_placement(&hot_chunks[idx / elements_in_chunk][idx % elements_in_chunk], THot(p_hot));
+		memnew_placement(&cold_chunks[idx / elements_in_chunk][idx % elements_in_chunk], TCold(p_cold));
+		_mark_initialized(idx);
+	}
+
+	_FORCE_INLINE_ THot *get_or_null(const RID &p_rid) {
+		uint32_t idx = _get_index(p_rid);
+		if (idx == UINT32_MAX) {
+			return nullptr;
+		}
+		return &hot_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+	}
+
+	_FORCE_INLINE_ TCold *get_cold_or_null(const RID &p_rid) {
+		uint32_t idx = _get_index(p_rid);
+		if (idx == UINT32_MAX) {
+			return nullptr;
+		}
+		return &cold_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+	}
+
+	_FORCE_INLINE_ bool get_or_null(const RID &p_rid, THot *&r_hot, TCold *&r_cold) {
+		uint32_t idx = _get_index(p_rid);
+		if (idx == UINT32_MAX) {
+			r_hot = nullptr;
+			r_cold = nullptr;
+			return false;
+		}
+		r_hot = &hot_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+		r_cold = &cold_chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+		return true;
+	}
+
+	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		if (unlikely(idx >= max_alloc)) {
+			if constexpr (THREAD_SAFE) {
+				mutex.unlock();
+			}
+			return false;
+		}
+
+		uint32_t validator = uint32_t(id >> 32);
+
+		bool owned = (validator != 0x7FFFFFFF) && (validator_chunks[idx / elements_in_chunk][idx % elements_in_chunk] & 0x7FFFFFFF) == validator;
+
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+
+		return owned;
+	}
+
+	_FORCE_INLINE_ void free(const RID &p_rid) {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		if (unlikely(idx >= max_alloc)) {
+			if constexpr (THREAD_SAFE) {
+				mutex.unlock();
+			}
+			ERR_FAIL();
+		}
+
+		uint32_t idx_chunk = idx / elements_in_chunk;
+		uint32_t idx_element = idx % elements_in_chunk;
+
+		uint32_t validator = uint32_t(id >> 32);
+		uint32_t &v = validator_chunks[idx_chunk][idx_element];
+		if (unlikely(v & UNINITIALIZED_BIT)) {
+			if constexpr (THREAD_SAFE) {
+				mutex.unlock();
+			}
+			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
+		} else if (unlikely(v != validator)) {
+			if constexpr (THREAD_SAFE) {
+				mutex.unlock();
+			}
+			ERR_FAIL();
+		}
+
+		hot_chunks[idx_chunk][idx_element].~THot();
+		cold_chunks[idx_chunk][idx_element].~TCold();
+		v = INVALID_VALIDATOR; // go invalid
+		_set_occupied(idx, false);
+
+		alloc_count--;
+		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
+
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t get_rid_count() const {
+		return alloc_count;
+	}
+
+	// Calls p_func(RID, THot &) for every initialized element, in memory order.
+	// Elements must not be allocated or freed from the callback.
+	template <typename F>
+	void for_each(F p_func) {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+		const uint32_t chunk_count = max_alloc / elements_in_chunk;
+		for (uint32_t c = 0; c < chunk_count; c++) {
+			THot *hot = hot_chunks[c];
+			const uint32_t *validators = validator_chunks[c];
+			const uint64_t *occupancy = occupancy_chunks[c];
+			for (uint32_t w = 0; w < elements_in_chunk / 64; w++) {
+				uint64_t bits = occupancy[w];
+				while (bits) {
+					const uint32_t i = w * 64 + CTZ64(bits);
+					bits &= bits - 1;
+					p_func(_make_from_id((uint64_t(validators[i]) << 32) | (c * elements_in_chunk + i)), hot[i]);
+				}
+			}
+		}
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+	}
+
+	// Same as for_each(), but calls p_func(RID, THot &, TCold &).
+	template <typename F>
+	void for_each_with_cold(F p_func) {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+		const uint32_t chunk_count = max_alloc / elements_in_chunk;
+		for (uint32_t c = 0; c < chunk_count; c++) {
+			THot *hot = hot_chunks[c];
+			TCold *cold = cold_chunks[c];
+			const uint32_t *validators = validator_chunks[c];
+			const uint64_t *occupancy = occupancy_chunks[c];
+			for (uint32_t w = 0; w < elements_in_chunk / 64; w++) {
+				uint64_t bits = occupancy[w];
+				while (bits) {
+					const uint32_t i = w * 64 + CTZ64(bits);
+					bits &= bits - 1;
+					p_func(_make_from_id((uint64_t(validators[i]) << 32) | (c * elements_in_chunk + i)), hot[i], cold[i]);
+				}
+			}
+		}
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+	}
+
+	void get_owned_list(List<RID> *p_owned) const {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+		for (size_t i = 0; i < max_alloc; i++) {
+			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			if (validator != INVALID_VALIDATOR) {
+				p_owned->push_back(_make_from_id((validator << 32) | i));
+			}
+		}
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+	}
+
+	//used for fast iteration in the elements or RIDs
+	void fill_owned_buffer(RID *p_rid_buffer) const {
+		if constexpr (THREAD_SAFE) {
+			mutex.lock();
+		}
+		uint32_t idx = 0;
+		for (size_t i = 0; i < max_alloc; i++) {
+			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			if (validator != INVALID_VALIDATOR) {
+				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
+				idx++;
+			}
+		}
+		if constexpr (THREAD_SAFE) {
+			mutex.unlock();
+		}
+	}
+
+	void set_description(const char *p_descrption) {
+		description = p_descrption;
+	}
+
+	// The chunk size is computed from the hot part, which is the one iterated over.
+	RID_HotColdAlloc(uint32_t p_target_chunk_byte_size = 65536, uint32_t p_maximum_number_of_elements = 262144) {
+		elements_in_chunk = MAX(64u, (p_target_chunk_byte_size / sizeof(THot)) & ~63u);
+		if constexpr (THREAD_SAFE) {
+			chunk_limit = (p_maximum_number_of_elements / elements_in_chunk) + 1;
+			hot_chunks = (THot **)memalloc(sizeof(THot *) * chunk_limit);
+			cold_chunks = (TCold **)memalloc(sizeof(TCold *) * chunk_limit);
+			validator_chunks = (uint32_t **)memalloc(sizeof(uint32_t *) * chunk_limit);
+			occupancy_chunks = (uint64_t **)memalloc(sizeof(uint64_t *) * chunk_limit);
+			free_list_chunks = (uint32_t **)memalloc(sizeof(uint32_t *) * chunk_limit);
+		}
+	}
+
+	~RID_HotColdAlloc() {
+		if (alloc_count) {
+			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
+					alloc_count, description ? description : typeid(THot).name()));
+
+			for (size_t i = 0; i < max_alloc; i++) {
+				uint32_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+				if (validator & UNINITIALIZED_BIT) {
+					continue; //uninitialized or free
+				}
+				hot_chunks[i / elements_in_chunk][i % elements_in_chunk].~THot();
+				cold_chunks[i / elements_in_chunk][i % elements_in_chunk].~TCold();
+			}
+		}
+
+		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		for (uint32_t i = 0; i < chunk_count; i++) {
+			memfree(hot_chunks[i]);
+			memfree(cold_chunks[i]);
+			memfree(validator_chunks[i]);
+			memfree(occupancy_chunks[i]);
+			memfree(free_list_chunks[i]);
+		}
+
+		if (hot_chunks) {
+			memfree(hot_chunks);
+			memfree(cold_chunks);
+			memfree(validator_chunks);
+			memfree(occupancy_chunks);
+			memfree(free_list_chunks);
+		}
+	}
+};
+
 template <typename T, bool THREAD_SAFE = false>
 class RID_PtrOwner {
 	RID_Alloc<T *, THREAD_SAFE> alloc;
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  swiss_group.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_GROUP_H
+#define SWISS_GROUP_H
+
+#include "core/typedefs.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_GROUP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#define SWISS_GROUP_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * Shared building blocks for the SwissHashMap and SwissHashSet containers.
+ *
+ * Every slot of the table has a one byte control word. Empty and deleted slots
+ * have the high bit set, occupied slots store the 7 lowest bits of the hash
+ * (called H2). The remaining bits of the hash (H1) select the group of
+ * SwissGroup::WIDTH consecutive slots where probing starts. A whole group of
+ * control bytes is compared against H2 at once, so only slots whose H2
+ * matches need their key compared, and most failed lookups stop at the first
+ * group without touching any key.
+ */
+
+namespace SwissControl {
+static constexpr uint8_t EMPTY = 0x80;
+static constexpr uint8_t DELETED = 0xFE;
+
+_FORCE_INLINE_ bool is_full(uint8_t p_ctrl) {
+	return (p_ctrl & 0x80) == 0;
+}
+
+// Mixing the user hash makes the top and bottom bits usable even for weak hashers.
+_FORCE_INLINE_ uint32_t mix(uint32_t p_hash) {
+	p_hash ^= p_hash >> 16;
+	p_hash *= 0x85ebca6b;
+	p_hash ^= p_hash >> 13;
+	p_hash *= 0xc2b2ae35;
+	p_hash ^= p_hash >> 16;
+	return p_hash;
+}
+
+_FORCE_INLINE_ uint8_t h2(uint32_t p_mixed_hash) {
+	return p_mixed_hash >> 25;
+}
+} // namespace SwissControl
+
+// Set of matching slots in a group. Each slot is represented by (1 << SHIFT) bits,
+// only the highest of which is set, so iteration works the same on every backend.
+template <uint32_t SHIFT>
+class SwissBitMask {
+	uint64_t mask = 0;
+
+public:
+	_FORCE_INLINE_ explicit operator bool() const { return mask != 0; }
+	_FORCE_INLINE_ uint32_t lowest() const { return CTZ64(mask) >> SHIFT; }
+	_FORCE_INLINE_ void clear_lowest() { mask &= mask - 1; }
+
+	_FORCE_INLINE_ explicit SwissBitMask(uint64_t p_mask) :
+			mask(p_mask) {}
+};
+
+struct SwissGroup {
+	static constexpr uint32_t WIDTH = 16;
+
+#if defined(SWISS_GROUP_SSE2)
+	typedef SwissBitMask<0> BitMask;
+
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit SwissGroup(const uint8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+
+	_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+		return BitMask((uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)p_h2), ctrl)));
+	}
+
+	_FORCE_INLINE_ BitMask match_empty() const {
+		return match(SwissControl::EMPTY);
+	}
+
+	_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+		return BitMask((uint16_t)_mm_movemask_epi8(ctrl));
+	}
+
+	_FORCE_INLINE_ BitMask match_full() const {
+		return BitMask((uint16_t)~_mm_movemask_epi8(ctrl));
+	}
+#elif defined(SWISS_GROUP_NEON)
+	// NEON has no movemask, narrowing each 16-bit lane by 4 leaves 4 bits per byte instead.
+	typedef SwissBitMask<2> BitMask;
+
+	uint8x16_t ctrl;
+
+	static _FORCE_INLINE_ BitMask _to_mask(uint8x16_t p_cmp) {
+		const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4);
+		return BitMask(vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull);
+	}
+
+	_FORCE_INLINE_ explicit SwissGroup(const uint8_t *p_ctrl) {
+		ctrl = vld1q_u8(p_ctrl);
+	}
+
+	_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+		return _to_mask(vceqq_u8(ctrl, vdupq_n_u8(p_h2)));
+	}
+
+	_FORCE_INLINE_ BitMask match_empty() const {
+		return match(SwissControl::EMPTY);
+	}
+
+	_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+		return _to_mask(vcltq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0)));
+	}
+
+	_FORCE_INLINE_ BitMask match_full() const {
+		return _to_mask(vcgeq_s8(vreinterpretq_s8_u8(ctrl), vdupq_n_s8(0)));
+	}
+#else
+	typedef SwissBitMask<0> BitMask;
+
+	const uint8_t *ctrl;
+
+	_FORCE_INLINE_ explicit SwissGroup(const uint8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+
+	_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(ctrl[i] == p_h2) << i;
+		}
+		return BitMask(mask);
+	}
+
+	_FORCE_INLINE_ BitMask match_empty() const {
+		return match(SwissControl::EMPTY);
+	}
+
+	_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(ctrl[i] >> 7) << i;
+		}
+		return BitMask(mask);
+	}
+
+	_FORCE_INLINE_ BitMask match_full() const {
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= uint32_t(SwissControl::is_full(ctrl[i])) << i;
+		}
+		return BitMask(mask);
+	}
+#endif
+};
+
+#endif // SWISS_GROUP_H
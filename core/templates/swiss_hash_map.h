@@ -0,0 +1,518 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_HASH_MAP_H
+#define SWISS_HASH_MAP_H
+
+#include "core/templates/hash_map.h"
+#include "core/templates/swiss_group.h"
+
+/**
+ * A HashMap with the same API as HashMap, but using SIMD group probing over a
+ * control byte array (see swiss_group.h) instead of Robin Hood hashing.
+ *
+ * Lookups compare 16 control bytes at once and only dereference the elements
+ * whose 7-bit hash fragment matches, which makes misses and lookups in large
+ * tables cheaper. Deletion leaves tombstones that are reclaimed on rehash.
+ *
+ * Like HashMap, keys and values are stored in a double linked list by insertion
+ * order, so iteration order and iterator stability are identical.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>,
+		typename Allocator = DefaultTypedAllocator<HashMapElement<TKey, TValue>>>
+class SwissHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY = SwissGroup::WIDTH;
+	static constexpr uint32_t MAX_CAPACITY = 1u << 31;
+
+	typedef typename HashMap<TKey, TValue, Hasher, Comparator, Allocator>::Iterator Iterator;
+	typedef typename HashMap<TKey, TValue, Hasher, Comparator, Allocator>::ConstIterator ConstIterator;
+
+private:
+	Allocator element_alloc;
+	uint8_t *ctrl = nullptr;
+	HashMapElement<TKey, TValue> **elements = nullptr;
+	HashMapElement<TKey, TValue> *head_element = nullptr;
+	HashMapElement<TKey, TValue> *tail_element = nullptr;
+
+	uint32_t capacity = MIN_CAPACITY; // Always a power of two multiple of SwissGroup::WIDTH.
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can be used before a rehash is needed.
+
+	static _FORCE_INLINE_ uint32_t _get_max_elements(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		return SwissControl::mix(Hasher::hash(p_key));
+	}
+
+	_FORCE_INLINE_ bool _lookup_pos_with_hash(const TKey &p_key, uint32_t p_hash, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		const uint32_t group_mask = capacity / SwissGroup::WIDTH - 1;
+		const uint8_t h2 = SwissControl::h2(p_hash);
+		uint32_t group = p_hash & group_mask;
+
+		// Triangular probing visits every group exactly once for power of two group counts.
+		for (uint32_t i = 1;; i++) {
+			const uint32_t base = group * SwissGroup::WIDTH;
+			const SwissGroup g(ctrl + base);
+			for (SwissGroup::BitMask match = g.match(h2); match; match.clear_lowest()) {
+				const uint32_t pos = base + match.lowest();
+				if (likely(Comparator::compare(elements[pos]->data.key, p_key))) {
+					r_pos = pos;
+					return true;
+				}
+			}
+			if (likely(g.match_empty())) {
+				return false;
+			}
+			group = (group + i) & group_mask;
+		}
+	}
+
+	_FORCE_INLINE_ bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false;
+		}
+		return _lookup_pos_with_hash(p_key, _hash(p_key), r_pos);
+	}
+
+	uint32_t _find_free_pos(uint32_t p_hash) const {
+		const uint32_t group_mask = capacity / SwissGroup::WIDTH - 1;
+		uint32_t group = p_hash & group_mask;
+
+		for (uint32_t i = 1;; i++) {
+			const uint32_t base = group * SwissGroup::WIDTH;
+			const SwissGroup::BitMask free = SwissGroup(ctrl + base).match_empty_or_deleted();
+			if (free) {
+				return base + free.lowest();
+			}
+			group = (group + i) & group_mask;
+		}
+	}
+
+	void _insert_element(uint32_t p_hash, HashMapElement<TKey, TValue> *p_element) {
+		const uint32_t pos = _find_free_pos(p_hash);
+		if (ctrl[pos] == SwissControl::EMPTY) {
+			growth_left--;
+		}
+		ctrl[pos] = SwissControl::h2(p_hash);
+		elements[pos] = p_element;
+		num_elements++;
+	}
+
+	void _erase_pos(uint32_t p_pos) {
+		// A lookup only stops at a group containing an empty slot, so if this group
+		// already has one no probe sequence can go through it and the slot can be
+		// emptied instead of becoming a tombstone.
+		const uint32_t base = p_pos & ~(SwissGroup::WIDTH - 1);
+		if (SwissGroup(ctrl + base).match_empty()) {
+			ctrl[p_pos] = SwissControl::EMPTY;
+			growth_left++;
+		} else {
+			ctrl[p_pos] = SwissControl::DELETED;
+		}
+		elements[p_pos] = nullptr;
+		num_elements--;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		uint8_t *old_ctrl = ctrl;
+		HashMapElement<TKey, TValue> **old_elements = elements;
+		const uint32_t old_capacity = capacity;
+
+		capacity = MAX(MIN_CAPACITY, p_new_capacity);
+		ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(sizeof(uint8_t) * capacity));
+		elements = reinterpret_cast<HashMapElement<TKey, TValue> **>(Memory::alloc_static(sizeof(HashMapElement<TKey, TValue> *) * capacity));
+		memset(ctrl, SwissControl::EMPTY, capacity);
+
+		num_elements = 0;
+		growth_left = _get_max_elements(capacity);
+
+		if (old_ctrl == nullptr) {
+			// Nothing to do.
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (SwissControl::is_full(old_ctrl[i])) {
+				_insert_element(_hash(old_elements[i]->data.key), old_elements[i]);
+			}
+		}
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_elements);
+	}
+
+	bool _grow() {
+		if (ctrl == nullptr) {
+			// Allocate on demand to save memory.
+			_resize_and_rehash(capacity);
+		} else if (num_elements <= _get_max_elements(capacity) / 2) {
+			// Mostly tombstones, rehashing in place is enough to reclaim them.
+			_resize_and_rehash(capacity);
+		} else {
+			ERR_FAIL_COND_V_MSG(capacity == MAX_CAPACITY, false, "Hash table maximum capacity reached, aborting insertion.");
+			_resize_and_rehash(capacity * 2);
+		}
+		return true;
+	}
+
+	_FORCE_INLINE_ HashMapElement<TKey, TValue> *_insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
+		const uint32_t hash = _hash(p_key);
+		uint32_t pos = 0;
+		bool exists = _lookup_pos_with_hash(p_key, hash, pos);
+
+		if (exists) {
+			elements[pos]->data.value = p_value;
+			return elements[pos];
+		}
+
+		if (unlikely(growth_left == 0)) {
+			if (!_grow()) {
+				return nullptr;
+			}
+		}
+
+		HashMapElement<TKey, TValue> *elem = element_alloc.new_allocation(HashMapElement<TKey, TValue>(p_key, p_value));
+
+		if (tail_element == nullptr) {
+			head_element = elem;
+			tail_element = elem;
+		} else if (p_front_insert) {
+			head_element->prev = elem;
+			elem->next = head_element;
+			head_element = elem;
+		} else {
+			tail_element->next = elem;
+			elem->prev = tail_element;
+			tail_element = elem;
+		}
+
+		_insert_element(hash, elem);
+		return elem;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr) {
+			return;
+		}
+
+		HashMapElement<TKey, TValue> *E = head_element;
+		while (E) {
+			HashMapElement<TKey, TValue> *next = E->next;
+			element_alloc.delete_allocation(E);
+			E = next;
+		}
+		memset(ctrl, SwissControl::EMPTY, capacity);
+
+		tail_element = nullptr;
+		head_element = nullptr;
+		num_elements = 0;
+		growth_left = _get_max_elements(capacity);
+	}
+
+	void sort() {
+		if (num_elements < 2) {
+			return; // An empty or single element map is already sorted.
+		}
+		// Same insertion sort as HashMap::sort(), only the linked list is affected.
+		HashMapElement<TKey, TValue> *inserting = head_element->next;
+		while (inserting != nullptr) {
+			HashMapElement<TKey, TValue> *after = nullptr;
+			for (HashMapElement<TKey, TValue> *current = inserting->prev; current != nullptr; current = current->prev) {
+				if (_hashmap_variant_less_than(inserting->data.key, current->data.key)) {
+					after = current;
+				} else {
+					break;
+				}
+			}
+			HashMapElement<TKey, TValue> *next = inserting->next;
+			if (after != nullptr) {
+				inserting->prev->next = next;
+				if (next == nullptr) {
+					tail_element = inserting->prev;
+				} else {
+					next->prev = inserting->prev;
+				}
+				HashMapElement<TKey, TValue> *before = after->prev;
+				if (before == nullptr) {
+					head_element = inserting;
+				} else {
+					before->next = inserting;
+				}
+				after->prev = inserting;
+				inserting->prev = before;
+				inserting->next = after;
+			}
+			inserting = next;
+		}
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[pos]->data.value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return elements[pos]->data.value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[pos]->data.value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[pos]->data.value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		HashMapElement<TKey, TValue> *element = elements[pos];
+		_erase_pos(pos);
+
+		if (head_element == element) {
+			head_element = element->next;
+		}
+
+		if (tail_element == element) {
+			tail_element = element->prev;
+		}
+
+		if (element->prev) {
+			element->prev->next = element->next;
+		}
+
+		if (element->next) {
+			element->next->prev = element->prev;
+		}
+
+		element_alloc.delete_allocation(element);
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t pos = 0;
+		ERR_FAIL_COND_V(_lookup_pos(p_new_key, pos), false);
+		ERR_FAIL_COND_V(!_lookup_pos(p_old_key, pos), false);
+		HashMapElement<TKey, TValue> *element = elements[pos];
+		_erase_pos(pos);
+
+		if (unlikely(growth_left == 0)) {
+			// The freed slot became a tombstone, the element is re-added after the rehash.
+			_resize_and_rehash(capacity);
+		}
+
+		const_cast<TKey &>(element->data.key) = p_new_key;
+		_insert_element(_hash(p_new_key), element);
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = capacity;
+		while (_get_max_elements(new_capacity) < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_capacity == MAX_CAPACITY, "Hash table maximum capacity reached.");
+			new_capacity *= 2;
+		}
+
+		if (new_capacity == capacity) {
+			return;
+		}
+
+		if (ctrl == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(head_element);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(nullptr);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		return Iterator(tail_element);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(elements[pos]);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(head_element);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(nullptr);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		return ConstIterator(tail_element);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(elements[pos]);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return elements[pos]->data.value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return _insert(p_key, TValue())->data.value;
+		} else {
+			return elements[pos]->data.value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value, bool p_front_insert = false) {
+		return Iterator(_insert(p_key, p_value, p_front_insert));
+	}
+
+	/* Constructors */
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		clear();
+
+		reserve(p_other.num_elements);
+
+		for (const KeyValue<TKey, TValue> &E : p_other) {
+			insert(E.key, E.value);
+		}
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SwissHashMap() {}
+
+	~SwissHashMap() {
+		clear();
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(elements);
+		}
+	}
+};
+
+#endif // SWISS_HASH_MAP_H
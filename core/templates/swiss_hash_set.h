@@ -0,0 +1,362 @@
+/**************************************************************************/
+/*  swiss_hash_set.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef SWISS_HASH_SET_H
+#define SWISS_HASH_SET_H
+
+#include "core/templates/hash_set.h"
+#include "core/templates/swiss_group.h"
+
+/**
+ * A set with the same API as HashSet, but using SIMD group probing over a
+ * control byte array (see swiss_group.h) instead of Robin Hood hashing.
+ *
+ * Like HashSet, keys are kept in a dense array so iteration is linear, and
+ * erasing moves the last key into the freed position.
+ */
+
+template <typename TKey,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashSet {
+public:
+	static constexpr uint32_t MIN_CAPACITY = SwissGroup::WIDTH;
+	static constexpr uint32_t MAX_CAPACITY = 1u << 31;
+
+	typedef typename HashSet<TKey, Hasher, Comparator>::Iterator Iterator;
+
+private:
+	uint8_t *ctrl = nullptr;
+	uint32_t *slot_to_key = nullptr;
+	TKey *keys = nullptr;
+	uint32_t *key_to_slot = nullptr;
+
+	uint32_t capacity = MIN_CAPACITY; // Always a power of two multiple of SwissGroup::WIDTH.
+	uint32_t num_elements = 0;
+	uint32_t growth_left = 0; // Empty slots that can be used before a rehash is needed.
+
+	static _FORCE_INLINE_ uint32_t _get_max_elements(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8;
+	}
+
+	static _FORCE_INLINE_ uint32_t _hash(const TKey &p_key) {
+		return SwissControl::mix(Hasher::hash(p_key));
+	}
+
+	_FORCE_INLINE_ bool _lookup_pos_with_hash(const TKey &p_key, uint32_t p_hash, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		const uint32_t group_mask = capacity / SwissGroup::WIDTH - 1;
+		const uint8_t h2 = SwissControl::h2(p_hash);
+		uint32_t group = p_hash & group_mask;
+
+		for (uint32_t i = 1;; i++) {
+			const uint32_t base = group * SwissGroup::WIDTH;
+			const SwissGroup g(ctrl + base);
+			for (SwissGroup::BitMask match = g.match(h2); match; match.clear_lowest()) {
+				const uint32_t key_pos = slot_to_key[base + match.lowest()];
+				if (likely(Comparator::compare(keys[key_pos], p_key))) {
+					r_pos = key_pos;
+					return true;
+				}
+			}
+			if (likely(g.match_empty())) {
+				return false;
+			}
+			group = (group + i) & group_mask;
+		}
+	}
+
+	_FORCE_INLINE_ bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (num_elements == 0) {
+			return false;
+		}
+		return _lookup_pos_with_hash(p_key, _hash(p_key), r_pos);
+	}
+
+	void _insert_with_hash(uint32_t p_hash, uint32_t p_key_pos) {
+		const uint32_t group_mask = capacity / SwissGroup::WIDTH - 1;
+		uint32_t group = p_hash & group_mask;
+
+		for (uint32_t i = 1;; i++) {
+			const uint32_t base = group * SwissGroup::WIDTH;
+			const SwissGroup::BitMask free = SwissGroup(ctrl + base).match_empty_or_deleted();
+			if (free) {
+				const uint32_t pos = base + free.lowest();
+				if (ctrl[pos] == SwissControl::EMPTY) {
+					growth_left--;
+				}
+				ctrl[pos] = SwissControl::h2(p_hash);
+				slot_to_key[pos] = p_key_pos;
+				key_to_slot[p_key_pos] = pos;
+				return;
+			}
+			group = (group + i) & group_mask;
+		}
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		capacity = MAX(MIN_CAPACITY, p_new_capacity);
+
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slot_to_key);
+		}
+		ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(sizeof(uint8_t) * capacity));
+		slot_to_key = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		keys = reinterpret_cast<TKey *>(Memory::realloc_static(keys, sizeof(TKey) * _get_max_elements(capacity)));
+		key_to_slot = reinterpret_cast<uint32_t *>(Memory::realloc_static(key_to_slot, sizeof(uint32_t) * _get_max_elements(capacity)));
+		memset(ctrl, SwissControl::EMPTY, capacity);
+
+		growth_left = _get_max_elements(capacity);
+
+		// The dense key array is the source of truth, only the index needs to be rebuilt.
+		for (uint32_t i = 0; i < num_elements; i++) {
+			_insert_with_hash(_hash(keys[i]), i);
+		}
+	}
+
+	_FORCE_INLINE_ int32_t _insert(const TKey &p_key) {
+		const uint32_t hash = _hash(p_key);
+		uint32_t pos = 0;
+		bool exists = _lookup_pos_with_hash(p_key, hash, pos);
+
+		if (exists) {
+			return pos;
+		}
+
+		if (unlikely(growth_left == 0)) {
+			if (ctrl == nullptr || num_elements <= _get_max_elements(capacity) / 2) {
+				// Allocate on demand, or reclaim tombstones without growing.
+				_resize_and_rehash(capacity);
+			} else {
+				ERR_FAIL_COND_V_MSG(capacity == MAX_CAPACITY, -1, "Hash table maximum capacity reached, aborting insertion.");
+				_resize_and_rehash(capacity * 2);
+			}
+		}
+
+		memnew_placement(&keys[num_elements], TKey(p_key));
+		_insert_with_hash(hash, num_elements);
+		num_elements++;
+		return num_elements - 1;
+	}
+
+	void _init_from(const SwissHashSet &p_other) {
+		capacity = p_other.capacity;
+		num_elements = p_other.num_elements;
+		growth_left = p_other.growth_left;
+
+		if (p_other.ctrl == nullptr) {
+			return;
+		}
+
+		const uint32_t max_elements = _get_max_elements(capacity);
+		ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(sizeof(uint8_t) * capacity));
+		slot_to_key = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		keys = reinterpret_cast<TKey *>(Memory::alloc_static(sizeof(TKey) * max_elements));
+		key_to_slot = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_elements));
+
+		memcpy(ctrl, p_other.ctrl, capacity);
+		memcpy(slot_to_key, p_other.slot_to_key, sizeof(uint32_t) * capacity);
+		memcpy(key_to_slot, p_other.key_to_slot, sizeof(uint32_t) * num_elements);
+		for (uint32_t i = 0; i < num_elements; i++) {
+			memnew_placement(&keys[i], TKey(p_other.keys[i]));
+		}
+	}
+
+	void _free_storage() {
+		if (ctrl != nullptr) {
+			Memory::free_static(ctrl);
+			Memory::free_static(slot_to_key);
+			Memory::free_static(keys);
+			Memory::free_static(key_to_slot);
+			ctrl = nullptr;
+			slot_to_key = nullptr;
+			keys = nullptr;
+			key_to_slot = nullptr;
+		}
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr) {
+			return;
+		}
+		memset(ctrl, SwissControl::EMPTY, capacity);
+		for (uint32_t i = 0; i < num_elements; i++) {
+			keys[i].~TKey();
+		}
+
+		num_elements = 0;
+		growth_left = _get_max_elements(capacity);
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t key_pos = 0;
+		bool exists = _lookup_pos(p_key, key_pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		// See SwissHashMap::_erase_pos() for why this is safe.
+		const uint32_t pos = key_to_slot[key_pos];
+		const uint32_t base = pos & ~(SwissGroup::WIDTH - 1);
+		if (SwissGroup(ctrl + base).match_empty()) {
+			ctrl[pos] = SwissControl::EMPTY;
+			growth_left++;
+		} else {
+			ctrl[pos] = SwissControl::DELETED;
+		}
+
+		keys[key_pos].~TKey();
+		num_elements--;
+		if (key_pos < num_elements) {
+			// Not the last key, move the last one here to keep keys lineal
+			memnew_placement(&keys[key_pos], TKey(keys[num_elements]));
+			keys[num_elements].~TKey();
+			key_to_slot[key_pos] = key_to_slot[num_elements];
+			slot_to_key[key_to_slot[key_pos]] = key_pos;
+		}
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_capacity = capacity;
+		while (_get_max_elements(new_capacity) < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_capacity == MAX_CAPACITY, "Hash table maximum capacity reached.");
+			new_capacity *= 2;
+		}
+
+		if (new_capacity == capacity) {
+			return;
+		}
+
+		if (ctrl == nullptr) {
+			capacity = new_capacity;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	_FORCE_INLINE_ Iterator begin() const {
+		return num_elements ? Iterator(keys, num_elements, 0) : Iterator();
+	}
+	_FORCE_INLINE_ Iterator end() const {
+		return Iterator();
+	}
+	_FORCE_INLINE_ Iterator last() const {
+		if (num_elements == 0) {
+			return Iterator();
+		}
+		return Iterator(keys, num_elements, num_elements - 1);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(keys, num_elements, pos);
+	}
+
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(*p_iter);
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key) {
+		int32_t pos = _insert(p_key);
+		if (pos < 0) {
+			return end();
+		}
+		return Iterator(keys, num_elements, pos);
+	}
+
+	/* Constructors */
+
+	SwissHashSet(const SwissHashSet &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashSet &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		clear();
+		_free_storage();
+		_init_from(p_other);
+	}
+
+	SwissHashSet(uint32_t p_initial_capacity) {
+		reserve(p_initial_capacity);
+	}
+	SwissHashSet() {}
+
+	void reset() {
+		clear();
+		_free_storage();
+		capacity = MIN_CAPACITY;
+		growth_left = 0;
+	}
+
+	~SwissHashSet() {
+		clear();
+		_free_storage();
+	}
+};
+
+#endif // SWISS_HASH_SET_H
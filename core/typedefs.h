@@ -253,6 +253,30 @@ static inline uint64_t BSWAP64(uint64_t x) {
 }
 #endif
 
+// Count trailing zero bits of a 64-bit value, which must not be 0.
+#if defined(__GNUC__)
+#define CTZ64(x) ((uint32_t)__builtin_ctzll(x))
+#elif defined(_MSC_VER)
+#include <intrin.h>
+static inline uint32_t CTZ64(uint64_t x) {
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)x)) {
+		return index;
+	}
+	_BitScanForward(&index, (unsigned long)(x >> 32));
+	return index + 32;
+}
+#else
+static inline uint32_t CTZ64(uint64_t x) {
+	uint32_t count = 0;
+	while (!(x & 1)) {
+		x >>= 1;
+		count++;
+	}
+	return count;
+}
+#endif
+
 // Generic comparator used in Map, List, etc.
 template <typename T>
 struct Comparator {
@@ -41,6 +41,11 @@
 PagedAllocator<Variant::Pools::BucketSmall, true> Variant::Pools::_bucket_small;
 PagedAllocator<Variant::Pools::BucketMedium, true> Variant::Pools::_bucket_medium;
 PagedAllocator<Variant::Pools::BucketLarge, true> Variant::Pools::_bucket_large;
+#ifdef VARIANT_IS_COMPACT
+PagedAllocator<Variant::Pools::BucketTiny, true> Variant::Pools::_bucket_tiny;
+
+static_assert(sizeof(Variant) == 16, "Compact Variant must be 16 bytes.");
+#endif
 
 String Variant::get_type_name(Variant::Type p_type) {
 	switch (p_type) {
@@ -904,34 +909,34 @@ bool Variant::is_zero() const {
 			return *reinterpret_cast<const Vector2i *>(_data._mem) == Vector2i();
 		}
 		case RECT2: {
-			return *reinterpret_cast<const Rect2 *>(_data._mem) == Rect2();
+			return *_payload<Rect2>() == Rect2();
 		}
 		case RECT2I: {
-			return *reinterpret_cast<const Rect2i *>(_data._mem) == Rect2i();
+			return *_payload<Rect2i>() == Rect2i();
 		}
 		case TRANSFORM2D: {
 			return *_data._transform2d == Transform2D();
 		}
 		case VECTOR3: {
-			return *reinterpret_cast<const Vector3 *>(_data._mem) == Vector3();
+			return *_payload<Vector3>() == Vector3();
 		}
 		case VECTOR3I: {
-			return *reinterpret_cast<const Vector3i *>(_data._mem) == Vector3i();
+			return *_payload<Vector3i>() == Vector3i();
 		}
 		case VECTOR4: {
-			return *reinterpret_cast<const Vector4 *>(_data._mem) == Vector4();
+			return *_payload<Vector4>() == Vector4();
 		}
 		case VECTOR4I: {
-			return *reinterpret_cast<const Vector4i *>(_data._mem) == Vector4i();
+			return *_payload<Vector4i>() == Vector4i();
 		}
 		case PLANE: {
-			return *reinterpret_cast<const Plane *>(_data._mem) == Plane();
+			return *_payload<Plane>() == Plane();
 		}
 		case AABB: {
 			return *_data._aabb == ::AABB();
 		}
 		case QUATERNION: {
-			return *reinterpret_cast<const Quaternion *>(_data._mem) == Quaternion();
+			return *_payload<Quaternion>() == Quaternion();
 		}
 		case BASIS: {
 			return *_data._basis == Basis();
@@ -945,7 +950,7 @@ bool Variant::is_zero() const {
 
 		// Miscellaneous types.
 		case COLOR: {
-			return *reinterpret_cast<const Color *>(_data._mem) == Color();
+			return *_payload<Color>() == Color();
 		}
 		case RID: {
 			return *reinterpret_cast<const ::RID *>(_data._mem) == ::RID();
@@ -954,10 +959,10 @@ bool Variant::is_zero() const {
 			return _get_obj().obj == nullptr;
 		}
 		case CALLABLE: {
-			return reinterpret_cast<const Callable *>(_data._mem)->is_null();
+			return _payload<Callable>()->is_null();
 		}
 		case SIGNAL: {
-			return reinterpret_cast<const Signal *>(_data._mem)->is_null();
+			return _payload<Signal>()->is_null();
 		}
 		case STRING_NAME: {
 			return *reinterpret_cast<const StringName *>(_data._mem) == StringName();
@@ -1033,29 +1038,29 @@ bool Variant::is_one() const {
 			return *reinterpret_cast<const Vector2i *>(_data._mem) == Vector2i(1, 1);
 		}
 		case RECT2: {
-			return *reinterpret_cast<const Rect2 *>(_data._mem) == Rect2(1, 1, 1, 1);
+			return *_payload<Rect2>() == Rect2(1, 1, 1, 1);
 		}
 		case RECT2I: {
-			return *reinterpret_cast<const Rect2i *>(_data._mem) == Rect2i(1, 1, 1, 1);
+			return *_payload<Rect2i>() == Rect2i(1, 1, 1, 1);
 		}
 		case VECTOR3: {
-			return *reinterpret_cast<const Vector3 *>(_data._mem) == Vector3(1, 1, 1);
+			return *_payload<Vector3>() == Vector3(1, 1, 1);
 		}
 		case VECTOR3I: {
-			return *reinterpret_cast<const Vector3i *>(_data._mem) == Vector3i(1, 1, 1);
+			return *_payload<Vector3i>() == Vector3i(1, 1, 1);
 		}
 		case VECTOR4: {
-			return *reinterpret_cast<const Vector4 *>(_data._mem) == Vector4(1, 1, 1, 1);
+			return *_payload<Vector4>() == Vector4(1, 1, 1, 1);
 		}
 		case VECTOR4I: {
-			return *reinterpret_cast<const Vector4i *>(_data._mem) == Vector4i(1, 1, 1, 1);
+			return *_payload<Vector4i>() == Vector4i(1, 1, 1, 1);
 		}
 		case PLANE: {
-			return *reinterpret_cast<const Plane *>(_data._mem) == Plane(1, 1, 1, 1);
+			return *_payload<Plane>() == Plane(1, 1, 1, 1);
 		}
 
 		case COLOR: {
-			return *reinterpret_cast<const Color *>(_data._mem) == Color(1, 1, 1, 1);
+			return *_payload<Color>() == Color(1, 1, 1, 1);
 		}
 
 		default: {
@@ -1164,36 +1169,36 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Vector2i(*reinterpret_cast<const Vector2i *>(p_variant._data._mem)));
 		} break;
 		case RECT2: {
-			memnew_placement(_data._mem, Rect2(*reinterpret_cast<const Rect2 *>(p_variant._data._mem)));
+			_payload_new<Rect2>(*p_variant._payload<Rect2>());
 		} break;
 		case RECT2I: {
-			memnew_placement(_data._mem, Rect2i(*reinterpret_cast<const Rect2i *>(p_variant._data._mem)));
+			_payload_new<Rect2i>(*p_variant._payload<Rect2i>());
 		} break;
 		case TRANSFORM2D: {
 			_data._transform2d = (Transform2D *)Pools::_bucket_small.alloc();
 			memnew_placement(_data._transform2d, Transform2D(*p_variant._data._transform2d));
 		} break;
 		case VECTOR3: {
-			memnew_placement(_data._mem, Vector3(*reinterpret_cast<const Vector3 *>(p_variant._data._mem)));
+			_payload_new<Vector3>(*p_variant._payload<Vector3>());
 		} break;
 		case VECTOR3I: {
-			memnew_placement(_data._mem, Vector3i(*reinterpret_cast<const Vector3i *>(p_variant._data._mem)));
+			_payload_new<Vector3i>(*p_variant._payload<Vector3i>());
 		} break;
 		case VECTOR4: {
-			memnew_placement(_data._mem, Vector4(*reinterpret_cast<const Vector4 *>(p_variant._data._mem)));
+			_payload_new<Vector4>(*p_variant._payload<Vector4>());
 		} break;
 		case VECTOR4I: {
-			memnew_placement(_data._mem, Vector4i(*reinterpret_cast<const Vector4i *>(p_variant._data._mem)));
+			_payload_new<Vector4i>(*p_variant._payload<Vector4i>());
 		} break;
 		case PLANE: {
-			memnew_placement(_data._mem, Plane(*reinterpret_cast<const Plane *>(p_variant._data._mem)));
+			_payload_new<Plane>(*p_variant._payload<Plane>());
 		} break;
 		case AABB: {
 			_data._aabb = (::AABB *)Pools::_bucket_small.alloc();
 			memnew_placement(_data._aabb, ::AABB(*p_variant._data._aabb));
 		} break;
 		case QUATERNION: {
-			memnew_placement(_data._mem, Quaternion(*reinterpret_cast<const Quaternion *>(p_variant._data._mem)));
+			_payload_new<Quaternion>(*p_variant._payload<Quaternion>());
 		} break;
 		case BASIS: {
 			_data._basis = (Basis *)Pools::_bucket_medium.alloc();
@@ -1210,20 +1215,20 @@ void Variant::reference(const Variant &p_variant) {
 
 		// Miscellaneous types.
 		case COLOR: {
-			memnew_placement(_data._mem, Color(*reinterpret_cast<const Color *>(p_variant._data._mem)));
+			_payload_new<Color>(*p_variant._payload<Color>());
 		} break;
 		case RID: {
 			memnew_placement(_data._mem, ::RID(*reinterpret_cast<const ::RID *>(p_variant._data._mem)));
 		} break;
 		case OBJECT: {
-			memnew_placement(_data._mem, ObjData);
+			_payload_new<ObjData>();
 			_get_obj().ref(p_variant._get_obj());
 		} break;
 		case CALLABLE: {
-			memnew_placement(_data._mem, Callable(*reinterpret_cast<const Callable *>(p_variant._data._mem)));
+			_payload_new<Callable>(*p_variant._payload<Callable>());
 		} break;
 		case SIGNAL: {
-			memnew_placement(_data._mem, Signal(*reinterpret_cast<const Signal *>(p_variant._data._mem)));
+			_payload_new<Signal>(*p_variant._payload<Signal>());
 		} break;
 		case STRING_NAME: {
 			memnew_placement(_data._mem, StringName(*reinterpret_cast<const StringName *>(p_variant._data._mem)));
@@ -1325,32 +1330,32 @@ void Variant::zero() {
 			*reinterpret_cast<Vector2i *>(_data._mem) = Vector2i();
 			break;
 		case RECT2:
-			*reinterpret_cast<Rect2 *>(_data._mem) = Rect2();
+			*_payload<Rect2>() = Rect2();
 			break;
 		case RECT2I:
-			*reinterpret_cast<Rect2i *>(_data._mem) = Rect2i();
+			*_payload<Rect2i>() = Rect2i();
 			break;
 		case VECTOR3:
-			*reinterpret_cast<Vector3 *>(_data._mem) = Vector3();
+			*_payload<Vector3>() = Vector3();
 			break;
 		case VECTOR3I:
-			*reinterpret_cast<Vector3i *>(_data._mem) = Vector3i();
+			*_payload<Vector3i>() = Vector3i();
 			break;
 		case VECTOR4:
-			*reinterpret_cast<Vector4 *>(_data._mem) = Vector4();
+			*_payload<Vector4>() = Vector4();
 			break;
 		case VECTOR4I:
-			*reinterpret_cast<Vector4i *>(_data._mem) = Vector4i();
+			*_payload<Vector4i>() = Vector4i();
 			break;
 		case PLANE:
-			*reinterpret_cast<Plane *>(_data._mem) = Plane();
+			*_payload<Plane>() = Plane();
 			break;
 		case QUATERNION:
-			*reinterpret_cast<Quaternion *>(_data._mem) = Quaternion();
+			*_payload<Quaternion>() = Quaternion();
 			break;
 
 		case COLOR:
-			*reinterpret_cast<Color *>(_data._mem) = Color();
+			*_payload<Color>() = Color();
 			break;
 
 		default:
@@ -1408,6 +1413,37 @@ void Variant::_clear_internal() {
 			}
 		} break;
 
+#ifdef VARIANT_IS_COMPACT
+		// Boxed math types, see `Variant::_is_boxed`.
+		case RECT2: {
+			_payload_delete<Rect2>();
+		} break;
+		case RECT2I: {
+			_payload_delete<Rect2i>();
+		} break;
+		case VECTOR3: {
+			_payload_delete<Vector3>();
+		} break;
+		case VECTOR3I: {
+			_payload_delete<Vector3i>();
+		} break;
+		case VECTOR4: {
+			_payload_delete<Vector4>();
+		} break;
+		case VECTOR4I: {
+			_payload_delete<Vector4i>();
+		} break;
+		case PLANE: {
+			_payload_delete<Plane>();
+		} break;
+		case QUATERNION: {
+			_payload_delete<Quaternion>();
+		} break;
+		case COLOR: {
+			_payload_delete<Color>();
+		} break;
+#endif
+
 		// Miscellaneous types.
 		case STRING_NAME: {
 			reinterpret_cast<StringName *>(_data._mem)->~StringName();
@@ -1417,6 +1453,7 @@ void Variant::_clear_internal() {
 		} break;
 		case OBJECT: {
 			_get_obj().unref();
+			_payload_delete<ObjData>();
 		} break;
 		case RID: {
 			// Not much need probably.
@@ -1425,10 +1462,10 @@ void Variant::_clear_internal() {
 			reinterpret_cast<RID_Class *>(_data._mem)->~RID_Class();
 		} break;
 		case CALLABLE: {
-			reinterpret_cast<Callable *>(_data._mem)->~Callable();
+			_payload_delete<Callable>();
 		} break;
 		case SIGNAL: {
-			reinterpret_cast<Signal *>(_data._mem)->~Signal();
+			_payload_delete<Signal>();
 		} break;
 		case DICTIONARY: {
 			reinterpret_cast<Dictionary *>(_data._mem)->~Dictionary();
@@ -1856,11 +1893,11 @@ String Variant::stringify(int recursion_count) const {
 			}
 		}
 		case CALLABLE: {
-			const Callable &c = *reinterpret_cast<const Callable *>(_data._mem);
+			const Callable &c = *_payload<Callable>();
 			return c;
 		}
 		case SIGNAL: {
-			const Signal &s = *reinterpret_cast<const Signal *>(_data._mem);
+			const Signal &s = *_payload<Signal>();
 			return s;
 		}
 		case RID: {
@@ -1883,13 +1920,13 @@ Variant::operator Vector2() const {
 	} else if (type == VECTOR2I) {
 		return *reinterpret_cast<const Vector2i *>(_data._mem);
 	} else if (type == VECTOR3) {
-		return Vector2(reinterpret_cast<const Vector3 *>(_data._mem)->x, reinterpret_cast<const Vector3 *>(_data._mem)->y);
+		return Vector2(_payload<Vector3>()->x, _payload<Vector3>()->y);
 	} else if (type == VECTOR3I) {
-		return Vector2(reinterpret_cast<const Vector3i *>(_data._mem)->x, reinterpret_cast<const Vector3i *>(_data._mem)->y);
+		return Vector2(_payload<Vector3i>()->x, _payload<Vector3i>()->y);
 	} else if (type == VECTOR4) {
-		return Vector2(reinterpret_cast<const Vector4 *>(_data._mem)->x, reinterpret_cast<const Vector4 *>(_data._mem)->y);
+		return Vector2(_payload<Vector4>()->x, _payload<Vector4>()->y);
 	} else if (type == VECTOR4I) {
-		return Vector2(reinterpret_cast<const Vector4i *>(_data._mem)->x, reinterpret_cast<const Vector4i *>(_data._mem)->y);
+		return Vector2(_payload<Vector4i>()->x, _payload<Vector4i>()->y);
 	} else {
 		return Vector2();
 	}
@@ -1901,13 +1938,13 @@ Variant::operator Vector2i() const {
 	} else if (type == VECTOR2) {
 		return *reinterpret_cast<const Vector2 *>(_data._mem);
 	} else if (type == VECTOR3) {
-		return Vector2(reinterpret_cast<const Vector3 *>(_data._mem)->x, reinterpret_cast<const Vector3 *>(_data._mem)->y);
+		return Vector2(_payload<Vector3>()->x, _payload<Vector3>()->y);
 	} else if (type == VECTOR3I) {
-		return Vector2(reinterpret_cast<const Vector3i *>(_data._mem)->x, reinterpret_cast<const Vector3i *>(_data._mem)->y);
+		return Vector2(_payload<Vector3i>()->x, _payload<Vector3i>()->y);
 	} else if (type == VECTOR4) {
-		return Vector2(reinterpret_cast<const Vector4 *>(_data._mem)->x, reinterpret_cast<const Vector4 *>(_data._mem)->y);
+		return Vector2(_payload<Vector4>()->x, _payload<Vector4>()->y);
 	} else if (type == VECTOR4I) {
-		return Vector2(reinterpret_cast<const Vector4i *>(_data._mem)->x, reinterpret_cast<const Vector4i *>(_data._mem)->y);
+		return Vector2(_payload<Vector4i>()->x, _payload<Vector4i>()->y);
 	} else {
 		return Vector2i();
 	}
@@ -1915,9 +1952,9 @@ Variant::operator Vector2i() const {
 
 Variant::operator Rect2() const {
 	if (type == RECT2) {
-		return *reinterpret_cast<const Rect2 *>(_data._mem);
+		return *_payload<Rect2>();
 	} else if (type == RECT2I) {
-		return *reinterpret_cast<const Rect2i *>(_data._mem);
+		return *_payload<Rect2i>();
 	} else {
 		return Rect2();
 	}
@@ -1925,9 +1962,9 @@ Variant::operator Rect2() const {
 
 Variant::operator Rect2i() const {
 	if (type == RECT2I) {
-		return *reinterpret_cast<const Rect2i *>(_data._mem);
+		return *_payload<Rect2i>();
 	} else if (type == RECT2) {
-		return *reinterpret_cast<const Rect2 *>(_data._mem);
+		return *_payload<Rect2>();
 	} else {
 		return Rect2i();
 	}
@@ -1935,17 +1972,17 @@ Variant::operator Rect2i() const {
 
 Variant::operator Vector3() const {
 	if (type == VECTOR3) {
-		return *reinterpret_cast<const Vector3 *>(_data._mem);
+		return *_payload<Vector3>();
 	} else if (type == VECTOR3I) {
-		return *reinterpret_cast<const Vector3i *>(_data._mem);
+		return *_payload<Vector3i>();
 	} else if (type == VECTOR2) {
 		return Vector3(reinterpret_cast<const Vector2 *>(_data._mem)->x, reinterpret_cast<const Vector2 *>(_data._mem)->y, 0.0);
 	} else if (type == VECTOR2I) {
 		return Vector3(reinterpret_cast<const Vector2i *>(_data._mem)->x, reinterpret_cast<const Vector2i *>(_data._mem)->y, 0.0);
 	} else if (type == VECTOR4) {
-		return Vector3(reinterpret_cast<const Vector4 *>(_data._mem)->x, reinterpret_cast<const Vector4 *>(_data._mem)->y, reinterpret_cast<const Vector4 *>(_data._mem)->z);
+		return Vector3(_payload<Vector4>()->x, _payload<Vector4>()->y, _payload<Vector4>()->z);
 	} else if (type == VECTOR4I) {
-		return Vector3(reinterpret_cast<const Vector4i *>(_data._mem)->x, reinterpret_cast<const Vector4i *>(_data._mem)->y, reinterpret_cast<const Vector4i *>(_data._mem)->z);
+		return Vector3(_payload<Vector4i>()->x, _payload<Vector4i>()->y, _payload<Vector4i>()->z);
 	} else {
 		return Vector3();
 	}
@@ -1953,17 +1990,17 @@ Variant::operator Vector3() const {
 
 Variant::operator Vector3i() const {
 	if (type == VECTOR3I) {
-		return *reinterpret_cast<const Vector3i *>(_data._mem);
+		return *_payload<Vector3i>();
 	} else if (type == VECTOR3) {
-		return *reinterpret_cast<const Vector3 *>(_data._mem);
+		return *_payload<Vector3>();
 	} else if (type == VECTOR2) {
 		return Vector3i(reinterpret_cast<const Vector2 *>(_data._mem)->x, reinterpret_cast<const Vector2 *>(_data._mem)->y, 0.0);
 	} else if (type == VECTOR2I) {
 		return Vector3i(reinterpret_cast<const Vector2i *>(_data._mem)->x, reinterpret_cast<const Vector2i *>(_data._mem)->y, 0.0);
 	} else if (type == VECTOR4) {
-		return Vector3i(reinterpret_cast<const Vector4 *>(_data._mem)->x, reinterpret_cast<const Vector4 *>(_data._mem)->y, reinterpret_cast<const Vector4 *>(_data._mem)->z);
+		return Vector3i(_payload<Vector4>()->x, _payload<Vector4>()->y, _payload<Vector4>()->z);
 	} else if (type == VECTOR4I) {
-		return Vector3i(reinterpret_cast<const Vector4i *>(_data._mem)->x, reinterpret_cast<const Vector4i *>(_data._mem)->y, reinterpret_cast<const Vector4i *>(_data._mem)->z);
+		return Vector3i(_payload<Vector4i>()->x, _payload<Vector4i>()->y, _payload<Vector4i>()->z);
 	} else {
 		return Vector3i();
 	}
@@ -1971,17 +2008,17 @@ Variant::operator Vector3i() const {
 
 Variant::operator Vector4() const {
 	if (type == VECTOR4) {
-		return *reinterpret_cast<const Vector4 *>(_data._mem);
+		return *_payload<Vector4>();
 	} else if (type == VECTOR4I) {
-		return *reinterpret_cast<const Vector4i *>(_data._mem);
+		return *_payload<Vector4i>();
 	} else if (type == VECTOR2) {
 		return Vector4(reinterpret_cast<const Vector2 *>(_data._mem)->x, reinterpret_cast<const Vector2 *>(_data._mem)->y, 0.0, 0.0);
 	} else if (type == VECTOR2I) {
 		return Vector4(reinterpret_cast<const Vector2i *>(_data._mem)->x, reinterpret_cast<const Vector2i *>(_data._mem)->y, 0.0, 0.0);
 	} else if (type == VECTOR3) {
-		return Vector4(reinterpret_cast<const Vector3 *>(_data._mem)->x, reinterpret_cast<const Vector3 *>(_data._mem)->y, reinterpret_cast<const Vector3 *>(_data._mem)->z, 0.0);
+		return Vector4(_payload<Vector3>()->x, _payload<Vector3>()->y, _payload<Vector3>()->z, 0.0);
 	} else if (type == VECTOR3I) {
-		return Vector4(reinterpret_cast<const Vector3i *>(_data._mem)->x, reinterpret_cast<const Vector3i *>(_data._mem)->y, reinterpret_cast<const Vector3i *>(_data._mem)->z, 0.0);
+		return Vector4(_payload<Vector3i>()->x, _payload<Vector3i>()->y, _payload<Vector3i>()->z, 0.0);
 	} else {
 		return Vector4();
 	}
@@ -1989,18 +2026,18 @@ Variant::operator Vector4() const {
 
 Variant::operator Vector4i() const {
 	if (type == VECTOR4I) {
-		return *reinterpret_cast<const Vector4i *>(_data._mem);
+		return *_payload<Vector4i>();
 	} else if (type == VECTOR4) {
-		const Vector4 &v4 = *reinterpret_cast<const Vector4 *>(_data._mem);
+		const Vector4 &v4 = *_payload<Vector4>();
 		return Vector4i(v4.x, v4.y, v4.z, v4.w);
 	} else if (type == VECTOR2) {
 		return Vector4i(reinterpret_cast<const Vector2 *>(_data._mem)->x, reinterpret_cast<const Vector2 *>(_data._mem)->y, 0.0, 0.0);
 	} else if (type == VECTOR2I) {
 		return Vector4i(reinterpret_cast<const Vector2i *>(_data._mem)->x, reinterpret_cast<const Vector2i *>(_data._mem)->y, 0.0, 0.0);
 	} else if (type == VECTOR3) {
-		return Vector4i(reinterpret_cast<const Vector3 *>(_data._mem)->x, reinterpret_cast<const Vector3 *>(_data._mem)->y, reinterpret_cast<const Vector3 *>(_data._mem)->z, 0.0);
+		return Vector4i(_payload<Vector3>()->x, _payload<Vector3>()->y, _payload<Vector3>()->z, 0.0);
 	} else if (type == VECTOR3I) {
-		return Vector4i(reinterpret_cast<const Vector3i *>(_data._mem)->x, reinterpret_cast<const Vector3i *>(_data._mem)->y, reinterpret_cast<const Vector3i *>(_data._mem)->z, 0.0);
+		return Vector4i(_payload<Vector3i>()->x, _payload<Vector3i>()->y, _payload<Vector3i>()->z, 0.0);
 	} else {
 		return Vector4i();
 	}
@@ -2008,7 +2045,7 @@ Variant::operator Vector4i() const {
 
 Variant::operator Plane() const {
 	if (type == PLANE) {
-		return *reinterpret_cast<const Plane *>(_data._mem);
+		return *_payload<Plane>();
 	} else {
 		return Plane();
 	}
@@ -2026,7 +2063,7 @@ Variant::operator Basis() const {
 	if (type == BASIS) {
 		return *_data._basis;
 	} else if (type == QUATERNION) {
-		return *reinterpret_cast<const Quaternion *>(_data._mem);
+		return *_payload<Quaternion>();
 	} else if (type == TRANSFORM3D) { // unexposed in Variant::can_convert?
 		return _data._transform3d->basis;
 	} else {
@@ -2036,7 +2073,7 @@ Variant::operator Basis() const {
 
 Variant::operator Quaternion() const {
 	if (type == QUATERNION) {
-		return *reinterpret_cast<const Quaternion *>(_data._mem);
+		return *_payload<Quaternion>();
 	} else if (type == BASIS) {
 		return *_data._basis;
 	} else if (type == TRANSFORM3D) {
@@ -2052,7 +2089,7 @@ Variant::operator Transform3D() const {
 	} else if (type == BASIS) {
 		return Transform3D(*_data._basis, Vector3());
 	} else if (type == QUATERNION) {
-		return Transform3D(Basis(*reinterpret_cast<const Quaternion *>(_data._mem)), Vector3());
+		return Transform3D(Basis(*_payload<Quaternion>()), Vector3());
 	} else if (type == TRANSFORM2D) {
 		const Transform2D &t = *_data._transform2d;
 		Transform3D m;
@@ -2076,7 +2113,7 @@ Variant::operator Projection() const {
 	} else if (type == BASIS) {
 		return Transform3D(*_data._basis, Vector3());
 	} else if (type == QUATERNION) {
-		return Transform3D(Basis(*reinterpret_cast<const Quaternion *>(_data._mem)), Vector3());
+		return Transform3D(Basis(*_payload<Quaternion>()), Vector3());
 	} else if (type == TRANSFORM2D) {
 		const Transform2D &t = *_data._transform2d;
 		Transform3D m;
@@ -2114,7 +2151,7 @@ Variant::operator Transform2D() const {
 
 Variant::operator Color() const {
 	if (type == COLOR) {
-		return *reinterpret_cast<const Color *>(_data._mem);
+		return *_payload<Color>();
 	} else if (type == STRING) {
 		return Color(operator String());
 	} else if (type == INT) {
@@ -2193,7 +2230,7 @@ Variant::operator Dictionary() const {
 
 Variant::operator Callable() const {
 	if (type == CALLABLE) {
-		return *reinterpret_cast<const Callable *>(_data._mem);
+		return *_payload<Callable>();
 	} else {
 		return Callable();
 	}
@@ -2201,7 +2238,7 @@ Variant::operator Callable() const {
 
 Variant::operator Signal() const {
 	if (type == SIGNAL) {
-		return *reinterpret_cast<const Signal *>(_data._mem);
+		return *_payload<Signal>();
 	} else {
 		return Signal();
 	}
@@ -2527,22 +2564,22 @@ Variant::Variant(const char32_t *p_wstring) :
 
 Variant::Variant(const Vector3 &p_vector3) :
 		type(VECTOR3) {
-	memnew_placement(_data._mem, Vector3(p_vector3));
+	_payload_new<Vector3>(p_vector3);
 }
 
 Variant::Variant(const Vector3i &p_vector3i) :
 		type(VECTOR3I) {
-	memnew_placement(_data._mem, Vector3i(p_vector3i));
+	_payload_new<Vector3i>(p_vector3i);
 }
 
 Variant::Variant(const Vector4 &p_vector4) :
 		type(VECTOR4) {
-	memnew_placement(_data._mem, Vector4(p_vector4));
+	_payload_new<Vector4>(p_vector4);
 }
 
 Variant::Variant(const Vector4i &p_vector4i) :
 		type(VECTOR4I) {
-	memnew_placement(_data._mem, Vector4i(p_vector4i));
+	_payload_new<Vector4i>(p_vector4i);
 }
 
 Variant::Variant(const Vector2 &p_vector2) :
@@ -2557,17 +2594,17 @@ Variant::Variant(const Vector2i &p_vector2i) :
 
 Variant::Variant(const Rect2 &p_rect2) :
 		type(RECT2) {
-	memnew_placement(_data._mem, Rect2(p_rect2));
+	_payload_new<Rect2>(p_rect2);
 }
 
 Variant::Variant(const Rect2i &p_rect2i) :
 		type(RECT2I) {
-	memnew_placement(_data._mem, Rect2i(p_rect2i));
+	_payload_new<Rect2i>(p_rect2i);
 }
 
 Variant::Variant(const Plane &p_plane) :
 		type(PLANE) {
-	memnew_placement(_data._mem, Plane(p_plane));
+	_payload_new<Plane>(p_plane);
 }
 
 Variant::Variant(const ::AABB &p_aabb) :
@@ -2584,7 +2621,7 @@ Variant::Variant(const Basis &p_matrix) :
 
 Variant::Variant(const Quaternion &p_quaternion) :
 		type(QUATERNION) {
-	memnew_placement(_data._mem, Quaternion(p_quaternion));
+	_payload_new<Quaternion>(p_quaternion);
 }
 
 Variant::Variant(const Transform3D &p_transform) :
@@ -2607,7 +2644,7 @@ Variant::Variant(const Transform2D &p_transform) :
 
 Variant::Variant(const Color &p_color) :
 		type(COLOR) {
-	memnew_placement(_data._mem, Color(p_color));
+	_payload_new<Color>(p_color);
 }
 
 Variant::Variant(const NodePath &p_node_path) :
@@ -2622,18 +2659,18 @@ Variant::Variant(const ::RID &p_rid) :
 
 Variant::Variant(const Object *p_object) :
 		type(OBJECT) {
-	_get_obj() = ObjData();
+	_payload_new<ObjData>();
 	_get_obj().ref_pointer(const_cast<Object *>(p_object));
 }
 
 Variant::Variant(const Callable &p_callable) :
 		type(CALLABLE) {
-	memnew_placement(_data._mem, Callable(p_callable));
+	_payload_new<Callable>(p_callable);
 }
 
 Variant::Variant(const Signal &p_callable) :
 		type(SIGNAL) {
-	memnew_placement(_data._mem, Signal(p_callable));
+	_payload_new<Signal>(p_callable);
 }
 
 Variant::Variant(const Dictionary &p_dictionary) :
@@ -2797,35 +2834,35 @@ void Variant::operator=(const Variant &p_variant) {
 			*reinterpret_cast<Vector2i *>(_data._mem) = *reinterpret_cast<const Vector2i *>(p_variant._data._mem);
 		} break;
 		case RECT2: {
-			*reinterpret_cast<Rect2 *>(_data._mem) = *reinterpret_cast<const Rect2 *>(p_variant._data._mem);
+			*_payload<Rect2>() = *p_variant._payload<Rect2>();
 		} break;
 		case RECT2I: {
-			*reinterpret_cast<Rect2i *>(_data._mem) = *reinterpret_cast<const Rect2i *>(p_variant._data._mem);
+			*_payload<Rect2i>() = *p_variant._payload<Rect2i>();
 		} break;
 		case TRANSFORM2D: {
 			*_data._transform2d = *(p_variant._data._transform2d);
 		} break;
 		case VECTOR3: {
-			*reinterpret_cast<Vector3 *>(_data._mem) = *reinterpret_cast<const Vector3 *>(p_variant._data._mem);
+			*_payload<Vector3>() = *p_variant._payload<Vector3>();
 		} break;
 		case VECTOR3I: {
-			*reinterpret_cast<Vector3i *>(_data._mem) = *reinterpret_cast<const Vector3i *>(p_variant._data._mem);
+			*_payload<Vector3i>() = *p_variant._payload<Vector3i>();
 		} break;
 		case VECTOR4: {
-			*reinterpret_cast<Vector4 *>(_data._mem) = *reinterpret_cast<const Vector4 *>(p_variant._data._mem);
+			*_payload<Vector4>() = *p_variant._payload<Vector4>();
 		} break;
 		case VECTOR4I: {
-			*reinterpret_cast<Vector4i *>(_data._mem) = *reinterpret_cast<const Vector4i *>(p_variant._data._mem);
+			*_payload<Vector4i>() = *p_variant._payload<Vector4i>();
 		} break;
 		case PLANE: {
-			*reinterpret_cast<Plane *>(_data._mem) = *reinterpret_cast<const Plane *>(p_variant._data._mem);
+			*_payload<Plane>() = *p_variant._payload<Plane>();
 		} break;
 
 		case AABB: {
 			*_data._aabb = *(p_variant._data._aabb);
 		} break;
 		case QUATERNION: {
-			*reinterpret_cast<Quaternion *>(_data._mem) = *reinterpret_cast<const Quaternion *>(p_variant._data._mem);
+			*_payload<Quaternion>() = *p_variant._payload<Quaternion>();
 		} break;
 		case BASIS: {
 			*_data._basis = *(p_variant._data._basis);
@@ -2839,7 +2876,7 @@ void Variant::operator=(const Variant &p_variant) {
 
 		// misc types
 		case COLOR: {
-			*reinterpret_cast<Color *>(_data._mem) = *reinterpret_cast<const Color *>(p_variant._data._mem);
+			*_payload<Color>() = *p_variant._payload<Color>();
 		} break;
 		case RID: {
 			*reinterpret_cast<::RID *>(_data._mem) = *reinterpret_cast<const ::RID *>(p_variant._data._mem);
@@ -2848,10 +2885,10 @@ void Variant::operator=(const Variant &p_variant) {
 			_get_obj().ref(p_variant._get_obj());
 		} break;
 		case CALLABLE: {
-			*reinterpret_cast<Callable *>(_data._mem) = *reinterpret_cast<const Callable *>(p_variant._data._mem);
+			*_payload<Callable>() = *p_variant._payload<Callable>();
 		} break;
 		case SIGNAL: {
-			*reinterpret_cast<Signal *>(_data._mem) = *reinterpret_cast<const Signal *>(p_variant._data._mem);
+			*_payload<Signal>() = *p_variant._payload<Signal>();
 		} break;
 
 		case STRING_NAME: {
@@ -2943,10 +2980,10 @@ uint32_t Variant::recursive_hash(int recursion_count) const {
 			return HashMapHasherDefault::hash(*reinterpret_cast<const Vector2i *>(_data._mem));
 		} break;
 		case RECT2: {
-			return HashMapHasherDefault::hash(*reinterpret_cast<const Rect2 *>(_data._mem));
+			return HashMapHasherDefault::hash(*_payload<Rect2>());
 		} break;
 		case RECT2I: {
-			return HashMapHasherDefault::hash(*reinterpret_cast<const Rect2i *>(_data._mem));
+			return HashMapHasherDefault::hash(*_payload<Rect2i>());
 		} break;
 		case TRANSFORM2D: {
 			uint32_t h = HASH_MURMUR3_SEED;
@@ -2961,20 +2998,20 @@ uint32_t Variant::recursive_hash(int recursion_count) const {
 			return hash_fmix32(h);
 		} break;
 		case VECTOR3: {
-			return HashMapHasherDefault::hash(*reinterpret_cast<const Vector3 *>(_data._mem));
+			return HashMapHasherDefault::hash(*_payload<Vector3>());
 		} break;
 		case VECTOR3I: {
-			return HashMapHasherDefault::hash(*reinterpret_cast<const Vector3i *>(_data._mem));
+			return HashMapHasherDefault::hash(*_payload<Vector3i>());
 		} break;
 		case VECTOR4: {
-			return HashMapHasherDefault::hash(*reinterpret_cast<const Vector4 *>(_data._mem));
+			return HashMapHasherDefault::hash(*_payload<Vector4>());
 		} break;
 		case VECTOR4I: {
-			return HashMapHasherDefault::hash(*reinterpret_cast<const Vector4i *>(_data._mem));
+			return HashMapHasherDefault::hash(*_payload<Vector4i>());
 		} break;
 		case PLANE: {
 			uint32_t h = HASH_MURMUR3_SEED;
-			const Plane &p = *reinterpret_cast<const Plane *>(_data._mem);
+			const Plane &p = *_payload<Plane>();
 			h = hash_murmur3_one_real(p.normal.x, h);
 			h = hash_murmur3_one_real(p.normal.y, h);
 			h = hash_murmur3_one_real(p.normal.z, h);
@@ -2986,7 +3023,7 @@ uint32_t Variant::recursive_hash(int recursion_count) const {
 		} break;
 		case QUATERNION: {
 			uint32_t h = HASH_MURMUR3_SEED;
-			const Quaternion &q = *reinterpret_cast<const Quaternion *>(_data._mem);
+			const Quaternion &q = *_payload<Quaternion>();
 			h = hash_murmur3_one_real(q.x, h);
 			h = hash_murmur3_one_real(q.y, h);
 			h = hash_murmur3_one_real(q.z, h);
@@ -3048,7 +3085,7 @@ uint32_t Variant::recursive_hash(int recursion_count) const {
 		// misc types
 		case COLOR: {
 			uint32_t h = HASH_MURMUR3_SEED;
-			const Color &c = *reinterpret_cast<const Color *>(_data._mem);
+			const Color &c = *_payload<Color>();
 			h = hash_murmur3_one_float(c.r, h);
 			h = hash_murmur3_one_float(c.g, h);
 			h = hash_murmur3_one_float(c.b, h);
@@ -3072,11 +3109,11 @@ uint32_t Variant::recursive_hash(int recursion_count) const {
 
 		} break;
 		case CALLABLE: {
-			return reinterpret_cast<const Callable *>(_data._mem)->hash();
+			return _payload<Callable>()->hash();
 
 		} break;
 		case SIGNAL: {
-			const Signal &s = *reinterpret_cast<const Signal *>(_data._mem);
+			const Signal &s = *_payload<Signal>();
 			uint32_t hash = s.get_name().hash();
 			return hash_murmur3_one_64(s.get_object_id(), hash);
 		} break;
@@ -3331,15 +3368,15 @@ bool Variant::hash_compare(const Variant &p_variant, int recursion_count, bool s
 		} break;
 
 		case RECT2: {
-			const Rect2 *l = reinterpret_cast<const Rect2 *>(_data._mem);
-			const Rect2 *r = reinterpret_cast<const Rect2 *>(p_variant._data._mem);
+			const Rect2 *l = _payload<Rect2>();
+			const Rect2 *r = p_variant._payload<Rect2>();
 
 			return hash_compare_vector2(l->position, r->position) &&
 					hash_compare_vector2(l->size, r->size);
 		} break;
 		case RECT2I: {
-			const Rect2i *l = reinterpret_cast<const Rect2i *>(_data._mem);
-			const Rect2i *r = reinterpret_cast<const Rect2i *>(p_variant._data._mem);
+			const Rect2i *l = _payload<Rect2i>();
+			const Rect2i *r = p_variant._payload<Rect2i>();
 
 			return *l == *r;
 		} break;
@@ -3358,33 +3395,33 @@ bool Variant::hash_compare(const Variant &p_variant, int recursion_count, bool s
 		} break;
 
 		case VECTOR3: {
-			const Vector3 *l = reinterpret_cast<const Vector3 *>(_data._mem);
-			const Vector3 *r = reinterpret_cast<const Vector3 *>(p_variant._data._mem);
+			const Vector3 *l = _payload<Vector3>();
+			const Vector3 *r = p_variant._payload<Vector3>();
 
 			return hash_compare_vector3(*l, *r);
 		} break;
 		case VECTOR3I: {
-			const Vector3i *l = reinterpret_cast<const Vector3i *>(_data._mem);
-			const Vector3i *r = reinterpret_cast<const Vector3i *>(p_variant._data._mem);
+			const Vector3i *l = _payload<Vector3i>();
+			const Vector3i *r = p_variant._payload<Vector3i>();
 
 			return *l == *r;
 		} break;
 		case VECTOR4: {
-			const Vector4 *l = reinterpret_cast<const Vector4 *>(_data._mem);
-			const Vector4 *r = reinterpret_cast<const Vector4 *>(p_variant._data._mem);
+			const Vector4 *l = _payload<Vector4>();
+			const Vector4 *r = p_variant._payload<Vector4>();
 
 			return hash_compare_vector4(*l, *r);
 		} break;
 		case VECTOR4I: {
-			const Vector4i *l = reinterpret_cast<const Vector4i *>(_data._mem);
-			const Vector4i *r = reinterpret_cast<const Vector4i *>(p_variant._data._mem);
+			const Vector4i *l = _payload<Vector4i>();
+			const Vector4i *r = p_variant._payload<Vector4i>();
 
 			return *l == *r;
 		} break;
 
 		case PLANE: {
-			const Plane *l = reinterpret_cast<const Plane *>(_data._mem);
-			const Plane *r = reinterpret_cast<const Plane *>(p_variant._data._mem);
+			const Plane *l = _payload<Plane>();
+			const Plane *r = p_variant._payload<Plane>();
 
 			return hash_compare_vector3(l->normal, r->normal) &&
 					hash_compare_scalar(l->d, r->d);
@@ -3400,8 +3437,8 @@ bool Variant::hash_compare(const Variant &p_variant, int recursion_count, bool s
 		} break;
 
 		case QUATERNION: {
-			const Quaternion *l = reinterpret_cast<const Quaternion *>(_data._mem);
-			const Quaternion *r = reinterpret_cast<const Quaternion *>(p_variant._data._mem);
+			const Quaternion *l = _payload<Quaternion>();
+			const Quaternion *r = p_variant._payload<Quaternion>();
 
 			return hash_compare_quaternion(*l, *r);
 		} break;
@@ -3445,8 +3482,8 @@ bool Variant::hash_compare(const Variant &p_variant, int recursion_count, bool s
 		} break;
 
 		case COLOR: {
-			const Color *l = reinterpret_cast<const Color *>(_data._mem);
-			const Color *r = reinterpret_cast<const Color *>(p_variant._data._mem);
+			const Color *l = _payload<Color>();
+			const Color *r = p_variant._payload<Color>();
 
 			return hash_compare_color(*l, *r);
 		} break;
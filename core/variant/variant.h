@@ -31,6 +31,10 @@
 #ifndef VARIANT_H
 #define VARIANT_H
 
+#if defined(VARIANT_IS_COMPACT) && defined(REAL_T_IS_DOUBLE)
+#error "The compact Variant layout requires single-precision real_t."
+#endif
+
 #include "core/core_string_names.h"
 #include "core/input/input_enums.h"
 #include "core/io/ip_address.h"
@@ -165,6 +169,17 @@ private:
 		static PagedAllocator<BucketSmall, true> _bucket_small;
 		static PagedAllocator<BucketMedium, true> _bucket_medium;
 		static PagedAllocator<BucketLarge, true> _bucket_large;
+
+#ifdef VARIANT_IS_COMPACT
+		// Storage for the payloads that don't fit inline in a compact Variant,
+		// see `_payload()`. Sized for Rect2/Vector4/Plane/Quaternion/Color,
+		// Callable/Signal and ObjData.
+		struct BucketTiny {
+			alignas(8) uint8_t _mem[16];
+		};
+
+		static PagedAllocator<BucketTiny, true> _bucket_tiny;
+#endif
 	};
 
 	friend struct _VariantCall;
@@ -173,6 +188,9 @@ private:
 	// It only allocates extra memory for AABB/Transform2D (24, 48 if double),
 	// Basis/Transform3D (48, 96 if double), Projection (64, 128 if double),
 	// and PackedArray/Array/Dictionary (platform-dependent).
+	// With VARIANT_IS_COMPACT (`variant_compact=yes`), Variant takes 16 bytes
+	// and Vector3/3i/4/4i, Rect2/2i, Plane, Quaternion, Color, Object, Callable
+	// and Signal payloads are allocated as well.
 
 	Type type = NIL;
 
@@ -257,6 +275,17 @@ private:
 	_ALWAYS_INLINE_ ObjData &_get_obj();
 	_ALWAYS_INLINE_ const ObjData &_get_obj() const;
 
+#ifdef VARIANT_IS_COMPACT
+	static constexpr size_t INLINE_SIZE = sizeof(int64_t);
+#else
+	static constexpr size_t INLINE_SIZE = sizeof(ObjData) > (sizeof(real_t) * 4) ? sizeof(ObjData) : (sizeof(real_t) * 4);
+#endif
+
+	// Payloads larger than INLINE_SIZE are stored in `Pools::_bucket_tiny`
+	// and only the pointer is kept in `_data`.
+	template <typename T>
+	static constexpr bool _is_boxed = sizeof(T) > INLINE_SIZE;
+
 	union {
 		bool _bool;
 		int64_t _int;
@@ -268,9 +297,48 @@ private:
 		Projection *_projection;
 		PackedArrayRefBase *packed_array;
 		void *_ptr; //generic pointer
-		uint8_t _mem[sizeof(ObjData) > (sizeof(real_t) * 4) ? sizeof(ObjData) : (sizeof(real_t) * 4)]{ 0 };
+		uint8_t _mem[INLINE_SIZE]{ 0 };
 	} _data alignas(8);
 
+	template <typename T>
+	_ALWAYS_INLINE_ T *_payload() {
+		if constexpr (_is_boxed<T>) {
+			return static_cast<T *>(_data._ptr);
+		} else {
+			return reinterpret_cast<T *>(_data._mem);
+		}
+	}
+
+	template <typename T>
+	_ALWAYS_INLINE_ const T *_payload() const {
+		if constexpr (_is_boxed<T>) {
+			return static_cast<const T *>(_data._ptr);
+		} else {
+			return reinterpret_cast<const T *>(_data._mem);
+		}
+	}
+
+	template <typename T, typename... Args>
+	_ALWAYS_INLINE_ T *_payload_new(const Args &...p_args) {
+#ifdef VARIANT_IS_COMPACT
+		if constexpr (_is_boxed<T>) {
+			static_assert(sizeof(T) <= sizeof(Pools::BucketTiny));
+			_data._ptr = Pools::_bucket_tiny.alloc();
+		}
+#endif
+		return memnew_placement(_payload<T>(), T(p_args...));
+	}
+
+	template <typename T>
+	_ALWAYS_INLINE_ void _payload_delete() {
+		_payload<T>()->~T();
+#ifdef VARIANT_IS_COMPACT
+		if constexpr (_is_boxed<T>) {
+			Pools::_bucket_tiny.free(static_cast<Pools::BucketTiny *>(_data._ptr));
+		}
+#endif
+	}
+
 	void reference(const Variant &p_variant);
 
 	void _clear_internal();
@@ -284,22 +352,22 @@ private:
 			true, //STRING,
 			false, //VECTOR2,
 			false, //VECTOR2I,
-			false, //RECT2,
-			false, //RECT2I,
-			false, //VECTOR3,
-			false, //VECTOR3I,
+			_is_boxed<Rect2>, //RECT2,
+			_is_boxed<Rect2i>, //RECT2I,
+			_is_boxed<Vector3>, //VECTOR3,
+			_is_boxed<Vector3i>, //VECTOR3I,
 			true, //TRANSFORM2D,
-			false, //VECTOR4,
-			false, //VECTOR4I,
-			false, //PLANE,
-			false, //QUATERNION,
+			_is_boxed<Vector4>, //VECTOR4,
+			_is_boxed<Vector4i>, //VECTOR4I,
+			_is_boxed<Plane>, //PLANE,
+			_is_boxed<Quaternion>, //QUATERNION,
 			true, //AABB,
 			true, //BASIS,
 			true, //TRANSFORM,
 			true, //PROJECTION,
 
 			// misc types
-			false, //COLOR,
+			_is_boxed<Color>, //COLOR,
 			true, //STRING_NAME,
 			true, //NODE_PATH,
 			false, //RID,
@@ -855,11 +923,11 @@ struct StringLikeVariantComparator {
 };
 
 Variant::ObjData &Variant::_get_obj() {
-	return *reinterpret_cast<ObjData *>(&_data._mem[0]);
+	return *_payload<ObjData>();
 }
 
 const Variant::ObjData &Variant::_get_obj() const {
-	return *reinterpret_cast<const ObjData *>(&_data._mem[0]);
+	return *_payload<ObjData>();
 }
 
 template <typename... VarArgs>
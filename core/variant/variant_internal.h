@@ -120,6 +120,32 @@ public:
 			case Variant::OBJECT:
 				init_object(v);
 				break;
+#ifdef VARIANT_IS_COMPACT
+			case Variant::RECT2:
+				init_generic<Rect2>(v);
+				break;
+			case Variant::RECT2I:
+				init_generic<Rect2i>(v);
+				break;
+			case Variant::VECTOR3:
+				init_generic<Vector3>(v);
+				break;
+			case Variant::VECTOR3I:
+				init_generic<Vector3i>(v);
+				break;
+			case Variant::VECTOR4:
+				init_generic<Vector4>(v);
+				break;
+			case Variant::VECTOR4I:
+				init_generic<Vector4i>(v);
+				break;
+			case Variant::PLANE:
+				init_generic<Plane>(v);
+				break;
+			case Variant::QUATERNION:
+				init_generic<Quaternion>(v);
+				break;
+#endif
 			default:
 				break;
 		}
@@ -140,24 +166,24 @@ public:
 	_FORCE_INLINE_ static const Vector2 *get_vector2(const Variant *v) { return reinterpret_cast<const Vector2 *>(v->_data._mem); }
 	_FORCE_INLINE_ static Vector2i *get_vector2i(Variant *v) { return reinterpret_cast<Vector2i *>(v->_data._mem); }
 	_FORCE_INLINE_ static const Vector2i *get_vector2i(const Variant *v) { return reinterpret_cast<const Vector2i *>(v->_data._mem); }
-	_FORCE_INLINE_ static Rect2 *get_rect2(Variant *v) { return reinterpret_cast<Rect2 *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Rect2 *get_rect2(const Variant *v) { return reinterpret_cast<const Rect2 *>(v->_data._mem); }
-	_FORCE_INLINE_ static Rect2i *get_rect2i(Variant *v) { return reinterpret_cast<Rect2i *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Rect2i *get_rect2i(const Variant *v) { return reinterpret_cast<const Rect2i *>(v->_data._mem); }
-	_FORCE_INLINE_ static Vector3 *get_vector3(Variant *v) { return reinterpret_cast<Vector3 *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Vector3 *get_vector3(const Variant *v) { return reinterpret_cast<const Vector3 *>(v->_data._mem); }
-	_FORCE_INLINE_ static Vector3i *get_vector3i(Variant *v) { return reinterpret_cast<Vector3i *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Vector3i *get_vector3i(const Variant *v) { return reinterpret_cast<const Vector3i *>(v->_data._mem); }
-	_FORCE_INLINE_ static Vector4 *get_vector4(Variant *v) { return reinterpret_cast<Vector4 *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Vector4 *get_vector4(const Variant *v) { return reinterpret_cast<const Vector4 *>(v->_data._mem); }
-	_FORCE_INLINE_ static Vector4i *get_vector4i(Variant *v) { return reinterpret_cast<Vector4i *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Vector4i *get_vector4i(const Variant *v) { return reinterpret_cast<const Vector4i *>(v->_data._mem); }
+	_FORCE_INLINE_ static Rect2 *get_rect2(Variant *v) { return v->_payload<Rect2>(); }
+	_FORCE_INLINE_ static const Rect2 *get_rect2(const Variant *v) { return v->_payload<Rect2>(); }
+	_FORCE_INLINE_ static Rect2i *get_rect2i(Variant *v) { return v->_payload<Rect2i>(); }
+	_FORCE_INLINE_ static const Rect2i *get_rect2i(const Variant *v) { return v->_payload<Rect2i>(); }
+	_FORCE_INLINE_ static Vector3 *get_vector3(Variant *v) { return v->_payload<Vector3>(); }
+	_FORCE_INLINE_ static const Vector3 *get_vector3(const Variant *v) { return v->_payload<Vector3>(); }
+	_FORCE_INLINE_ static Vector3i *get_vector3i(Variant *v) { return v->_payload<Vector3i>(); }
+	_FORCE_INLINE_ static const Vector3i *get_vector3i(const Variant *v) { return v->_payload<Vector3i>(); }
+	_FORCE_INLINE_ static Vector4 *get_vector4(Variant *v) { return v->_payload<Vector4>(); }
+	_FORCE_INLINE_ static const Vector4 *get_vector4(const Variant *v) { return v->_payload<Vector4>(); }
+	_FORCE_INLINE_ static Vector4i *get_vector4i(Variant *v) { return v->_payload<Vector4i>(); }
+	_FORCE_INLINE_ static const Vector4i *get_vector4i(const Variant *v) { return v->_payload<Vector4i>(); }
 	_FORCE_INLINE_ static Transform2D *get_transform2d(Variant *v) { return v->_data._transform2d; }
 	_FORCE_INLINE_ static const Transform2D *get_transform2d(const Variant *v) { return v->_data._transform2d; }
-	_FORCE_INLINE_ static Plane *get_plane(Variant *v) { return reinterpret_cast<Plane *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Plane *get_plane(const Variant *v) { return reinterpret_cast<const Plane *>(v->_data._mem); }
-	_FORCE_INLINE_ static Quaternion *get_quaternion(Variant *v) { return reinterpret_cast<Quaternion *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Quaternion *get_quaternion(const Variant *v) { return reinterpret_cast<const Quaternion *>(v->_data._mem); }
+	_FORCE_INLINE_ static Plane *get_plane(Variant *v) { return v->_payload<Plane>(); }
+	_FORCE_INLINE_ static const Plane *get_plane(const Variant *v) { return v->_payload<Plane>(); }
+	_FORCE_INLINE_ static Quaternion *get_quaternion(Variant *v) { return v->_payload<Quaternion>(); }
+	_FORCE_INLINE_ static const Quaternion *get_quaternion(const Variant *v) { return v->_payload<Quaternion>(); }
 	_FORCE_INLINE_ static ::AABB *get_aabb(Variant *v) { return v->_data._aabb; }
 	_FORCE_INLINE_ static const ::AABB *get_aabb(const Variant *v) { return v->_data._aabb; }
 	_FORCE_INLINE_ static Basis *get_basis(Variant *v) { return v->_data._basis; }
@@ -168,18 +194,18 @@ public:
 	_FORCE_INLINE_ static const Projection *get_projection(const Variant *v) { return v->_data._projection; }
 
 	// Misc types.
-	_FORCE_INLINE_ static Color *get_color(Variant *v) { return reinterpret_cast<Color *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Color *get_color(const Variant *v) { return reinterpret_cast<const Color *>(v->_data._mem); }
+	_FORCE_INLINE_ static Color *get_color(Variant *v) { return v->_payload<Color>(); }
+	_FORCE_INLINE_ static const Color *get_color(const Variant *v) { return v->_payload<Color>(); }
 	_FORCE_INLINE_ static StringName *get_string_name(Variant *v) { return reinterpret_cast<StringName *>(v->_data._mem); }
 	_FORCE_INLINE_ static const StringName *get_string_name(const Variant *v) { return reinterpret_cast<const StringName *>(v->_data._mem); }
 	_FORCE_INLINE_ static NodePath *get_node_path(Variant *v) { return reinterpret_cast<NodePath *>(v->_data._mem); }
 	_FORCE_INLINE_ static const NodePath *get_node_path(const Variant *v) { return reinterpret_cast<const NodePath *>(v->_data._mem); }
 	_FORCE_INLINE_ static ::RID *get_rid(Variant *v) { return reinterpret_cast<::RID *>(v->_data._mem); }
 	_FORCE_INLINE_ static const ::RID *get_rid(const Variant *v) { return reinterpret_cast<const ::RID *>(v->_data._mem); }
-	_FORCE_INLINE_ static Callable *get_callable(Variant *v) { return reinterpret_cast<Callable *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Callable *get_callable(const Variant *v) { return reinterpret_cast<const Callable *>(v->_data._mem); }
-	_FORCE_INLINE_ static Signal *get_signal(Variant *v) { return reinterpret_cast<Signal *>(v->_data._mem); }
-	_FORCE_INLINE_ static const Signal *get_signal(const Variant *v) { return reinterpret_cast<const Signal *>(v->_data._mem); }
+	_FORCE_INLINE_ static Callable *get_callable(Variant *v) { return v->_payload<Callable>(); }
+	_FORCE_INLINE_ static const Callable *get_callable(const Variant *v) { return v->_payload<Callable>(); }
+	_FORCE_INLINE_ static Signal *get_signal(Variant *v) { return v->_payload<Signal>(); }
+	_FORCE_INLINE_ static const Signal *get_signal(const Variant *v) { return v->_payload<Signal>(); }
 	_FORCE_INLINE_ static Dictionary *get_dictionary(Variant *v) { return reinterpret_cast<Dictionary *>(v->_data._mem); }
 	_FORCE_INLINE_ static const Dictionary *get_dictionary(const Variant *v) { return reinterpret_cast<const Dictionary *>(v->_data._mem); }
 	_FORCE_INLINE_ static Array *get_array(Variant *v) { return reinterpret_cast<Array *>(v->_data._mem); }
@@ -214,12 +240,16 @@ public:
 
 	template <typename T>
 	_FORCE_INLINE_ static void init_generic(Variant *v) {
+		if constexpr (Variant::_is_boxed<T>) {
+			v->_payload_new<T>();
+		}
 		v->type = GetTypeInfo<T>::VARIANT_TYPE;
 	}
 
 	// Should be in the same order as Variant::Type for consistency.
 	// Those primitive and vector types don't need an `init_` method:
 	// Nil, bool, float, Vector2/i, Rect2/i, Vector3/i, Plane, Quat, RID.
+	// (In compact builds the larger ones are boxed by `init_generic`.)
 	// Object is a special case, handled via `object_reset_data`.
 	_FORCE_INLINE_ static void init_string(Variant *v) {
 		memnew_placement(v->_data._mem, String);
@@ -251,7 +281,7 @@ public:
 		v->type = Variant::PROJECTION;
 	}
 	_FORCE_INLINE_ static void init_color(Variant *v) {
-		memnew_placement(v->_data._mem, Color);
+		v->_payload_new<Color>();
 		v->type = Variant::COLOR;
 	}
 	_FORCE_INLINE_ static void init_string_name(Variant *v) {
@@ -263,11 +293,11 @@ public:
 		v->type = Variant::NODE_PATH;
 	}
 	_FORCE_INLINE_ static void init_callable(Variant *v) {
-		memnew_placement(v->_data._mem, Callable);
+		v->_payload_new<Callable>();
 		v->type = Variant::CALLABLE;
 	}
 	_FORCE_INLINE_ static void init_signal(Variant *v) {
-		memnew_placement(v->_data._mem, Signal);
+		v->_payload_new<Signal>();
 		v->type = Variant::SIGNAL;
 	}
 	_FORCE_INLINE_ static void init_dictionary(Variant *v) {
@@ -319,7 +349,7 @@ public:
 		v->type = Variant::PACKED_VECTOR4_ARRAY;
 	}
 	_FORCE_INLINE_ static void init_object(Variant *v) {
-		object_reset_data(v);
+		v->_payload_new<Variant::ObjData>();
 		v->type = Variant::OBJECT;
 	}
 
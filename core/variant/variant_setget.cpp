@@ -1306,9 +1306,9 @@ bool Variant::iter_init(Variant &r_iter, bool &valid) const {
 			return from < to;
 		} break;
 		case VECTOR3: {
-			double from = reinterpret_cast<const Vector3 *>(_data._mem)->x;
-			double to = reinterpret_cast<const Vector3 *>(_data._mem)->y;
-			double step = reinterpret_cast<const Vector3 *>(_data._mem)->z;
+			double from = _payload<Vector3>()->x;
+			double to = _payload<Vector3>()->y;
+			double step = _payload<Vector3>()->z;
 
 			r_iter = from;
 
@@ -1320,9 +1320,9 @@ bool Variant::iter_init(Variant &r_iter, bool &valid) const {
 			return step < 0;
 		} break;
 		case VECTOR3I: {
-			int64_t from = reinterpret_cast<const Vector3i *>(_data._mem)->x;
-			int64_t to = reinterpret_cast<const Vector3i *>(_data._mem)->y;
-			int64_t step = reinterpret_cast<const Vector3i *>(_data._mem)->z;
+			int64_t from = _payload<Vector3i>()->x;
+			int64_t to = _payload<Vector3i>()->y;
+			int64_t step = _payload<Vector3i>()->z;
 
 			r_iter = from;
 
@@ -1533,8 +1533,8 @@ bool Variant::iter_next(Variant &r_iter, bool &valid) const {
 			return true;
 		} break;
 		case VECTOR3: {
-			double to = reinterpret_cast<const Vector3 *>(_data._mem)->y;
-			double step = reinterpret_cast<const Vector3 *>(_data._mem)->z;
+			double to = _payload<Vector3>()->y;
+			double step = _payload<Vector3>()->z;
 
 			double idx = r_iter;
 			idx += step;
@@ -1551,8 +1551,8 @@ bool Variant::iter_next(Variant &r_iter, bool &valid) const {
 			return true;
 		} break;
 		case VECTOR3I: {
-			int64_t to = reinterpret_cast<const Vector3i *>(_data._mem)->y;
-			int64_t step = reinterpret_cast<const Vector3i *>(_data._mem)->z;
+			int64_t to = _payload<Vector3i>()->y;
+			int64_t step = _payload<Vector3i>()->z;
 
 			int64_t idx = r_iter;
 			idx += step;
@@ -1140,42 +1140,28 @@ Variant VariantUtilityFunctions::str_to_var(const String &p_var) {
 }
 
 PackedByteArray VariantUtilityFunctions::var_to_bytes(const Variant &p_var) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, false);
+	LocalVector<uint8_t> buffer;
+	Error err = encode_variant(p_var, buffer, false);
 	if (err != OK) {
 		return PackedByteArray();
 	}
 
 	PackedByteArray barr;
-	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, false);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
-
+	barr.resize(buffer.size());
+	memcpy(barr.ptrw(), buffer.ptr(), buffer.size());
 	return barr;
 }
 
 PackedByteArray VariantUtilityFunctions::var_to_bytes_with_objects(const Variant &p_var) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, true);
+	LocalVector<uint8_t> buffer;
+	Error err = encode_variant(p_var, buffer, true);
 	if (err != OK) {
 		return PackedByteArray();
 	}
 
 	PackedByteArray barr;
-	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, true);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
-
+	barr.resize(buffer.size());
+	memcpy(barr.ptrw(), buffer.ptr(), buffer.size());
 	return barr;
 }
 
@@ -49,12 +49,18 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	// Set when opened through open_mapped(), reads are served from the mapping.
+	uint8_t *mapped = nullptr;
+	uint64_t mapped_size = 0;
+	mutable uint64_t mapped_pos = 0;
+
 	void _close();
 
 public:
 	static CloseNotificationFunc close_notification_func;
 
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
+	virtual Error open_mapped_internal(const String &p_path) override;
 	virtual bool is_open() const override; ///< true when file is open
 
 	virtual String get_path() const override; /// returns the path for the current open file
@@ -68,6 +74,7 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_data() const override { return mapped; }
 
 	virtual Error get_error() const override; ///< get last error
 
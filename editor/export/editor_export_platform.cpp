@@ -34,7 +34,7 @@
 #include "core/crypto/crypto_core.h"
 #include "core/extension/gdextension.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION, FileAccessPack::compress_blocks
 #include "core/io/zip_io.h"
 #include "core/version.h"
 #include "editor/editor_file_system.h"
@@ -243,7 +243,16 @@ Error EditorExportPlatform::_save_pack_file(void *p_userdata, const String &p_pa
 	}
 
 	// Store file content.
-	ftmp->store_buffer(p_data.ptr(), p_data.size());
+	Vector<uint8_t> compressed;
+	if (pd->compress) {
+		compressed = FileAccessPack::compress_blocks(p_data.ptr(), p_data.size());
+	}
+	if (!compressed.is_empty()) {
+		sd.compressed = true;
+		ftmp->store_buffer(compressed.ptr(), compressed.size());
+	} else {
+		ftmp->store_buffer(p_data.ptr(), p_data.size());
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -1724,6 +1733,7 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	PackData pd;
 	pd.ep = &ep;
 	pd.f = ftmp;
+	pd.compress = GLOBAL_GET("editor/export/compress_pack_files");
 	pd.so_files = p_so_files;
 
 	Error err = export_project_files(p_preset, p_debug, p_save_func, &pd, _pack_add_shared_object);
@@ -1781,8 +1791,13 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 
 	int64_t pck_start_pos = f->get_position();
 
+	bool has_compressed = false;
+	for (int i = 0; i < pd.file_ofs.size(); i++) {
+		has_compressed = has_compressed || pd.file_ofs[i].compressed;
+	}
+
 	f->store_32(PACK_HEADER_MAGIC);
-	f->store_32(PACK_FORMAT_VERSION);
+	f->store_32(has_compressed ? PACK_FORMAT_VERSION_COMPRESSED : PACK_FORMAT_VERSION);
 	f->store_32(VERSION_MAJOR);
 	f->store_32(VERSION_MINOR);
 	f->store_32(VERSION_PATCH);
@@ -1872,6 +1887,9 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 		if (pd.file_ofs[i].encrypted) {
 			flags |= PACK_FILE_ENCRYPTED;
 		}
+		if (pd.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 	}
 
@@ -34,6 +34,7 @@
 #include "core/core_globals.h"
 #include "core/crypto/crypto.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/timeline_profiler.h"
 #include "core/extension/extension_api_dump.h"
 #include "core/extension/gdextension_interface_dump.gen.h"
 #include "core/extension/gdextension_manager.h"
@@ -46,6 +47,7 @@
 #include "core/io/ip.h"
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
 #include "core/register_core_types.h"
@@ -128,6 +130,7 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_sampling_profiler.h"
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -650,6 +653,10 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
+	print_help_option("--profile-timeline <path>", "Record engine profiling zones from all threads and save them to a given file in Chrome/Perfetto trace JSON format on exit.\n");
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+	print_help_option("--gdscript-sampling-profile <path>", "Periodically sample the GDScript call stacks of all threads and save them to a given file in collapsed stack format (for flame graphs) on exit.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
+#endif
 #ifdef TOOLS_ENABLED
 	print_help_option("--editor-pseudolocalization", "Enable pseudolocalization for the editor and the project manager.\n");
 #endif
@@ -1718,6 +1725,24 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			}
 		} else if (arg == "--disable-vsync") {
 			disable_vsync = true;
+		} else if (arg == "--profile-timeline") {
+			if (N) {
+				TimelineProfiler::start(N->get());
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --profile-timeline <path>.\n");
+				goto error;
+			}
+#if defined(DEBUG_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED)
+		} else if (arg == "--gdscript-sampling-profile") {
+			if (N) {
+				GDScriptSamplingProfiler::start(N->get());
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <path> argument for --gdscript-sampling-profile <path>.\n");
+				goto error;
+			}
+#endif
 		} else if (arg == "--print-fps") {
 			print_fps = true;
 #ifdef TOOLS_ENABLED
@@ -2679,6 +2704,7 @@ error:
 	}
 
 	unregister_core_types();
+	TimelineProfiler::cleanup();
 
 	OS::get_singleton()->_cmdline.clear();
 	OS::get_singleton()->_user_args.clear();
@@ -4283,6 +4309,7 @@ static uint64_t navigation_process_max = 0;
 // will terminate the program. In case of failure, the OS exit code needs
 // to be set explicitly here (defaults to EXIT_SUCCESS).
 bool Main::iteration() {
+	TIMELINE_ZONE("Main::iteration");
 	iterating++;
 
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
@@ -4329,6 +4356,8 @@ bool Main::iteration() {
 	NavigationServer3D::get_singleton()->sync();
 
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
+		TIMELINE_ZONE("Main::iteration physics step");
+
 		if (Input::get_singleton()->is_agile_input_event_flushing()) {
 			Input::get_singleton()->flush_buffered_events();
 		}
@@ -4461,6 +4490,11 @@ bool Main::iteration() {
 
 	iterating--;
 
+	// Frame scratch memory is only valid until the end of the outermost iteration.
+	if (iterating == 0) {
+		FrameArena::reset();
+	}
+
 	if (movie_writer) {
 		movie_writer->add_frame();
 	}
@@ -4529,6 +4563,8 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+	TimelineProfiler::finish();
+
 #ifdef DEBUG_ENABLED
 	if (input) {
 		input->flush_frame_parsed_events();
@@ -4685,6 +4721,9 @@ void Main::cleanup(bool p_force) {
 
 	unregister_core_types();
 
+	// Worker threads are gone at this point.
+	TimelineProfiler::cleanup();
+
 	OS::get_singleton()->benchmark_end_measure("Shutdown", "Main::Cleanup");
 	OS::get_singleton()->benchmark_dump();
 
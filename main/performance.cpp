@@ -30,6 +30,7 @@
 
 #include "performance.h"
 
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
@@ -97,6 +98,8 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_SURFACE);
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_DRAW);
 	BIND_ENUM_CONSTANT(PIPELINE_COMPILATIONS_SPECIALIZATION);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_MAX);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_RESERVED);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -109,6 +112,33 @@ int Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+#ifdef MEMORY_TAGS_ENABLED
+uint64_t Performance::_get_memory_tag_usage(int p_tag) const {
+	return Memory::get_tag_mem_usage(Memory::Tag(p_tag));
+}
+
+uint64_t Performance::_get_memory_tag_max_usage(int p_tag) const {
+	return Memory::get_tag_mem_max_usage(Memory::Tag(p_tag));
+}
+
+uint64_t Performance::_get_memory_tag_alloc_count(int p_tag) const {
+	return Memory::get_tag_alloc_count(Memory::Tag(p_tag));
+}
+
+void Performance::_add_memory_tag_monitors() {
+	// Exposed as custom monitors so they show up in the editor and remote debugger
+	// without growing the Monitor enum for an optional build feature.
+	for (int i = 0; i < Memory::TAG_MAX; i++) {
+		Vector<Variant> args;
+		args.push_back(i);
+		const String name = Memory::get_tag_name(Memory::Tag(i));
+		add_custom_monitor("memory_tags/" + name, callable_mp(this, &Performance::_get_memory_tag_usage), args);
+		add_custom_monitor("memory_tags/" + name + "_max", callable_mp(this, &Performance::_get_memory_tag_max_usage), args);
+		add_custom_monitor("memory_tags/" + name + "_count", callable_mp(this, &Performance::_get_memory_tag_alloc_count), args);
+	}
+}
+#endif
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
@@ -153,6 +183,8 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("pipeline/compilations_surface"),
 		PNAME("pipeline/compilations_draw"),
 		PNAME("pipeline/compilations_specialization"),
+		PNAME("memory/frame_arena_max"),
+		PNAME("memory/frame_arena_reserved"),
 	};
 
 	return names[p_monitor];
@@ -204,6 +236,10 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_PIPELINE_COMPILATIONS_DRAW);
 		case PIPELINE_COMPILATIONS_SPECIALIZATION:
 			return RS::get_singleton()->get_rendering_info(RS::RENDERING_INFO_PIPELINE_COMPILATIONS_SPECIALIZATION);
+		case MEMORY_FRAME_ARENA_MAX:
+			return FrameArena::get_max_usage();
+		case MEMORY_FRAME_ARENA_RESERVED:
+			return FrameArena::get_reserved();
 		case PHYSICS_2D_ACTIVE_OBJECTS:
 			return PhysicsServer2D::get_singleton()->get_process_info(PhysicsServer2D::INFO_ACTIVE_OBJECTS);
 		case PHYSICS_2D_COLLISION_PAIRS:
@@ -296,7 +332,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
-
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 	};
 
 	return types[p_monitor];
@@ -363,6 +405,16 @@ Performance::Performance() {
 	_navigation_process_time = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
+
+#ifdef MEMORY_TAGS_ENABLED
+	_add_memory_tag_monitors();
+#endif
+}
+
+Performance::~Performance() {
+	if (singleton == this) {
+		singleton = nullptr;
+	}
 }
 
 Performance::MonitorCall::MonitorCall(Callable p_callable, Vector<Variant> p_arguments) {
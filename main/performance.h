@@ -47,6 +47,12 @@ class Performance : public Object {
 	static void _bind_methods();
 
 	int _get_node_count() const;
+#ifdef MEMORY_TAGS_ENABLED
+	uint64_t _get_memory_tag_usage(int p_tag) const;
+	uint64_t _get_memory_tag_max_usage(int p_tag) const;
+	uint64_t _get_memory_tag_alloc_count(int p_tag) const;
+	void _add_memory_tag_monitors();
+#endif
 
 	double _process_time;
 	double _physics_process_time;
@@ -106,6 +112,8 @@ public:
 		PIPELINE_COMPILATIONS_SURFACE,
 		PIPELINE_COMPILATIONS_DRAW,
 		PIPELINE_COMPILATIONS_SPECIALIZATION,
+		MEMORY_FRAME_ARENA_MAX,
+		MEMORY_FRAME_ARENA_RESERVED,
 		MONITOR_MAX
 	};
 
@@ -135,6 +143,7 @@ public:
 	static Performance *get_singleton() { return singleton; }
 
 	Performance();
+	~Performance();
 };
 
 VARIANT_ENUM_CAST(Performance::Monitor);
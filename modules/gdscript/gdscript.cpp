@@ -31,10 +31,13 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_inline_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -801,6 +804,21 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+	GDScriptInlineCache::invalidate_all();
+
+	if (!bytecode_cache.is_empty()) {
+		// Set up by `GDScriptCache` when the exported project has precompiled bytecode for this script.
+		const Vector<uint8_t> payload = bytecode_cache;
+		bytecode_cache.clear();
+		if (GDScriptBytecodeCache::load_script(this, payload) == OK) {
+			GDScriptInlineCache::invalidate_all();
+			can_run = ScriptServer::is_scripting_enabled() || is_tool();
+			reloading = false;
+			return can_run ? _static_init() : OK;
+		}
+		print_verbose(vformat(R"(GDScript: Bytecode cache of "%s" is out of date, compiling.)", path));
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -839,6 +857,8 @@ Error GDScript::reload(bool p_keep_state) {
 
 	GDScriptCompiler compiler;
 	err = compiler.compile(&parser, this, p_keep_state);
+	// Members and functions moved around, drop whatever the VM resolved against the old layout.
+	GDScriptInlineCache::invalidate_all();
 
 	if (err) {
 		_err_print_error("GDScript::reload", path.is_empty() ? "built-in" : (const char *)path.utf8().get_data(), compiler.get_error_line(), ("Compile Error: " + compiler.get_error()).utf8().get_data(), false, ERR_HANDLER_SCRIPT);
@@ -1127,6 +1147,7 @@ Error GDScript::load_source_code(const String &p_path) {
 
 void GDScript::set_binary_tokens_source(const Vector<uint8_t> &p_binary_tokens) {
 	binary_tokens = p_binary_tokens;
+	bytecode_cache.clear();
 }
 
 const Vector<uint8_t> &GDScript::get_binary_tokens_source() const {
@@ -1439,7 +1460,7 @@ void GDScript::_save_orphaned_subclasses(ClearData *p_clear_data) {
 	constants.clear();
 
 	// keep orphan subclass only for subclasses that are still in use
-	for (int i = 0; i < weak_subclasses.size(); i++) {
+	for (int i = 0; i < weak_subclasses.size() && !detached; i++) {
 		ClassRefWithName subclass = weak_subclasses[i];
 		Object *obj = ObjectDB::get_instance(subclass.id);
 		if (!obj) {
@@ -1526,6 +1547,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptInlineCache::invalidate_all();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
@@ -1550,6 +1572,9 @@ void GDScript::clear(ClearData *p_clear_data) {
 	if (!GDScriptLanguage::singleton->finishing) {
 		RBSet<GDScript *> must_clear_dependencies = get_must_clear_dependencies();
 		for (GDScript *E : must_clear_dependencies) {
+			if (detached && E->get_root_script() != get_root_script()) {
+				continue;
+			}
 			clear_data->scripts.insert(E);
 			E->clear(clear_data);
 		}
@@ -1604,7 +1629,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		}
 		for (Ref<Script> &E : clear_data->scripts) {
 			Ref<GDScript> gdscr = E;
-			if (gdscr.is_valid()) {
+			if (gdscr.is_valid() && !detached) {
 				GDScriptCache::remove_script(gdscr->get_path());
 			}
 		}
@@ -2268,6 +2293,10 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler::bind_debugger();
+#endif
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2309,6 +2338,12 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+#ifdef DEBUG_ENABLED
+	// Saves the profile requested with `--gdscript-sampling-profile`, if any.
+	GDScriptSamplingProfiler::stop();
+	GDScriptSamplingProfiler::unbind_debugger();
+#endif
+
 	_call_stack.free();
 
 	// Clear the cache before parsing the script_list
@@ -2344,6 +2379,11 @@ void GDScriptLanguage::finish() {
 	}
 	script_list.clear();
 	function_list.clear();
+	GDScriptFunctionState::clear_stack_pool();
+
+#ifdef DEBUG_ENABLED
+	GDScriptSamplingProfiler::cleanup();
+#endif
 
 	finishing = false;
 }
@@ -2694,6 +2734,8 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 void GDScriptLanguage::frame() {
 	calls = 0;
 
+	GDScriptCache::evict_unused_prefetched_parsers();
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(mutex);
@@ -2939,6 +2981,8 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+	_optimize_bytecode = GLOBAL_DEF("debug/settings/gdscript/optimize_bytecode", true);
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
@@ -3045,7 +3089,14 @@ void ResourceFormatLoaderGDScript::get_dependencies(const String &p_path, List<S
 	}
 
 	for (const String &E : parser.get_dependencies()) {
-		p_dependencies->push_back(E);
+		String dep = E;
+		if (p_add_types) {
+			const String type = ResourceLoader::get_resource_type(E);
+			if (!type.is_empty()) {
+				dep += "::" + type;
+			}
+		}
+		p_dependencies->push_back(dep);
 	}
 }
 
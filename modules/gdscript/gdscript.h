@@ -83,7 +83,9 @@ class GDScript : public Script {
 
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
+	friend class GDScriptInlineCache;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
 	friend class GDScriptLambdaCallable;
@@ -175,9 +177,11 @@ private:
 	RBSet<Object *> instances;
 	bool destructing = false;
 	bool clearing = false;
+	bool detached = false; // Compiled apart from `GDScriptCache`, so the scripts it depends on aren't its to clear.
 	//exported members
 	String source;
 	Vector<uint8_t> binary_tokens;
+	Vector<uint8_t> bytecode_cache; // Precompiled classes for the next reload, see `GDScriptBytecodeCache`.
 	String path;
 	bool path_valid = false; // False if using default path.
 	StringName local_name; // Inner class identifier or `class_name`.
@@ -349,6 +353,7 @@ public:
 class GDScriptInstance : public ScriptInstance {
 	friend class GDScript;
 	friend class GDScriptFunction;
+	friend class GDScriptInlineCache;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptCompiler;
@@ -447,6 +452,7 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	static thread_local CallStack _call_stack;
 	int _debug_max_call_stack = 0;
+	bool _optimize_bytecode = true;
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
 	void _remove_global(const StringName &p_name);
@@ -555,6 +561,9 @@ public:
 
 	_FORCE_INLINE_ static GDScriptLanguage *get_singleton() { return singleton; }
 
+	_FORCE_INLINE_ bool is_bytecode_optimization_enabled() const { return _optimize_bytecode; }
+	void set_bytecode_optimization_enabled(bool p_enabled) { _optimize_bytecode = p_enabled; }
+
 	virtual String get_name() const override;
 
 	/* LANGUAGE FUNCTIONS */
@@ -31,9 +31,33 @@
 #include "gdscript_byte_codegen.h"
 
 #include "gdscript.h"
+#include "gdscript_inline_cache.h"
 
 #include "core/debugger/engine_debugger.h"
 
+// Types whose validated operators compute the whole result before storing it, so the result may alias an operand.
+static bool _is_value_type(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::RECT2I:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::VECTOR4:
+		case Variant::VECTOR4I:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::COLOR:
+			return true;
+		default:
+			return false;
+	}
+}
+
 uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) {
 	function->_argument_count++;
 	function->argument_types.push_back(p_type);
@@ -137,6 +161,11 @@ uint32_t GDScriptByteCodeGenerator::add_temporary(const GDScriptDataType &p_type
 void GDScriptByteCodeGenerator::pop_temporary() {
 	ERR_FAIL_COND(used_temporaries.is_empty());
 	int slot_idx = used_temporaries.back()->get();
+	if (pending_forward_assign >= 0 && slot_idx == pending_forward_temporary && pending_forward_assign + 3 == opcodes.size()) {
+		// The temporary dies right after being assigned, so the operator may write into the local instead.
+		forwardable_operators.push_back(pending_forward_operator);
+	}
+	pending_forward_assign = -1;
 	if (temporaries[slot_idx].can_contain_object) {
 		// Avoid keeping in the stack long-lived references to objects,
 		// which may prevent `RefCounted` objects from being freed.
@@ -150,7 +179,7 @@ void GDScriptByteCodeGenerator::pop_temporary() {
 
 void GDScriptByteCodeGenerator::start_parameters() {
 	if (function->_default_arg_count > 0) {
-		append(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
+		append_opcode(GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT);
 		function->default_arguments.push_back(opcodes.size());
 	}
 }
@@ -162,6 +191,7 @@ void GDScriptByteCodeGenerator::end_parameters() {
 void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName &p_function_name, bool p_static, Variant p_rpc_config, const GDScriptDataType &p_return_type) {
 	function = memnew(GDScriptFunction);
 	debug_stack = EngineDebugger::is_active();
+	optimize = GDScriptLanguage::get_singleton()->is_bytecode_optimization_enabled();
 
 	function->name = p_function_name;
 	function->_script = p_script;
@@ -178,6 +208,272 @@ void GDScriptByteCodeGenerator::write_start(GDScript *p_script, const StringName
 	function->_argument_count = 0;
 }
 
+// Returns the size of an operator instruction writing its result at offset 3, or zero for any other instruction.
+static int _get_operator_size(int p_opcode) {
+	if (p_opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+		return 5;
+	}
+	if (p_opcode >= GDScriptFunction::OPCODE_OPERATOR_INT_ADD && p_opcode <= GDScriptFunction::OPCODE_OPERATOR_VECTOR3_MULTIPLY_FLOAT) {
+		return 4;
+	}
+	return 0;
+}
+
+// Returns the offset of the operand holding a code address, or zero if the instruction doesn't jump.
+static int _get_jump_operand(int p_opcode) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_JUMP:
+			return 1;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+			return 2;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			return 5;
+		default:
+			if (p_opcode >= GDScriptFunction::OPCODE_ITERATE_BEGIN && p_opcode <= GDScriptFunction::OPCODE_ITERATE_OBJECT) {
+				return 4;
+			}
+			if (p_opcode >= GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_EQUAL && p_opcode <= GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL) {
+				return 4;
+			}
+			return 0;
+	}
+}
+
+// Returns the offset of the address an instruction writes without reading anything else it could observe, or zero.
+static int _get_pure_store(const int *p_code, int p_start) {
+	switch (p_code[p_start]) {
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+			return 1;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			// Default construction, with the target as the only instruction argument.
+			return (p_code[p_start + 1] == 1 && p_code[p_start + 3] == 0) ? 2 : 0;
+		default:
+			return 0;
+	}
+}
+
+// Returns whether the instruction replaces the value at `p_address` without reading it first.
+static bool _overwrites(const int *p_code, int p_start, int p_address) {
+	switch (p_code[p_start]) {
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+			return p_code[p_start + 1] == p_address && p_code[p_start + 2] != p_address;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+			return p_code[p_start + 1] == p_address;
+		default:
+			return false;
+	}
+}
+
+// Peephole pass over the finished bytecode, run once temporaries have their final addresses.
+// It threads jumps, drops jumps to the next instruction and dead stores, forwards operator results
+// into locals, and fuses common pairs into superinstructions. Removed words are then compacted
+// away, remapping every code address. A pair is only merged when nothing jumps to its second instruction.
+void GDScriptByteCodeGenerator::optimize_bytecode() {
+	enum {
+		WORD_START = 1 << 0,
+		WORD_TARGET = 1 << 1,
+		WORD_REMOVED = 1 << 2,
+	};
+
+	const int code_size = opcodes.size();
+	int *code = opcodes.ptrw();
+	const int start_count = opcode_starts.size();
+	const int *starts = opcode_starts.ptr();
+
+	LocalVector<uint8_t> flags;
+	flags.resize(code_size + 1);
+	memset(flags.ptr(), 0, flags.size());
+	for (int i = 0; i < start_count; i++) {
+		flags[starts[i]] |= WORD_START;
+	}
+	flags[code_size] |= WORD_START;
+
+	// Jumps landing on an unconditional jump can go to its destination directly.
+	for (int i = 0; i < start_count; i++) {
+		const int operand = _get_jump_operand(code[starts[i]]);
+		if (operand == 0) {
+			continue;
+		}
+		int to = code[starts[i] + operand];
+		for (int hops = 0; hops < 8 && to < code_size && (flags[to] & WORD_START) && code[to] == GDScriptFunction::OPCODE_JUMP; hops++) {
+			if (code[to + 1] == to) {
+				break; // Empty infinite loop.
+			}
+			to = code[to + 1];
+		}
+		code[starts[i] + operand] = to;
+	}
+
+	// Unconditional jumps to the next instruction do nothing.
+	for (int i = 0; i < start_count; i++) {
+		if (code[starts[i]] == GDScriptFunction::OPCODE_JUMP && code[starts[i] + 1] == starts[i] + 2) {
+			flags[starts[i]] |= WORD_REMOVED;
+			flags[starts[i] + 1] |= WORD_REMOVED;
+		}
+	}
+
+	// Find every instruction reachable from somewhere other than the previous one.
+	for (int i = 0; i < start_count; i++) {
+		if (flags[starts[i]] & WORD_REMOVED) {
+			continue;
+		}
+		const int operand = _get_jump_operand(code[starts[i]]);
+		if (operand != 0) {
+			flags[code[starts[i] + operand]] |= WORD_TARGET;
+		}
+		if (code[starts[i]] == GDScriptFunction::OPCODE_AWAIT) {
+			flags[starts[i] + 2] |= WORD_TARGET; // Resumed after yielding.
+		}
+	}
+	for (int i = 0; i < function->default_arguments.size(); i++) {
+		flags[function->default_arguments[i]] |= WORD_TARGET;
+	}
+
+	// Copy propagation: the operator writes into the local and the assignment goes away.
+	// Both validated and unboxed operators keep their result address at offset 3.
+	for (int i = 0; i < forwardable_operators.size(); i++) {
+		const int op = forwardable_operators[i];
+		const int assign = op + _get_operator_size(code[op]);
+		if (assign == op || (flags[assign] & WORD_TARGET) || code[assign] != GDScriptFunction::OPCODE_ASSIGN || code[op + 3] != code[assign + 2]) {
+			continue;
+		}
+		code[op + 3] = code[assign + 1];
+		flags[assign] |= WORD_REMOVED;
+		flags[assign + 1] |= WORD_REMOVED;
+		flags[assign + 2] |= WORD_REMOVED;
+	}
+
+	// Dead stores and superinstructions, over pairs of adjacent instructions.
+	for (int i = 0; i + 1 < start_count; i++) {
+		const int first = starts[i];
+		const int second = starts[i + 1];
+		if ((flags[first] & WORD_REMOVED) || (flags[second] & WORD_REMOVED)) {
+			continue;
+		}
+
+		const int store = _get_pure_store(code, first);
+		if (store != 0 && _overwrites(code, second, code[first + store])) {
+			for (int j = first; j < second; j++) {
+				flags[j] |= WORD_REMOVED;
+			}
+			continue;
+		}
+
+		if (flags[second] & WORD_TARGET) {
+			continue;
+		}
+
+		switch (code[first]) {
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				// Result address of the operator is `code[first + 3]`, and the second instruction starts at `first + 5`.
+				if (code[second] == GDScriptFunction::OPCODE_ASSIGN && code[second + 2] == code[first + 3]) {
+					code[first] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+					code[first + 5] = code[second + 1];
+				} else if ((code[second] == GDScriptFunction::OPCODE_JUMP_IF || code[second] == GDScriptFunction::OPCODE_JUMP_IF_NOT) && code[second + 1] == code[first + 3]) {
+					code[first] = code[second] == GDScriptFunction::OPCODE_JUMP_IF ? GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF : GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+					code[first + 5] = code[second + 2];
+				} else {
+					continue;
+				}
+				flags[second] &= ~WORD_START;
+				flags[second + 1] |= WORD_REMOVED;
+				flags[second + 2] |= WORD_REMOVED;
+				i++;
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_NOT_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_LESS:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_LESS_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER:
+			case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER:
+			case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL: {
+				// The comparison result is still written, the jump target replaces the `JUMP_IF_NOT` opcode at `first + 4`.
+				if (code[second] != GDScriptFunction::OPCODE_JUMP_IF_NOT || code[second + 1] != code[first + 3]) {
+					continue;
+				}
+				if (code[first] >= GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS) {
+					code[first] = GDScriptFunction::OPCODE_JUMP_IF_NOT_FLOAT_LESS + (code[first] - GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS);
+				} else {
+					code[first] = GDScriptFunction::OPCODE_JUMP_IF_NOT_INT_EQUAL + (code[first] - GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL);
+				}
+				code[first + 4] = code[second + 2];
+				flags[second] &= ~WORD_START;
+				flags[second + 1] |= WORD_REMOVED;
+				flags[second + 2] |= WORD_REMOVED;
+				i++;
+			} break;
+			case GDScriptFunction::OPCODE_GET_MEMBER: {
+				if (code[second] != GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED) {
+					continue;
+				}
+				// The call keeps its operands, only its opcode goes away.
+				code[first] = GDScriptFunction::OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED;
+				flags[second] &= ~WORD_START;
+				flags[second] |= WORD_REMOVED;
+				i++;
+			} break;
+			default:
+				break;
+		}
+	}
+
+	// Compact, then remap code addresses to the new positions. Removed instructions map to whatever follows them.
+	LocalVector<int> new_pos;
+	new_pos.resize(code_size + 1);
+	int size = 0;
+	for (int i = 0; i < code_size; i++) {
+		new_pos[i] = size;
+		if (!(flags[i] & WORD_REMOVED)) {
+			size++;
+		}
+	}
+	new_pos[code_size] = size;
+
+	if (size == code_size) {
+		return;
+	}
+
+	for (int i = 0; i < start_count; i++) {
+		if ((flags[starts[i]] & (WORD_START | WORD_REMOVED)) != WORD_START) {
+			continue;
+		}
+		const int operand = _get_jump_operand(code[starts[i]]);
+		if (operand != 0) {
+			code[starts[i] + operand] = new_pos[code[starts[i] + operand]];
+		}
+	}
+	for (int i = 0; i < function->default_arguments.size(); i++) {
+		function->default_arguments.write[i] = new_pos[function->default_arguments[i]];
+	}
+
+	for (int i = 0; i < code_size; i++) {
+		if (!(flags[i] & WORD_REMOVED)) {
+			code[new_pos[i]] = code[i];
+		}
+	}
+	opcodes.resize(size);
+
+	int kept = 0;
+	for (int i = 0; i < start_count; i++) {
+		if ((flags[starts[i]] & (WORD_START | WORD_REMOVED)) == WORD_START) {
+			opcode_starts.write[kept++] = new_pos[starts[i]];
+		}
+	}
+	opcode_starts.resize(kept);
+}
+
 GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 #ifdef DEBUG_ENABLED
 	if (!used_temporaries.is_empty()) {
@@ -196,6 +492,20 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	if (optimize) {
+		optimize_bytecode();
+	}
+
+#ifdef TOOLS_ENABLED
+	for (int start : opcode_starts) {
+		if (opcodes[start] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			function->global_index_positions.push_back(start + 2);
+		} else if (opcodes[start] == GDScriptFunction::OPCODE_OPERATOR) {
+			function->operator_cache_positions.push_back(start);
+		}
+	}
+#endif
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -395,6 +705,14 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (debug_stack) {
 		function->stack_debug = stack_debug;
 	}
@@ -554,8 +872,79 @@ void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Varia
 	append(p_target);
 }
 
+// Finds an operator working directly on the values stored in typed slots. Those skip the validated evaluator call,
+// relying on typed locals and temporaries always holding a value of their type.
+static bool _get_unboxed_operator(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type, GDScriptFunction::Opcode &r_opcode) {
+#define UNBOXED_OPERATOR(m_operator, m_right_type, m_opcode)                          \
+	if (p_operator == Variant::m_operator && p_right_type == Variant::m_right_type) { \
+		r_opcode = GDScriptFunction::m_opcode;                                        \
+		return true;                                                                  \
+	}
+	switch (p_left_type) {
+		case Variant::INT:
+			UNBOXED_OPERATOR(OP_ADD, INT, OPCODE_OPERATOR_INT_ADD);
+			UNBOXED_OPERATOR(OP_SUBTRACT, INT, OPCODE_OPERATOR_INT_SUBTRACT);
+			UNBOXED_OPERATOR(OP_MULTIPLY, INT, OPCODE_OPERATOR_INT_MULTIPLY);
+			UNBOXED_OPERATOR(OP_EQUAL, INT, OPCODE_OPERATOR_INT_EQUAL);
+			UNBOXED_OPERATOR(OP_NOT_EQUAL, INT, OPCODE_OPERATOR_INT_NOT_EQUAL);
+			UNBOXED_OPERATOR(OP_LESS, INT, OPCODE_OPERATOR_INT_LESS);
+			UNBOXED_OPERATOR(OP_LESS_EQUAL, INT, OPCODE_OPERATOR_INT_LESS_EQUAL);
+			UNBOXED_OPERATOR(OP_GREATER, INT, OPCODE_OPERATOR_INT_GREATER);
+			UNBOXED_OPERATOR(OP_GREATER_EQUAL, INT, OPCODE_OPERATOR_INT_GREATER_EQUAL);
+			UNBOXED_OPERATOR(OP_NEGATE, NIL, OPCODE_OPERATOR_INT_NEGATE);
+			break;
+		case Variant::FLOAT:
+			UNBOXED_OPERATOR(OP_ADD, FLOAT, OPCODE_OPERATOR_FLOAT_ADD);
+			UNBOXED_OPERATOR(OP_SUBTRACT, FLOAT, OPCODE_OPERATOR_FLOAT_SUBTRACT);
+			UNBOXED_OPERATOR(OP_MULTIPLY, FLOAT, OPCODE_OPERATOR_FLOAT_MULTIPLY);
+			UNBOXED_OPERATOR(OP_DIVIDE, FLOAT, OPCODE_OPERATOR_FLOAT_DIVIDE);
+			UNBOXED_OPERATOR(OP_EQUAL, FLOAT, OPCODE_OPERATOR_FLOAT_EQUAL);
+			UNBOXED_OPERATOR(OP_NOT_EQUAL, FLOAT, OPCODE_OPERATOR_FLOAT_NOT_EQUAL);
+			UNBOXED_OPERATOR(OP_LESS, FLOAT, OPCODE_OPERATOR_FLOAT_LESS);
+			UNBOXED_OPERATOR(OP_LESS_EQUAL, FLOAT, OPCODE_OPERATOR_FLOAT_LESS_EQUAL);
+			UNBOXED_OPERATOR(OP_GREATER, FLOAT, OPCODE_OPERATOR_FLOAT_GREATER);
+			UNBOXED_OPERATOR(OP_GREATER_EQUAL, FLOAT, OPCODE_OPERATOR_FLOAT_GREATER_EQUAL);
+			UNBOXED_OPERATOR(OP_NEGATE, NIL, OPCODE_OPERATOR_FLOAT_NEGATE);
+			break;
+		case Variant::BOOL:
+			UNBOXED_OPERATOR(OP_NOT, NIL, OPCODE_OPERATOR_BOOL_NOT);
+			break;
+		case Variant::VECTOR2:
+			UNBOXED_OPERATOR(OP_ADD, VECTOR2, OPCODE_OPERATOR_VECTOR2_ADD);
+			UNBOXED_OPERATOR(OP_SUBTRACT, VECTOR2, OPCODE_OPERATOR_VECTOR2_SUBTRACT);
+			UNBOXED_OPERATOR(OP_MULTIPLY, VECTOR2, OPCODE_OPERATOR_VECTOR2_MULTIPLY);
+			UNBOXED_OPERATOR(OP_MULTIPLY, FLOAT, OPCODE_OPERATOR_VECTOR2_MULTIPLY_FLOAT);
+			break;
+		case Variant::VECTOR3:
+			UNBOXED_OPERATOR(OP_ADD, VECTOR3, OPCODE_OPERATOR_VECTOR3_ADD);
+			UNBOXED_OPERATOR(OP_SUBTRACT, VECTOR3, OPCODE_OPERATOR_VECTOR3_SUBTRACT);
+			UNBOXED_OPERATOR(OP_MULTIPLY, VECTOR3, OPCODE_OPERATOR_VECTOR3_MULTIPLY);
+			UNBOXED_OPERATOR(OP_MULTIPLY, FLOAT, OPCODE_OPERATOR_VECTOR3_MULTIPLY_FLOAT);
+			break;
+		default:
+			break;
+	}
+#undef UNBOXED_OPERATOR
+	return false;
+}
+
 void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Variant::Operator p_operator, const Address &p_left_operand) {
 	if (HAS_BUILTIN_TYPE(p_left_operand)) {
+		GDScriptFunction::Opcode unboxed_opcode;
+		if (_get_unboxed_operator(p_operator, p_left_operand.type.builtin_type, Variant::NIL, unboxed_opcode)) {
+			if (p_target.mode == Address::TEMPORARY) {
+				Variant::Type result_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
+				if (result_type != temporaries[p_target.address].type) {
+					write_type_adjust(p_target, result_type);
+				}
+			}
+			append_opcode(unboxed_opcode);
+			append(p_left_operand);
+			append(Address());
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 
@@ -595,6 +984,19 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		last_operator_pos = opcodes.size();
+		last_operator_type = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+
+		GDScriptFunction::Opcode unboxed_opcode;
+		if (_get_unboxed_operator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type, unboxed_opcode)) {
+			append_opcode(unboxed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			last_operator_end = opcodes.size();
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -603,6 +1005,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		append(p_right_operand);
 		append(p_target);
 		append(op_func);
+		last_operator_end = opcodes.size();
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -844,6 +1247,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -862,6 +1266,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -948,6 +1353,10 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 			append(p_source);
 		}
 	}
+
+	if (p_target.mode == Address::LOCAL_VARIABLE) {
+		initialized_locals.insert(p_target.address);
+	}
 }
 
 void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Address &p_source) {
@@ -978,10 +1387,26 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_source);
 		append(p_target.type.builtin_type);
 	} else {
+		if (p_source.mode == Address::TEMPORARY && p_target.mode == Address::LOCAL_VARIABLE && HAS_BUILTIN_TYPE(p_target) && _is_value_type(p_target.type.builtin_type) && initialized_locals.has(p_target.address) &&
+				last_operator_pos >= 0 && last_operator_end == opcodes.size() && last_operator_type == p_target.type.builtin_type) {
+			// Assigning the result of the previous operator. The local already holds a value of the result
+			// type, which validated and unboxed operators need, so the operator may write into it directly if the temporary is
+			// popped right after this. That is checked in `pop_temporary()`.
+			const Vector<int> &indices = temporaries[p_source.address].bytecode_indices;
+			if (!indices.is_empty() && indices[indices.size() - 1] == last_operator_pos + 3) {
+				pending_forward_operator = last_operator_pos;
+				pending_forward_assign = opcodes.size();
+				pending_forward_temporary = p_source.address;
+			}
+		}
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
 		append(p_source);
 	}
+
+	if (p_target.mode == Address::LOCAL_VARIABLE) {
+		initialized_locals.insert(p_target.address);
+	}
 }
 
 void GDScriptByteCodeGenerator::write_assign_null(const Address &p_target) {
@@ -1076,6 +1501,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1101,6 +1527,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1335,6 +1762,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1348,6 +1776,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1361,6 +1790,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1908,6 +2338,7 @@ void GDScriptByteCodeGenerator::clear_address(const Address &p_address) {
 
 	if (p_address.mode == Address::LOCAL_VARIABLE) {
 		dirty_locals.erase(p_address.address);
+		initialized_locals.insert(p_address.address);
 	}
 }
 
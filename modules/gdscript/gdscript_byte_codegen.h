@@ -76,8 +76,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	bool ended = false;
 	GDScriptFunction *function = nullptr;
 	bool debug_stack = false;
+	bool optimize = true;
 
 	Vector<int> opcodes;
+	Vector<int> opcode_starts;
 	List<RBMap<StringName, int>> stack_id_stack;
 	RBMap<StringName, int> stack_identifiers;
 	List<int> stack_identifiers_counts;
@@ -85,6 +87,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	Vector<StackSlot> locals;
 	HashSet<int> dirty_locals;
+	HashSet<int> initialized_locals;
 
 	Vector<StackSlot> temporaries;
 	List<int> used_temporaries;
@@ -98,6 +101,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
+
+	// Copy propagation candidates, see `optimize_bytecode()`.
+	int last_operator_pos = -1;
+	int last_operator_end = -1;
+	Variant::Type last_operator_type = Variant::NIL;
+	int pending_forward_operator = -1;
+	int pending_forward_assign = -1;
+	int pending_forward_temporary = -1;
+	Vector<int> forwardable_operators;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -196,6 +209,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 #endif
 		for (int i = current_locals; i < locals.size(); i++) {
 			dirty_locals.insert(i + GDScriptFunction::FIXED_ADDRESSES_MAX);
+			initialized_locals.erase(i + GDScriptFunction::FIXED_ADDRESSES_MAX);
 		}
 		locals.resize(current_locals);
 		if (debug_stack) {
@@ -374,10 +388,12 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		opcode_starts.push_back(opcodes.size());
 		opcodes.push_back(p_code);
 	}
 
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
+		opcode_starts.push_back(opcodes.size());
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
 		instr_args_max = MAX(instr_args_max, p_argument_count);
@@ -447,10 +463,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
 	}
 
+	void optimize_bytecode();
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
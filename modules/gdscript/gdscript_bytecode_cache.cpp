@@ -0,0 +1,1566 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_analyzer.h"
+#include "gdscript_cache.h"
+#include "gdscript_compiler.h"
+#include "gdscript_function.h"
+#include "gdscript_inline_cache.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/config/engine.h"
+#include "core/debugger/engine_debugger.h"
+#include "core/io/compression.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/version.h"
+
+// Header: magic, version, engine hash, tokens hash, payload checksum and decompressed size (zero if not compressed).
+static constexpr int HEADER_SIZE = 24;
+
+enum ScriptKind {
+	SCRIPT_NONE,
+	SCRIPT_LOCAL, // A class of the script being loaded, by its path of inner class names.
+	SCRIPT_GDSCRIPT, // A class of another GDScript file.
+	SCRIPT_RESOURCE, // Any other script, by resource path.
+};
+
+enum ConstantKind {
+	CONSTANT_VALUE,
+	CONSTANT_NULL_OBJECT,
+	CONSTANT_ARRAY,
+	CONSTANT_DICTIONARY,
+	CONSTANT_SCRIPT,
+	CONSTANT_GLOBAL, // Native classes and engine singletons, by global name.
+	CONSTANT_RESOURCE,
+};
+
+struct GDScriptBytecodeCache::Writer {
+	Vector<uint8_t> buffer;
+	GDScript *root = nullptr;
+	String error; // First reason why the script can't be stored.
+	Descriptors *descriptors = nullptr;
+
+	void fail(const String &p_reason) {
+		if (error.is_empty()) {
+			error = p_reason;
+		}
+	}
+
+	void put_u8(uint8_t p_value) {
+		buffer.push_back(p_value);
+	}
+
+	void put_u32(uint32_t p_value) {
+		const int pos = buffer.size();
+		buffer.resize(pos + 4);
+		encode_uint32(p_value, &buffer.write[pos]);
+	}
+
+	void put_i32(int32_t p_value) {
+		put_u32(uint32_t(p_value));
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_u32(utf8.length());
+		const int pos = buffer.size();
+		buffer.resize(pos + utf8.length());
+		memcpy(buffer.ptrw() + pos, utf8.get_data(), utf8.length());
+	}
+
+	void put_variant(const Variant &p_value) {
+		int len = 0;
+		Error err = encode_variant(p_value, nullptr, len, false);
+		if (err != OK) {
+			fail("Could not encode value of type " + Variant::get_type_name(p_value.get_type()) + ".");
+			return;
+		}
+		const int pos = buffer.size();
+		buffer.resize(pos + len);
+		encode_variant(p_value, buffer.ptrw() + pos, len, false);
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int pos = 0;
+	GDScript *root = nullptr;
+	bool failed = false;
+
+	bool has(uint32_t p_bytes) {
+		if (failed || p_bytes > uint32_t(size - pos)) {
+			failed = true;
+			return false;
+		}
+		return true;
+	}
+
+	uint8_t get_u8() {
+		if (!has(1)) {
+			return 0;
+		}
+		return data[pos++];
+	}
+
+	uint32_t get_u32() {
+		if (!has(4)) {
+			return 0;
+		}
+		const uint32_t value = decode_uint32(&data[pos]);
+		pos += 4;
+		return value;
+	}
+
+	int32_t get_i32() {
+		return int32_t(get_u32());
+	}
+
+	// Element counts are bounded by the remaining data, so a damaged cache can't request huge allocations.
+	uint32_t get_count() {
+		const uint32_t count = get_u32();
+		if (count > uint32_t(size - pos)) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		const uint32_t len = get_u32();
+		if (!has(len)) {
+			return String();
+		}
+		String string = String::utf8(reinterpret_cast<const char *>(&data[pos]), len);
+		pos += len;
+		return string;
+	}
+
+	Variant get_variant() {
+		Variant value;
+		int len = 0;
+		if (failed || decode_variant(value, &data[pos], size - pos, &len, false) != OK) {
+			failed = true;
+			return Variant();
+		}
+		pos += len;
+		return value;
+	}
+};
+
+static uint32_t _get_engine_hash(bool p_debug) {
+	uint32_t hash = hash_murmur3_one_32(GDScriptBytecodeCache::CACHE_VERSION);
+	hash = hash_murmur3_one_32(String(VERSION_FULL_BUILD).hash(), hash);
+	hash = hash_murmur3_one_32(String(VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	hash = hash_murmur3_one_32(sizeof(void *), hash);
+	hash = hash_murmur3_one_32(sizeof(real_t), hash);
+	// Debug bytecode has line and assert opcodes that release builds must not run.
+	hash = hash_murmur3_one_32(p_debug ? 1 : 0, hash);
+	return hash_fmix32(hash);
+}
+
+static bool _is_debug_build() {
+#ifdef DEBUG_ENABLED
+	return true;
+#else
+	return false;
+#endif
+}
+
+// Inner class names from the root script, separated by "::". Empty for the root itself.
+String GDScriptBytecodeCache::_get_class_path(const GDScript *p_class) {
+	String class_path;
+	for (const GDScript *E = p_class; E->_owner != nullptr; E = E->_owner) {
+		class_path = class_path.is_empty() ? String(E->local_name) : String(E->local_name) + "::" + class_path;
+	}
+	return class_path;
+}
+
+static GDScript *_find_class_path(GDScript *p_root, const String &p_class_path) {
+	if (p_class_path.is_empty()) {
+		return p_root;
+	}
+	GDScript *result = p_root;
+	const Vector<String> names = p_class_path.split("::");
+	for (int i = 0; result != nullptr && i < names.size(); i++) {
+		const Ref<GDScript> *subclass = result->get_subclasses().getptr(names[i]);
+		result = subclass ? subclass->ptr() : nullptr;
+	}
+	return result;
+}
+
+bool GDScriptBytecodeCache::is_enabled() {
+	// The editor compiles from source, and the debugger needs the line information only a fresh compilation has.
+	return !Engine::get_singleton()->is_editor_hint() && !EngineDebugger::is_active();
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	return p_script_path.get_basename() + ".gdbc";
+}
+
+/* Serialization */
+
+#ifdef TOOLS_ENABLED
+
+// Reverse lookups of the validated function pointers held by compiled functions, since the pointers themselves
+// are only valid in the running process. Each table is built the first time a script needs it.
+struct GDScriptBytecodeCache::Descriptors {
+	struct Member {
+		Variant::Type type = Variant::NIL;
+		StringName name;
+	};
+
+	struct Constructor {
+		Variant::Type type = Variant::NIL;
+		int index = 0;
+	};
+
+	template <typename K, typename V>
+	static const V *lookup(const RBMap<K, V> &p_map, const K &p_key) {
+		const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+		return E ? &E->value() : nullptr;
+	}
+
+	bool has_operators = false;
+	bool has_members = false;
+	bool has_keyed = false;
+	bool has_builtin_methods = false;
+	bool has_constructors = false;
+	bool has_utilities = false;
+
+	RBMap<Variant::ValidatedOperatorEvaluator, uint32_t> operators; // Operator, then both operand types in a byte each.
+	RBMap<Variant::ValidatedSetter, Member> setters;
+	RBMap<Variant::ValidatedGetter, Member> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Member> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Constructor> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+
+	void build_operators() {
+		if (has_operators) {
+			return;
+		}
+		has_operators = true;
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int a = 0; a < Variant::VARIANT_MAX; a++) {
+				for (int b = 0; b < Variant::VARIANT_MAX; b++) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(a), Variant::Type(b));
+					if (evaluator && !operators.has(evaluator)) {
+						operators.insert(evaluator, (op << 16) | (a << 8) | b);
+					}
+				}
+			}
+		}
+	}
+
+	void build_members() {
+		if (has_members) {
+			return;
+		}
+		has_members = true;
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			List<StringName> members;
+			Variant::get_member_list(Variant::Type(type), &members);
+			for (const StringName &name : members) {
+				setters.insert(Variant::get_member_validated_setter(Variant::Type(type), name), { Variant::Type(type), name });
+				getters.insert(Variant::get_member_validated_getter(Variant::Type(type), name), { Variant::Type(type), name });
+			}
+		}
+	}
+
+	void build_keyed() {
+		if (has_keyed) {
+			return;
+		}
+		has_keyed = true;
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			keyed_setters.insert(Variant::get_member_validated_keyed_setter(Variant::Type(type)), Variant::Type(type));
+			keyed_getters.insert(Variant::get_member_validated_keyed_getter(Variant::Type(type)), Variant::Type(type));
+			indexed_setters.insert(Variant::get_member_validated_indexed_setter(Variant::Type(type)), Variant::Type(type));
+			indexed_getters.insert(Variant::get_member_validated_indexed_getter(Variant::Type(type)), Variant::Type(type));
+		}
+	}
+
+	void build_builtin_methods() {
+		if (has_builtin_methods) {
+			return;
+		}
+		has_builtin_methods = true;
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			List<StringName> methods;
+			Variant::get_builtin_method_list(Variant::Type(type), &methods);
+			for (const StringName &name : methods) {
+				builtin_methods.insert(Variant::get_validated_builtin_method(Variant::Type(type), name), { Variant::Type(type), name });
+			}
+		}
+	}
+
+	void build_constructors() {
+		if (has_constructors) {
+			return;
+		}
+		has_constructors = true;
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			for (int i = 0; i < Variant::get_constructor_count(Variant::Type(type)); i++) {
+				constructors.insert(Variant::get_validated_constructor(Variant::Type(type), i), { Variant::Type(type), i });
+			}
+		}
+	}
+
+	void build_utilities() {
+		if (has_utilities) {
+			return;
+		}
+		has_utilities = true;
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &name : functions) {
+			utilities.insert(Variant::get_validated_utility_function(name), name);
+		}
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &name : functions) {
+			gds_utilities.insert(GDScriptUtilityFunctions::get_function(name), name);
+		}
+	}
+};
+
+void GDScriptBytecodeCache::_write_script(Writer &p_writer, Script *p_script) {
+	if (p_script == nullptr) {
+		p_writer.put_u8(SCRIPT_NONE);
+		return;
+	}
+
+	GDScript *gdscript = Object::cast_to<GDScript>(p_script);
+	if (gdscript) {
+		GDScript *root = gdscript->get_root_script();
+		if (root == p_writer.root) {
+			p_writer.put_u8(SCRIPT_LOCAL);
+			p_writer.put_string(_get_class_path(gdscript));
+			return;
+		}
+		if (!root->get_script_path().is_resource_file()) {
+			p_writer.fail(vformat(R"(Class "%s" has no resource path.)", gdscript->get_fully_qualified_name()));
+			return;
+		}
+		p_writer.put_u8(SCRIPT_GDSCRIPT);
+		p_writer.put_string(root->get_script_path());
+		p_writer.put_string(_get_class_path(gdscript));
+		return;
+	}
+
+	if (!p_script->get_path().is_resource_file()) {
+		p_writer.fail("Referenced script has no resource path.");
+		return;
+	}
+	p_writer.put_u8(SCRIPT_RESOURCE);
+	p_writer.put_string(p_script->get_path());
+}
+
+void GDScriptBytecodeCache::_write_constant(Writer &p_writer, const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_value.get_validated_object();
+			if (object == nullptr) {
+				p_writer.put_u8(CONSTANT_NULL_OBJECT);
+				return;
+			}
+
+			Script *script = Object::cast_to<Script>(object);
+			if (script) {
+				p_writer.put_u8(CONSTANT_SCRIPT);
+				_write_script(p_writer, script);
+				return;
+			}
+
+			GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+			for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+				if (language->get_global_array()[E.value].get_validated_object() == object) {
+					p_writer.put_u8(CONSTANT_GLOBAL);
+					p_writer.put_string(E.key);
+					return;
+				}
+			}
+
+			Resource *resource = Object::cast_to<Resource>(object);
+			if (resource && resource->get_path().is_resource_file()) {
+				p_writer.put_u8(CONSTANT_RESOURCE);
+				p_writer.put_string(resource->get_path());
+				return;
+			}
+
+			p_writer.fail(vformat(R"(Constant of class "%s" can't be stored.)", object->get_class()));
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			p_writer.put_u8(CONSTANT_ARRAY);
+			p_writer.put_u8(array.is_read_only());
+			p_writer.put_u8(array.is_typed());
+			if (array.is_typed()) {
+				p_writer.put_u32(array.get_typed_builtin());
+				p_writer.put_string(array.get_typed_class_name());
+				_write_script(p_writer, Object::cast_to<Script>(array.get_typed_script()));
+			}
+			p_writer.put_u32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				_write_constant(p_writer, array[i]);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			p_writer.put_u8(CONSTANT_DICTIONARY);
+			p_writer.put_u8(dictionary.is_read_only());
+			p_writer.put_u8(dictionary.is_typed());
+			if (dictionary.is_typed()) {
+				p_writer.put_u32(dictionary.get_typed_key_builtin());
+				p_writer.put_string(dictionary.get_typed_key_class_name());
+				_write_script(p_writer, Object::cast_to<Script>(dictionary.get_typed_key_script()));
+				p_writer.put_u32(dictionary.get_typed_value_builtin());
+				p_writer.put_string(dictionary.get_typed_value_class_name());
+				_write_script(p_writer, Object::cast_to<Script>(dictionary.get_typed_value_script()));
+			}
+			List<Variant> keys;
+			dictionary.get_key_list(&keys);
+			p_writer.put_u32(keys.size());
+			for (const Variant &key : keys) {
+				_write_constant(p_writer, key);
+				_write_constant(p_writer, dictionary[key]);
+			}
+		} break;
+		case Variant::RID:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL: {
+			p_writer.fail(vformat(R"(Constant of type "%s" can't be stored.)", Variant::get_type_name(p_value.get_type())));
+		} break;
+		default: {
+			p_writer.put_u8(CONSTANT_VALUE);
+			p_writer.put_variant(p_value);
+		} break;
+	}
+}
+
+void GDScriptBytecodeCache::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_u8(p_type.has_type);
+	p_writer.put_u8(p_type.kind);
+	p_writer.put_u32(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	_write_script(p_writer, p_type.script_type);
+	p_writer.put_u32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_write_data_type(p_writer, element_type);
+	}
+}
+
+void GDScriptBytecodeCache::_write_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_u32(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_u32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_u32(p_info.usage);
+}
+
+void GDScriptBytecodeCache::_write_method_info(Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	_write_property_info(p_writer, p_info.return_val);
+	p_writer.put_u32(p_info.flags);
+	p_writer.put_i32(p_info.id);
+	p_writer.put_u32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_write_property_info(p_writer, argument);
+	}
+	p_writer.put_u32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		_write_constant(p_writer, default_argument);
+	}
+	p_writer.put_i32(p_info.return_val_metadata);
+	p_writer.put_u32(p_info.arguments_metadata.size());
+	for (int metadata : p_info.arguments_metadata) {
+		p_writer.put_i32(metadata);
+	}
+}
+
+void GDScriptBytecodeCache::_write_function(Writer &p_writer, const GDScriptFunction *p_function) {
+	Descriptors &descriptors = *p_writer.descriptors;
+
+	p_writer.put_string(p_function->name);
+	p_writer.put_u8(p_function->_static);
+	p_writer.put_u32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		_write_data_type(p_writer, argument_type);
+	}
+	_write_data_type(p_writer, p_function->return_type);
+	_write_method_info(p_writer, p_function->method_info);
+	_write_constant(p_writer, p_function->rpc_config);
+
+#ifdef DEBUG_ENABLED
+	p_writer.put_string(p_function->profile.signature);
+#else
+	p_writer.put_string(String());
+#endif
+	p_writer.put_i32(p_function->_initial_line);
+	p_writer.put_i32(p_function->_argument_count);
+	p_writer.put_i32(p_function->_stack_size);
+	p_writer.put_i32(p_function->_instruction_args_size);
+	p_writer.put_u32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_i32(E.key);
+		p_writer.put_u32(E.value);
+	}
+
+	// Generic operators cache the evaluator of the first operand types they see, which has to be found again.
+	Vector<int> code = p_function->code;
+	constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int);
+	for (int position : p_function->operator_cache_positions) {
+		for (int i = 5; i < 7 + pointer_size; i++) {
+			code.write[position + i] = 0;
+		}
+	}
+	p_writer.put_u32(code.size());
+	for (int word : code) {
+		p_writer.put_i32(word);
+	}
+
+	p_writer.put_u32(p_function->default_arguments.size());
+	for (int default_argument : p_function->default_arguments) {
+		p_writer.put_i32(default_argument);
+	}
+	p_writer.put_u32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_write_constant(p_writer, constant);
+	}
+	p_writer.put_u32(p_function->global_names.size());
+	for (const StringName &name : p_function->global_names) {
+		p_writer.put_string(name);
+	}
+
+	// Global indices depend on the order things were registered in, they are stored by name.
+	p_writer.put_u32(p_function->global_index_positions.size());
+	for (int position : p_function->global_index_positions) {
+		StringName global;
+		for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+			if (E.value == p_function->code[position]) {
+				global = E.key;
+				break;
+			}
+		}
+		if (global == StringName()) {
+			p_writer.fail(vformat(R"(Unknown global in function "%s".)", p_function->name));
+		}
+		p_writer.put_i32(position);
+		p_writer.put_string(global);
+	}
+
+	if (!p_function->operator_funcs.is_empty()) {
+		descriptors.build_operators();
+	}
+	p_writer.put_u32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const uint32_t *descriptor = Descriptors::lookup(descriptors.operators, evaluator);
+		if (descriptor == nullptr) {
+			p_writer.fail("Unknown operator evaluator.");
+		}
+		p_writer.put_u32(descriptor ? *descriptor : 0);
+	}
+
+	if (!p_function->setters.is_empty() || !p_function->getters.is_empty()) {
+		descriptors.build_members();
+	}
+	p_writer.put_u32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		const Descriptors::Member *member = Descriptors::lookup(descriptors.setters, setter);
+		if (member == nullptr) {
+			p_writer.fail("Unknown member setter.");
+		}
+		p_writer.put_u32(member ? member->type : 0);
+		p_writer.put_string(member ? String(member->name) : String());
+	}
+	p_writer.put_u32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		const Descriptors::Member *member = Descriptors::lookup(descriptors.getters, getter);
+		if (member == nullptr) {
+			p_writer.fail("Unknown member getter.");
+		}
+		p_writer.put_u32(member ? member->type : 0);
+		p_writer.put_string(member ? String(member->name) : String());
+	}
+
+	if (!p_function->keyed_setters.is_empty() || !p_function->keyed_getters.is_empty() || !p_function->indexed_setters.is_empty() || !p_function->indexed_getters.is_empty()) {
+		descriptors.build_keyed();
+	}
+#define WRITE_TYPED_ACCESSORS(m_vector, m_map)                          \
+	p_writer.put_u32(p_function->m_vector.size());                      \
+	for (int i = 0; i < p_function->m_vector.size(); i++) {             \
+		const Variant::Type *type = Descriptors::lookup(descriptors.m_map, p_function->m_vector[i]); \
+		if (type == nullptr) {                                          \
+			p_writer.fail("Unknown keyed or indexed accessor.");        \
+		}                                                               \
+		p_writer.put_u32(type ? *type : 0);                             \
+	}
+	WRITE_TYPED_ACCESSORS(keyed_setters, keyed_setters);
+	WRITE_TYPED_ACCESSORS(keyed_getters, keyed_getters);
+	WRITE_TYPED_ACCESSORS(indexed_setters, indexed_setters);
+	WRITE_TYPED_ACCESSORS(indexed_getters, indexed_getters);
+#undef WRITE_TYPED_ACCESSORS
+
+	if (!p_function->builtin_methods.is_empty()) {
+		descriptors.build_builtin_methods();
+	}
+	p_writer.put_u32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+		const Descriptors::Member *member = Descriptors::lookup(descriptors.builtin_methods, method);
+		if (member == nullptr) {
+			p_writer.fail("Unknown built-in method.");
+		}
+		p_writer.put_u32(member ? member->type : 0);
+		p_writer.put_string(member ? String(member->name) : String());
+	}
+
+	if (!p_function->constructors.is_empty()) {
+		descriptors.build_constructors();
+	}
+	p_writer.put_u32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const Descriptors::Constructor *descriptor = Descriptors::lookup(descriptors.constructors, constructor);
+		if (descriptor == nullptr) {
+			p_writer.fail("Unknown constructor.");
+		}
+		p_writer.put_u32(descriptor ? descriptor->type : 0);
+		p_writer.put_i32(descriptor ? descriptor->index : 0);
+	}
+
+	if (!p_function->utilities.is_empty() || !p_function->gds_utilities.is_empty()) {
+		descriptors.build_utilities();
+	}
+	p_writer.put_u32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *name = Descriptors::lookup(descriptors.utilities, utility);
+		if (name == nullptr) {
+			p_writer.fail("Unknown utility function.");
+		}
+		p_writer.put_string(name ? String(*name) : String());
+	}
+	p_writer.put_u32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		const StringName *name = Descriptors::lookup(descriptors.gds_utilities, utility);
+		if (name == nullptr) {
+			p_writer.fail("Unknown GDScript utility function.");
+		}
+		p_writer.put_string(name ? String(*name) : String());
+	}
+
+	p_writer.put_u32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+		p_writer.put_u32(method->get_hash());
+	}
+
+	p_writer.put_i32(p_function->_inline_caches_count);
+
+	p_writer.put_u32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		_write_function(p_writer, lambda);
+		const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		p_writer.put_i32(info ? info->capture_count : 0);
+		p_writer.put_u8(info ? info->use_self : false);
+	}
+}
+
+void GDScriptBytecodeCache::_write_class_tree(Writer &p_writer, const GDScript *p_class) {
+	p_writer.put_string(p_class->local_name);
+	p_writer.put_string(p_class->global_name);
+	p_writer.put_string(p_class->fully_qualified_name);
+	p_writer.put_string(p_class->simplified_icon_path);
+	p_writer.put_u32(p_class->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		_write_class_tree(p_writer, E.value.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_write_class(Writer &p_writer, GDScript *p_class) {
+	p_writer.put_string(_get_class_path(p_class));
+	p_writer.put_u8(p_class->tool);
+	p_writer.put_string(p_class->native.is_valid() ? String(p_class->native->get_name()) : String());
+
+	// The layout of the base is checked on load, members are accessed by index.
+	_write_script(p_writer, p_class->base.ptr());
+	if (p_class->base.is_valid()) {
+		p_writer.put_u32(p_class->base->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_class->base->member_indices) {
+			p_writer.put_string(E.key);
+			p_writer.put_i32(E.value.index);
+		}
+	}
+
+	const auto write_members = [&p_writer](const HashMap<StringName, GDScript::MemberInfo> &p_members, const HashSet<StringName> *p_filter) {
+		// Stored in index order, so indices can be checked against the base class layout on load.
+		Vector<const StringName *> ordered;
+		ordered.resize(p_members.size());
+		ordered.fill(nullptr);
+		int count = 0;
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_members) {
+			if (p_filter == nullptr || p_filter->has(E.key)) {
+				if (E.value.index < 0 || E.value.index >= ordered.size()) {
+					p_writer.fail(vformat(R"(Invalid index for member "%s".)", E.key));
+					return;
+				}
+				ordered.write[E.value.index] = &E.key;
+				count++;
+			}
+		}
+		p_writer.put_u32(count);
+		for (const StringName *name : ordered) {
+			if (name == nullptr) {
+				continue;
+			}
+			const GDScript::MemberInfo &info = p_members[*name];
+			p_writer.put_string(*name);
+			p_writer.put_i32(info.index);
+			p_writer.put_string(info.setter);
+			p_writer.put_string(info.getter);
+			_write_data_type(p_writer, info.data_type);
+			_write_property_info(p_writer, info.property_info);
+		}
+	};
+	write_members(p_class->member_indices, &p_class->members);
+	write_members(p_class->static_variables_indices, nullptr);
+
+	// Inner classes are added back to the constants on load.
+	int constant_count = 0;
+	for (const KeyValue<StringName, Variant> &E : p_class->constants) {
+		constant_count += !p_class->subclasses.has(E.key);
+	}
+	p_writer.put_u32(constant_count);
+	for (const KeyValue<StringName, Variant> &E : p_class->constants) {
+		if (!p_class->subclasses.has(E.key)) {
+			p_writer.put_string(E.key);
+			_write_constant(p_writer, E.value);
+		}
+	}
+
+	p_writer.put_u32(p_class->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_class->_signals) {
+		p_writer.put_string(E.key);
+		_write_method_info(p_writer, E.value);
+	}
+	_write_constant(p_writer, p_class->rpc_config);
+
+	p_writer.put_u32(p_class->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_class->member_functions) {
+		_write_function(p_writer, E.value);
+	}
+	GDScriptFunction *implicit_functions[] = { p_class->implicit_initializer, p_class->implicit_ready, p_class->static_initializer };
+	for (GDScriptFunction *function : implicit_functions) {
+		p_writer.put_u8(function != nullptr);
+		if (function) {
+			_write_function(p_writer, function);
+		}
+	}
+}
+
+void GDScriptBytecodeCache::_set_detached(GDScript *p_class) {
+	p_class->detached = true;
+	for (KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		_set_detached(E.value.ptr());
+	}
+}
+
+Ref<GDScript> GDScriptBytecodeCache::_compile_release_script(const GDScript *p_script, const Vector<uint8_t> &p_binary_tokens) {
+	const String path = p_script->get_script_path();
+	if (!path.is_empty() && GDScriptCache::get_cached_script(path).ptr() != p_script) {
+		// Compiling registers the dependencies of the path, which is only safe while the editor's own copy is cached.
+		return Ref<GDScript>();
+	}
+
+	// A copy of the script, so the editor keeps running its debug bytecode. Dependencies still resolve to the editor's
+	// scripts, and references back to this path are stored by path, so they resolve to the loaded script on load.
+	Ref<GDScript> copy;
+	copy.instantiate();
+	copy->path = path;
+	copy->path_valid = true;
+
+	GDScriptParser parser;
+	Error err = p_binary_tokens.is_empty() ? parser.parse(p_script->get_source_code(), path, false) : parser.parse_binary(p_binary_tokens, path);
+	if (err == OK) {
+		GDScriptAnalyzer analyzer(&parser);
+		err = analyzer.analyze();
+	}
+	if (err == OK) {
+		GDScriptCompiler compiler;
+		compiler.set_release_bytecode(true);
+		err = compiler.compile(&parser, copy.ptr(), false);
+	}
+	_set_detached(copy.ptr());
+	if (err != OK) {
+		print_verbose(vformat(R"(GDScript: Not caching release bytecode of "%s": %s)", path, error_names[err]));
+		return Ref<GDScript>();
+	}
+	return copy;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::serialize(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug, bool p_compress) {
+	ERR_FAIL_NULL_V(p_script, Vector<uint8_t>());
+	if (!p_script->is_valid() || !p_script->is_root_script()) {
+		return Vector<uint8_t>();
+	}
+
+	if (!p_debug) {
+		// Scripts in the editor always run debug bytecode.
+		Ref<GDScript> release = _compile_release_script(p_script, p_binary_tokens);
+		return release.is_valid() ? _serialize(release.ptr(), p_binary_tokens, false, p_compress) : Vector<uint8_t>();
+	}
+	return _serialize(p_script, p_binary_tokens, true, p_compress);
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::_serialize(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug, bool p_compress) {
+	Descriptors descriptors;
+	Writer writer;
+	writer.root = p_script;
+	writer.descriptors = &descriptors;
+
+	_write_class_tree(writer, p_script);
+	writer.put_u8(GDScriptCache::has_static_script(p_script->fully_qualified_name));
+
+	// Local base classes come before the classes extending them.
+	Vector<GDScript *> classes;
+	List<GDScript *> pending;
+	pending.push_back(p_script);
+	while (!pending.is_empty()) {
+		GDScript *current = pending.front()->get();
+		pending.pop_front();
+		for (const KeyValue<StringName, Ref<GDScript>> &E : current->subclasses) {
+			pending.push_back(E.value.ptr());
+		}
+		Vector<GDScript *> chain;
+		for (GDScript *E = current; E && E->get_root_script() == p_script && !classes.has(E) && !chain.has(E); E = E->_base) {
+			chain.push_back(E);
+		}
+		for (int i = chain.size() - 1; i >= 0; i--) {
+			classes.push_back(chain[i]);
+		}
+	}
+	writer.put_u32(classes.size());
+	for (GDScript *E : classes) {
+		_write_class(writer, E);
+	}
+
+	if (!writer.error.is_empty()) {
+		print_verbose(vformat(R"(GDScript: Not caching bytecode of "%s": %s)", p_script->get_script_path(), writer.error));
+		return Vector<uint8_t>();
+	}
+
+	const Vector<uint8_t> &payload = writer.buffer;
+	Vector<uint8_t> buffer;
+	buffer.resize(HEADER_SIZE);
+	buffer.write[0] = 'G';
+	buffer.write[1] = 'D';
+	buffer.write[2] = 'B';
+	buffer.write[3] = 'C';
+	encode_uint32(CACHE_VERSION, &buffer.write[4]);
+	encode_uint32(_get_engine_hash(p_debug), &buffer.write[8]);
+	encode_uint32(hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size()), &buffer.write[12]);
+	encode_uint32(hash_djb2_buffer(payload.ptr(), payload.size()), &buffer.write[16]);
+
+	if (p_compress) {
+		encode_uint32(payload.size(), &buffer.write[20]);
+		Vector<uint8_t> compressed;
+		compressed.resize(Compression::get_max_compressed_buffer_size(payload.size(), Compression::MODE_ZSTD));
+		const int compressed_size = Compression::compress(compressed.ptrw(), payload.ptr(), payload.size(), Compression::MODE_ZSTD);
+		ERR_FAIL_COND_V_MSG(compressed_size < 0, Vector<uint8_t>(), "Error compressing GDScript bytecode cache.");
+		compressed.resize(compressed_size);
+		buffer.append_array(compressed);
+	} else {
+		encode_uint32(0u, &buffer.write[20]);
+		buffer.append_array(payload);
+	}
+
+	return buffer;
+}
+
+#endif // TOOLS_ENABLED
+
+/* Loading */
+
+Ref<Script> GDScriptBytecodeCache::_read_script(Reader &p_reader, bool p_full) {
+	switch (p_reader.get_u8()) {
+		case SCRIPT_NONE:
+			return Ref<Script>();
+		case SCRIPT_LOCAL: {
+			GDScript *script = _find_class_path(p_reader.root, p_reader.get_string());
+			if (script == nullptr) {
+				p_reader.failed = true;
+			}
+			return Ref<Script>(script);
+		}
+		case SCRIPT_GDSCRIPT: {
+			const String path = p_reader.get_string();
+			const String class_path = p_reader.get_string();
+			if (p_reader.failed) {
+				return Ref<Script>();
+			}
+			Error err = OK;
+			Ref<GDScript> root = p_full ? GDScriptCache::get_full_script(path, err, p_reader.root->path) : GDScriptCache::get_shallow_script(path, err, p_reader.root->path);
+			GDScript *script = root.is_valid() && err == OK ? _find_class_path(root.ptr(), class_path) : nullptr;
+			if (script == nullptr) {
+				p_reader.failed = true;
+			}
+			return Ref<Script>(script);
+		}
+		case SCRIPT_RESOURCE: {
+			const String path = p_reader.get_string();
+			Ref<Script> script;
+			if (!p_reader.failed) {
+				script = ResourceLoader::load(path);
+			}
+			if (script.is_null()) {
+				p_reader.failed = true;
+			}
+			return script;
+		}
+		default:
+			p_reader.failed = true;
+			return Ref<Script>();
+	}
+}
+
+Variant GDScriptBytecodeCache::_read_constant(Reader &p_reader) {
+	switch (p_reader.get_u8()) {
+		case CONSTANT_VALUE:
+			return p_reader.get_variant();
+		case CONSTANT_NULL_OBJECT:
+			return Variant((Object *)nullptr);
+		case CONSTANT_ARRAY: {
+			const bool read_only = p_reader.get_u8();
+			Array array;
+			if (p_reader.get_u8()) {
+				const uint32_t builtin_type = p_reader.get_u32();
+				const StringName class_name = p_reader.get_string();
+				const Ref<Script> script = _read_script(p_reader);
+				if (p_reader.failed || builtin_type >= Variant::VARIANT_MAX) {
+					p_reader.failed = true;
+					return Variant();
+				}
+				array.set_typed(builtin_type, class_name, script);
+			}
+			const uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_reader.failed; i++) {
+				array.push_back(_read_constant(p_reader));
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			return array;
+		}
+		case CONSTANT_DICTIONARY: {
+			const bool read_only = p_reader.get_u8();
+			Dictionary dictionary;
+			if (p_reader.get_u8()) {
+				const uint32_t key_type = p_reader.get_u32();
+				const StringName key_class_name = p_reader.get_string();
+				const Ref<Script> key_script = _read_script(p_reader);
+				const uint32_t value_type = p_reader.get_u32();
+				const StringName value_class_name = p_reader.get_string();
+				const Ref<Script> value_script = _read_script(p_reader);
+				if (p_reader.failed || key_type >= Variant::VARIANT_MAX || value_type >= Variant::VARIANT_MAX) {
+					p_reader.failed = true;
+					return Variant();
+				}
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			const uint32_t size = p_reader.get_count();
+			for (uint32_t i = 0; i < size && !p_reader.failed; i++) {
+				const Variant key = _read_constant(p_reader);
+				dictionary[key] = _read_constant(p_reader);
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			return dictionary;
+		}
+		case CONSTANT_SCRIPT:
+			return _read_script(p_reader);
+		case CONSTANT_GLOBAL: {
+			const StringName name = p_reader.get_string();
+			const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (index == nullptr) {
+				p_reader.failed = true;
+				return Variant();
+			}
+			return GDScriptLanguage::get_singleton()->get_global_array()[*index];
+		}
+		case CONSTANT_RESOURCE: {
+			const String path = p_reader.get_string();
+			Ref<Resource> resource;
+			if (!p_reader.failed) {
+				resource = ResourceLoader::load(path);
+			}
+			if (resource.is_null()) {
+				p_reader.failed = true;
+			}
+			return resource;
+		}
+		default:
+			p_reader.failed = true;
+			return Variant();
+	}
+}
+
+GDScriptDataType GDScriptBytecodeCache::_read_data_type(Reader &p_reader) {
+	GDScriptDataType type;
+	type.has_type = p_reader.get_u8();
+	const uint8_t kind = p_reader.get_u8();
+	const uint32_t builtin_type = p_reader.get_u32();
+	if (kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX) {
+		p_reader.failed = true;
+		return type;
+	}
+	type.kind = GDScriptDataType::Kind(kind);
+	type.builtin_type = Variant::Type(builtin_type);
+	type.native_type = p_reader.get_string();
+
+	// Like the compiler, only hold a strong reference to classes outside of this script, avoiding cycles.
+	const int script_kind = p_reader.pos < p_reader.size ? (int)p_reader.data[p_reader.pos] : (int)SCRIPT_NONE;
+	Ref<Script> script = _read_script(p_reader);
+	if (script_kind != SCRIPT_LOCAL) {
+		type.script_type_ref = script;
+	}
+	type.script_type = script.ptr();
+
+	const uint32_t element_count = p_reader.get_count();
+	for (uint32_t i = 0; i < element_count && !p_reader.failed; i++) {
+		type.container_element_types.push_back(_read_data_type(p_reader));
+	}
+	return type;
+}
+
+PropertyInfo GDScriptBytecodeCache::_read_property_info(Reader &p_reader) {
+	PropertyInfo info;
+	const uint32_t type = p_reader.get_u32();
+	if (type >= Variant::VARIANT_MAX) {
+		p_reader.failed = true;
+		return info;
+	}
+	info.type = Variant::Type(type);
+	info.name = p_reader.get_string();
+	info.class_name = p_reader.get_string();
+	info.hint = PropertyHint(p_reader.get_u32());
+	info.hint_string = p_reader.get_string();
+	info.usage = p_reader.get_u32();
+	return info;
+}
+
+MethodInfo GDScriptBytecodeCache::_read_method_info(Reader &p_reader) {
+	MethodInfo info;
+	info.name = p_reader.get_string();
+	info.return_val = _read_property_info(p_reader);
+	info.flags = p_reader.get_u32();
+	info.id = p_reader.get_i32();
+	const uint32_t argument_count = p_reader.get_count();
+	for (uint32_t i = 0; i < argument_count && !p_reader.failed; i++) {
+		info.arguments.push_back(_read_property_info(p_reader));
+	}
+	const uint32_t default_argument_count = p_reader.get_count();
+	for (uint32_t i = 0; i < default_argument_count && !p_reader.failed; i++) {
+		info.default_arguments.push_back(_read_constant(p_reader));
+	}
+	info.return_val_metadata = p_reader.get_i32();
+	const uint32_t metadata_count = p_reader.get_count();
+	for (uint32_t i = 0; i < metadata_count && !p_reader.failed; i++) {
+		info.arguments_metadata.push_back(p_reader.get_i32());
+	}
+	return info;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &p_reader, GDScript *p_class) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_class;
+	function->source = p_class->get_script_path();
+	function->name = p_reader.get_string();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	function->_static = p_reader.get_u8();
+	const uint32_t argument_type_count = p_reader.get_count();
+	for (uint32_t i = 0; i < argument_type_count && !p_reader.failed; i++) {
+		function->argument_types.push_back(_read_data_type(p_reader));
+	}
+	function->return_type = _read_data_type(p_reader);
+	function->method_info = _read_method_info(p_reader);
+	function->rpc_config = _read_constant(p_reader);
+
+#ifdef DEBUG_ENABLED
+	function->profile.signature = p_reader.get_string();
+#else
+	p_reader.get_string();
+#endif
+	function->_initial_line = p_reader.get_i32();
+	function->_argument_count = p_reader.get_i32();
+	function->_stack_size = p_reader.get_i32();
+	function->_instruction_args_size = p_reader.get_i32();
+	const uint32_t temporary_count = p_reader.get_count();
+	for (uint32_t i = 0; i < temporary_count && !p_reader.failed; i++) {
+		const int slot = p_reader.get_i32();
+		function->temporary_slots[slot] = Variant::Type(p_reader.get_u32());
+	}
+
+	const uint32_t code_size = p_reader.get_count();
+	if (p_reader.has(code_size * 4)) {
+		function->code.resize(code_size);
+		int *code = function->code.ptrw();
+		for (uint32_t i = 0; i < code_size; i++) {
+			code[i] = p_reader.get_i32();
+		}
+	}
+	const uint32_t default_argument_count = p_reader.get_count();
+	for (uint32_t i = 0; i < default_argument_count && !p_reader.failed; i++) {
+		function->default_arguments.push_back(p_reader.get_i32());
+	}
+	const uint32_t constant_count = p_reader.get_count();
+	for (uint32_t i = 0; i < constant_count && !p_reader.failed; i++) {
+		function->constants.push_back(_read_constant(p_reader));
+	}
+	const uint32_t global_name_count = p_reader.get_count();
+	for (uint32_t i = 0; i < global_name_count && !p_reader.failed; i++) {
+		function->global_names.push_back(p_reader.get_string());
+	}
+
+	const uint32_t global_count = p_reader.get_count();
+	for (uint32_t i = 0; i < global_count && !p_reader.failed; i++) {
+		const int position = p_reader.get_i32();
+		const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(p_reader.get_string());
+		if (index == nullptr || position < 0 || position >= function->code.size()) {
+			p_reader.failed = true;
+			break;
+		}
+		function->code.write[position] = *index;
+	}
+
+	const uint32_t operator_count = p_reader.get_count();
+	for (uint32_t i = 0; i < operator_count && !p_reader.failed; i++) {
+		const uint32_t descriptor = p_reader.get_u32();
+		const Variant::Operator op = Variant::Operator(descriptor >> 16);
+		const Variant::Type type_a = Variant::Type((descriptor >> 8) & 0xFF);
+		const Variant::Type type_b = Variant::Type(descriptor & 0xFF);
+		Variant::ValidatedOperatorEvaluator evaluator = op < Variant::OP_MAX && type_a < Variant::VARIANT_MAX && type_b < Variant::VARIANT_MAX ? Variant::get_validated_operator_evaluator(op, type_a, type_b) : nullptr;
+		p_reader.failed = p_reader.failed || evaluator == nullptr;
+		function->operator_funcs.push_back(evaluator);
+#ifdef DEBUG_ENABLED
+		function->operator_names.push_back(op < Variant::OP_MAX ? Variant::get_operator_name(op) : String());
+#endif
+	}
+
+#define READ_MEMBER_ACCESSORS(m_vector, m_names, m_getter)                                       \
+	{                                                                                            \
+		const uint32_t count = p_reader.get_count();                                             \
+		for (uint32_t i = 0; i < count && !p_reader.failed; i++) {                               \
+			const uint32_t type = p_reader.get_u32();                                            \
+			const StringName name = p_reader.get_string();                                       \
+			auto accessor = type < Variant::VARIANT_MAX ? Variant::m_getter(Variant::Type(type), name) : nullptr; \
+			p_reader.failed = p_reader.failed || accessor == nullptr;                            \
+			function->m_vector.push_back(accessor);                                              \
+			DEBUG_NAME(m_names, name);                                                           \
+		}                                                                                        \
+	}
+#define READ_TYPED_ACCESSORS(m_vector, m_getter)                                                 \
+	{                                                                                            \
+		const uint32_t count = p_reader.get_count();                                             \
+		for (uint32_t i = 0; i < count && !p_reader.failed; i++) {                               \
+			const uint32_t type = p_reader.get_u32();                                            \
+			auto accessor = type < Variant::VARIANT_MAX ? Variant::m_getter(Variant::Type(type)) : nullptr; \
+			p_reader.failed = p_reader.failed || accessor == nullptr;                            \
+			function->m_vector.push_back(accessor);                                              \
+		}                                                                                        \
+	}
+#ifdef DEBUG_ENABLED
+#define DEBUG_NAME(m_names, m_name) function->m_names.push_back(m_name)
+#else
+#define DEBUG_NAME(m_names, m_name)
+#endif
+
+	READ_MEMBER_ACCESSORS(setters, setter_names, get_member_validated_setter);
+	READ_MEMBER_ACCESSORS(getters, getter_names, get_member_validated_getter);
+	READ_TYPED_ACCESSORS(keyed_setters, get_member_validated_keyed_setter);
+	READ_TYPED_ACCESSORS(keyed_getters, get_member_validated_keyed_getter);
+	READ_TYPED_ACCESSORS(indexed_setters, get_member_validated_indexed_setter);
+	READ_TYPED_ACCESSORS(indexed_getters, get_member_validated_indexed_getter);
+	READ_MEMBER_ACCESSORS(builtin_methods, builtin_methods_names, get_validated_builtin_method);
+
+	const uint32_t constructor_count = p_reader.get_count();
+	for (uint32_t i = 0; i < constructor_count && !p_reader.failed; i++) {
+		const uint32_t type = p_reader.get_u32();
+		const int index = p_reader.get_i32();
+		Variant::ValidatedConstructor constructor = type < Variant::VARIANT_MAX && index >= 0 && index < Variant::get_constructor_count(Variant::Type(type)) ? Variant::get_validated_constructor(Variant::Type(type), index) : nullptr;
+		p_reader.failed = p_reader.failed || constructor == nullptr;
+		function->constructors.push_back(constructor);
+		DEBUG_NAME(constructors_names, type < Variant::VARIANT_MAX ? Variant::get_type_name(Variant::Type(type)) : String());
+	}
+
+	const uint32_t utility_count = p_reader.get_count();
+	for (uint32_t i = 0; i < utility_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(name);
+		p_reader.failed = p_reader.failed || utility == nullptr;
+		function->utilities.push_back(utility);
+		DEBUG_NAME(utilities_names, name);
+	}
+	const uint32_t gds_utility_count = p_reader.get_count();
+	for (uint32_t i = 0; i < gds_utility_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(name);
+		p_reader.failed = p_reader.failed || utility == nullptr;
+		function->gds_utilities.push_back(utility);
+		DEBUG_NAME(gds_utilities_names, name);
+	}
+
+#undef DEBUG_NAME
+#undef READ_TYPED_ACCESSORS
+#undef READ_MEMBER_ACCESSORS
+
+	// Method binds must still have the signature the code was compiled against.
+	const uint32_t method_count = p_reader.get_count();
+	for (uint32_t i = 0; i < method_count && !p_reader.failed; i++) {
+		const StringName class_name = p_reader.get_string();
+		const StringName method_name = p_reader.get_string();
+		const uint32_t hash = p_reader.get_u32();
+		MethodBind *method = ClassDB::get_method(class_name, method_name);
+		p_reader.failed = p_reader.failed || method == nullptr || method->get_hash() != hash;
+		function->methods.push_back(method);
+	}
+
+	const int inline_cache_count = p_reader.get_i32();
+
+	const uint32_t lambda_count = p_reader.get_count();
+	for (uint32_t i = 0; i < lambda_count && !p_reader.failed; i++) {
+		GDScriptFunction *lambda = _read_function(p_reader, p_class);
+		if (lambda == nullptr) {
+			break;
+		}
+		function->lambdas.push_back(lambda);
+		GDScript::LambdaInfo info;
+		info.capture_count = p_reader.get_i32();
+		info.use_self = p_reader.get_u8();
+		p_class->lambda_info.insert(lambda, info);
+	}
+
+	if (p_reader.failed || inline_cache_count < 0) {
+		p_reader.failed = true;
+		memdelete(function);
+		return nullptr;
+	}
+
+	// Same as `GDScriptByteCodeGenerator::write_end()`.
+	function->_code_size = function->code.size();
+	function->_code_ptr = function->_code_size ? function->code.ptrw() : nullptr;
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_operator_funcs_ptr = function->operator_funcs.is_empty() ? nullptr : function->operator_funcs.ptr();
+	function->_setters_count = function->setters.size();
+	function->_setters_ptr = function->setters.is_empty() ? nullptr : function->setters.ptr();
+	function->_getters_count = function->getters.size();
+	function->_getters_ptr = function->getters.is_empty() ? nullptr : function->getters.ptr();
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_setters_ptr = function->keyed_setters.is_empty() ? nullptr : function->keyed_setters.ptr();
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_keyed_getters_ptr = function->keyed_getters.is_empty() ? nullptr : function->keyed_getters.ptr();
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_setters_ptr = function->indexed_setters.is_empty() ? nullptr : function->indexed_setters.ptr();
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_indexed_getters_ptr = function->indexed_getters.is_empty() ? nullptr : function->indexed_getters.ptr();
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_builtin_methods_ptr = function->builtin_methods.is_empty() ? nullptr : function->builtin_methods.ptr();
+	function->_constructors_count = function->constructors.size();
+	function->_constructors_ptr = function->constructors.is_empty() ? nullptr : function->constructors.ptr();
+	function->_utilities_count = function->utilities.size();
+	function->_utilities_ptr = function->utilities.is_empty() ? nullptr : function->utilities.ptr();
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_gds_utilities_ptr = function->gds_utilities.is_empty() ? nullptr : function->gds_utilities.ptr();
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+	function->_inline_caches_count = inline_cache_count;
+	function->_inline_caches_ptr = inline_cache_count ? memnew_arr(GDScriptInlineCache, inline_cache_count) : nullptr;
+
+	return function;
+}
+
+// Creates the inner classes, or only skips over them if `p_class` is null.
+void GDScriptBytecodeCache::_read_class_tree(Reader &p_reader, GDScript *p_class) {
+	const StringName local_name = p_reader.get_string();
+	const StringName global_name = p_reader.get_string();
+	const String fully_qualified_name = p_reader.get_string();
+	const String simplified_icon_path = p_reader.get_string();
+	const uint32_t subclass_count = p_reader.get_count();
+	if (p_class == nullptr) {
+		for (uint32_t i = 0; i < subclass_count && !p_reader.failed; i++) {
+			_read_class_tree(p_reader, nullptr);
+		}
+		return;
+	}
+
+	p_class->local_name = local_name;
+	p_class->global_name = global_name;
+	p_class->fully_qualified_name = fully_qualified_name;
+	p_class->simplified_icon_path = simplified_icon_path;
+	p_class->subclasses.clear();
+	for (uint32_t i = 0; i < subclass_count && !p_reader.failed; i++) {
+		// Read the name ahead to reuse orphaned subclasses like `GDScriptCompiler::make_scripts()` does.
+		const int start = p_reader.pos;
+		const StringName name = p_reader.get_string();
+		p_reader.get_string();
+		const String subclass_fully_qualified_name = p_reader.get_string();
+		p_reader.pos = start;
+		if (p_reader.failed) {
+			break;
+		}
+
+		Ref<GDScript> subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(subclass_fully_qualified_name);
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+		subclass->_owner = p_class;
+		subclass->path = p_class->path;
+		p_class->subclasses.insert(name, subclass);
+		_read_class_tree(p_reader, subclass.ptr());
+	}
+}
+
+void GDScriptBytecodeCache::_read_class(Reader &p_reader, GDScript *p_class) {
+	p_class->tool = p_reader.get_u8();
+
+	const StringName native_name = p_reader.get_string();
+	const int *native_index = GDScriptLanguage::get_singleton()->get_global_map().getptr(native_name);
+	p_class->native = native_index ? Ref<GDScriptNativeClass>(GDScriptLanguage::get_singleton()->get_global_array()[*native_index]) : Ref<GDScriptNativeClass>();
+	if (p_class->native.is_null()) {
+		p_reader.failed = true;
+		return;
+	}
+
+	const Ref<Script> base_script = _read_script(p_reader, true);
+	const Ref<GDScript> base = base_script;
+	if (p_reader.failed || base.ptr() != base_script.ptr()) {
+		p_reader.failed = true;
+		return;
+	}
+	if (base.is_valid()) {
+		// Member indices of this class continue the ones of its base.
+		const uint32_t base_member_count = p_reader.get_count();
+		bool matches = base->is_valid() && base_member_count == uint32_t(base->member_indices.size());
+		for (uint32_t i = 0; i < base_member_count && !p_reader.failed; i++) {
+			const StringName name = p_reader.get_string();
+			const int index = p_reader.get_i32();
+			const GDScript::MemberInfo *info = base->member_indices.getptr(name);
+			matches = matches && info && info->index == index;
+		}
+		if (!matches) {
+			print_verbose(vformat(R"(GDScript: Base class of "%s" changed since its bytecode was cached.)", p_class->fully_qualified_name));
+			p_reader.failed = true;
+			return;
+		}
+		p_class->base = base;
+		p_class->_base = base.ptr();
+		p_class->member_indices = base->member_indices;
+	}
+
+	const uint32_t member_count = p_reader.get_count();
+	for (uint32_t i = 0; i < member_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		GDScript::MemberInfo info;
+		info.index = p_reader.get_i32();
+		info.setter = p_reader.get_string();
+		info.getter = p_reader.get_string();
+		info.data_type = _read_data_type(p_reader);
+		info.property_info = _read_property_info(p_reader);
+		p_reader.failed = p_reader.failed || info.index < 0 || (uint32_t)info.index != p_class->member_indices.size();
+		p_class->member_indices[name] = info;
+		p_class->members.insert(name);
+	}
+	const uint32_t static_count = p_reader.get_count();
+	for (uint32_t i = 0; i < static_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		GDScript::MemberInfo info;
+		info.index = p_reader.get_i32();
+		info.setter = p_reader.get_string();
+		info.getter = p_reader.get_string();
+		info.data_type = _read_data_type(p_reader);
+		info.property_info = _read_property_info(p_reader);
+		p_reader.failed = p_reader.failed || info.index < 0 || (uint32_t)info.index != p_class->static_variables_indices.size();
+		p_class->static_variables_indices[name] = info;
+	}
+
+	const uint32_t constant_count = p_reader.get_count();
+	for (uint32_t i = 0; i < constant_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		p_class->constants.insert(name, _read_constant(p_reader));
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_class->subclasses) {
+		p_class->constants.insert(E.key, E.value);
+	}
+
+	const uint32_t signal_count = p_reader.get_count();
+	for (uint32_t i = 0; i < signal_count && !p_reader.failed; i++) {
+		const StringName name = p_reader.get_string();
+		p_class->_signals[name] = _read_method_info(p_reader);
+	}
+	p_class->rpc_config = _read_constant(p_reader);
+
+	const uint32_t function_count = p_reader.get_count();
+	for (uint32_t i = 0; i < function_count && !p_reader.failed; i++) {
+		GDScriptFunction *function = _read_function(p_reader, p_class);
+		if (function) {
+			p_class->member_functions[function->name] = function;
+		}
+	}
+	GDScriptFunction **implicit_functions[] = { &p_class->implicit_initializer, &p_class->implicit_ready, &p_class->static_initializer };
+	for (GDScriptFunction **function : implicit_functions) {
+		if (p_reader.get_u8() && !p_reader.failed) {
+			*function = _read_function(p_reader, p_class);
+		}
+	}
+	if (p_reader.failed) {
+		return;
+	}
+	if (GDScriptFunction **initializer = p_class->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init)) {
+		p_class->initializer = *initializer;
+	}
+
+	p_class->static_variables.resize(p_class->static_variables_indices.size());
+	p_class->_static_default_init();
+	p_class->valid = true;
+}
+
+Error GDScriptBytecodeCache::prepare_script(GDScript *p_script, const Vector<uint8_t> &p_cache) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	p_script->bytecode_cache.clear();
+
+	if (p_cache.size() < HEADER_SIZE || p_cache[0] != 'G' || p_cache[1] != 'D' || p_cache[2] != 'B' || p_cache[3] != 'C') {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	const uint8_t *header = p_cache.ptr();
+	if (decode_uint32(&header[4]) != CACHE_VERSION || decode_uint32(&header[8]) != _get_engine_hash(_is_debug_build())) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	const Vector<uint8_t> &tokens = p_script->binary_tokens;
+	if (decode_uint32(&header[12]) != hash_djb2_buffer(tokens.ptr(), tokens.size())) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	Vector<uint8_t> payload;
+	const uint32_t decompressed_size = decode_uint32(&header[20]);
+	if (decompressed_size == 0) {
+		payload = p_cache.slice(HEADER_SIZE);
+	} else {
+		payload.resize(decompressed_size);
+		const int result = Compression::decompress(payload.ptrw(), payload.size(), &header[HEADER_SIZE], p_cache.size() - HEADER_SIZE, Compression::MODE_ZSTD);
+		if (result != int(decompressed_size)) {
+			return ERR_FILE_CORRUPT;
+		}
+	}
+	if (decode_uint32(&header[16]) != hash_djb2_buffer(payload.ptr(), payload.size())) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	Reader reader;
+	reader.data = payload.ptr();
+	reader.size = payload.size();
+	reader.root = p_script;
+	_read_class_tree(reader, p_script);
+	if (reader.failed) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	p_script->bytecode_cache = payload;
+	return OK;
+}
+
+Error GDScriptBytecodeCache::load_script(GDScript *p_script, const Vector<uint8_t> &p_payload) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+
+	Reader reader;
+	reader.data = p_payload.ptr();
+	reader.size = p_payload.size();
+	reader.root = p_script;
+
+	// Skip the class tree, already built by `prepare_script()`.
+	_read_class_tree(reader, nullptr);
+
+	const bool keep_static_data = reader.get_u8();
+	const uint32_t class_count = reader.get_count();
+	for (uint32_t i = 0; i < class_count && !reader.failed; i++) {
+		GDScript *script = _find_class_path(p_script, reader.get_string());
+		if (script == nullptr || script->valid) {
+			reader.failed = true;
+			break;
+		}
+		_read_class(reader, script);
+	}
+
+	if (reader.failed) {
+		// Leave the rest to the compiler, which starts by clearing everything loaded so far.
+		List<GDScript *> pending;
+		pending.push_back(p_script);
+		while (!pending.is_empty()) {
+			GDScript *script = pending.front()->get();
+			pending.pop_front();
+			script->valid = false;
+			for (const KeyValue<StringName, Ref<GDScript>> &E : script->subclasses) {
+				pending.push_back(E.value.ptr());
+			}
+		}
+		return ERR_FILE_CORRUPT;
+	}
+
+	if (keep_static_data) {
+		GDScriptCache::add_static_script(p_script);
+	}
+	return GDScriptCache::finish_compiling(p_script->path);
+}
@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_BYTECODE_CACHE_H
+#define GDSCRIPT_BYTECODE_CACHE_H
+
+#include "core/object/ref_counted.h"
+#include "core/object/script_language.h"
+#include "core/templates/vector.h"
+
+class GDScript;
+class GDScriptFunction;
+class GDScriptDataType;
+
+// Compiled bytecode of an exported script, stored next to its binary tokens so loading skips parsing,
+// analysis and compilation. A cache only applies to the engine build (including debug or release) and the exact
+// tokens it was made from, scripts fall back to compiling their tokens otherwise.
+class GDScriptBytecodeCache {
+	struct Writer;
+	struct Reader;
+	struct Descriptors;
+
+	static String _get_class_path(const GDScript *p_class);
+
+#ifdef TOOLS_ENABLED
+	static void _write_script(Writer &p_writer, Script *p_script);
+	static void _write_constant(Writer &p_writer, const Variant &p_value);
+	static void _write_data_type(Writer &p_writer, const GDScriptDataType &p_type);
+	static void _write_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static void _write_method_info(Writer &p_writer, const MethodInfo &p_info);
+	static void _write_function(Writer &p_writer, const GDScriptFunction *p_function);
+	static void _write_class_tree(Writer &p_writer, const GDScript *p_class);
+	static void _write_class(Writer &p_writer, GDScript *p_class);
+
+	static void _set_detached(GDScript *p_class);
+	static Ref<GDScript> _compile_release_script(const GDScript *p_script, const Vector<uint8_t> &p_binary_tokens);
+	static Vector<uint8_t> _serialize(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug, bool p_compress);
+#endif
+
+	static Ref<Script> _read_script(Reader &p_reader, bool p_full = false);
+	static Variant _read_constant(Reader &p_reader);
+	static GDScriptDataType _read_data_type(Reader &p_reader);
+	static PropertyInfo _read_property_info(Reader &p_reader);
+	static MethodInfo _read_method_info(Reader &p_reader);
+	static GDScriptFunction *_read_function(Reader &p_reader, GDScript *p_class);
+	static void _read_class_tree(Reader &p_reader, GDScript *p_class);
+	static void _read_class(Reader &p_reader, GDScript *p_class);
+
+public:
+	static constexpr uint32_t CACHE_VERSION = 2;
+
+	static bool is_enabled();
+	static String get_cache_path(const String &p_script_path);
+
+	// Validates a cache against the binary tokens already set on a freshly created script, and creates its inner classes.
+	// On success the next `GDScript::reload()` loads the compiled classes instead of parsing.
+	static Error prepare_script(GDScript *p_script, const Vector<uint8_t> &p_cache);
+	static Error load_script(GDScript *p_script, const Vector<uint8_t> &p_payload);
+
+#ifdef TOOLS_ENABLED
+	// Returns an empty buffer if the script uses something that can't be stored, like an object without a resource path.
+	// Without `p_debug`, the cache is made for release templates and the script is compiled again to drop debug opcodes.
+	static Vector<uint8_t> serialize(GDScript *p_script, const Vector<uint8_t> &p_binary_tokens, bool p_debug, bool p_compress);
+#endif
+};
+
+#endif // GDSCRIPT_BYTECODE_CACHE_H
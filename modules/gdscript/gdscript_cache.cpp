@@ -32,12 +32,25 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
 #include "core/templates/vector.h"
 
+static Error _parse_script_file(GDScriptParser *p_parser, const String &p_path, uint32_t &r_source_hash) {
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	}
+	String source = GDScriptCache::get_source_code(remapped_path);
+	r_source_hash = source.hash();
+	return p_parser->parse(source, p_path, false);
+}
+
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
 	return status;
 }
@@ -75,16 +88,19 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.get_extension().to_lower() == "gdc") {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
+				GDScriptParser *prefetched = nullptr;
+				if (GDScriptCache::_take_prefetched_parser(path, prefetched, result, source_hash)) {
+					if (analyzer != nullptr) {
+						memdelete(analyzer);
+						analyzer = nullptr;
+					}
+					memdelete(parser);
+					parser = prefetched;
 				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
+					result = _parse_script_file(get_parser(), path, source_hash);
 				}
+				// Dependencies are parsed on other threads while this one analyzes.
+				GDScriptCache::_prefetch_dependencies(parser->get_dependencies());
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -139,6 +155,7 @@ GDScriptParserRef::~GDScriptParserRef() {
 	if (!abandoned) {
 		MutexLock lock(GDScriptCache::singleton->mutex);
 		GDScriptCache::singleton->parser_map.erase(path);
+		GDScriptCache::_forget_prefetched_parser(path);
 	}
 }
 
@@ -253,6 +270,7 @@ void GDScriptCache::remove_parser(const String &p_path) {
 
 	// Can't clear the parser because some other parser might be currently using it in the chain of calls.
 	singleton->parser_map.erase(p_path);
+	_forget_prefetched_parser(p_path);
 
 	// Have to copy while iterating, because parser_inverse_dependencies is modified.
 	HashSet<String> ideps = singleton->parser_inverse_dependencies[p_path];
@@ -262,6 +280,231 @@ void GDScriptCache::remove_parser(const String &p_path) {
 	}
 }
 
+void GDScriptCache::_run_prefetch(PrefetchedParser *p_prefetched) {
+	GDScriptParser *parser = memnew(GDScriptParser);
+	uint32_t source_hash = 0;
+	const Error result = _parse_script_file(parser, p_prefetched->path, source_hash);
+	// Must be collected before handing the parser over, the thread taking it starts analyzing right away.
+	const List<String> dependencies = parser->get_dependencies();
+
+	{
+		MutexLock lock(singleton->prefetch_mutex);
+		p_prefetched->parser = parser;
+		p_prefetched->result = result;
+		p_prefetched->source_hash = source_hash;
+		p_prefetched->done_msec = OS::get_singleton()->get_ticks_msec();
+		p_prefetched->state = PrefetchedParser::DONE;
+	}
+	p_prefetched->done.post();
+
+	_prefetch_dependencies(dependencies);
+
+	MutexLock lock(singleton->prefetch_mutex);
+	p_prefetched->finished = true;
+}
+
+void GDScriptCache::_prefetch_task(void *p_userdata) {
+	PrefetchedParser *prefetched = static_cast<PrefetchedParser *>(p_userdata);
+	{
+		MutexLock lock(singleton->prefetch_mutex);
+		if (prefetched->state != PrefetchedParser::QUEUED) {
+			prefetched->finished = true;
+			return;
+		}
+		prefetched->state = PrefetchedParser::RUNNING;
+	}
+	_run_prefetch(prefetched);
+}
+
+void GDScriptCache::_prefetch_on_caller_thread(const String &p_path) {
+	// Exported scripts may come with a bytecode cache, in which case they are never parsed.
+	if (ResourceLoader::path_remap(p_path).get_extension().to_lower() != "gd") {
+		return;
+	}
+	{
+		MutexLock lock(singleton->mutex);
+		if (singleton->full_gdscript_cache.has(p_path) || singleton->shallow_gdscript_cache.has(p_path) || singleton->parser_map.has(p_path)) {
+			return;
+		}
+	}
+
+	// Scripts requested from several loading threads are parsed on each of them, without holding the cache mutex.
+	PrefetchedParser *prefetched = nullptr;
+	{
+		MutexLock lock(singleton->prefetch_mutex);
+		if (singleton->prefetch_known.has(p_path)) {
+			return;
+		}
+		singleton->prefetch_known.insert(p_path);
+		prefetched = memnew(PrefetchedParser);
+		prefetched->path = p_path;
+		prefetched->state = PrefetchedParser::RUNNING;
+		singleton->prefetched_parsers.insert(p_path, prefetched);
+		singleton->prefetch_tasks.push_back(prefetched);
+	}
+	_run_prefetch(prefetched);
+}
+
+void GDScriptCache::_prefetch_dependencies(const List<String> &p_dependencies) {
+	for (const String &E : p_dependencies) {
+		prefetch_parser(E);
+	}
+}
+
+void GDScriptCache::_evict_unused_prefetches() {
+	// Called with `prefetch_mutex` locked.
+	const uint64_t now = OS::get_singleton()->get_ticks_msec();
+	for (PrefetchedParser *prefetched : singleton->prefetch_tasks) {
+		if (prefetched->taken || prefetched->state != PrefetchedParser::DONE || now - prefetched->done_msec < PREFETCH_EXPIRE_MSEC) {
+			continue;
+		}
+		// Nothing loaded it after all, a later load parses it again.
+		prefetched->taken = true;
+		singleton->prefetched_parsers.erase(prefetched->path);
+		singleton->prefetch_known.erase(prefetched->path);
+	}
+}
+
+void GDScriptCache::_reap_prefetch_tasks(bool p_wait) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (!p_wait) {
+		// Called with `prefetch_mutex` locked.
+		_evict_unused_prefetches();
+		for (uint32_t i = 0; i < singleton->prefetch_tasks.size(); i++) {
+			PrefetchedParser *prefetched = singleton->prefetch_tasks[i];
+			if (!prefetched->taken || !prefetched->finished) {
+				continue;
+			}
+			if (prefetched->task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				if (!pool->is_task_completed(prefetched->task_id)) {
+					continue;
+				}
+				pool->wait_for_task_completion(prefetched->task_id);
+			}
+			if (prefetched->parser != nullptr) {
+				memdelete(prefetched->parser);
+			}
+			memdelete(prefetched);
+			singleton->prefetch_tasks.remove_at_unordered(i);
+			i--;
+		}
+		return;
+	}
+
+	// Running tasks may still queue their dependencies, so repeat until nothing is left.
+	while (true) {
+		LocalVector<PrefetchedParser *> tasks;
+		{
+			MutexLock lock(singleton->prefetch_mutex);
+			for (PrefetchedParser *prefetched : singleton->prefetch_tasks) {
+				if (prefetched->state == PrefetchedParser::QUEUED) {
+					prefetched->state = PrefetchedParser::CANCELED;
+				}
+			}
+			tasks = singleton->prefetch_tasks;
+			singleton->prefetch_tasks.clear();
+			singleton->prefetched_parsers.clear();
+		}
+		if (tasks.is_empty()) {
+			break;
+		}
+		for (PrefetchedParser *prefetched : tasks) {
+			if (prefetched->task_id != WorkerThreadPool::INVALID_TASK_ID && pool != nullptr) {
+				pool->wait_for_task_completion(prefetched->task_id);
+			}
+		}
+		MutexLock lock(singleton->prefetch_mutex);
+		for (PrefetchedParser *prefetched : tasks) {
+			// Parsing on the caller's thread, a few steps away from finishing.
+			while (prefetched->task_id == WorkerThreadPool::INVALID_TASK_ID && !prefetched->finished) {
+				lock.temp_unlock();
+				OS::get_singleton()->delay_usec(1);
+				lock.temp_relock();
+			}
+			if (prefetched->parser != nullptr) {
+				memdelete(prefetched->parser);
+			}
+			memdelete(prefetched);
+		}
+	}
+}
+
+bool GDScriptCache::_take_prefetched_parser(const String &p_path, GDScriptParser *&r_parser, Error &r_result, uint32_t &r_source_hash) {
+	MutexLock lock(singleton->prefetch_mutex);
+	singleton->prefetch_known.insert(p_path);
+
+	HashMap<String, PrefetchedParser *>::Iterator E = singleton->prefetched_parsers.find(p_path);
+	if (!E) {
+		return false;
+	}
+	PrefetchedParser *prefetched = E->value;
+	singleton->prefetched_parsers.remove(E);
+	prefetched->taken = true;
+
+	if (prefetched->state == PrefetchedParser::QUEUED) {
+		// Not started yet, parsing here is faster than waiting for a free thread.
+		prefetched->state = PrefetchedParser::CANCELED;
+		return false;
+	}
+	if (prefetched->state == PrefetchedParser::RUNNING) {
+		// The parsing thread needs nothing held by this one to finish.
+		lock.temp_unlock();
+		prefetched->done.wait();
+		lock.temp_relock();
+	}
+
+	r_parser = prefetched->parser;
+	r_result = prefetched->result;
+	r_source_hash = prefetched->source_hash;
+	prefetched->parser = nullptr;
+	return r_parser != nullptr;
+}
+
+void GDScriptCache::_forget_prefetched_parser(const String &p_path) {
+	MutexLock lock(singleton->prefetch_mutex);
+	singleton->prefetch_known.erase(p_path);
+
+	HashMap<String, PrefetchedParser *>::Iterator E = singleton->prefetched_parsers.find(p_path);
+	if (E) {
+		// The file may have changed since, the result is freed once its thread is done.
+		if (E->value->state == PrefetchedParser::QUEUED) {
+			E->value->state = PrefetchedParser::CANCELED;
+		}
+		E->value->taken = true;
+		singleton->prefetched_parsers.remove(E);
+	}
+}
+
+void GDScriptCache::prefetch_parser(const String &p_path) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (singleton == nullptr || pool == nullptr || pool->get_thread_count() < 2 || p_path.get_extension().to_lower() != "gd") {
+		return;
+	}
+
+	MutexLock lock(singleton->prefetch_mutex);
+	if (singleton->prefetch_known.has(p_path)) {
+		return;
+	}
+	singleton->prefetch_known.insert(p_path);
+	_reap_prefetch_tasks(false);
+
+	PrefetchedParser *prefetched = memnew(PrefetchedParser);
+	prefetched->path = p_path;
+	singleton->prefetched_parsers.insert(p_path, prefetched);
+	singleton->prefetch_tasks.push_back(prefetched);
+	prefetched->task_id = pool->add_native_task(&GDScriptCache::_prefetch_task, prefetched, false, "Parse GDScript " + p_path);
+}
+
+void GDScriptCache::evict_unused_prefetched_parsers() {
+	if (singleton == nullptr) {
+		return;
+	}
+	MutexLock lock(singleton->prefetch_mutex);
+	if (!singleton->prefetch_tasks.is_empty()) {
+		_reap_prefetch_tasks(false);
+	}
+}
+
 String GDScriptCache::get_source_code(const String &p_path) {
 	Vector<uint8_t> source_file;
 	Error err;
@@ -296,6 +539,8 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 }
 
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
+	_prefetch_on_caller_thread(p_path);
+
 	MutexLock lock(singleton->mutex);
 
 	if (!p_owner.is_empty()) {
@@ -327,9 +572,19 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
-	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
-	if (r_error == OK) {
-		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+	bool has_bytecode = false;
+	if (remapped_path.get_extension().to_lower() == "gdc" && GDScriptBytecodeCache::is_enabled()) {
+		const String cache_path = GDScriptBytecodeCache::get_cache_path(remapped_path);
+		if (FileAccess::exists(cache_path)) {
+			has_bytecode = GDScriptBytecodeCache::prepare_script(script.ptr(), FileAccess::get_file_as_bytes(cache_path)) == OK;
+		}
+	}
+
+	if (!has_bytecode) {
+		Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
+		if (r_error == OK) {
+			GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
+		}
 	}
 
 	singleton->shallow_gdscript_cache[p_path] = script;
@@ -338,6 +593,8 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 }
 
 Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_error, const String &p_owner, bool p_update_from_disk) {
+	_prefetch_on_caller_thread(p_path);
+
 	MutexLock lock(singleton->mutex);
 
 	if (!p_owner.is_empty()) {
@@ -440,6 +697,11 @@ void GDScriptCache::add_static_script(Ref<GDScript> p_script) {
 	singleton->static_gdscript_cache[p_script->get_fully_qualified_name()] = p_script;
 }
 
+bool GDScriptCache::has_static_script(const String &p_fqcn) {
+	MutexLock lock(singleton->mutex);
+	return singleton->static_gdscript_cache.has(p_fqcn);
+}
+
 void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
@@ -485,6 +747,10 @@ void GDScriptCache::clear() {
 	parser_map_refs.clear();
 	singleton->shallow_gdscript_cache.clear();
 	singleton->full_gdscript_cache.clear();
+
+	_reap_prefetch_tasks(true);
+	MutexLock prefetch_lock(singleton->prefetch_mutex);
+	singleton->prefetch_known.clear();
 }
 
 GDScriptCache::GDScriptCache() {
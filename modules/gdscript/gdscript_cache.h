@@ -34,9 +34,12 @@
 #include "gdscript.h"
 
 #include "core/object/ref_counted.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/safe_binary_mutex.h"
+#include "core/os/semaphore.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
 
 class GDScriptAnalyzer;
 class GDScriptParser;
@@ -78,6 +81,27 @@ public:
 };
 
 class GDScriptCache {
+	// A script parsed ahead of time on the `WorkerThreadPool`, waiting for its `GDScriptParserRef` to ask for it.
+	struct PrefetchedParser {
+		enum State {
+			QUEUED,
+			RUNNING,
+			DONE,
+			CANCELED, // Parsed by whoever needed it before the task started.
+		};
+
+		String path;
+		State state = QUEUED;
+		bool taken = false;
+		bool finished = false; // The parsing thread won't touch this anymore.
+		GDScriptParser *parser = nullptr;
+		Error result = OK;
+		uint32_t source_hash = 0;
+		uint64_t done_msec = 0;
+		Semaphore done;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
 	// String key is full path.
 	HashMap<String, GDScriptParserRef *> parser_map;
 	HashMap<String, Vector<ObjectID>> abandoned_parser_map;
@@ -87,6 +111,14 @@ class GDScriptCache {
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
 
+	// Guards the prefetch state only, so parsing threads never wait for the cache mutex.
+	// Must be locked after `mutex` when both are needed.
+	BinaryMutex prefetch_mutex;
+	HashMap<String, PrefetchedParser *> prefetched_parsers;
+	LocalVector<PrefetchedParser *> prefetch_tasks;
+	HashSet<String> prefetch_known; // Scripts already parsed or queued.
+	static constexpr uint64_t PREFETCH_EXPIRE_MSEC = 10000; // Parses nobody asked for are dropped after this.
+
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
@@ -95,6 +127,15 @@ class GDScriptCache {
 
 	bool cleared = false;
 
+	static void _prefetch_task(void *p_userdata);
+	static void _run_prefetch(PrefetchedParser *p_prefetched);
+	static void _prefetch_on_caller_thread(const String &p_path);
+	static void _prefetch_dependencies(const List<String> &p_dependencies);
+	static void _reap_prefetch_tasks(bool p_wait);
+	static void _evict_unused_prefetches();
+	static bool _take_prefetched_parser(const String &p_path, GDScriptParser *&r_parser, Error &r_result, uint32_t &r_source_hash);
+	static void _forget_prefetched_parser(const String &p_path);
+
 public:
 	static const int BINARY_MUTEX_TAG = 2;
 
@@ -108,6 +149,8 @@ public:
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
+	static void prefetch_parser(const String &p_path);
+	static void evict_unused_prefetched_parsers();
 	static String get_source_code(const String &p_path);
 	static Vector<uint8_t> get_binary_tokens(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
@@ -115,6 +158,7 @@ public:
 	static Ref<GDScript> get_cached_script(const String &p_path);
 	static Error finish_compiling(const String &p_owner);
 	static void add_static_script(Ref<GDScript> p_script);
+	static bool has_static_script(const String &p_fqcn);
 	static void remove_static_script(const String &p_fqcn);
 
 	static void clear();
@@ -251,6 +251,296 @@ static bool _can_use_validate_call(const MethodBind *p_method, const Vector<GDSc
 	return true;
 }
 
+// Limits for `_get_inline_function()`, so only small functions get copied into their callers.
+static constexpr int MAX_INLINE_DEPTH = 3;
+static constexpr int MAX_INLINE_NODES = 24;
+
+static StringName _get_native_base(const GDScriptParser::ClassNode *p_class) {
+	while (p_class->base_type.kind == GDScriptParser::DataType::CLASS && p_class->base_type.class_type != nullptr) {
+		p_class = p_class->base_type.class_type;
+	}
+	return p_class->base_type.native_type;
+}
+
+static bool _is_plain_builtin(const GDScriptParser::DataType &p_type) {
+	return p_type.is_hard_type() && p_type.kind == GDScriptParser::DataType::BUILTIN && !p_type.has_container_element_types();
+}
+
+const GDScriptParser::FunctionNode *GDScriptCompiler::_get_inline_function(const GDScriptParser::CallNode *p_call, const GDScriptParser::ClassNode *p_class, int p_depth, const GDScriptParser::ClassNode *&r_owner) const {
+	if (!inline_functions || p_depth >= MAX_INLINE_DEPTH || p_call->is_super || p_call == awaited_node || p_call->callee == nullptr) {
+		return nullptr;
+	}
+
+	// Only static functions are known at compile time: methods can be overridden by scripts that don't exist yet.
+	const StringName &name = p_call->function_name;
+	const GDScriptParser::ClassNode *search = nullptr;
+	if (p_call->callee->type == GDScriptParser::Node::IDENTIFIER) {
+		if (p_class == nullptr || !p_call->is_static || name == SNAME("new")) {
+			return nullptr;
+		}
+		if (GDScriptParser::get_builtin_type(name) < Variant::VARIANT_MAX || Variant::has_utility_function(name) || GDScriptUtilityFunctions::function_exists(name) || ClassDB::has_method(_get_native_base(p_class), name)) {
+			return nullptr;
+		}
+		search = p_class;
+	} else if (p_call->callee->type == GDScriptParser::Node::SUBSCRIPT) {
+		// Static function of a preloaded or global class, the base has no side effects to keep.
+		const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_call->callee);
+		const GDScriptParser::DataType base_type = subscript->base->get_datatype();
+		if (!subscript->is_attribute || !subscript->base->is_constant || !base_type.is_meta_type || base_type.kind != GDScriptParser::DataType::CLASS) {
+			return nullptr;
+		}
+		search = base_type.class_type;
+	}
+
+	const GDScriptParser::FunctionNode *function = nullptr;
+	const GDScriptParser::ClassNode *owner = nullptr;
+	for (const GDScriptParser::ClassNode *class_node = search; class_node != nullptr; class_node = class_node->base_type.class_type) {
+		if (class_node->has_member(name)) {
+			const GDScriptParser::ClassNode::Member &member = class_node->get_member(name);
+			if (member.type == GDScriptParser::ClassNode::Member::FUNCTION) {
+				function = member.function;
+				owner = class_node;
+			}
+			break;
+		}
+	}
+
+	if (function == nullptr || !function->is_static || function->is_coroutine || function->body == nullptr || function->body->statements.size() != 1 || function->parameters.size() != p_call->arguments.size()) {
+		return nullptr;
+	}
+	if (function->body->statements[0]->type != GDScriptParser::Node::RETURN) {
+		return nullptr;
+	}
+	const GDScriptParser::ExpressionNode *value = static_cast<const GDScriptParser::ReturnNode *>(function->body->statements[0])->return_value;
+	if (value == nullptr) {
+		return nullptr;
+	}
+
+	// Typed parameters and return values convert on call, only inline when there is nothing to convert.
+	for (int i = 0; i < function->parameters.size(); i++) {
+		const GDScriptParser::DataType parameter_type = function->parameters[i]->get_datatype();
+		if (!parameter_type.is_hard_type() || parameter_type.is_variant()) {
+			continue;
+		}
+		const GDScriptParser::DataType argument_type = p_call->arguments[i]->get_datatype();
+		if (!_is_plain_builtin(parameter_type) || !_is_plain_builtin(argument_type) || argument_type.builtin_type != parameter_type.builtin_type) {
+			return nullptr;
+		}
+	}
+	const GDScriptParser::DataType call_type = p_call->get_datatype();
+	if (call_type.is_hard_type() && !call_type.is_variant()) {
+		const GDScriptParser::DataType value_type = value->get_datatype();
+		if (!_is_plain_builtin(call_type) || !_is_plain_builtin(value_type) || value_type.builtin_type != call_type.builtin_type) {
+			return nullptr;
+		}
+	}
+
+	int budget = MAX_INLINE_NODES;
+	if (!_is_inlinable_expression(value, function, owner, p_depth + 1, budget)) {
+		return nullptr;
+	}
+
+	r_owner = owner;
+	return function;
+}
+
+bool GDScriptCompiler::_is_inlinable_expression(const GDScriptParser::ExpressionNode *p_expression, const GDScriptParser::FunctionNode *p_function, const GDScriptParser::ClassNode *p_owner, int p_depth, int &r_budget) const {
+	if (p_expression == nullptr || --r_budget < 0) {
+		return false;
+	}
+
+	// The body is compiled in the caller's context, so it can't refer to anything but parameters, constants and built-in types.
+	const GDScriptParser::DataType type = p_expression->get_datatype();
+	if (type.is_meta_type || (type.is_hard_type() && !type.is_variant() && type.kind != GDScriptParser::DataType::BUILTIN)) {
+		return false;
+	}
+	if (p_expression->is_constant) {
+		return true;
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+			return identifier->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER && p_function->parameters.has(identifier->parameter_source);
+		}
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			return _is_inlinable_expression(binary->left_operand, p_function, p_owner, p_depth, r_budget) && _is_inlinable_expression(binary->right_operand, p_function, p_owner, p_depth, r_budget);
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+			return _is_inlinable_expression(unary->operand, p_function, p_owner, p_depth, r_budget);
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			return _is_inlinable_expression(ternary->condition, p_function, p_owner, p_depth, r_budget) && _is_inlinable_expression(ternary->true_expr, p_function, p_owner, p_depth, r_budget) && _is_inlinable_expression(ternary->false_expr, p_function, p_owner, p_depth, r_budget);
+		}
+		case GDScriptParser::Node::SUBSCRIPT: {
+			const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(p_expression);
+			if (!_is_plain_builtin(subscript->base->get_datatype()) || !_is_inlinable_expression(subscript->base, p_function, p_owner, p_depth, r_budget)) {
+				return false;
+			}
+			return subscript->is_attribute || _is_inlinable_expression(subscript->index, p_function, p_owner, p_depth, r_budget);
+		}
+		case GDScriptParser::Node::CALL: {
+			const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(p_expression);
+			if (call->is_super || call->callee == nullptr) {
+				return false;
+			}
+			for (const GDScriptParser::ExpressionNode *argument : call->arguments) {
+				if (!_is_inlinable_expression(argument, p_function, p_owner, p_depth, r_budget)) {
+					return false;
+				}
+			}
+			if (call->callee->type == GDScriptParser::Node::IDENTIFIER) {
+				const StringName &name = call->function_name;
+				if (GDScriptParser::get_builtin_type(name) < Variant::VARIANT_MAX || Variant::has_utility_function(name) || GDScriptUtilityFunctions::function_exists(name)) {
+					return true;
+				}
+			} else if (call->callee->type == GDScriptParser::Node::SUBSCRIPT) {
+				const GDScriptParser::SubscriptNode *subscript = static_cast<const GDScriptParser::SubscriptNode *>(call->callee);
+				if (subscript->is_attribute && _is_plain_builtin(subscript->base->get_datatype()) && !subscript->base->get_datatype().is_meta_type) {
+					// Method of a built-in value. Parameters alias the caller's arguments, so it must not modify its base.
+					const Variant::Type base_type = subscript->base->get_datatype().builtin_type;
+					if (!Variant::has_builtin_method(base_type, call->function_name) || !Variant::is_builtin_method_const(base_type, call->function_name)) {
+						return false;
+					}
+					return _is_inlinable_expression(subscript->base, p_function, p_owner, p_depth, r_budget);
+				}
+			}
+			// Any other call must be inlined as well, it would be looked up on the caller's class otherwise.
+			const GDScriptParser::ClassNode *owner = nullptr;
+			return _get_inline_function(call, p_owner, p_depth, owner) != nullptr;
+		}
+		default:
+			return false;
+	}
+}
+
+bool GDScriptCompiler::_fold_inline_expression(const GDScriptParser::ExpressionNode *p_expression, const GDScriptParser::FunctionNode *p_function, const GDScriptParser::CallNode *p_call, Variant &r_value) const {
+	if (p_expression->is_constant) {
+		r_value = p_expression->reduced_value;
+		return true;
+	}
+
+	switch (p_expression->type) {
+		case GDScriptParser::Node::IDENTIFIER: {
+			const GDScriptParser::IdentifierNode *identifier = static_cast<const GDScriptParser::IdentifierNode *>(p_expression);
+			const GDScriptParser::ExpressionNode *argument = p_call->arguments[p_function->parameters.find(identifier->parameter_source)];
+			if (!argument->is_constant) {
+				return false;
+			}
+			r_value = argument->reduced_value;
+			return true;
+		}
+		case GDScriptParser::Node::BINARY_OPERATOR: {
+			const GDScriptParser::BinaryOpNode *binary = static_cast<const GDScriptParser::BinaryOpNode *>(p_expression);
+			Variant left;
+			Variant right;
+			if (!_fold_inline_expression(binary->left_operand, p_function, p_call, left) || !_fold_inline_expression(binary->right_operand, p_function, p_call, right)) {
+				return false;
+			}
+			bool valid = false;
+			Variant::evaluate(binary->variant_op, left, right, r_value, valid);
+			return valid;
+		}
+		case GDScriptParser::Node::UNARY_OPERATOR: {
+			const GDScriptParser::UnaryOpNode *unary = static_cast<const GDScriptParser::UnaryOpNode *>(p_expression);
+			Variant operand;
+			if (!_fold_inline_expression(unary->operand, p_function, p_call, operand)) {
+				return false;
+			}
+			bool valid = false;
+			Variant::evaluate(unary->variant_op, operand, Variant(), r_value, valid);
+			return valid;
+		}
+		case GDScriptParser::Node::TERNARY_OPERATOR: {
+			const GDScriptParser::TernaryOpNode *ternary = static_cast<const GDScriptParser::TernaryOpNode *>(p_expression);
+			Variant condition;
+			if (!_fold_inline_expression(ternary->condition, p_function, p_call, condition)) {
+				return false;
+			}
+			return _fold_inline_expression(condition.booleanize() ? ternary->true_expr : ternary->false_expr, p_function, p_call, r_value);
+		}
+		default:
+			// Calls may have side effects.
+			return false;
+	}
+}
+
+GDScriptCodeGenerator::Address GDScriptCompiler::_parse_inline_call(CodeGen &codegen, Error &r_error, const GDScriptParser::CallNode *p_call, const GDScriptParser::FunctionNode *p_function, const GDScriptParser::ClassNode *p_owner, bool p_root) {
+	GDScriptCodeGenerator *gen = codegen.generator;
+	const GDScriptParser::ExpressionNode *body = static_cast<const GDScriptParser::ReturnNode *>(p_function->body->statements[0])->return_value;
+
+#ifdef DEBUG_ENABLED
+	String callee = p_function->identifier->name;
+	if (p_owner != codegen.class_node) {
+		callee = (p_owner->identifier ? String(p_owner->identifier->name) : p_owner->fqcn.get_file()) + "." + callee;
+	}
+	int stats = 0;
+	while (stats < codegen.inlined_calls.size() && codegen.inlined_calls[stats].callee != callee) {
+		stats++;
+	}
+	if (stats == codegen.inlined_calls.size()) {
+		GDScriptFunction::InlinedCall inlined_call;
+		inlined_call.callee = callee;
+		codegen.inlined_calls.push_back(inlined_call);
+	}
+	codegen.inlined_calls.write[stats].count++;
+#endif
+
+	Variant folded;
+	if (_fold_inline_expression(body, p_function, p_call, folded)) {
+#ifdef DEBUG_ENABLED
+		codegen.inlined_calls.write[stats].folded++;
+#endif
+		return codegen.add_constant(folded);
+	}
+
+	GDScriptCodeGenerator::Address result;
+	if (p_root) {
+		result = GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::NIL);
+	} else {
+		result = codegen.add_temporary(_gdtype_from_datatype(p_call->get_datatype(), codegen.script));
+	}
+
+	CodeGen::InlineFrame frame;
+	frame.function = p_function;
+	frame.class_node = p_owner;
+	frame.depth = codegen.inline_frame ? codegen.inline_frame->depth + 1 : 1;
+	for (int i = 0; i < p_call->arguments.size(); i++) {
+		GDScriptCodeGenerator::Address argument = _parse_expression(codegen, r_error, p_call->arguments[i]);
+		if (r_error) {
+			return GDScriptCodeGenerator::Address();
+		}
+		if (argument.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+			// Each use of the parameter would release the temporary, so keep the argument in a hidden local instead.
+			const StringName local_name = "@inline_" + String(p_function->parameters[i]->identifier->name);
+			GDScriptCodeGenerator::Address local(GDScriptCodeGenerator::Address::LOCAL_VARIABLE, gen->add_local(local_name, argument.type), argument.type);
+			gen->write_assign(local, argument);
+			gen->pop_temporary();
+			argument = local;
+		}
+		frame.arguments.push_back(argument);
+	}
+
+	const CodeGen::InlineFrame *previous_frame = codegen.inline_frame;
+	codegen.inline_frame = &frame;
+	GDScriptCodeGenerator::Address value = _parse_expression(codegen, r_error, body, p_root);
+	codegen.inline_frame = previous_frame;
+	if (r_error) {
+		return GDScriptCodeGenerator::Address();
+	}
+
+	if (!p_root) {
+		gen->write_assign(result, value);
+	}
+	if (value.mode == GDScriptCodeGenerator::Address::TEMPORARY) {
+		gen->pop_temporary();
+	}
+	return result;
+}
+
 GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root, bool p_initializer) {
 	if (p_expression->is_constant && !(p_expression->get_datatype().is_meta_type && p_expression->get_datatype().kind == GDScriptParser::DataType::CLASS)) {
 		return codegen.add_constant(p_expression->reduced_value);
@@ -265,6 +555,14 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 
 			StringName identifier = in->name;
 
+			if (codegen.inline_frame != nullptr && in->source == GDScriptParser::IdentifierNode::FUNCTION_PARAMETER) {
+				// Parameter of an inlined function, see `_parse_inline_call()`.
+				int index = codegen.inline_frame->function->parameters.find(in->parameter_source);
+				if (index >= 0) {
+					return codegen.inline_frame->arguments[index];
+				}
+			}
+
 			switch (in->source) {
 				// LOCALS.
 				case GDScriptParser::IdentifierNode::FUNCTION_PARAMETER:
@@ -601,6 +899,14 @@ GDScriptCodeGenerator::Address GDScriptCompiler::_parse_expression(CodeGen &code
 		} break;
 		case GDScriptParser::Node::CALL: {
 			const GDScriptParser::CallNode *call = static_cast<const GDScriptParser::CallNode *>(p_expression);
+			{
+				const GDScriptParser::ClassNode *inline_owner = nullptr;
+				const GDScriptParser::ClassNode *call_class = codegen.inline_frame ? codegen.inline_frame->class_node : codegen.class_node;
+				const GDScriptParser::FunctionNode *inline_function = _get_inline_function(call, call_class, codegen.inline_frame ? codegen.inline_frame->depth : 0, inline_owner);
+				if (inline_function != nullptr) {
+					return _parse_inline_call(codegen, r_error, call, inline_function, inline_owner, p_root);
+				}
+			}
 			bool is_awaited = p_expression == awaited_node;
 			GDScriptDataType type = _gdtype_from_datatype(call->get_datatype(), codegen.script);
 			GDScriptCodeGenerator::Address result;
@@ -1895,7 +2201,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 #ifdef DEBUG_ENABLED
 		// Add a newline before each statement, since the debugger needs those.
-		gen->write_newline(s->start_line);
+		if (!release_bytecode) {
+			gen->write_newline(s->start_line);
+		}
 #endif
 
 		switch (s->type) {
@@ -1947,7 +2255,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 
 #ifdef DEBUG_ENABLED
 					// Add a newline before each branch, since the debugger needs those.
-					gen->write_newline(branch->start_line);
+					if (!release_bytecode) {
+						gen->write_newline(branch->start_line);
+					}
 #endif
 					// For each pattern in branch.
 					GDScriptCodeGenerator::Address pattern_result = codegen.add_temporary();
@@ -2135,6 +2445,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::ASSERT: {
 #ifdef DEBUG_ENABLED
+				if (release_bytecode) {
+					break;
+				}
 				const GDScriptParser::AssertNode *as = static_cast<const GDScriptParser::AssertNode *>(s);
 
 				GDScriptCodeGenerator::Address condition = _parse_expression(codegen, err, as->condition);
@@ -2162,7 +2475,9 @@ Error GDScriptCompiler::_parse_block(CodeGen &codegen, const GDScriptParser::Sui
 			} break;
 			case GDScriptParser::Node::BREAKPOINT: {
 #ifdef DEBUG_ENABLED
-				gen->write_breakpoint();
+				if (!release_bytecode) {
+					gen->write_breakpoint();
+				}
 #endif
 			} break;
 			case GDScriptParser::Node::VARIABLE: {
@@ -2445,6 +2760,9 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 	}
 
 	GDScriptFunction *gd_function = codegen.generator->write_end();
+#ifdef DEBUG_ENABLED
+	gd_function->inlined_calls = codegen.inlined_calls;
+#endif
 
 	if (is_initializer) {
 		p_script->initializer = gd_function;
@@ -2607,6 +2925,9 @@ GDScriptFunction *GDScriptCompiler::_make_static_initializer(Error &r_error, GDS
 	codegen.generator->set_initial_line(p_class->start_line);
 
 	GDScriptFunction *gd_function = codegen.generator->write_end();
+#ifdef DEBUG_ENABLED
+	gd_function->inlined_calls = codegen.inlined_calls;
+#endif
 
 	memdelete(codegen.generator);
 
@@ -3243,6 +3564,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	source = p_script->get_path();
 
+	// Inlined bodies can't stop at breakpoints, and would go stale when the editor reloads only the callee's script.
+	inline_functions = GDScriptLanguage::get_singleton()->is_bytecode_optimization_enabled() && !EngineDebugger::is_active() && !Engine::get_singleton()->is_editor_hint();
+
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
 	// Create scripts for subclasses beforehand so they can be referenced
@@ -3266,7 +3590,7 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	_get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
 	main_script->_recurse_replace_function_ptrs(func_ptr_replacements);
 
-	if (has_static_data && !root->annotated_static_unload) {
+	if (has_static_data && !root->annotated_static_unload && !release_bytecode) {
 		GDScriptCache::add_static_script(p_script);
 	}
 
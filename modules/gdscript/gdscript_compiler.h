@@ -83,6 +83,18 @@ class GDScriptCompiler {
 		List<HashMap<StringName, GDScriptCodeGenerator::Address>> locals_stack;
 		bool is_static = false;
 
+		// The function whose body is being compiled in place of a call, see `_parse_inline_call()`.
+		struct InlineFrame {
+			const GDScriptParser::FunctionNode *function = nullptr;
+			const GDScriptParser::ClassNode *class_node = nullptr;
+			Vector<GDScriptCodeGenerator::Address> arguments;
+			int depth = 0;
+		};
+		const InlineFrame *inline_frame = nullptr;
+#ifdef DEBUG_ENABLED
+		Vector<GDScriptFunction::InlinedCall> inlined_calls;
+#endif
+
 		GDScriptCodeGenerator::Address add_local(const StringName &p_name, const GDScriptDataType &p_type) {
 			uint32_t addr = generator->add_local(p_name, p_type);
 			locals[p_name] = GDScriptCodeGenerator::Address(GDScriptCodeGenerator::Address::LOCAL_VARIABLE, addr, p_type);
@@ -152,6 +164,10 @@ class GDScriptCompiler {
 	GDScriptDataType _gdtype_from_datatype(const GDScriptParser::DataType &p_datatype, GDScript *p_owner, bool p_handle_metatype = true);
 
 	GDScriptCodeGenerator::Address _parse_expression(CodeGen &codegen, Error &r_error, const GDScriptParser::ExpressionNode *p_expression, bool p_root = false, bool p_initializer = false);
+	const GDScriptParser::FunctionNode *_get_inline_function(const GDScriptParser::CallNode *p_call, const GDScriptParser::ClassNode *p_class, int p_depth, const GDScriptParser::ClassNode *&r_owner) const;
+	bool _is_inlinable_expression(const GDScriptParser::ExpressionNode *p_expression, const GDScriptParser::FunctionNode *p_function, const GDScriptParser::ClassNode *p_owner, int p_depth, int &r_budget) const;
+	bool _fold_inline_expression(const GDScriptParser::ExpressionNode *p_expression, const GDScriptParser::FunctionNode *p_function, const GDScriptParser::CallNode *p_call, Variant &r_value) const;
+	GDScriptCodeGenerator::Address _parse_inline_call(CodeGen &codegen, Error &r_error, const GDScriptParser::CallNode *p_call, const GDScriptParser::FunctionNode *p_function, const GDScriptParser::ClassNode *p_owner, bool p_root);
 	GDScriptCodeGenerator::Address _parse_match_pattern(CodeGen &codegen, Error &r_error, const GDScriptParser::PatternNode *p_pattern, const GDScriptCodeGenerator::Address &p_value_addr, const GDScriptCodeGenerator::Address &p_type_addr, const GDScriptCodeGenerator::Address &p_previous_test, bool p_is_first, bool p_is_nested);
 	List<GDScriptCodeGenerator::Address> _add_block_locals(CodeGen &codegen, const GDScriptParser::SuiteNode *p_block);
 	void _clear_block_locals(CodeGen &codegen, const List<GDScriptCodeGenerator::Address> &p_locals);
@@ -174,11 +190,16 @@ class GDScriptCompiler {
 	String error;
 	GDScriptParser::ExpressionNode *awaited_node = nullptr;
 	bool has_static_data = false;
+	bool inline_functions = false;
+	bool release_bytecode = false;
 
 public:
 	static void convert_to_initializer_type(Variant &p_variant, const GDScriptParser::VariableNode *p_node);
 	static void make_scripts(GDScript *p_script, const GDScriptParser::ClassNode *p_class, bool p_keep_state);
 	Error compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state = false);
+	// Leaves out the line, assert and breakpoint opcodes debug builds emit, so the bytecode matches what release
+	// templates compile. Such scripts are only meant to be stored, they aren't registered as static scripts.
+	void set_release_bytecode(bool p_enabled) { release_bytecode = p_enabled; }
 
 	String get_error() const;
 	int get_error_line() const;
@@ -100,6 +100,19 @@ static String _disassemble_address(const GDScript *p_script, const GDScriptFunct
 void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 #define DADDR(m_ip) (_disassemble_address(_script, *this, _code_ptr[ip + m_ip]))
 
+	if (!inlined_calls.is_empty()) {
+		int total = 0;
+		int folded = 0;
+		for (const InlinedCall &E : inlined_calls) {
+			total += E.count;
+			folded += E.folded;
+		}
+		print_line(vformat(" inlined calls: %d (folded to constants: %d)", total, folded));
+		for (const InlinedCall &E : inlined_calls) {
+			print_line(vformat("   %s: %d (folded: %d)", E.callee, E.count, E.folded));
+		}
+	}
+
 	for (int ip = 0; ip < _code_size;) {
 		StringBuilder text;
 		int incr = 0;
@@ -141,6 +154,126 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += "; assign ";
+				text += DADDR(5);
+				text += " = ";
+				text += DADDR(3);
+
+				incr += 6;
+			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF:
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += opcode == OPCODE_OPERATOR_VALIDATED_JUMP_IF ? "; jump-if " : "; jump-if-not ";
+				text += DADDR(3);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
+
+#define DISASSEMBLE_OPERATOR_UNBOXED(m_name, m_op) \
+	case OPCODE_OPERATOR_##m_name: {               \
+		text += "operator (";                      \
+		text += #m_name;                           \
+		text += ") ";                              \
+		text += DADDR(3);                          \
+		text += " = ";                             \
+		text += DADDR(1);                          \
+		text += " " m_op " ";                      \
+		text += DADDR(2);                          \
+		incr += 4;                                 \
+	} break
+
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_ADD, "+");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_SUBTRACT, "-");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_MULTIPLY, "*");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_EQUAL, "==");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_NOT_EQUAL, "!=");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_LESS, "<");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_LESS_EQUAL, "<=");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_GREATER, ">");
+				DISASSEMBLE_OPERATOR_UNBOXED(INT_GREATER_EQUAL, ">=");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_ADD, "+");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_SUBTRACT, "-");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_MULTIPLY, "*");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_DIVIDE, "/");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_EQUAL, "==");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_NOT_EQUAL, "!=");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_LESS, "<");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_LESS_EQUAL, "<=");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_GREATER, ">");
+				DISASSEMBLE_OPERATOR_UNBOXED(FLOAT_GREATER_EQUAL, ">=");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR2_ADD, "+");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR2_SUBTRACT, "-");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR2_MULTIPLY, "*");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR2_MULTIPLY_FLOAT, "*");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR3_ADD, "+");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR3_SUBTRACT, "-");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR3_MULTIPLY, "*");
+				DISASSEMBLE_OPERATOR_UNBOXED(VECTOR3_MULTIPLY_FLOAT, "*");
+
+#define DISASSEMBLE_OPERATOR_UNBOXED_UNARY(m_name, m_op) \
+	case OPCODE_OPERATOR_##m_name: {                     \
+		text += "operator (";                            \
+		text += #m_name;                                 \
+		text += ") ";                                    \
+		text += DADDR(3);                                \
+		text += " = " m_op;                              \
+		text += DADDR(1);                                \
+		incr += 4;                                       \
+	} break
+
+				DISASSEMBLE_OPERATOR_UNBOXED_UNARY(INT_NEGATE, "-");
+				DISASSEMBLE_OPERATOR_UNBOXED_UNARY(FLOAT_NEGATE, "-");
+				DISASSEMBLE_OPERATOR_UNBOXED_UNARY(BOOL_NOT, "not ");
+
+#define DISASSEMBLE_JUMP_IF_NOT_UNBOXED(m_name, m_op) \
+	case OPCODE_JUMP_IF_NOT_##m_name: {               \
+		text += "operator (";                         \
+		text += #m_name;                              \
+		text += ") ";                                 \
+		text += DADDR(3);                             \
+		text += " = ";                                \
+		text += DADDR(1);                             \
+		text += " " m_op " ";                         \
+		text += DADDR(2);                             \
+		text += "; jump-if-not ";                     \
+		text += DADDR(3);                             \
+		text += " to ";                               \
+		text += itos(_code_ptr[ip + 4]);              \
+		incr += 5;                                    \
+	} break
+
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_EQUAL, "==");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_NOT_EQUAL, "!=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_LESS, "<");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_LESS_EQUAL, "<=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_GREATER, ">");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(INT_GREATER_EQUAL, ">=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS, "<");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS_EQUAL, "<=");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER, ">");
+				DISASSEMBLE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER_EQUAL, ">=");
+
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -308,7 +441,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -329,7 +462,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -698,7 +831,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -888,6 +1021,36 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 5 + argc;
 			} break;
+			case OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED: {
+				text += "get_member ";
+				text += DADDR(1);
+				text += " = [\"";
+				text += _global_names_ptr[_code_ptr[ip + 2]];
+				text += "\"]; ";
+
+				ip += 2; // The call operands follow the member name.
+				int instr_var_args = _code_ptr[++ip];
+				int argc = _code_ptr[ip + 1 + instr_var_args];
+
+				text += "call-builtin-method validated ";
+
+				text += DADDR(2 + argc) + " = ";
+
+				text += DADDR(1 + argc) + ".";
+				text += builtin_methods_names[_code_ptr[ip + 4 + argc]];
+
+				text += "(";
+
+				for (int i = 0; i < argc; i++) {
+					if (i > 0) {
+						text += ", ";
+					}
+					text += DADDR(1 + i);
+				}
+				text += ")";
+
+				incr = 5 + argc;
+			} break;
 			case OPCODE_CALL_UTILITY: {
 				int instr_var_args = _code_ptr[++ip];
 
@@ -31,6 +31,10 @@
 #include "gdscript_function.h"
 
 #include "gdscript.h"
+#include "gdscript_inline_cache.h"
+
+#include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
 
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
@@ -121,6 +125,10 @@ GDScriptFunction::~GDScriptFunction() {
 		memdelete(lambdas[i]);
 	}
 
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -134,24 +142,56 @@ GDScriptFunction::~GDScriptFunction() {
 
 /////////////////////
 
+// Resumes a coroutine when the signal it awaits is emitted. Calls resume()
+// directly, rather than going through a bound `_signal_callback` method.
+class GDScriptFunctionState::ResumeCallable : public CallableCustom {
+	Ref<GDScriptFunctionState> state;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return static_cast<const ResumeCallable *>(p_a)->state == static_cast<const ResumeCallable *>(p_b)->state;
+	}
+
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b) {
+		return static_cast<const ResumeCallable *>(p_a)->state.ptr() < static_cast<const ResumeCallable *>(p_b)->state.ptr();
+	}
+
+public:
+	uint32_t hash() const override { return hash_one_uint64(state->get_instance_id()); }
+	String get_as_text() const override { return "GDScriptFunctionState::_signal_callback"; }
+	CompareEqualFunc get_compare_equal_func() const override { return compare_equal; }
+	CompareLessFunc get_compare_less_func() const override { return compare_less; }
+	ObjectID get_object() const override { return state->get_instance_id(); }
+	StringName get_method() const override { return SNAME("_signal_callback"); }
+
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override {
+		r_call_error.error = Callable::CallError::CALL_OK;
+		r_return_value = state->resume(_get_signal_argument(p_arguments, p_argcount));
+	}
+
+	ResumeCallable(const Ref<GDScriptFunctionState> &p_state) :
+			state(p_state) {}
+};
+
+Variant GDScriptFunctionState::_get_signal_argument(const Variant **p_args, int p_argcount) {
+	if (p_argcount == 0) {
+		return Variant();
+	} else if (p_argcount == 1) {
+		return *p_args[0];
+	}
+	Array extra_args;
+	for (int i = 0; i < p_argcount; i++) {
+		extra_args.push_back(*p_args[i]);
+	}
+	return extra_args;
+}
+
 Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
-	Variant arg;
 	r_error.error = Callable::CallError::CALL_OK;
 
 	if (p_argcount == 0) {
 		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
 		r_error.expected = 1;
 		return Variant();
-	} else if (p_argcount == 1) {
-		//noooneee
-	} else if (p_argcount == 2) {
-		arg = *p_args[0];
-	} else {
-		Array extra_args;
-		for (int i = 0; i < p_argcount - 1; i++) {
-			extra_args.push_back(*p_args[i]);
-		}
-		arg = extra_args;
 	}
 
 	Ref<GDScriptFunctionState> self = *p_args[p_argcount - 1];
@@ -163,7 +203,13 @@ Variant GDScriptFunctionState::_signal_callback(const Variant **p_args, int p_ar
 		return Variant();
 	}
 
-	return resume(arg);
+	return resume(_get_signal_argument(p_args, p_argcount - 1));
+}
+
+Error GDScriptFunctionState::_connect_to_signal(const Signal &p_signal) {
+	Object *object = p_signal.get_object();
+	ERR_FAIL_NULL_V(object, ERR_INVALID_PARAMETER);
+	return object->connect(p_signal.get_name(), Callable(memnew(ResumeCallable(Ref<GDScriptFunctionState>(this)))), Object::CONNECT_ONE_SHOT);
 }
 
 bool GDScriptFunctionState::is_valid(bool p_extended_check) const {
@@ -221,6 +267,11 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 	// then the function did await again after resuming.
 	if (ret.is_ref_counted()) {
 		GDScriptFunctionState *gdfs = Object::cast_to<GDScriptFunctionState>(ret);
+		if (gdfs == this) {
+			// Awaiting again reuses this state and its stack, it can be resumed once more.
+			state.result = Variant();
+			return ret;
+		}
 		if (gdfs && gdfs->function == function) {
 			completed = false;
 			gdfs->first_state = first_state.is_valid() ? first_state : Ref<GDScriptFunctionState>(this);
@@ -251,7 +302,7 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 
 void GDScriptFunctionState::_clear_stack() {
 	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+		Variant *stack = (Variant *)state.stack;
 		// The first 3 are special addresses and not copied to the state, so we skip them here.
 		for (int i = 3; i < state.stack_size; i++) {
 			stack[i].~Variant();
@@ -277,9 +328,70 @@ void GDScriptFunctionState::_bind_methods() {
 	ADD_SIGNAL(MethodInfo("completed", PropertyInfo(Variant::NIL, "result", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_NIL_IS_VARIANT)));
 }
 
+static constexpr uint32_t COROUTINE_STACK_MIN_SHIFT = 6; // 64 bytes.
+static constexpr uint32_t COROUTINE_STACK_CLASSES = 11; // Up to 64 KiB, larger stacks aren't pooled.
+static constexpr uint32_t COROUTINE_STACK_MAX_FREE = 4096; // Per size class.
+
+static SpinLock coroutine_stack_lock;
+static LocalVector<uint8_t *> coroutine_stack_pool[COROUTINE_STACK_CLASSES];
+static bool coroutine_stack_pool_cleared = false; // Stacks freed after clear_stack_pool() aren't pooled again.
+
+static _FORCE_INLINE_ uint32_t _get_coroutine_stack_class(uint32_t p_size) {
+	return get_shift_from_power_of_2(next_power_of_2(MAX(p_size, 1u << COROUTINE_STACK_MIN_SHIFT))) - COROUTINE_STACK_MIN_SHIFT;
+}
+
+uint8_t *GDScriptFunctionState::_alloc_stack(uint32_t p_size) {
+	const uint32_t size_class = _get_coroutine_stack_class(p_size);
+	if (size_class >= COROUTINE_STACK_CLASSES) {
+		return (uint8_t *)memalloc(p_size);
+	}
+
+	coroutine_stack_lock.lock();
+	LocalVector<uint8_t *> &pool = coroutine_stack_pool[size_class];
+	if (!pool.is_empty()) {
+		uint8_t *stack = pool[pool.size() - 1];
+		pool.resize(pool.size() - 1);
+		coroutine_stack_lock.unlock();
+		return stack;
+	}
+	coroutine_stack_lock.unlock();
+	return (uint8_t *)memalloc(1u << (size_class + COROUTINE_STACK_MIN_SHIFT));
+}
+
+void GDScriptFunctionState::_free_stack(uint8_t *p_stack, uint32_t p_size) {
+	if (!p_stack) {
+		return;
+	}
+	const uint32_t size_class = _get_coroutine_stack_class(p_size);
+	if (size_class < COROUTINE_STACK_CLASSES) {
+		coroutine_stack_lock.lock();
+		LocalVector<uint8_t *> &pool = coroutine_stack_pool[size_class];
+		if (!coroutine_stack_pool_cleared && pool.size() < COROUTINE_STACK_MAX_FREE) {
+			pool.push_back(p_stack);
+			coroutine_stack_lock.unlock();
+			return;
+		}
+		coroutine_stack_lock.unlock();
+	}
+	memfree(p_stack);
+}
+
+void GDScriptFunctionState::clear_stack_pool() {
+	coroutine_stack_lock.lock();
+	for (LocalVector<uint8_t *> &pool : coroutine_stack_pool) {
+		for (uint8_t *stack : pool) {
+			memfree(stack);
+		}
+		pool.reset();
+	}
+	coroutine_stack_pool_cleared = true;
+	coroutine_stack_lock.unlock();
+}
+
 GDScriptFunctionState::GDScriptFunctionState() :
 		scripts_list(this),
 		instances_list(this) {
+	state.owner = this;
 }
 
 GDScriptFunctionState::~GDScriptFunctionState() {
@@ -288,4 +400,5 @@ GDScriptFunctionState::~GDScriptFunctionState() {
 		scripts_list.remove_from_list();
 		instances_list.remove_from_list();
 	}
+	_free_stack(state.stack, state.alloca_size);
 }
@@ -41,6 +41,8 @@
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+class GDScriptFunctionState;
+class GDScriptInlineCache;
 class GDScriptInstance;
 class GDScript;
 
@@ -257,6 +259,51 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN, // Superinstruction, see `GDScriptByteCodeGenerator::optimize_bytecode()`.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF, // Superinstruction.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, // Superinstruction.
+		// Operators on typed operands, working on the values stored in place. Comparisons must stay in the same order
+		// as the matching jumps below.
+		OPCODE_OPERATOR_INT_ADD,
+		OPCODE_OPERATOR_INT_SUBTRACT,
+		OPCODE_OPERATOR_INT_MULTIPLY,
+		OPCODE_OPERATOR_INT_EQUAL,
+		OPCODE_OPERATOR_INT_NOT_EQUAL,
+		OPCODE_OPERATOR_INT_LESS,
+		OPCODE_OPERATOR_INT_LESS_EQUAL,
+		OPCODE_OPERATOR_INT_GREATER,
+		OPCODE_OPERATOR_INT_GREATER_EQUAL,
+		OPCODE_OPERATOR_INT_NEGATE,
+		OPCODE_OPERATOR_FLOAT_ADD,
+		OPCODE_OPERATOR_FLOAT_SUBTRACT,
+		OPCODE_OPERATOR_FLOAT_MULTIPLY,
+		OPCODE_OPERATOR_FLOAT_DIVIDE,
+		OPCODE_OPERATOR_FLOAT_EQUAL,
+		OPCODE_OPERATOR_FLOAT_NOT_EQUAL,
+		OPCODE_OPERATOR_FLOAT_LESS,
+		OPCODE_OPERATOR_FLOAT_LESS_EQUAL,
+		OPCODE_OPERATOR_FLOAT_GREATER,
+		OPCODE_OPERATOR_FLOAT_GREATER_EQUAL,
+		OPCODE_OPERATOR_FLOAT_NEGATE,
+		OPCODE_OPERATOR_BOOL_NOT,
+		OPCODE_OPERATOR_VECTOR2_ADD,
+		OPCODE_OPERATOR_VECTOR2_SUBTRACT,
+		OPCODE_OPERATOR_VECTOR2_MULTIPLY,
+		OPCODE_OPERATOR_VECTOR2_MULTIPLY_FLOAT,
+		OPCODE_OPERATOR_VECTOR3_ADD,
+		OPCODE_OPERATOR_VECTOR3_SUBTRACT,
+		OPCODE_OPERATOR_VECTOR3_MULTIPLY,
+		OPCODE_OPERATOR_VECTOR3_MULTIPLY_FLOAT,
+		OPCODE_JUMP_IF_NOT_INT_EQUAL, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_INT_LESS, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_INT_GREATER, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_FLOAT_LESS, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_FLOAT_GREATER, // Superinstruction.
+		OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL, // Superinstruction.
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -301,6 +348,7 @@ public:
 		OPCODE_CALL_UTILITY_VALIDATED,
 		OPCODE_CALL_GDSCRIPT_UTILITY,
 		OPCODE_CALL_BUILTIN_TYPE_VALIDATED,
+		OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED, // Superinstruction.
 		OPCODE_CALL_SELF_BASE,
 		OPCODE_CALL_METHOD_BIND,
 		OPCODE_CALL_METHOD_BIND_RET,
@@ -440,11 +488,22 @@ public:
 		StringName identifier;
 	};
 
+#ifdef DEBUG_ENABLED
+	// Calls replaced by the body of the callee, see `GDScriptCompiler::_parse_inline_call()`.
+	struct InlinedCall {
+		String callee;
+		int count = 0;
+		int folded = 0; // Calls with constant arguments, reduced to a constant.
+	};
+#endif
+
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptSamplingProfiler;
 
 	StringName name;
 	StringName source;
@@ -482,6 +541,11 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+#ifdef TOOLS_ENABLED
+	// Code words that only hold for the current process, rewritten when storing bytecode.
+	Vector<int> global_index_positions;
+	Vector<int> operator_cache_positions;
+#endif
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -500,6 +564,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -518,6 +583,7 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	GDScriptInlineCache *_inline_caches_ptr = nullptr;
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -530,6 +596,7 @@ private:
 	Vector<String> constructors_names;
 	Vector<String> utilities_names;
 	Vector<String> gds_utilities_names;
+	Vector<InlinedCall> inlined_calls;
 
 	struct Profile {
 		StringName signature;
@@ -550,6 +617,7 @@ private:
 		HashMap<String, NativeProfile> native_calls;
 		HashMap<String, NativeProfile> last_native_calls;
 	} profile;
+	SafeNumeric<uint32_t> sampling_id; // Assigned by GDScriptSamplingProfiler when first sampled.
 #endif
 
 	_FORCE_INLINE_ String _get_call_error(const String &p_where, const Variant **p_argptrs, const Variant &p_ret, const Callable::CallError &p_err) const;
@@ -565,7 +633,8 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		GDScriptFunctionState *owner = nullptr;
+		uint8_t *stack = nullptr; // `alloca_size` bytes from GDScriptFunctionState::_alloc_stack().
 		int stack_size = 0;
 		uint32_t alloca_size = 0;
 		int ip = 0;
@@ -582,6 +651,7 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ int get_code_size() const { return _code_size; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
@@ -592,6 +662,7 @@ public:
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+	const Vector<InlinedCall> &get_inlined_calls() const { return inlined_calls; }
 #endif
 
 	GDScriptFunction();
@@ -606,6 +677,9 @@ class GDScriptFunctionState : public RefCounted {
 	Variant _signal_callback(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	Ref<GDScriptFunctionState> first_state;
 
+	class ResumeCallable;
+	static Variant _get_signal_argument(const Variant **p_args, int p_argcount);
+
 	SelfList<GDScriptFunctionState> scripts_list;
 	SelfList<GDScriptFunctionState> instances_list;
 
@@ -618,6 +692,12 @@ public:
 
 	void _clear_stack();
 	void _clear_connections();
+	Error _connect_to_signal(const Signal &p_signal);
+
+	// Coroutine stacks are recycled in power of two size classes.
+	static uint8_t *_alloc_stack(uint32_t p_size);
+	static void _free_stack(uint8_t *p_stack, uint32_t p_size);
+	static void clear_stack_pool();
 
 	GDScriptFunctionState();
 	~GDScriptFunctionState();
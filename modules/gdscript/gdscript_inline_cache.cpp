@@ -0,0 +1,222 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_inline_cache.h"
+
+#include "scene/scene_string_names.h"
+
+const ClassDB::ClassInfo *GDScriptInlineCache::_get_native_class_info(const StringName &p_class) {
+	const ClassDB::ClassInfo *info = ClassDB::classes.getptr(p_class);
+	if (!info || info->gdextension) {
+		return nullptr; // Extension instances have their own get/set callbacks, which Object tries first.
+	}
+	return info;
+}
+
+bool GDScriptInlineCache::_is_script_chain_valid(const GDScript *p_script) {
+	for (const GDScript *script = p_script; script; script = script->_base) {
+		if (!script->valid) {
+			return false;
+		}
+	}
+	return true;
+}
+
+GDScriptInlineCache::Hit GDScriptInlineCache::_resolve_get(const StringName &p_class, GDScript *p_script, const StringName &p_name) {
+	Hit hit;
+	hit.kind = KIND_GENERIC;
+
+	const ClassDB::ClassInfo *info = _get_native_class_info(p_class);
+	if (!info) {
+		return hit;
+	}
+
+	// Mirrors GDScriptInstance::get().
+	if (p_script) {
+		if (!_is_script_chain_valid(p_script)) {
+			return hit;
+		}
+		const GDScript::MemberInfo *member = p_script->member_indices.getptr(p_name);
+		if (member) {
+			if (member->getter == StringName()) {
+				hit.kind = KIND_SCRIPT_MEMBER;
+				hit.index = member->index;
+			}
+			return hit;
+		}
+		const StringName &get_function = GDScriptLanguage::get_singleton()->strings._get;
+		for (const GDScript *script = p_script; script; script = script->_base) {
+			if (script->constants.has(p_name) || script->static_variables_indices.has(p_name) || script->_signals.has(p_name) ||
+					script->member_functions.has(p_name) || script->subclasses.has(p_name) || script->member_functions.has(get_function)) {
+				return hit;
+			}
+		}
+	}
+
+	// Mirrors ClassDB::get_property().
+	const ClassDB::ClassInfo *check = info;
+	while (check) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			if (psg->getter == StringName()) {
+				return hit;
+			}
+			if (psg->index >= 0) {
+				// Called through Object::callp(), so a script function with the same name wins.
+				if (p_script) {
+					for (const GDScript *script = p_script; script; script = script->_base) {
+						if (script->member_functions.has(psg->getter)) {
+							return hit;
+						}
+					}
+				}
+				MethodBind *getter = ClassDB::get_method(p_class, psg->getter);
+				if (getter) {
+					hit.kind = KIND_NATIVE_GETTER;
+					hit.index = psg->index;
+					hit.target = getter;
+				}
+			} else if (psg->_getptr) {
+				hit.kind = KIND_NATIVE_GETTER;
+				hit.target = psg->_getptr;
+			}
+			return hit;
+		}
+		if (check->constant_map.has(p_name) || check->method_map.has(p_name) || check->signal_map.has(p_name)) {
+			return hit;
+		}
+		check = check->inherits_ptr;
+	}
+
+	return hit;
+}
+
+GDScriptInlineCache::Hit GDScriptInlineCache::_resolve_set(const StringName &p_class, GDScript *p_script, const StringName &p_name) {
+	Hit hit;
+	hit.kind = KIND_GENERIC;
+
+	const ClassDB::ClassInfo *info = _get_native_class_info(p_class);
+	if (!info) {
+		return hit;
+	}
+
+	// Mirrors GDScriptInstance::set().
+	if (p_script) {
+		if (!_is_script_chain_valid(p_script)) {
+			return hit;
+		}
+		GDScript::MemberInfo *member = p_script->member_indices.getptr(p_name);
+		if (member) {
+			if (member->setter == StringName()) {
+				hit.kind = KIND_SCRIPT_MEMBER;
+				hit.index = member->index;
+				hit.target = &member->data_type;
+			}
+			return hit;
+		}
+		const StringName &set_function = GDScriptLanguage::get_singleton()->strings._set;
+		for (const GDScript *script = p_script; script; script = script->_base) {
+			if (script->static_variables_indices.has(p_name) || script->member_functions.has(set_function)) {
+				return hit;
+			}
+		}
+	}
+
+	// Mirrors ClassDB::set_property(), which always uses the bound setter when there is one.
+	const ClassDB::ClassInfo *check = info;
+	while (check) {
+		const ClassDB::PropertySetGet *psg = check->property_setget.getptr(p_name);
+		if (psg) {
+			if (psg->setter != StringName() && psg->_setptr) {
+				hit.kind = KIND_NATIVE_SETTER;
+				hit.index = psg->index;
+				hit.target = psg->_setptr;
+			}
+			return hit;
+		}
+		check = check->inherits_ptr;
+	}
+
+	return hit;
+}
+
+GDScriptInlineCache::Hit GDScriptInlineCache::_resolve_call(const StringName &p_class, GDScript *p_script, const StringName &p_name) {
+	Hit hit;
+	hit.kind = KIND_GENERIC;
+
+	// `free()` and `_ready()` have extra behavior in Object::callp() and GDScriptInstance::callp().
+	if (p_name == CoreStringName(free_) || p_name == SceneStringName(_ready) || !_get_native_class_info(p_class)) {
+		return hit;
+	}
+
+	if (p_script) {
+		if (!_is_script_chain_valid(p_script)) {
+			return hit;
+		}
+		for (const GDScript *script = p_script; script; script = script->_base) {
+			GDScriptFunction *const *function = script->member_functions.getptr(p_name);
+			if (function) {
+				hit.kind = KIND_SCRIPT_FUNCTION;
+				hit.target = *function;
+				return hit;
+			}
+		}
+	}
+
+	MethodBind *method = ClassDB::get_method(p_class, p_name);
+	if (method) {
+		hit.kind = KIND_NATIVE_METHOD;
+		hit.target = method;
+	}
+	return hit;
+}
+
+void GDScriptInlineCache::_store(const Key &p_key, const Hit &p_hit, uint32_t p_generation) {
+	const uint32_t fill = fills.fetch_add(1, std::memory_order_relaxed);
+	if (fill >= MAX_FILLS) {
+		return;
+	}
+
+	Entry &entry = entries[fill % WAYS];
+	uint32_t sequence = entry.sequence.load(std::memory_order_relaxed);
+	if ((sequence & 1) || !entry.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+		return; // Another thread is filling this entry.
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+
+	entry.generation.store(p_generation, std::memory_order_relaxed);
+	entry.class_id.store(p_key.class_id, std::memory_order_relaxed);
+	entry.script.store(p_key.script, std::memory_order_relaxed);
+	entry.kind.store(p_hit.kind, std::memory_order_relaxed);
+	entry.index.store(p_hit.index, std::memory_order_relaxed);
+	entry.target.store(p_hit.target, std::memory_order_relaxed);
+
+	entry.sequence.store(sequence + 2, std::memory_order_release);
+}
@@ -0,0 +1,299 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_INLINE_CACHE_H
+#define GDSCRIPT_INLINE_CACHE_H
+
+#include "gdscript.h"
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/variant/variant_internal.h"
+
+#include <atomic>
+
+// Per-instruction cache for named property access and method calls on objects
+// (OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL*).
+//
+// Each cache remembers how a name resolved for up to WAYS receiver shapes. A
+// shape is the native class of the object plus its GDScript, if any. Hits skip
+// the hash lookups along the script chain and in ClassDB and dispatch straight
+// to the member slot, GDScriptFunction or MethodBind. Names that resolve
+// through anything dynamic (`_get`, `_set`, property setters/getters written in
+// GDScript, constants, signals...) are cached as KIND_GENERIC and keep going
+// through the regular Object path.
+//
+// Objects of GDExtension classes resolve to KIND_GENERIC, and objects with a
+// non-GDScript (or placeholder) script instance always take the regular path.
+//
+// The same function can run on several threads, so every entry is guarded by
+// its own sequence counter: writers make it odd while filling the entry and
+// readers discard whatever they read if it changed under them.
+class GDScriptInlineCache {
+public:
+	enum Kind : uint32_t {
+		KIND_EMPTY,
+		KIND_GENERIC, // Resolved, but can only be handled by the regular path.
+		KIND_SCRIPT_MEMBER, // `index` is the member slot, `target` the member's GDScriptDataType.
+		KIND_SCRIPT_FUNCTION, // `target` is the GDScriptFunction.
+		KIND_NATIVE_METHOD, // `target` is the MethodBind.
+		KIND_NATIVE_GETTER, // `target` is the getter MethodBind, `index` the property index or -1.
+		KIND_NATIVE_SETTER, // `target` is the setter MethodBind, `index` the property index or -1.
+	};
+
+	static constexpr uint32_t WAYS = 4;
+	// Sites that keep missing after this many fills are megamorphic; they keep the
+	// entries they have but stop resolving new shapes.
+	static constexpr uint32_t MAX_FILLS = WAYS * 16;
+
+private:
+	struct Key {
+		const void *class_id = nullptr;
+		GDScript *script = nullptr;
+		GDScriptInstance *instance = nullptr; // Not part of the key, kept around for dispatch.
+	};
+
+	struct Hit {
+		Kind kind = KIND_EMPTY;
+		int32_t index = -1;
+		void *target = nullptr;
+	};
+
+	struct Entry {
+		std::atomic<uint32_t> sequence{ 0 };
+		std::atomic<uint32_t> generation{ 0 };
+		std::atomic<const void *> class_id{ nullptr };
+		std::atomic<GDScript *> script{ nullptr };
+		std::atomic<uint32_t> kind{ KIND_EMPTY };
+		std::atomic<int32_t> index{ -1 };
+		std::atomic<void *> target{ nullptr };
+	};
+
+	Entry entries[WAYS];
+	std::atomic<uint32_t> fills{ 0 };
+
+	// Bumped whenever a script is compiled or cleared, which invalidates every entry at once.
+	static inline std::atomic<uint32_t> generation{ 1 };
+
+	static const ClassDB::ClassInfo *_get_native_class_info(const StringName &p_class);
+	static bool _is_script_chain_valid(const GDScript *p_script);
+	static Hit _resolve_get(const StringName &p_class, GDScript *p_script, const StringName &p_name);
+	static Hit _resolve_set(const StringName &p_class, GDScript *p_script, const StringName &p_name);
+	static Hit _resolve_call(const StringName &p_class, GDScript *p_script, const StringName &p_name);
+
+	void _store(const Key &p_key, const Hit &p_hit, uint32_t p_generation);
+
+	_FORCE_INLINE_ static bool _make_key(Object *p_object, Key &r_key) {
+		ScriptInstance *script_instance = p_object->get_script_instance();
+		if (script_instance) {
+			if (unlikely(script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton())) {
+				return false;
+			}
+			r_key.instance = static_cast<GDScriptInstance *>(script_instance);
+			r_key.script = r_key.instance->script.ptr();
+		}
+		r_key.class_id = p_object->get_class_name().data_unique_pointer();
+		return true;
+	}
+
+	_FORCE_INLINE_ bool _lookup(const Key &p_key, uint32_t p_generation, Hit &r_hit) const {
+		for (uint32_t i = 0; i < WAYS; i++) {
+			const Entry &entry = entries[i];
+			const uint32_t sequence = entry.sequence.load(std::memory_order_acquire);
+			if (sequence & 1) {
+				continue; // Being written.
+			}
+			if (entry.class_id.load(std::memory_order_relaxed) != p_key.class_id || entry.script.load(std::memory_order_relaxed) != p_key.script || entry.generation.load(std::memory_order_relaxed) != p_generation) {
+				continue;
+			}
+			r_hit.kind = Kind(entry.kind.load(std::memory_order_relaxed));
+			r_hit.index = entry.index.load(std::memory_order_relaxed);
+			r_hit.target = entry.target.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (entry.sequence.load(std::memory_order_relaxed) == sequence && r_hit.kind != KIND_EMPTY) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	_FORCE_INLINE_ void _find(Object *p_object, const Key &p_key, const StringName &p_name, Hit &r_hit, Hit (*p_resolve)(const StringName &, GDScript *, const StringName &)) {
+		const uint32_t current_generation = generation.load(std::memory_order_acquire);
+		if (likely(_lookup(p_key, current_generation, r_hit))) {
+			return;
+		}
+		if (fills.load(std::memory_order_relaxed) >= MAX_FILLS) {
+			r_hit.kind = KIND_GENERIC;
+			return;
+		}
+		r_hit = p_resolve(p_object->get_class_name(), p_key.script, p_name);
+		// Stored under the generation read before resolving, so a script compiled
+		// in the meantime can't leave a stale entry behind.
+		_store(p_key, r_hit, current_generation);
+	}
+
+	_FORCE_INLINE_ static Object *_get_call_object(const Variant *p_base) {
+#ifdef DEBUG_ENABLED
+		return p_base->get_validated_object();
+#else
+		// Same as Variant::callp(), which doesn't validate the instance in release builds.
+		return p_base->get_type() == Variant::OBJECT ? const_cast<Object *>(*VariantInternal::get_object(p_base)) : nullptr;
+#endif
+	}
+
+public:
+	// Drops every cached entry in every function.
+	static void invalidate_all() { generation.fetch_add(1, std::memory_order_acq_rel); }
+
+	// Same as Variant::get_named().
+	_FORCE_INLINE_ Variant get_named(const Variant *p_base, const StringName &p_name, bool &r_valid) {
+		if (p_base->get_type() != Variant::OBJECT) {
+			return p_base->get_named(p_name, r_valid);
+		}
+		Object *object = p_base->get_validated_object();
+		Key key;
+		if (unlikely(!object || !_make_key(object, key))) {
+			return p_base->get_named(p_name, r_valid);
+		}
+
+		Hit hit;
+		_find(object, key, p_name, hit, &_resolve_get);
+		switch (hit.kind) {
+			case KIND_SCRIPT_MEMBER: {
+				r_valid = true;
+				return key.instance->members[hit.index];
+			}
+			case KIND_NATIVE_GETTER: {
+				MethodBind *getter = static_cast<MethodBind *>(hit.target);
+				Callable::CallError ce;
+				r_valid = true;
+				if (hit.index >= 0) {
+					// ClassDB::get_property() goes through Object::callp() for indexed properties.
+#ifdef DEBUG_ENABLED
+					_ObjectDebugLock debug_lock(object);
+#endif
+					Variant index = hit.index;
+					const Variant *args[1] = { &index };
+					const Variant value = getter->call(object, args, 1, ce);
+					return (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
+				}
+				return getter->call(object, nullptr, 0, ce);
+			}
+			default: {
+				return object->get(p_name, &r_valid);
+			}
+		}
+	}
+
+	// Same as Variant::set_named().
+	_FORCE_INLINE_ void set_named(Variant *p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+		if (p_base->get_type() != Variant::OBJECT) {
+			p_base->set_named(p_name, p_value, r_valid);
+			return;
+		}
+		Object *object = p_base->get_validated_object();
+		Key key;
+		if (unlikely(!object || !_make_key(object, key))) {
+			p_base->set_named(p_name, p_value, r_valid);
+			return;
+		}
+
+		Hit hit;
+		_find(object, key, p_name, hit, &_resolve_set);
+		switch (hit.kind) {
+			case KIND_SCRIPT_MEMBER: {
+				const GDScriptDataType *data_type = static_cast<const GDScriptDataType *>(hit.target);
+				if (data_type->has_type && !data_type->is_type(p_value)) {
+					break; // Needs a conversion, let GDScriptInstance::set() handle it.
+				}
+#ifdef TOOLS_ENABLED
+				object->_mark_edited();
+#endif
+				key.instance->members.write[hit.index] = p_value;
+				r_valid = true;
+				return;
+			}
+			case KIND_NATIVE_SETTER: {
+#ifdef TOOLS_ENABLED
+				object->_mark_edited();
+#endif
+				MethodBind *setter = static_cast<MethodBind *>(hit.target);
+				Callable::CallError ce;
+				if (hit.index >= 0) {
+					Variant index = hit.index;
+					const Variant *args[2] = { &index, &p_value };
+					setter->call(object, args, 2, ce);
+				} else {
+					const Variant *args[1] = { &p_value };
+					setter->call(object, args, 1, ce);
+				}
+				r_valid = ce.error == Callable::CallError::CALL_OK;
+				return;
+			}
+			default: {
+			} break;
+		}
+		object->set(p_name, p_value, &r_valid);
+	}
+
+	// Same as Variant::callp().
+	_FORCE_INLINE_ void callp(Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+		Object *object = _get_call_object(p_base);
+		Key key;
+		if (!object || unlikely(!_make_key(object, key))) {
+			p_base->callp(p_method, p_args, p_argcount, r_ret, r_error);
+			return;
+		}
+
+		Hit hit;
+		_find(object, key, p_method, hit, &_resolve_call);
+		switch (hit.kind) {
+			case KIND_SCRIPT_FUNCTION: {
+				r_error.error = Callable::CallError::CALL_OK;
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(object);
+#endif
+				r_ret = static_cast<GDScriptFunction *>(hit.target)->call(key.instance, p_args, p_argcount, r_error);
+			} break;
+			case KIND_NATIVE_METHOD: {
+				r_error.error = Callable::CallError::CALL_OK;
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(object);
+#endif
+				r_ret = static_cast<MethodBind *>(hit.target)->call(object, p_args, p_argcount, r_error);
+			} break;
+			default: {
+				p_base->callp(p_method, p_args, p_argcount, r_ret, r_error);
+			} break;
+		}
+	}
+};
+
+#endif // GDSCRIPT_INLINE_CACHE_H
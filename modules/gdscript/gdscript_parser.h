@@ -1337,6 +1337,8 @@ private:
 	bool can_continue = false;
 	List<bool> multiline_stack;
 	HashMap<String, Ref<GDScriptParserRef>> depended_parsers;
+	HashSet<String> dependency_paths; // Constant `extends` and `preload()` paths, as written.
+	HashSet<StringName> referenced_names; // Non-local identifiers, some of which may be global classes.
 
 	ClassNode *head = nullptr;
 	Node *list = nullptr;
@@ -1585,10 +1587,8 @@ public:
 	bool annotation_exists(const String &p_annotation_name) const;
 
 	const List<ParserError> &get_errors() const { return errors; }
-	const List<String> get_dependencies() const {
-		// TODO: Keep track of deps.
-		return List<String>();
-	}
+	// Scripts and resources this script refers to through `extends`, `preload()` or a global class name.
+	List<String> get_dependencies() const;
 #ifdef DEBUG_ENABLED
 	const List<GDScriptWarning> &get_warnings() const { return warnings; }
 	const HashSet<int> &get_unsafe_lines() const { return unsafe_lines; }
@@ -1656,6 +1656,7 @@ public:
 		void print_tree(const GDScriptParser &p_parser);
 	};
 #endif // DEBUG_ENABLED
+	static void initialize();
 	static void cleanup();
 };
 
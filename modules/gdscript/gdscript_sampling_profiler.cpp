@@ -0,0 +1,362 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#ifdef DEBUG_ENABLED
+
+#include "gdscript_function.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/debugger/engine_profiler.h"
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_builder.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// A sampled stack: the index of its thread, followed by one `function_id << 32 | line`
+// entry per frame, outermost first.
+typedef Vector<uint64_t> SampledStack;
+
+struct SampledStackHasher {
+	static _FORCE_INLINE_ uint32_t hash(const SampledStack &p_stack) {
+		return hash_murmur3_buffer(p_stack.ptr(), p_stack.size() * sizeof(uint64_t));
+	}
+};
+
+typedef HashMap<SampledStack, uint64_t, SampledStackHasher> SampledStackCounts;
+
+// Written only by its own thread, read by the sampler. Stacks are kept for the
+// whole run once allocated, as threads hold on to them, and are freed by
+// cleanup() at exit.
+struct GDScriptSamplingProfiler::ThreadStack {
+	Frame frames[MAX_DEPTH + 1]; // The last frame absorbs calls deeper than MAX_DEPTH, it's never sampled.
+	std::atomic<uint32_t> depth = 0;
+	uint32_t index = 0;
+	ThreadStack *next = nullptr;
+
+	struct FunctionInfo {
+		String name;
+		String source;
+	};
+
+	static inline Mutex mutex;
+	static inline ThreadStack *first = nullptr;
+	static inline LocalVector<String> thread_names;
+	static inline LocalVector<FunctionInfo> functions; // Indexed by function ID - 1.
+	static inline SampledStackCounts samples;
+	static inline SampledStackCounts pending; // Since the last tick, only gathered while streaming to the debugger.
+	static inline bool streaming = false;
+	static inline uint64_t sample_count = 0;
+	static inline uint32_t interval_usec = DEFAULT_INTERVAL_USEC;
+	static inline String path;
+	static inline Thread sampler;
+	static inline uint32_t generation = 0; // Bumped by cleanup(), invalidating `current` in every thread.
+
+	static inline thread_local ThreadStack *current = nullptr;
+	static inline thread_local uint32_t current_generation = 0;
+};
+
+class GDScriptSamplingProfiler::DebuggerProfiler : public EngineProfiler {
+	bool started = false;
+
+public:
+	void toggle(bool p_enable, const Array &p_opts) override {
+		if (p_enable) {
+			{
+				MutexLock lock(ThreadStack::mutex);
+				ThreadStack::pending.clear();
+				ThreadStack::streaming = true;
+			}
+			// When already sampling from the command line, its samples are streamed as well.
+			if (!is_active()) {
+				uint32_t interval = DEFAULT_INTERVAL_USEC;
+				if (p_opts.size() > 0 && p_opts[0].get_type() == Variant::INT) {
+					interval = MAX(1, int(p_opts[0]));
+				}
+				start(String(), interval);
+				started = true;
+			}
+		} else {
+			if (started) {
+				stop();
+				started = false;
+			}
+			MutexLock lock(ThreadStack::mutex);
+			ThreadStack::pending.clear();
+			ThreadStack::streaming = false;
+		}
+	}
+
+	void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) override {
+		PackedInt64Array counts;
+		PackedStringArray stacks = _collapse(true, &counts);
+		if (stacks.is_empty()) {
+			return;
+		}
+		Array msg;
+		msg.push_back(stacks);
+		msg.push_back(counts);
+		EngineDebugger::get_singleton()->send_message("gdscript_sampling:samples", msg);
+	}
+};
+
+static Ref<EngineProfiler> debugger_profiler;
+
+GDScriptSamplingProfiler::ThreadStack *GDScriptSamplingProfiler::_get_thread_stack() {
+	if (likely(ThreadStack::current && ThreadStack::current_generation == ThreadStack::generation)) {
+		return ThreadStack::current;
+	}
+
+	MutexLock lock(ThreadStack::mutex);
+
+	ThreadStack *stack = memnew(ThreadStack);
+	stack->index = ThreadStack::thread_names.size();
+	ThreadStack::thread_names.push_back(Thread::is_main_thread() ? String("Main Thread") : vformat("Thread %d", Thread::get_caller_id()));
+	stack->next = ThreadStack::first;
+	ThreadStack::first = stack;
+
+	ThreadStack::current = stack;
+	ThreadStack::current_generation = ThreadStack::generation;
+	return stack;
+}
+
+uint32_t GDScriptSamplingProfiler::_register_function(GDScriptFunction *p_function) {
+	MutexLock lock(ThreadStack::mutex);
+
+	uint32_t id = p_function->sampling_id.get();
+	if (id == 0) {
+		// IDs are never reused, so samples of freed functions keep their names.
+		ThreadStack::functions.push_back({ p_function->get_name(), p_function->get_source() });
+		id = ThreadStack::functions.size();
+		p_function->sampling_id.set(id);
+	}
+	return id;
+}
+
+GDScriptSamplingProfiler::Frame *GDScriptSamplingProfiler::enter(GDScriptFunction *p_function) {
+	ThreadStack *stack = _get_thread_stack();
+
+	uint32_t id = p_function->sampling_id.get();
+	if (unlikely(id == 0)) {
+		id = _register_function(p_function);
+	}
+
+	const uint32_t depth = stack->depth.load(std::memory_order_relaxed);
+	Frame &frame = stack->frames[MIN(depth, (uint32_t)MAX_DEPTH)];
+	frame.function_id.store(id, std::memory_order_relaxed);
+	frame.line.store(p_function->_initial_line, std::memory_order_relaxed);
+	stack->depth.store(depth + 1, std::memory_order_release);
+	return &frame;
+}
+
+void GDScriptSamplingProfiler::exit() {
+	ThreadStack *stack = ThreadStack::current;
+	if (unlikely(!stack || ThreadStack::current_generation != ThreadStack::generation)) {
+		return;
+	}
+	const uint32_t depth = stack->depth.load(std::memory_order_relaxed);
+	ERR_FAIL_COND(depth == 0);
+	stack->depth.store(depth - 1, std::memory_order_release);
+}
+
+void GDScriptSamplingProfiler::_take_sample() {
+	MutexLock lock(ThreadStack::mutex);
+
+	SampledStack key;
+	for (ThreadStack *stack = ThreadStack::first; stack; stack = stack->next) {
+		const uint32_t depth = MIN(stack->depth.load(std::memory_order_acquire), (uint32_t)MAX_DEPTH);
+		if (depth == 0) {
+			continue;
+		}
+		// Frames may change while being read, which at worst attributes this sample
+		// to a line the thread just left.
+		key.resize(depth + 1);
+		uint64_t *w = key.ptrw();
+		w[0] = stack->index;
+		for (uint32_t i = 0; i < depth; i++) {
+			const Frame &frame = stack->frames[i];
+			w[i + 1] = (uint64_t(frame.function_id.load(std::memory_order_relaxed)) << 32) | uint32_t(frame.line.load(std::memory_order_relaxed));
+		}
+		ThreadStack::samples[key]++;
+		if (ThreadStack::streaming) {
+			ThreadStack::pending[key]++;
+		}
+	}
+	ThreadStack::sample_count++;
+}
+
+void GDScriptSamplingProfiler::_sampler_thread_func(void *p_userdata) {
+	Thread::set_name("GDScript Sampling Profiler");
+	while (is_active()) {
+		OS::get_singleton()->delay_usec(ThreadStack::interval_usec);
+		_take_sample();
+	}
+}
+
+PackedStringArray GDScriptSamplingProfiler::_collapse(bool p_pending, PackedInt64Array *r_counts) {
+	MutexLock lock(ThreadStack::mutex);
+
+	SampledStackCounts &counts = p_pending ? ThreadStack::pending : ThreadStack::samples;
+	PackedStringArray stacks;
+	for (const KeyValue<SampledStack, uint64_t> &E : counts) {
+		const uint64_t *r = E.key.ptr();
+		StringBuilder line;
+		line.append(ThreadStack::thread_names[r[0]]);
+		for (int i = 1; i < E.key.size(); i++) {
+			const uint32_t id = r[i] >> 32;
+			const int32_t frame_line = int32_t(r[i] & 0xFFFFFFFF);
+			line.append(";");
+			if (id == 0 || id > ThreadStack::functions.size()) {
+				line.append("<unknown>");
+				continue;
+			}
+			const ThreadStack::FunctionInfo &info = ThreadStack::functions[id - 1];
+			line.append(vformat("%s (%s:%d)", info.name, info.source, frame_line));
+		}
+		if (r_counts) {
+			stacks.push_back(line.as_string());
+			r_counts->push_back(E.value);
+		} else {
+			line.append(" ");
+			line.append(itos(E.value));
+			stacks.push_back(line.as_string());
+		}
+	}
+	if (p_pending) {
+		counts.clear();
+	}
+	return stacks;
+}
+
+void GDScriptSamplingProfiler::start(const String &p_path, uint32_t p_interval_usec) {
+	ERR_FAIL_COND_MSG(p_interval_usec == 0, "The GDScript sampling profiler needs an interval of at least one microsecond.");
+	ERR_FAIL_COND_MSG(is_active(), "The GDScript sampling profiler is already running.");
+
+	{
+		MutexLock lock(ThreadStack::mutex);
+		ThreadStack::path = p_path;
+		ThreadStack::interval_usec = p_interval_usec;
+	}
+	active.store(true, std::memory_order_relaxed);
+	ThreadStack::sampler.start(_sampler_thread_func, nullptr);
+}
+
+Error GDScriptSamplingProfiler::stop() {
+	if (!is_active()) {
+		return OK;
+	}
+	active.store(false, std::memory_order_relaxed);
+	ThreadStack::sampler.wait_to_finish();
+
+	String save_path;
+	{
+		MutexLock lock(ThreadStack::mutex);
+		save_path = ThreadStack::path;
+		ThreadStack::path = String();
+	}
+	if (save_path.is_empty()) {
+		return OK;
+	}
+
+	const Error err = save_collapsed_stacks(save_path);
+	if (err == OK) {
+		print_line(vformat("GDScript sampling profile saved to: %s", save_path));
+	}
+	return err;
+}
+
+PackedStringArray GDScriptSamplingProfiler::get_collapsed_stacks() {
+	PackedStringArray stacks = _collapse(false, nullptr);
+	stacks.sort();
+	return stacks;
+}
+
+Error GDScriptSamplingProfiler::save_collapsed_stacks(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't save GDScript sampling profile to: %s", p_path));
+
+	for (const String &line : get_collapsed_stacks()) {
+		f->store_line(line);
+	}
+	return OK;
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(ThreadStack::mutex);
+	return ThreadStack::sample_count;
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(ThreadStack::mutex);
+	ThreadStack::samples.clear();
+	ThreadStack::pending.clear();
+	ThreadStack::sample_count = 0;
+}
+
+void GDScriptSamplingProfiler::bind_debugger() {
+	if (debugger_profiler.is_valid()) {
+		return;
+	}
+	debugger_profiler = Ref<EngineProfiler>(memnew(DebuggerProfiler));
+	debugger_profiler->bind("gdscript_sampling");
+}
+
+void GDScriptSamplingProfiler::unbind_debugger() {
+	if (debugger_profiler.is_valid()) {
+		debugger_profiler->unbind();
+		debugger_profiler.unref();
+	}
+}
+
+void GDScriptSamplingProfiler::cleanup() {
+	stop();
+
+	MutexLock lock(ThreadStack::mutex);
+	ThreadStack *stack = ThreadStack::first;
+	while (stack) {
+		ThreadStack *next = stack->next;
+		memdelete(stack);
+		stack = next;
+	}
+	ThreadStack::first = nullptr;
+	ThreadStack::thread_names.reset();
+	ThreadStack::functions.reset();
+	ThreadStack::samples.clear();
+	ThreadStack::pending.clear();
+	ThreadStack::sample_count = 0;
+	ThreadStack::generation++;
+}
+
+#endif // DEBUG_ENABLED
@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_SAMPLING_PROFILER_H
+#define GDSCRIPT_SAMPLING_PROFILER_H
+
+#ifdef DEBUG_ENABLED
+
+#include "core/string/ustring.h"
+#include "core/variant/variant.h"
+
+#include <atomic>
+
+class GDScriptFunction;
+
+// Periodically captures the GDScript call stack of every thread running scripts,
+// with the current line of each frame, and aggregates identical stacks.
+// Results are available as collapsed stacks ("frame;frame;frame count" lines),
+// which flame graph tools read directly. Started with the
+// `--gdscript-sampling-profile <path>` command line argument, or remotely
+// through the "gdscript_sampling" debugger profiler.
+//
+// Each thread keeps a shadow stack that GDScriptFunction::call() pushes to
+// while sampling is active. The sampler thread only reads those stacks, so
+// the cost for scripts is a push and a pop per call, and a store per line.
+class GDScriptSamplingProfiler {
+public:
+	struct Frame {
+		std::atomic<uint32_t> function_id = 0;
+		std::atomic<int32_t> line = 0;
+	};
+
+	enum {
+		MAX_DEPTH = 128,
+		DEFAULT_INTERVAL_USEC = 1000,
+	};
+
+private:
+	struct ThreadStack;
+	class DebuggerProfiler;
+
+	static inline std::atomic<bool> active = false;
+
+	static ThreadStack *_get_thread_stack();
+	static uint32_t _register_function(GDScriptFunction *p_function);
+	static void _sampler_thread_func(void *p_userdata);
+	static void _take_sample();
+	static PackedStringArray _collapse(bool p_pending, PackedInt64Array *r_counts);
+
+public:
+	_FORCE_INLINE_ static bool is_active() { return active.load(std::memory_order_relaxed); }
+
+	// Pushes a frame for `p_function` on the calling thread's stack. The frame's
+	// line should be updated as the function runs, and exit() called when it returns.
+	static Frame *enter(GDScriptFunction *p_function);
+	static void exit();
+
+	// Samples every `p_interval_usec` microseconds until stopped. If `p_path` is
+	// not empty, the collapsed stacks are saved there by stop().
+	static void start(const String &p_path = String(), uint32_t p_interval_usec = DEFAULT_INTERVAL_USEC);
+	static Error stop();
+
+	// One "Thread;func (res://path.gd:line);... count" line per distinct stack, sorted.
+	static PackedStringArray get_collapsed_stacks();
+	static Error save_collapsed_stacks(const String &p_path);
+	static uint64_t get_sample_count();
+	static void clear();
+
+	static void bind_debugger();
+	static void unbind_debugger();
+	// Frees all stacks. No other thread may be running scripts anymore.
+	static void cleanup();
+};
+
+#endif // DEBUG_ENABLED
+
+#endif // GDSCRIPT_SAMPLING_PROFILER_H
@@ -30,7 +30,9 @@
 
 #include "gdscript.h"
 #include "gdscript_function.h"
+#include "gdscript_inline_cache.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/os/os.h"
 
@@ -232,6 +234,49 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = {            \
 		&&OPCODE_OPERATOR,                               \
 		&&OPCODE_OPERATOR_VALIDATED,                     \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,              \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF,             \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_INT_ADD,                       \
+		&&OPCODE_OPERATOR_INT_SUBTRACT,                  \
+		&&OPCODE_OPERATOR_INT_MULTIPLY,                  \
+		&&OPCODE_OPERATOR_INT_EQUAL,                     \
+		&&OPCODE_OPERATOR_INT_NOT_EQUAL,                 \
+		&&OPCODE_OPERATOR_INT_LESS,                      \
+		&&OPCODE_OPERATOR_INT_LESS_EQUAL,                \
+		&&OPCODE_OPERATOR_INT_GREATER,                   \
+		&&OPCODE_OPERATOR_INT_GREATER_EQUAL,             \
+		&&OPCODE_OPERATOR_INT_NEGATE,                    \
+		&&OPCODE_OPERATOR_FLOAT_ADD,                     \
+		&&OPCODE_OPERATOR_FLOAT_SUBTRACT,                \
+		&&OPCODE_OPERATOR_FLOAT_MULTIPLY,                \
+		&&OPCODE_OPERATOR_FLOAT_DIVIDE,                  \
+		&&OPCODE_OPERATOR_FLOAT_EQUAL,                   \
+		&&OPCODE_OPERATOR_FLOAT_NOT_EQUAL,               \
+		&&OPCODE_OPERATOR_FLOAT_LESS,                    \
+		&&OPCODE_OPERATOR_FLOAT_LESS_EQUAL,              \
+		&&OPCODE_OPERATOR_FLOAT_GREATER,                 \
+		&&OPCODE_OPERATOR_FLOAT_GREATER_EQUAL,           \
+		&&OPCODE_OPERATOR_FLOAT_NEGATE,                  \
+		&&OPCODE_OPERATOR_BOOL_NOT,                      \
+		&&OPCODE_OPERATOR_VECTOR2_ADD,                   \
+		&&OPCODE_OPERATOR_VECTOR2_SUBTRACT,              \
+		&&OPCODE_OPERATOR_VECTOR2_MULTIPLY,              \
+		&&OPCODE_OPERATOR_VECTOR2_MULTIPLY_FLOAT,        \
+		&&OPCODE_OPERATOR_VECTOR3_ADD,                   \
+		&&OPCODE_OPERATOR_VECTOR3_SUBTRACT,              \
+		&&OPCODE_OPERATOR_VECTOR3_MULTIPLY,              \
+		&&OPCODE_OPERATOR_VECTOR3_MULTIPLY_FLOAT,        \
+		&&OPCODE_JUMP_IF_NOT_INT_EQUAL,                  \
+		&&OPCODE_JUMP_IF_NOT_INT_NOT_EQUAL,              \
+		&&OPCODE_JUMP_IF_NOT_INT_LESS,                   \
+		&&OPCODE_JUMP_IF_NOT_INT_LESS_EQUAL,             \
+		&&OPCODE_JUMP_IF_NOT_INT_GREATER,                \
+		&&OPCODE_JUMP_IF_NOT_INT_GREATER_EQUAL,          \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_LESS,                 \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_LESS_EQUAL,           \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_GREATER,              \
+		&&OPCODE_JUMP_IF_NOT_FLOAT_GREATER_EQUAL,        \
 		&&OPCODE_TYPE_TEST_BUILTIN,                      \
 		&&OPCODE_TYPE_TEST_ARRAY,                        \
 		&&OPCODE_TYPE_TEST_DICTIONARY,                   \
@@ -276,6 +321,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_CALL_UTILITY_VALIDATED,                 \
 		&&OPCODE_CALL_GDSCRIPT_UTILITY,                  \
 		&&OPCODE_CALL_BUILTIN_TYPE_VALIDATED,            \
+		&&OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED, \
 		&&OPCODE_CALL_SELF_BASE,                         \
 		&&OPCODE_CALL_METHOD_BIND,                       \
 		&&OPCODE_CALL_METHOD_BIND_RET,                   \
@@ -469,6 +515,8 @@ void (*type_init_function_table[])(Variant *) = {
 Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state) {
 	OPCODES_TABLE;
 
+	MEMORY_TAG_SCOPE(Memory::TAG_SCRIPTING);
+
 	if (!_code_ptr) {
 		return _get_default_variant_for_data_type(return_type);
 	}
@@ -520,11 +568,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	if (p_state) {
 		//use existing (supplied) state (awaited)
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; //ptr() to avoid bounds check
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->alloca_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
@@ -622,6 +670,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	memnew_placement(&stack[ADDR_STACK_NIL], Variant);
 
 	String err_text;
+	bool stack_kept = false; // Awaiting again after being resumed, the stack stays in the state.
 
 #ifdef DEBUG_ENABLED
 
@@ -701,6 +750,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 	bool exit_ok = false;
 	bool awaited = false;
+	GDScriptSamplingProfiler::Frame *sampled_frame = nullptr;
+	if (unlikely(GDScriptSamplingProfiler::is_active())) {
+		sampled_frame = GDScriptSamplingProfiler::enter(this);
+	}
 	int variant_address_limits[ADDR_TYPE_MAX] = { _stack_size, _constant_count, p_instance ? (int)p_instance->members.size() : 0 };
 #endif
 
@@ -818,6 +871,155 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(result, 2);
+				GET_VARIANT_PTR(dst, 4);
+
+				operator_func(a, b, result);
+				*dst = *result;
+
+				ip += 6;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(test, 2);
+
+				operator_func(a, b, test);
+
+				if (test->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(test, 2);
+
+				operator_func(a, b, test);
+
+				if (!test->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_OPERATOR_UNBOXED(m_name, m_left_type, m_right_type, m_result_type, m_op) \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                  \
+		CHECK_SPACE(4);                                                                 \
+		GET_VARIANT_PTR(a, 0);                                                          \
+		GET_VARIANT_PTR(b, 1);                                                          \
+		GET_VARIANT_PTR(dst, 2);                                                        \
+		const m_left_type &left = *VariantGetInternalPtr<m_left_type>::get_ptr(a);      \
+		const m_right_type &right = *VariantGetInternalPtr<m_right_type>::get_ptr(b);   \
+		*VariantGetInternalPtr<m_result_type>::get_ptr(dst) = left m_op right;          \
+		ip += 4;                                                                        \
+	}                                                                                   \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_UNBOXED(INT_ADD, int64_t, int64_t, int64_t, +);
+			OPCODE_OPERATOR_UNBOXED(INT_SUBTRACT, int64_t, int64_t, int64_t, -);
+			OPCODE_OPERATOR_UNBOXED(INT_MULTIPLY, int64_t, int64_t, int64_t, *);
+			OPCODE_OPERATOR_UNBOXED(INT_EQUAL, int64_t, int64_t, bool, ==);
+			OPCODE_OPERATOR_UNBOXED(INT_NOT_EQUAL, int64_t, int64_t, bool, !=);
+			OPCODE_OPERATOR_UNBOXED(INT_LESS, int64_t, int64_t, bool, <);
+			OPCODE_OPERATOR_UNBOXED(INT_LESS_EQUAL, int64_t, int64_t, bool, <=);
+			OPCODE_OPERATOR_UNBOXED(INT_GREATER, int64_t, int64_t, bool, >);
+			OPCODE_OPERATOR_UNBOXED(INT_GREATER_EQUAL, int64_t, int64_t, bool, >=);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_ADD, double, double, double, +);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_SUBTRACT, double, double, double, -);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_MULTIPLY, double, double, double, *);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_DIVIDE, double, double, double, /);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_EQUAL, double, double, bool, ==);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_NOT_EQUAL, double, double, bool, !=);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_LESS, double, double, bool, <);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_LESS_EQUAL, double, double, bool, <=);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_GREATER, double, double, bool, >);
+			OPCODE_OPERATOR_UNBOXED(FLOAT_GREATER_EQUAL, double, double, bool, >=);
+			OPCODE_OPERATOR_UNBOXED(VECTOR2_ADD, Vector2, Vector2, Vector2, +);
+			OPCODE_OPERATOR_UNBOXED(VECTOR2_SUBTRACT, Vector2, Vector2, Vector2, -);
+			OPCODE_OPERATOR_UNBOXED(VECTOR2_MULTIPLY, Vector2, Vector2, Vector2, *);
+			OPCODE_OPERATOR_UNBOXED(VECTOR2_MULTIPLY_FLOAT, Vector2, double, Vector2, *);
+			OPCODE_OPERATOR_UNBOXED(VECTOR3_ADD, Vector3, Vector3, Vector3, +);
+			OPCODE_OPERATOR_UNBOXED(VECTOR3_SUBTRACT, Vector3, Vector3, Vector3, -);
+			OPCODE_OPERATOR_UNBOXED(VECTOR3_MULTIPLY, Vector3, Vector3, Vector3, *);
+			OPCODE_OPERATOR_UNBOXED(VECTOR3_MULTIPLY_FLOAT, Vector3, double, Vector3, *);
+
+#define OPCODE_OPERATOR_UNBOXED_UNARY(m_name, m_type, m_op)                                             \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                  \
+		CHECK_SPACE(4);                                                                                 \
+		GET_VARIANT_PTR(a, 0);                                                                          \
+		GET_VARIANT_PTR(dst, 2);                                                                        \
+		*VariantGetInternalPtr<m_type>::get_ptr(dst) = m_op *VariantGetInternalPtr<m_type>::get_ptr(a); \
+		ip += 4;                                                                                        \
+	}                                                                                                   \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_UNBOXED_UNARY(INT_NEGATE, int64_t, -);
+			OPCODE_OPERATOR_UNBOXED_UNARY(FLOAT_NEGATE, double, -);
+			OPCODE_OPERATOR_UNBOXED_UNARY(BOOL_NOT, bool, !);
+
+#define OPCODE_JUMP_IF_NOT_UNBOXED(m_name, m_type, m_op)                                                                \
+	OPCODE(OPCODE_JUMP_IF_NOT_##m_name) {                                                                               \
+		CHECK_SPACE(5);                                                                                                 \
+		GET_VARIANT_PTR(a, 0);                                                                                          \
+		GET_VARIANT_PTR(b, 1);                                                                                          \
+		GET_VARIANT_PTR(dst, 2);                                                                                        \
+		const bool result = *VariantGetInternalPtr<m_type>::get_ptr(a) m_op *VariantGetInternalPtr<m_type>::get_ptr(b); \
+		*VariantGetInternalPtr<bool>::get_ptr(dst) = result;                                                            \
+		if (!result) {                                                                                                  \
+			int to = _code_ptr[ip + 4];                                                                                 \
+			GD_ERR_BREAK(to < 0 || to > _code_size);                                                                    \
+			ip = to;                                                                                                    \
+		} else {                                                                                                        \
+			ip += 5;                                                                                                    \
+		}                                                                                                               \
+	}                                                                                                                   \
+	DISPATCH_OPCODE
+
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_EQUAL, int64_t, ==);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_NOT_EQUAL, int64_t, !=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_LESS, int64_t, <);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_LESS_EQUAL, int64_t, <=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_GREATER, int64_t, >);
+			OPCODE_JUMP_IF_NOT_UNBOXED(INT_GREATER_EQUAL, int64_t, >=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS, double, <);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_LESS_EQUAL, double, <=);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER, double, >);
+			OPCODE_JUMP_IF_NOT_UNBOXED(FLOAT_GREATER_EQUAL, double, >=);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1162,7 +1364,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1172,8 +1374,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				_inline_caches_ptr[cache_idx].set_named(dst, *index, *value, valid);
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1194,7 +1399,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1214,7 +1419,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1224,13 +1429,16 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret = _inline_caches_ptr[cache_idx].get_named(src, *index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+				*dst = _inline_caches_ptr[cache_idx].get_named(src, *index, valid);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1239,7 +1447,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1858,7 +2066,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1869,6 +2077,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *inline_cache = &_inline_caches_ptr[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1887,7 +2099,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					inline_cache->callp(base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1917,7 +2129,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					inline_cache->callp(base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1967,7 +2179,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2330,6 +2542,49 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED) {
+				CHECK_SPACE(3);
+				{
+					GET_VARIANT_PTR(member, 0);
+					int indexname = _code_ptr[ip + 2];
+					GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+					const StringName *index = &_global_names_ptr[indexname];
+#ifndef DEBUG_ENABLED
+					ClassDB::get_property(p_instance->owner, *index, *member);
+#else
+					bool ok = ClassDB::get_property(p_instance->owner, *index, *member);
+					if (!ok) {
+						err_text = "Internal error getting property: " + String(*index);
+						OPCODE_BREAK;
+					}
+#endif
+				}
+
+				// The call operands follow the member name, which takes the place of the call opcode.
+				ip += 2;
+
+				LOAD_INSTRUCTION_ARGS
+
+				CHECK_SPACE(3 + instr_arg_count);
+
+				ip += instr_arg_count;
+
+				int argc = _code_ptr[ip + 1];
+				GD_ERR_BREAK(argc < 0);
+
+				GET_INSTRUCTION_ARG(base, argc);
+
+				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _builtin_methods_count);
+				Variant::ValidatedBuiltInMethod method = _builtin_methods_ptr[_code_ptr[ip + 2]];
+				Variant **argptrs = instruction_args;
+
+				GET_INSTRUCTION_ARG(ret, argc + 1);
+				method(base, (const Variant **)argptrs, argc, ret);
+
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_CALL_UTILITY) {
 				LOAD_INSTRUCTION_ARGS
 				CHECK_SPACE(3 + instr_arg_count);
@@ -2530,44 +2785,54 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 
 				if (is_signal) {
-					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
-					gdfs->function = this;
-
-					gdfs->state.stack.resize(alloca_size);
+					Ref<GDScriptFunctionState> gdfs;
+					if (p_state) {
+						// The stack already lives in the state being resumed, keep using
+						// both rather than copying the stack to a new state.
+						gdfs = Ref<GDScriptFunctionState>(p_state->owner);
+					} else {
+						gdfs = Ref<GDScriptFunctionState>(memnew(GDScriptFunctionState));
+						gdfs->state.stack = GDScriptFunctionState::_alloc_stack(alloca_size);
 
-					// First 3 stack addresses are special, so we just skip them here.
-					for (int i = 3; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+						// First 3 stack addresses are special, so we just skip them here.
+						for (int i = 3; i < _stack_size; i++) {
+							memnew_placement(&gdfs->state.stack[sizeof(Variant) * i], Variant(stack[i]));
+						}
+						gdfs->state.stack_size = _stack_size;
+						gdfs->state.alloca_size = alloca_size;
+						gdfs->state.script = _script;
+						gdfs->state.instance = p_instance;
+#ifdef DEBUG_ENABLED
+						gdfs->state.function_name = name;
+						gdfs->state.script_path = _script->get_script_path();
+#endif
+						gdfs->state.defarg = defarg;
+						gdfs->function = this;
 					}
-					gdfs->state.stack_size = _stack_size;
-					gdfs->state.alloca_size = alloca_size;
 					gdfs->state.ip = ip + 2;
 					gdfs->state.line = line;
-					gdfs->state.script = _script;
 					{
 						MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 						_script->pending_func_states.add(&gdfs->scripts_list);
 						if (p_instance) {
-							gdfs->state.instance = p_instance;
 							p_instance->pending_func_states.add(&gdfs->instances_list);
-						} else {
-							gdfs->state.instance = nullptr;
 						}
 					}
-#ifdef DEBUG_ENABLED
-					gdfs->state.function_name = name;
-					gdfs->state.script_path = _script->get_script_path();
-#endif
-					gdfs->state.defarg = defarg;
-					gdfs->function = this;
 
 					retvalue = gdfs;
 
-					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
+					Error err = gdfs->_connect_to_signal(sig);
 					if (err != OK) {
+						{
+							MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
+							gdfs->scripts_list.remove_from_list();
+							gdfs->instances_list.remove_from_list();
+						}
+						retvalue = Variant();
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
 					}
+					stack_kept = p_state != nullptr;
 
 #ifdef DEBUG_ENABLED
 					exit_ok = true;
@@ -3778,6 +4043,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+#ifdef DEBUG_ENABLED
+				if (unlikely(sampled_frame)) {
+					sampled_frame->line.store(line, std::memory_order_relaxed);
+				}
+#endif
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3860,6 +4131,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 	OPCODES_OUT
 #ifdef DEBUG_ENABLED
+	// Popped on every return, including `await`, as the shadow stack follows native calls.
+	if (unlikely(sampled_frame)) {
+		GDScriptSamplingProfiler::exit();
+	}
+
 	if (GDScriptLanguage::get_singleton()->profiling) {
 		uint64_t time_taken = OS::get_singleton()->get_ticks_usec() - function_start_time;
 		profile.total_time.add(time_taken);
@@ -3881,8 +4157,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 		// Free stack, except reserved addresses.
-		for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-			stack[i].~Variant();
+		if (!stack_kept) {
+			for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+				stack[i].~Variant();
+			}
 		}
 #ifdef DEBUG_ENABLED
 	}
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_tokenizer.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -84,14 +85,23 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr int DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	int script_mode = DEFAULT_SCRIPT_MODE;
+	bool precompile_bytecode = false;
+	bool debug_export = false;
 
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/precompile_bytecode"), false));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		precompile_bytecode = false;
+		debug_export = p_debug;
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
+			precompile_bytecode = get_option("gdscript/precompile_bytecode");
 		}
 	}
 
@@ -114,6 +124,18 @@ protected:
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (precompile_bytecode) {
+			// Only scripts compiled from what is being exported, the cache is rejected at runtime otherwise.
+			Ref<GDScript> gdscript = ResourceLoader::load(p_path);
+			if (gdscript.is_valid() && gdscript->is_valid() && gdscript->get_source_code() == source) {
+				// Release templates get the script compiled again without the debug opcodes the editor runs.
+				Vector<uint8_t> cache = GDScriptBytecodeCache::serialize(gdscript.ptr(), file, debug_export, compress_mode == GDScriptTokenizerBuffer::COMPRESS_ZSTD);
+				if (!cache.is_empty()) {
+					add_file(GDScriptBytecodeCache::get_cache_path(p_path), cache, false);
+				}
+			}
+		}
 	}
 
 public:
@@ -156,6 +178,7 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		gdscript_cache = memnew(GDScriptCache);
 
+		GDScriptParser::initialize();
 		GDScriptUtilityFunctions::register_functions();
 	}
 
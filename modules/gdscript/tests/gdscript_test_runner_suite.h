@@ -33,7 +33,16 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_parser.h"
+#include "../gdscript_sampling_profiler.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/io/dir_access.h"
+
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -43,8 +52,11 @@ TEST_SUITE("[Modules][GDScript]") {
 	TEST_CASE("Script compilation and runtime") {
 		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
 		bool use_binary_tokens = OS::get_singleton()->get_cmdline_args().find("--use-binary-tokens") != nullptr;
+		bool disable_bytecode_optimizer = OS::get_singleton()->get_cmdline_args().find("--disable-bytecode-optimizer") != nullptr;
+		GDScriptLanguage::get_singleton()->set_bytecode_optimization_enabled(!disable_bytecode_optimizer);
 		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens);
 		int fail_count = runner.run_tests();
+		GDScriptLanguage::get_singleton()->set_bytecode_optimization_enabled(true);
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
@@ -70,6 +82,515 @@ func _init():
 	ref_counted->set_script(gdscript);
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
+
+TEST_CASE("[Stress][Modules][GDScript] Named access and call microbenchmarks") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+class Item:
+	var value = 0
+	func bump():
+		value += 1
+
+class ItemB extends Item:
+	pass
+
+class ItemC extends Item:
+	pass
+
+class ItemD extends Item:
+	pass
+
+func get_member(n):
+	var item = Item.new()
+	var total = 0
+	for i in n:
+		total += item.value
+	return total
+
+func set_member(n):
+	var item = Item.new()
+	for i in n:
+		item.value = i
+	return item.value
+
+func call_script(n):
+	var item = Item.new()
+	for i in n:
+		item.bump()
+	return item.value
+
+func get_native(n):
+	var resource = Resource.new()
+	var total = 0
+	for i in n:
+		total += resource.resource_name.length()
+	return total
+
+func call_native(n):
+	var item = Item.new()
+	var total = 0
+	for i in n:
+		total += item.get_reference_count()
+	return total
+
+func polymorphic(n):
+	var items = [Item.new(), ItemB.new(), ItemC.new(), ItemD.new()]
+	for i in n:
+		var item = items[i & 3]
+		item.value = item.value + 1
+		item.bump()
+	return items[0].value
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should compile.");
+
+	Ref<RefCounted> runner = memnew(RefCounted);
+	runner->set_script(gdscript);
+
+	const int iterations = 1000000;
+	const char *benchmarks[] = { "get_member", "set_member", "call_script", "get_native", "call_native", "polymorphic" };
+	for (const char *benchmark : benchmarks) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		runner->call(benchmark, iterations);
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		MESSAGE(benchmark, ": ", usec * 1000 / iterations, " ns/iteration.");
+	}
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Variant arithmetic microbenchmarks") {
+	// Reports sizeof(Variant) so runs with and without `variant_compact` can be compared.
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func int_math(n):
+	var total = 0
+	for i in n:
+		total = (total + i * 3) % 1000003
+	return total
+
+func float_math(n):
+	var total = 0.0
+	for i in n:
+		total += i * 0.5 - total * 0.25
+	return total
+
+func vector_math(n):
+	var total = Vector3()
+	for i in n:
+		total = total * 0.5 + Vector3(i, 1, 2)
+	return total
+
+func array_sum(n):
+	var values = []
+	values.resize(1000)
+	values.fill(1)
+	var total = 0
+	for i in n / 1000:
+		for value in values:
+			total += value
+	return total
+)");
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	REQUIRE_MESSAGE(error == OK, "The benchmark script should compile.");
+
+	Ref<RefCounted> runner = memnew(RefCounted);
+	runner->set_script(gdscript);
+
+	const int iterations = 1000000;
+	const char *benchmarks[] = { "int_math", "float_math", "vector_math", "array_sum" };
+	for (const char *benchmark : benchmarks) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		runner->call(benchmark, iterations);
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		MESSAGE(benchmark, " (", (uint64_t)sizeof(Variant), "-byte Variant): ", usec * 1000 / iterations, " ns/iteration.");
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode optimizer keeps behavior and shrinks code") {
+	const String source = R"(
+extends RefCounted
+
+func run(n: int) -> int:
+	var total: int = 0
+	var i: int = 0
+	while i < n:
+		i += 1
+		if i % 3 == 0:
+			continue
+		elif i > 50:
+			break
+		total += i * 2
+	return total
+)";
+
+	int results[2] = {};
+	int code_sizes[2] = {};
+	for (int optimized = 0; optimized < 2; optimized++) {
+		GDScriptLanguage::get_singleton()->set_bytecode_optimization_enabled(optimized);
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+		code_sizes[optimized] = gdscript->get_member_functions()["run"]->get_code_size();
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		results[optimized] = ref_counted->call("run", 100);
+	}
+	GDScriptLanguage::get_singleton()->set_bytecode_optimization_enabled(true);
+
+	CHECK_MESSAGE(results[0] == 1734, "The unoptimized function should return the expected value.");
+	CHECK_MESSAGE(results[1] == results[0], "The optimized function should return the same value.");
+	CHECK_MESSAGE(code_sizes[1] < code_sizes[0], "The optimized function should have less bytecode.");
+}
+
+TEST_CASE("[Modules][GDScript] Small static functions are inlined") {
+	const String source = R"(
+extends RefCounted
+
+static func twice(x: int) -> int:
+	return x * 2
+
+static func offset(x: int) -> int:
+	return twice(x) + 1
+
+static func countdown(n: int) -> int:
+	return 0 if n <= 0 else countdown(n - 1)
+
+func run(n: int) -> int:
+	return twice(n) + offset(n) + twice(5) + countdown(n)
+)";
+
+	int results[2] = {};
+	for (int optimized = 0; optimized < 2; optimized++) {
+		GDScriptLanguage::get_singleton()->set_bytecode_optimization_enabled(optimized);
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, "The script should parse successfully.");
+
+		const Vector<GDScriptFunction::InlinedCall> &inlined_calls = gdscript->get_member_functions()["run"]->get_inlined_calls();
+		if (optimized) {
+			// `offset()` brings `twice()` along, `countdown()` is recursive and stays a call.
+			REQUIRE(inlined_calls.size() == 2);
+			CHECK(inlined_calls[0].callee == "twice");
+			CHECK(inlined_calls[0].count == 3);
+			CHECK(inlined_calls[0].folded == 1);
+			CHECK(inlined_calls[1].callee == "offset");
+			CHECK(inlined_calls[1].count == 1);
+		} else {
+			CHECK_MESSAGE(inlined_calls.is_empty(), "Nothing should be inlined without the bytecode optimizer.");
+		}
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		results[optimized] = ref_counted->call("run", 7);
+	}
+	GDScriptLanguage::get_singleton()->set_bytecode_optimization_enabled(true);
+
+	CHECK_MESSAGE(results[0] == 39, "The function should return the expected value.");
+	CHECK_MESSAGE(results[1] == results[0], "Inlining should not change the result.");
+}
+
+// Compiles `p_source` from its binary tokens, through a bytecode cache if `p_cache` isn't empty.
+static Ref<GDScript> load_from_binary_tokens(const Vector<uint8_t> &p_tokens, const Vector<uint8_t> &p_cache) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_binary_tokens_source(p_tokens);
+	if (!p_cache.is_empty() && GDScriptBytecodeCache::prepare_script(gdscript.ptr(), p_cache) != OK) {
+		return Ref<GDScript>();
+	}
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	return error == OK ? gdscript : Ref<GDScript>();
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache round trip") {
+	const String source = R"(
+extends RefCounted
+
+signal finished(value: int)
+
+enum Mode { FIRST, SECOND = 5 }
+
+const PRIMES: Array[int] = [2, 3, 5, 7]
+const NAMES = { "a": 1, "b": 2 }
+
+static var created := 0
+
+class Base:
+	var weight := 2
+	func scale(p_value):
+		return p_value * weight
+
+class Heavy extends Base:
+	func _init():
+		weight = 3
+
+var offset := 1.5
+var label: String = "x"
+
+func _init():
+	created += 1
+
+func run(n: int) -> String:
+	var total := 0
+	for prime in PRIMES:
+		total += prime * n
+	var adder := func(p_value): return p_value + Mode.SECOND
+	total = adder.call(total)
+	var heavy := Heavy.new()
+	total += heavy.scale(NAMES.b)
+	var ratio := total / offset
+	return "%d %s %.2f %d %s" % [total, label.repeat(2), ratio, created, Vector2i(n, 1)]
+)";
+
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	REQUIRE_MESSAGE(!tokens.is_empty(), "The script should tokenize.");
+
+	Ref<GDScript> compiled = load_from_binary_tokens(tokens, Vector<uint8_t>());
+	REQUIRE_MESSAGE(compiled.is_valid(), "The script should compile from binary tokens.");
+
+	const Vector<uint8_t> cache = GDScriptBytecodeCache::serialize(compiled.ptr(), tokens, true, true);
+	REQUIRE_MESSAGE(!cache.is_empty(), "The compiled script should be cacheable.");
+
+	Ref<GDScript> cached = load_from_binary_tokens(tokens, cache);
+	REQUIRE_MESSAGE(cached.is_valid(), "The script should load from its bytecode cache.");
+	CHECK_MESSAGE(cached->get_subclasses().size() == 2, "Inner classes should be restored.");
+	CHECK_MESSAGE(cached->has_script_signal("finished"), "Signals should be restored.");
+
+	Ref<RefCounted> expected = memnew(RefCounted);
+	expected->set_script(compiled);
+	Ref<RefCounted> actual = memnew(RefCounted);
+	actual->set_script(cached);
+	const String expected_result = expected->call("run", 4);
+	const String actual_result = actual->call("run", 4);
+	CHECK_MESSAGE(expected_result == "79 xx 52.67 1 (4, 1)", "The compiled script should return the expected value.");
+	CHECK_MESSAGE(actual_result == expected_result, "The cached script should return the same value.");
+
+	Vector<uint8_t> other_tokens = GDScriptTokenizerBuffer::parse_code_string(source + "\nfunc other():\n\tpass\n", GDScriptTokenizerBuffer::COMPRESS_NONE);
+	Ref<GDScript> stale = memnew(GDScript);
+	stale->set_binary_tokens_source(other_tokens);
+	CHECK_MESSAGE(GDScriptBytecodeCache::prepare_script(stale.ptr(), cache) != OK, "A cache made from other tokens should be rejected.");
+
+	Vector<uint8_t> damaged = cache;
+	damaged.write[damaged.size() / 2] ^= 0xFF;
+	Ref<GDScript> corrupt = memnew(GDScript);
+	corrupt->set_binary_tokens_source(tokens);
+	CHECK_MESSAGE(GDScriptBytecodeCache::prepare_script(corrupt.ptr(), damaged) != OK, "A damaged cache should be rejected.");
+
+	// The engine hash covers the build type, debug bytecode must not run on release builds and vice versa.
+	Vector<uint8_t> other_build = cache;
+	other_build.write[8] ^= 0xFF;
+	Ref<GDScript> mismatched = memnew(GDScript);
+	mismatched->set_binary_tokens_source(tokens);
+	CHECK_MESSAGE(GDScriptBytecodeCache::prepare_script(mismatched.ptr(), other_build) == ERR_FILE_UNRECOGNIZED, "A cache made by another engine build should be rejected.");
+
+	// Release caches come from a separate compile, the script they're made from keeps running its own bytecode.
+	const Vector<uint8_t> release_cache = GDScriptBytecodeCache::serialize(compiled.ptr(), tokens, false, true);
+	REQUIRE_MESSAGE(!release_cache.is_empty(), "The compiled script should be cacheable for release templates.");
+	Ref<GDScript> release = memnew(GDScript);
+	release->set_binary_tokens_source(tokens);
+	CHECK_MESSAGE(GDScriptBytecodeCache::prepare_script(release.ptr(), release_cache) == ERR_FILE_UNRECOGNIZED, "A release cache should be rejected by debug builds.");
+	CHECK_MESSAGE(expected->call("run", 4) == "79 xx 52.67 1 (4, 1)", "Making a release cache shouldn't affect the compiled script.");
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Bytecode cache load time") {
+	// A corpus of mid-sized scripts, compiled from binary tokens like an exported project without a cache.
+	Vector<Vector<uint8_t>> corpus_tokens;
+	Vector<Vector<uint8_t>> corpus_caches;
+	for (int i = 0; i < 50; i++) {
+		String source = "extends RefCounted\n\nclass Inner:\n\tvar value := " + itos(i) + "\n";
+		for (int j = 0; j < 20; j++) {
+			source += vformat("\nvar member_%d := %d\n\nfunc method_%d(p_value: int) -> int:\n\tvar total := member_%d\n\tfor k in p_value:\n\t\ttotal += k * %d\n\tif total > 100:\n\t\treturn Inner.new().value + total\n\treturn str(total).length()\n", j, j, j, j, j + i);
+		}
+		const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+		Ref<GDScript> compiled = load_from_binary_tokens(tokens, Vector<uint8_t>());
+		REQUIRE_MESSAGE(compiled.is_valid(), "The benchmark script should compile.");
+		corpus_tokens.push_back(tokens);
+		corpus_caches.push_back(GDScriptBytecodeCache::serialize(compiled.ptr(), tokens, true, true));
+	}
+
+	const char *modes[] = { "compile from tokens", "load from bytecode cache" };
+	for (int mode = 0; mode < 2; mode++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < corpus_tokens.size(); i++) {
+			Ref<GDScript> gdscript = load_from_binary_tokens(corpus_tokens[i], mode ? corpus_caches[i] : Vector<uint8_t>());
+			CHECK(gdscript.is_valid());
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		MESSAGE(modes[mode], ": ", usec / corpus_tokens.size(), " usec/script.");
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Load scripts with dependencies parsed in parallel") {
+	const String base_path = TestUtils::get_temp_path("gdscript_cache_base.gd");
+	const String helper_path = TestUtils::get_temp_path("gdscript_cache_helper.gd");
+	const String main_path = TestUtils::get_temp_path("gdscript_cache_main.gd");
+	const String main_source = R"(
+extends "gdscript_cache_base.gd"
+
+const Helper = preload("gdscript_cache_helper.gd")
+
+func compute() -> int:
+	return base_value() + Helper.helper_value()
+)";
+	const String sources[][2] = {
+		{ base_path, "extends RefCounted\n\nfunc base_value() -> int:\n\treturn 40\n" },
+		{ helper_path, "extends RefCounted\n\nstatic func helper_value() -> int:\n\treturn 2\n" },
+		{ main_path, main_source },
+	};
+	for (const String *source : sources) {
+		Ref<FileAccess> f = FileAccess::open(source[0], FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(source[1]);
+	}
+
+	GDScriptParser parser;
+	REQUIRE(parser.parse(main_source, main_path, false) == OK);
+	List<String> dependencies = parser.get_dependencies();
+	CHECK_MESSAGE(dependencies.find(base_path) != nullptr, "The `extends` path should be a dependency.");
+	CHECK_MESSAGE(dependencies.find(helper_path) != nullptr, "The `preload()` path should be a dependency.");
+
+	// Dependencies are handed over to the worker thread pool while the main script is analyzed.
+	Error err = OK;
+	Ref<GDScript> gdscript = GDScriptCache::get_full_script(main_path, err);
+	REQUIRE(err == OK);
+	REQUIRE(gdscript.is_valid());
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+	CHECK(int(ref_counted->call("compute")) == 42);
+
+	ref_counted.unref();
+	gdscript.unref();
+	for (const String *source : sources) {
+		GDScriptCache::remove_script(source[0]);
+		DirAccess::remove_absolute(source[0]);
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Sampling profiler captures call stacks") {
+	const String source = R"(
+extends RefCounted
+
+func busy() -> int:
+	var x := 0
+	for i in 200:
+		x += i
+	return x
+
+func run(n: int) -> int:
+	var total := 0
+	for i in n:
+		total += busy()
+	return total
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	REQUIRE(gdscript->reload() == OK);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::clear();
+	GDScriptSamplingProfiler::start(String(), 500);
+	REQUIRE(GDScriptSamplingProfiler::is_active());
+	const uint64_t timeout = OS::get_singleton()->get_ticks_msec() + 5000;
+	while (GDScriptSamplingProfiler::get_sample_count() < 20 && OS::get_singleton()->get_ticks_msec() < timeout) {
+		ref_counted->call("run", 100);
+	}
+	CHECK(GDScriptSamplingProfiler::stop() == OK);
+	CHECK_FALSE(GDScriptSamplingProfiler::is_active());
+
+	CHECK(GDScriptSamplingProfiler::get_sample_count() > 0);
+	bool found_nested = false;
+	for (const String &line : GDScriptSamplingProfiler::get_collapsed_stacks()) {
+		CHECK_MESSAGE(line.begins_with("Main Thread;run ("), "Every sampled stack should start from the called function.");
+		found_nested = found_nested || line.contains(";busy (");
+	}
+	CHECK_MESSAGE(found_nested, "Calls made by the sampled function should appear in its stacks.");
+
+	// Calls outside of the sampling window are not recorded.
+	const uint64_t sample_count = GDScriptSamplingProfiler::get_sample_count();
+	ref_counted->call("run", 100);
+	CHECK(GDScriptSamplingProfiler::get_sample_count() == sample_count);
+	GDScriptSamplingProfiler::clear();
+}
+
+static const char *coroutine_test_source = R"(
+extends RefCounted
+
+signal tick
+
+var resumed := 0
+
+func worker(rounds: int) -> int:
+	for _i in rounds:
+		await tick
+		resumed += 1
+	return rounds
+
+func spawn(count: int, rounds: int) -> void:
+	for _i in count:
+		worker(rounds)
+)";
+
+TEST_CASE("[Modules][GDScript] Coroutines keep their state across awaits") {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(coroutine_test_source);
+	REQUIRE(gdscript->reload() == OK);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	Ref<GDScriptFunctionState> state = ref_counted->call("worker", 3);
+	REQUIRE(state.is_valid());
+	for (int i = 1; i <= 3; i++) {
+		CHECK_MESSAGE(state->is_valid(), "The coroutine should stay resumable until it completes.");
+		ref_counted->emit_signal("tick");
+		CHECK(int(ref_counted->get("resumed")) == i);
+	}
+	CHECK_FALSE_MESSAGE(state->is_valid(), "The coroutine should be done after its last resume.");
+
+	// Further emissions don't reach the completed coroutine.
+	ref_counted->emit_signal("tick");
+	CHECK(int(ref_counted->get("resumed")) == 3);
+}
+
+TEST_CASE("[Stress][Modules][GDScript] Concurrently awaiting coroutines") {
+	const int COROUTINES = 100000;
+	const int ROUNDS = 10;
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(coroutine_test_source);
+	REQUIRE(gdscript->reload() == OK);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	ref_counted->call("spawn", COROUTINES, ROUNDS);
+	MESSAGE("start: ", (OS::get_singleton()->get_ticks_usec() - begin) / 1000, " msec for ", COROUTINES, " coroutines.");
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < ROUNDS; i++) {
+		ref_counted->emit_signal("tick");
+	}
+	MESSAGE("resume: ", (OS::get_singleton()->get_ticks_usec() - begin) / ROUNDS / 1000, " msec per round.");
+	CHECK(int(ref_counted->get("resumed")) == COROUTINES * ROUNDS);
+}
 #endif // TOOLS_ENABLED
 
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
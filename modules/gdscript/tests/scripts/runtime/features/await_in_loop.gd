@@ -0,0 +1,19 @@
+signal tick(value: int)
+
+func worker(label: String, count: int) -> int:
+	var total := 0
+	for _i in count:
+		var value: int = await tick
+		total += value
+		print("%s got %d" % [label, value])
+	return total
+
+func report(label: String, count: int):
+	var total := await worker(label, count)
+	print("%s total %d" % [label, total])
+
+func test():
+	report("a", 3)
+	report("b", 2)
+	for i in range(1, 5):
+		tick.emit(i)
@@ -0,0 +1,89 @@
+# Exercises the sequences the bytecode optimizer rewrites: operators assigned to
+# typed and untyped locals, comparisons feeding jumps, nested jumps, stores that
+# are overwritten right away, and native members used as call receivers.
+extends Node
+
+
+func sum_below(limit: int, stop_at: int = 1 + 99) -> int:
+	var total: int = 0
+	var i: int = 0
+	while i < limit:
+		i += 1
+		if i % 2 == 0:
+			continue
+		elif i > stop_at:
+			break
+		else:
+			total += i
+	return total
+
+
+func classify(values: Array) -> String:
+	var result := ""
+	for value: int in values:
+		if value < 0:
+			result += "n"
+		elif value == 0:
+			result += "z"
+		elif value > 10 and value < 100:
+			result += "m"
+		elif value >= 100 or value == 7:
+			result += "l"
+		else:
+			result += "s"
+	return result
+
+
+func accumulate() -> Vector2:
+	var v := Vector2(1, 1)
+	var step := Vector2(0.5, 2)
+	for i in 3:
+		v = v + step * float(i)
+		v *= 2.0
+	return v
+
+
+func untyped_target(a: int, b: int):
+	var untyped
+	untyped = a * b
+	untyped = untyped + a
+	return untyped
+
+
+func overwritten() -> int:
+	var value: int
+	value = 5
+	var flag: bool
+	flag = value > 3
+	var name_copy = "unused"
+	name_copy = "used"
+	return value + (1 if flag else 0) + name_copy.length()
+
+
+func waits() -> int:
+	var count: int = 0
+	for i in 4:
+		await not_coroutine()
+		if count < i * 2:
+			count += i
+	return count
+
+
+func not_coroutine():
+	return null
+
+
+func test():
+	print(sum_below(10))
+	print(sum_below(10, 4))
+	print(classify([-3, 0, 5, 50, 500, 7]))
+	print(accumulate())
+	print(untyped_target(3, 4))
+	print(overwritten())
+	print(await waits())
+
+	editor_description = "optimizer"
+	var length_sum := 0
+	for i in 3:
+		length_sum += editor_description.length()
+	print(length_sum)
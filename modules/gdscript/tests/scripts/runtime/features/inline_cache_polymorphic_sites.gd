@@ -0,0 +1,93 @@
+# Every access below goes through one bytecode site that sees several receiver
+# shapes, so the inline caches get filled, hit, and fall back to the regular path.
+
+class A:
+	var value = 1
+
+	func describe():
+		return "A %d" % value
+
+
+class B:
+	var value: int = 2
+
+	func describe():
+		return "B %d" % value
+
+
+class C extends A:
+	var _backing = 3
+	var other:
+		get:
+			return _backing * 10
+		set(v):
+			_backing = v
+
+	func describe():
+		return "C %d" % value
+
+
+class D:
+	func _get(property):
+		if property == &"value":
+			return 4
+		return null
+
+	func _set(property, v):
+		print("D set ", property, " ", v)
+		return true
+
+	func describe():
+		return "D"
+
+
+class Style extends StyleBoxFlat:
+	var extra = 5
+
+
+func get_value(obj):
+	return obj.value
+
+
+func set_value(obj, v):
+	obj.value = v
+
+
+func call_describe(obj):
+	return obj.describe()
+
+
+func get_border(obj):
+	return obj.border_width_left
+
+
+func set_border(obj, v):
+	obj.border_width_left = v
+
+
+func test():
+	var objects = [A.new(), B.new(), C.new(), D.new()]
+	for _i in 3:
+		for obj in objects:
+			print(call_describe(obj), " ", get_value(obj))
+
+	# `B.value` is typed, so the float needs a conversion the cache leaves to the regular path.
+	for obj in objects:
+		set_value(obj, 7.5)
+	for obj in objects:
+		print(get_value(obj))
+	set_value(objects[1], 8)
+	print(get_value(objects[1]))
+
+	# Properties with a GDScript getter and setter are never cached.
+	var c = objects[2]
+	for i in 3:
+		c.other = i
+		print(c.other)
+
+	# Indexed native property, on a plain and on a scripted object.
+	var styles = [StyleBoxFlat.new(), Style.new()]
+	for i in styles.size():
+		set_border(styles[i], i + 1)
+	for style in styles:
+		print(get_border(style), " ", style.get_class())
@@ -0,0 +1,69 @@
+# Small static functions are compiled in place of their calls when the bytecode
+# optimizer is enabled. Results, argument evaluation order and side effects must
+# stay the same as with a regular call.
+extends RefCounted
+
+
+class Helpers:
+	const SCALE = 3
+
+	static func scaled(x: int) -> int:
+		return x * SCALE
+
+	static func clamp_scaled(x: int, limit: int) -> int:
+		return mini(scaled(x), limit)
+
+
+var calls := 0
+
+
+static func square(x: float) -> float:
+	return x * x
+
+
+static func pick(flag: bool, a, b):
+	return a if flag else b
+
+
+static func factorial(n: int) -> int:
+	return 1 if n <= 0 else n * factorial(n - 1)
+
+
+static func length_of(v: Vector2) -> float:
+	return v.length()
+
+
+static func append_to(a: PackedInt32Array, x: int) -> bool:
+	return a.append(x)
+
+
+func next() -> int:
+	calls += 1
+	return calls
+
+
+func test():
+	var f := 2.5
+	print(square(1.5))
+	print(square(0.5))
+	print(square(f + 1.0))
+	print(Helpers.scaled(4))
+	print(Helpers.clamp_scaled(5, 10))
+	print(Helpers.clamp_scaled(2, 10))
+	print(pick(true, "a", "b"), pick(false, "a", "b"))
+	print(factorial(5))
+	print(length_of(Vector2(1.5, 2)))
+
+	# Methods that modify their base are not inlined, the argument is passed like in a regular call.
+	var packed := PackedInt32Array([1, 2, 3])
+	append_to(packed, 4)
+	print(packed)
+
+	# Every argument is evaluated once and in order, even when unused.
+	print(pick(false, next(), next()))
+	print(calls)
+
+	var total := 0
+	for i in 4:
+		total += Helpers.scaled(i)
+	print(total)
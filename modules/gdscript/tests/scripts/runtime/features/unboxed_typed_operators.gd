@@ -0,0 +1,96 @@
+# Operators on statically typed int, float, bool, Vector2 and Vector3 operands
+# use dedicated opcodes, and comparisons feeding a condition jump directly.
+
+func int_ops(n: int) -> int:
+	var acc: int = 0
+	var i: int = 0
+	while i < n:
+		acc = acc * 3 - i
+		i += 1
+	return -acc
+
+
+func int_compares(a: int, b: int) -> String:
+	var s := ""
+	if a == b:
+		s += "e"
+	if a != b:
+		s += "n"
+	if a < b:
+		s += "l"
+	if a <= b:
+		s += "L"
+	if a > b:
+		s += "g"
+	if a >= b:
+		s += "G"
+	return s
+
+
+func float_ops(x: float) -> float:
+	var y: float = x * 2.0 + 0.5
+	y = y / 4.0 - x
+	return -y
+
+
+func float_compares(a: float, b: float) -> String:
+	var s := ""
+	if a == b:
+		s += "e"
+	if a != b:
+		s += "n"
+	if a < b:
+		s += "l"
+	if a <= b:
+		s += "L"
+	if a > b:
+		s += "g"
+	if a >= b:
+		s += "G"
+	return s
+
+
+func float_steps() -> int:
+	var x: float = 0.0
+	var steps: int = 0
+	while x < 1.0:
+		x += 0.25
+		steps += 1
+	return steps
+
+
+func test():
+	print(int_ops(4))
+	print(int_compares(1, 2), " ", int_compares(2, 2), " ", int_compares(3, 2))
+	print(float_ops(1.5))
+	print(float_compares(0.5, 1.5), " ", float_compares(1.5, 1.5), " ", float_compares(2.5, 1.5))
+	print(float_steps())
+
+	var flag: bool = true
+	flag = not flag
+	print(flag)
+	print(not flag)
+
+	var k: int = 5
+	k = -k
+	print(k)
+
+	var v: Vector2 = Vector2(1, 2)
+	var w: Vector2 = Vector2(3, 4)
+	var f: float = 0.5
+	print(v + w)
+	print(v - w)
+	print(v * w)
+	print(w * f)
+
+	var a: Vector3 = Vector3(1, 2, 3)
+	var b: Vector3 = Vector3(4, 5, 6)
+	print(a + b)
+	print(a - b)
+	print(a * b)
+	print(b * f)
+
+	var p: Vector2 = Vector2.ZERO
+	for _i in 3:
+		p = p + Vector2(1, 0.5) * 2.0
+	print(p)
@@ -36,6 +36,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/timeline_profiler.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1288,6 +1289,9 @@ void GodotPhysicsServer2D::init() {
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
+	MEMORY_TAG_SCOPE(Memory::TAG_PHYSICS);
+	TIMELINE_ZONE("PhysicsServer2D::step");
+
 	if (!active) {
 		return;
 	}
@@ -1310,6 +1314,9 @@ void GodotPhysicsServer2D::sync() {
 }
 
 void GodotPhysicsServer2D::flush_queries() {
+	MEMORY_TAG_SCOPE(Memory::TAG_PHYSICS);
+	TIMELINE_ZONE("PhysicsServer2D::flush_queries");
+
 	if (!active) {
 		return;
 	}
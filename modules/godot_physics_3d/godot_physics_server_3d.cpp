@@ -39,6 +39,7 @@
 #include "joints/godot_slider_joint_3d.h"
 
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/timeline_profiler.h"
 #include "core/os/os.h"
 
 #define FLUSH_QUERY_CHECK(m_object) \
@@ -1629,6 +1630,9 @@ void GodotPhysicsServer3D::init() {
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
+	MEMORY_TAG_SCOPE(Memory::TAG_PHYSICS);
+	TIMELINE_ZONE("PhysicsServer3D::step");
+
 	if (!active) {
 		return;
 	}
@@ -1651,6 +1655,9 @@ void GodotPhysicsServer3D::sync() {
 }
 
 void GodotPhysicsServer3D::flush_queries() {
+	MEMORY_TAG_SCOPE(Memory::TAG_PHYSICS);
+	TIMELINE_ZONE("PhysicsServer3D::flush_queries");
+
 	if (!active) {
 		return;
 	}
@@ -17,6 +17,12 @@ def configure(env):
         print("The 'mono' module does not currently support building for this platform. Aborting.")
         sys.exit(255)
 
+    if env["variant_compact"]:
+        import sys
+
+        print("The 'mono' module relies on the standard Variant layout and can't be built with variant_compact=yes. Aborting.")
+        sys.exit(255)
+
     env.add_module_version_string("mono")
 
 
@@ -30,6 +30,7 @@
 
 #include "godot_navigation_server_3d.h"
 
+#include "core/debugger/timeline_profiler.h"
 #include "core/os/mutex.h"
 #include "scene/main/node.h"
 
@@ -1306,6 +1307,9 @@ uint32_t GodotNavigationServer3D::map_get_iteration_id(RID p_map) const {
 }
 
 void GodotNavigationServer3D::sync() {
+	MEMORY_TAG_SCOPE(Memory::TAG_NAVIGATION);
+	TIMELINE_ZONE("NavigationServer3D::sync");
+
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
 		navmesh_generator_3d->sync();
@@ -1314,6 +1318,9 @@ void GodotNavigationServer3D::sync() {
 }
 
 void GodotNavigationServer3D::process(real_t p_delta_time) {
+	MEMORY_TAG_SCOPE(Memory::TAG_NAVIGATION);
+	TIMELINE_ZONE("NavigationServer3D::process");
+
 	flush_queries();
 
 	if (!active) {
@@ -39,6 +39,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/frame_arena.h"
 
 #include <Obstacle2d.h>
 
@@ -426,16 +427,20 @@ void NavMap::sync() {
 
 		_new_pm_polygon_count = polygon_count;
 
+		// The per-edge lists below are small and thrown away right after, so they come from the frame arena.
+		FrameArena::Scope arena_scope;
+		typedef LocalVector<gd::Edge::Connection, uint32_t, false, false, FrameArena> ScratchConnections;
+
 		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
+		HashMap<gd::EdgeKey, ScratchConnections, gd::EdgeKey> connections;
 		for (gd::Polygon &poly : polygons) {
 			for (uint32_t p = 0; p < poly.points.size(); p++) {
 				int next_point = (p + 1) % poly.points.size();
 				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
 
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
+				HashMap<gd::EdgeKey, ScratchConnections, gd::EdgeKey>::Iterator connection = connections.find(ek);
 				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
+					connections[ek] = ScratchConnections();
 					_new_pm_edge_count += 1;
 				}
 				if (connections[ek].size() <= 1) {
@@ -453,12 +458,12 @@ void NavMap::sync() {
 			}
 		}
 
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
+		ScratchConnections free_edges;
+		for (KeyValue<gd::EdgeKey, ScratchConnections> &E : connections) {
 			if (E.value.size() == 2) {
 				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
+				gd::Edge::Connection &c1 = E.value[0];
+				gd::Edge::Connection &c2 = E.value[1];
 				c1.polygon->edges[c1.edge].connections.push_back(c2);
 				c2.polygon->edges[c2.edge].connections.push_back(c1);
 				// Note: The pathway_start/end are full for those connection and do not need to be modified.
@@ -480,12 +485,12 @@ void NavMap::sync() {
 		// connection, integration and path finding.
 		_new_pm_edge_free_count = free_edges.size();
 
-		for (int i = 0; i < free_edges.size(); i++) {
+		for (uint32_t i = 0; i < free_edges.size(); i++) {
 			const gd::Edge::Connection &free_edge = free_edges[i];
 			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
 			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
 
-			for (int j = 0; j < free_edges.size(); j++) {
+			for (uint32_t j = 0; j < free_edges.size(); j++) {
 				const gd::Edge::Connection &other_edge = free_edges[j];
 				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
 					continue;
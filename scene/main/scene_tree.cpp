@@ -32,6 +32,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/debugger/engine_debugger.h"
+#include "core/debugger/timeline_profiler.h"
 #include "core/input/input.h"
 #include "core/io/dir_access.h"
 #include "core/io/image_loader.h"
@@ -527,6 +528,8 @@ void SceneTree::iteration_prepare() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	TIMELINE_ZONE("SceneTree::physics_process");
+
 	current_frame++;
 
 	flush_transform_notifications();
@@ -566,6 +569,8 @@ void SceneTree::iteration_end() {
 }
 
 bool SceneTree::process(double p_time) {
+	TIMELINE_ZONE("SceneTree::process");
+
 	if (MainLoop::process(p_time)) {
 		_quit = true;
 	}
@@ -54,7 +54,8 @@
 class PhysicsServer3DWrapMT : public PhysicsServer3D {
 	mutable PhysicsServer3D *physics_server_3d = nullptr;
 
-	mutable CommandQueueMT command_queue;
+	// Lock-free, as bodies and areas are updated in bulk every frame.
+	mutable CommandQueueMPSC command_queue;
 
 	Thread::ID server_thread = Thread::UNASSIGNED_ID;
 	WorkerThreadPool::TaskID server_task_id = WorkerThreadPool::INVALID_TASK_ID;
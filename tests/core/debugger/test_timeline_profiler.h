@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  test_timeline_profiler.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_TIMELINE_PROFILER_H
+#define TEST_TIMELINE_PROFILER_H
+
+#include "core/debugger/timeline_profiler.h"
+#include "core/io/json.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTimelineProfiler {
+
+// Returns the complete events with the given name, in recording order.
+Array get_events(const String &p_trace_json, const String &p_name) {
+	const Dictionary trace = JSON::parse_string(p_trace_json);
+	const Array trace_events = trace["traceEvents"];
+	Array events;
+	for (int i = 0; i < trace_events.size(); i++) {
+		const Dictionary event = trace_events[i];
+		if (event["ph"] == "X" && event["name"] == p_name) {
+			events.push_back(event);
+		}
+	}
+	return events;
+}
+
+String get_thread_name(const String &p_trace_json, int64_t p_tid) {
+	const Dictionary trace = JSON::parse_string(p_trace_json);
+	const Array trace_events = trace["traceEvents"];
+	for (int i = 0; i < trace_events.size(); i++) {
+		const Dictionary event = trace_events[i];
+		if (event["ph"] == "M" && int64_t(event["tid"]) == p_tid) {
+			return Dictionary(event["args"])["name"];
+		}
+	}
+	return String();
+}
+
+TEST_CASE("[TimelineProfiler] Nested zones") {
+	{
+		TIMELINE_ZONE("test_not_recording");
+	}
+
+	TimelineProfiler::start(String());
+	CHECK(TimelineProfiler::is_recording());
+	{
+		TIMELINE_ZONE("test_outer");
+		{
+			TIMELINE_ZONE("test_inner");
+			OS::get_singleton()->delay_usec(1000);
+		}
+	}
+	CHECK(TimelineProfiler::finish() == OK);
+	CHECK_FALSE(TimelineProfiler::is_recording());
+	{
+		TIMELINE_ZONE("test_after_finish");
+	}
+
+	const String json = TimelineProfiler::get_trace_json();
+	CHECK(get_events(json, "test_not_recording").is_empty());
+	CHECK(get_events(json, "test_after_finish").is_empty());
+
+	const Array outer_events = get_events(json, "test_outer");
+	const Array inner_events = get_events(json, "test_inner");
+	REQUIRE(outer_events.size() == 1);
+	REQUIRE(inner_events.size() == 1);
+
+	const Dictionary outer = outer_events[0];
+	const Dictionary inner = inner_events[0];
+	CHECK(int64_t(outer["tid"]) == int64_t(inner["tid"]));
+	CHECK(int64_t(inner["dur"]) >= 1000);
+	CHECK(int64_t(inner["ts"]) >= int64_t(outer["ts"]));
+	CHECK(int64_t(inner["ts"]) + int64_t(inner["dur"]) <= int64_t(outer["ts"]) + int64_t(outer["dur"]));
+	CHECK(get_thread_name(json, outer["tid"]) == "Main Thread");
+}
+
+void zone_thread(void *p_userdata) {
+	TimelineProfiler::set_thread_name("Test Thread");
+	TIMELINE_ZONE("test_thread_zone");
+}
+
+TEST_CASE("[TimelineProfiler] Zones from other threads") {
+	TimelineProfiler::start(String());
+	{
+		TIMELINE_ZONE("test_main_zone");
+		Thread thread;
+		thread.start(zone_thread, nullptr);
+		thread.wait_to_finish();
+	}
+	TimelineProfiler::finish();
+
+	const String json = TimelineProfiler::get_trace_json();
+	const Array main_events = get_events(json, "test_main_zone");
+	const Array thread_events = get_events(json, "test_thread_zone");
+	REQUIRE(main_events.size() == 1);
+	REQUIRE(thread_events.size() == 1);
+
+	const int64_t thread_tid = Dictionary(thread_events[0])["tid"];
+	CHECK(thread_tid != int64_t(Dictionary(main_events[0])["tid"]));
+	CHECK(get_thread_name(json, thread_tid) == "Test Thread");
+}
+
+TEST_CASE("[TimelineProfiler] Restarting drops previous events") {
+	TimelineProfiler::start(String());
+	{
+		TIMELINE_ZONE("test_first_run");
+	}
+	TimelineProfiler::finish();
+
+	OS::get_singleton()->delay_usec(10);
+	TimelineProfiler::start(String());
+	{
+		TIMELINE_ZONE("test_second_run");
+	}
+	TimelineProfiler::finish();
+
+	const String json = TimelineProfiler::get_trace_json();
+	CHECK(get_events(json, "test_first_run").is_empty());
+	CHECK(get_events(json, "test_second_run").size() == 1);
+}
+
+void looping_zone_thread(void *p_userdata) {
+	const SafeFlag *exit = static_cast<const SafeFlag *>(p_userdata);
+	while (!exit->is_set()) {
+		TIMELINE_ZONE("test_looping_zone");
+		{
+			TIMELINE_ZONE("test_looping_inner_zone");
+		}
+	}
+}
+
+TEST_CASE("[TimelineProfiler] Save while threads overwrite their events") {
+	// A small ring, so the recording thread keeps reusing the slots being saved.
+	TimelineProfiler::cleanup();
+	TimelineProfiler::start(String(), 16);
+
+	SafeFlag exit;
+	Thread thread;
+	thread.start(looping_zone_thread, &exit);
+	int invalid_events = 0;
+	for (int i = 0; i < 200; i++) {
+		const Dictionary trace = JSON::parse_string(TimelineProfiler::get_trace_json());
+		const Array trace_events = trace["traceEvents"];
+		for (int j = 0; j < trace_events.size(); j++) {
+			const Dictionary event = trace_events[j];
+			if (event["ph"] == "X" && event["name"] != "test_looping_zone" && event["name"] != "test_looping_inner_zone") {
+				invalid_events++;
+			}
+		}
+	}
+	exit.set();
+	thread.wait_to_finish();
+	TimelineProfiler::finish();
+	TimelineProfiler::cleanup();
+
+	CHECK_MESSAGE(invalid_events == 0, "Events overwritten while saving should be skipped.");
+}
+
+} // namespace TestTimelineProfiler
+
+#endif // TEST_TIMELINE_PROFILER_H
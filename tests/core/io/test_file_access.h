@@ -107,6 +107,37 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Memory mapped reads") {
+	Ref<FileAccess> f = FileAccess::open_mapped(TestUtils::get_data_path("line_endings_lf.test.txt"));
+	REQUIRE(!f.is_null());
+	const String expected = "Hello darkness\nMy old friend\nI've come to talk\nWith you again\n";
+	CHECK(f->get_length() == (uint64_t)expected.utf8().length());
+	CHECK(f->get_as_utf8_string() == expected);
+
+	f->seek(6);
+	uint8_t word[8] = {};
+	CHECK(f->get_buffer(word, 8) == 8);
+	CHECK(String::utf8((const char *)word, 8) == "darkness");
+	CHECK(f->get_position() == 14);
+
+	f->seek_end(-4);
+	uint8_t tail[8] = {};
+	CHECK(f->get_buffer(tail, 8) == 4);
+	CHECK(f->eof_reached());
+
+	f->seek(0);
+	const uint8_t *span = f->get_mapped_buffer(5);
+	if (f->get_mapped_data()) {
+		// Not all platforms map files, but the span must match the contents when they do.
+		REQUIRE(span != nullptr);
+		CHECK(String::utf8((const char *)span, 5) == "Hello");
+		CHECK(f->get_position() == 5);
+		CHECK(f->get_mapped_buffer(f->get_length()) == nullptr);
+	} else {
+		CHECK(span == nullptr);
+	}
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
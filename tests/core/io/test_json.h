@@ -32,6 +32,7 @@
 #define TEST_JSON_H
 
 #include "core/io/json.h"
+#include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -232,6 +233,215 @@ TEST_CASE("[JSON] Parsing escape sequences") {
 		ERR_PRINT_ON
 	}
 }
+
+TEST_CASE("[JSON] Parsing UTF-8 buffers") {
+	const char *documents[] = {
+		"null",
+		" true ",
+		"-12.5e2",
+		"\"h\u00e9llo \u4e16\u754c \\u00e9 \\ud83d\\ude00 \\\" \\\\ \\/ \\n\"",
+		"[]",
+		"{}",
+		"[1, [2, [3, {}]], {\"a\": [true, false, null]}]",
+		"{\"name\": \"my_dictionary\", \"version\": \"1.0.0\", \"entities\": [{\"name\": \"entity_0\", \"value\": 0.25}]}",
+		"{\"dup\": 1, \"dup\": 2}",
+		"[1, 2,]",
+		"{\n\t\"trailing\": \"comma\",\n}",
+		// Errors.
+		"",
+		"[1 2]",
+		"{\"a\" 1}",
+		"{\"a\": }",
+		"{1: 2}",
+		"[1, 2",
+		"\"unterminated",
+		"\"\\ud800\"",
+		"\"\\q\"",
+		"nope",
+		"1 2",
+	};
+
+	ERR_PRINT_OFF
+	for (const char *document : documents) {
+		JSON expected;
+		const Error expected_err = expected.parse(String::utf8(document));
+
+		JSON json;
+		const Error err = json.parse_utf8_buffer(String::utf8(document).to_utf8_buffer());
+		CHECK_MESSAGE(
+				err == expected_err,
+				vformat("Parsing `%s` as a UTF-8 buffer should succeed or fail like parse().", document));
+		CHECK_MESSAGE(
+				json.get_data() == expected.get_data(),
+				vformat("Parsing `%s` as a UTF-8 buffer should return the same data as parse().", document));
+		if (err == OK) {
+			CHECK(json.get_error_line() == 0);
+		}
+	}
+	ERR_PRINT_ON
+}
+
+class JSONEventRecorder : public JSON::Handler {
+public:
+	String events;
+
+	virtual bool begin_object() override {
+		events += "{";
+		return true;
+	}
+	virtual bool key(const char *p_utf8, int p_len) override {
+		events += String::utf8(p_utf8, p_len) + ":";
+		return true;
+	}
+	virtual bool end_object() override {
+		events += "}";
+		return true;
+	}
+	virtual bool begin_array() override {
+		events += "[";
+		return true;
+	}
+	virtual bool end_array() override {
+		events += "]";
+		return true;
+	}
+	virtual bool value_string(const char *p_utf8, int p_len) override {
+		events += "'" + String::utf8(p_utf8, p_len) + "' ";
+		return true;
+	}
+	virtual bool value_number(double p_value) override {
+		events += rtos(p_value) + " ";
+		return !events.contains("stop");
+	}
+	virtual bool value_bool(bool p_value) override {
+		events += p_value ? "true " : "false ";
+		return true;
+	}
+	virtual bool value_null() override {
+		events += "null ";
+		return true;
+	}
+};
+
+TEST_CASE("[JSON] Parsing UTF-8 with a handler") {
+	const CharString document = String("{\"a\": [1, \"x\\ty\", {}], \"b\": {\"c\": null, \"d\": false}}").utf8();
+	JSONEventRecorder recorder;
+	String err_str;
+	int err_line = 0;
+	CHECK(JSON::parse_utf8((const uint8_t *)document.get_data(), document.length(), recorder, err_str, err_line) == OK);
+	CHECK(recorder.events == "{a:[1 'x\ty' {}]b:{c:null d:false }}");
+
+	const CharString stopped = String("[\"stop\", 1, 2]").utf8();
+	JSONEventRecorder stopper;
+	CHECK_MESSAGE(
+			JSON::parse_utf8((const uint8_t *)stopped.get_data(), stopped.length(), stopper, err_str, err_line) == ERR_SKIP,
+			"Returning false from a handler should stop parsing.");
+	CHECK(stopper.events == "['stop' 1 ");
+
+	const CharString multiline = String("[\n1,\n\n2 3]").utf8();
+	JSONEventRecorder errors;
+	CHECK(JSON::parse_utf8((const uint8_t *)multiline.get_data(), multiline.length(), errors, err_str, err_line) == ERR_PARSE_ERROR);
+	CHECK(err_line == 3);
+	CHECK(err_str == "Expected ','");
+}
+
+TEST_CASE("[JSON] Stringifying to UTF-8 buffers") {
+	Dictionary nested;
+	nested["b"] = 1.5;
+	nested["a"] = Array();
+	nested["c"] = Dictionary();
+	nested[String::utf8("\u00e9\t\"quoted\"\n")] = String::utf8("\u4e16\u754c \\ \b\f\r\v");
+	Array array;
+	array.push_back(Variant());
+	array.push_back(true);
+	array.push_back(INT64_MIN);
+	array.push_back(0.1);
+	array.push_back(nested);
+	array.push_back(PackedInt32Array({ 1, 2, 3 }));
+	array.push_back(Vector2(1, 2));
+
+	const char *indents[] = { "", "\t", "  " };
+	for (const char *indent : indents) {
+		for (int sort_keys = 0; sort_keys < 2; sort_keys++) {
+			for (int full_precision = 0; full_precision < 2; full_precision++) {
+				CHECK_MESSAGE(
+						JSON::stringify_to_utf8_buffer(array, indent, sort_keys, full_precision) == JSON::stringify(array, indent, sort_keys, full_precision).to_utf8_buffer(),
+						"Stringifying to a UTF-8 buffer should produce the same text as stringify().");
+			}
+		}
+	}
+}
+
+static Array _make_benchmark_data(int p_count) {
+	Array ret;
+	for (int i = 0; i < p_count; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["name"] = vformat("player_%d", i);
+		entry["score"] = i * 0.75;
+		entry["online"] = i % 3 == 0;
+		Array tags;
+		tags.push_back("alpha");
+		tags.push_back("beta");
+		tags.push_back(String::utf8("\u00e9t\u00e9 \"quoted\""));
+		entry["tags"] = tags;
+		Dictionary position;
+		position["x"] = i * 1.5;
+		position["y"] = -i * 2.25;
+		entry["position"] = position;
+		ret.push_back(entry);
+	}
+	return ret;
+}
+
+TEST_CASE("[Stress][JSON] Parse and stringify throughput") {
+	const Array data = _make_benchmark_data(50000);
+	const int iterations = 5;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	PackedByteArray text_buffer;
+	for (int i = 0; i < iterations; i++) {
+		text_buffer = JSON::stringify(data).to_utf8_buffer();
+	}
+	const uint64_t stringify_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	PackedByteArray utf8_buffer;
+	for (int i = 0; i < iterations; i++) {
+		utf8_buffer = JSON::stringify_to_utf8_buffer(data);
+	}
+	const uint64_t stringify_utf8_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(utf8_buffer == text_buffer);
+
+	JSON json;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		REQUIRE(json.parse(String::utf8((const char *)text_buffer.ptr(), text_buffer.size())) == OK);
+	}
+	const uint64_t parse_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		REQUIRE(json.parse_utf8_buffer(utf8_buffer) == OK);
+	}
+	const uint64_t parse_utf8_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(json.get_data() == JSON::parse_string(String::utf8((const char *)text_buffer.ptr(), text_buffer.size())));
+
+	// Events only, nothing is allocated per value.
+	JSON::Handler handler;
+	String err_str;
+	int err_line = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		REQUIRE(JSON::parse_utf8(utf8_buffer.ptr(), utf8_buffer.size(), handler, err_str, err_line) == OK);
+	}
+	const uint64_t events_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const double megabytes = double(utf8_buffer.size()) * iterations / (1024 * 1024);
+	MESSAGE(vformat("%.1f MiB of JSON, in MiB/s:", megabytes / iterations));
+	MESSAGE(vformat("stringify() + to_utf8_buffer(): %.1f, stringify_to_utf8_buffer(): %.1f", megabytes / (stringify_usec / 1e6), megabytes / (stringify_utf8_usec / 1e6)));
+	MESSAGE(vformat("get_string_from_utf8() + parse(): %.1f, parse_utf8_buffer(): %.1f, parse_utf8() events only: %.1f", megabytes / (parse_usec / 1e6), megabytes / (parse_utf8_usec / 1e6), megabytes / (events_usec / 1e6)));
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
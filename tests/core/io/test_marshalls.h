@@ -32,6 +32,7 @@
 #define TEST_MARSHALLS_H
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -386,6 +387,170 @@ TEST_CASE("[Marshalls] Typed array decoding") {
 	CHECK(array[0] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+TEST_CASE("[Marshalls] Packed array encoding") {
+	PackedInt32Array ints;
+	ints.push_back(1);
+	ints.push_back(-2);
+	uint8_t buffer[16];
+	int r_len;
+
+	CHECK(encode_variant(ints, buffer, r_len) == OK);
+	CHECK_MESSAGE(r_len == 16, "Length == 4 bytes for header + 4 bytes for array size + 2 * 4 bytes for elements");
+	CHECK_MESSAGE(buffer[0] == 0x1e, "Variant::PACKED_INT32_ARRAY");
+	CHECK(buffer[4] == 0x02);
+	CHECK(buffer[8] == 0x01);
+	CHECK(buffer[9] == 0x00);
+	CHECK(buffer[12] == 0xfe);
+	CHECK(buffer[15] == 0xff);
+
+	PackedVector3Array vectors;
+	PackedColorArray colors;
+	PackedFloat64Array doubles;
+	for (int i = 0; i < 5; i++) {
+		vectors.push_back(Vector3(i, -i * 0.5, i * 3.25));
+		colors.push_back(Color(i * 0.125, 0.5, 1.0 - i * 0.125, 0.75));
+		doubles.push_back(i / 3.0);
+	}
+
+	Array payloads;
+	payloads.push_back(vectors);
+	payloads.push_back(colors);
+	payloads.push_back(doubles);
+	for (const Variant &payload : payloads) {
+		LocalVector<uint8_t> encoded;
+		CHECK(encode_variant(payload, encoded) == OK);
+
+		Variant decoded;
+		CHECK(decode_variant(decoded, encoded.ptr(), encoded.size(), &r_len) == OK);
+		CHECK(r_len == (int)encoded.size());
+		CHECK(decoded == payload);
+	}
+}
+
+TEST_CASE("[Marshalls] Growable buffer encoding") {
+	Dictionary state;
+	state["name"] = "player";
+	state["position"] = Vector3(1, 2, 3);
+	state["health"] = 100;
+	state["speed"] = 1.0 / 3.0;
+	state[Vector2i(4, 5)] = NodePath("/root/Level:position:x");
+	Array inventory;
+	inventory.push_back(StringName("sword"));
+	inventory.push_back(PackedByteArray());
+	PackedByteArray odd;
+	odd.resize(5);
+	inventory.push_back(odd);
+	PackedStringArray tags;
+	tags.push_back("a");
+	tags.push_back("three");
+	inventory.push_back(tags);
+	state["inventory"] = inventory;
+
+	int len;
+	CHECK(encode_variant(state, nullptr, len) == OK);
+	Vector<uint8_t> expected;
+	expected.resize(len);
+	CHECK(encode_variant(state, expected.ptrw(), len) == OK);
+
+	// Encoding appends to what is already in the buffer.
+	LocalVector<uint8_t> buffer;
+	buffer.push_back(0xaa);
+	CHECK(encode_variant(state, buffer) == OK);
+	CHECK(buffer.size() == 1 + (uint32_t)len);
+	CHECK(buffer[0] == 0xaa);
+	CHECK_MESSAGE(memcmp(buffer.ptr() + 1, expected.ptr(), len) == 0, "Single-pass encoding should match the sized buffer encoding.");
+
+	Variant decoded;
+	CHECK(decode_variant(decoded, buffer.ptr() + 1, len) == OK);
+	CHECK(decoded == Variant(state));
+
+	// A failed encoding leaves the buffer as it was.
+	Array nested;
+	Array inner = nested;
+	for (int i = 0; i <= Variant::MAX_RECURSION_DEPTH + 1; i++) {
+		Array child;
+		inner.push_back(child);
+		inner = child;
+	}
+	ERR_PRINT_OFF;
+	CHECK(encode_variant(nested, buffer) == ERR_OUT_OF_MEMORY);
+	ERR_PRINT_ON;
+	CHECK(buffer.size() == 1 + (uint32_t)len);
+
+	// So does one longer than the limit, which stops growing the buffer once it's reached.
+	PackedByteArray large;
+	large.resize(1 << 20);
+	LocalVector<uint8_t> limited;
+	CHECK(encode_variant(large, limited, false, 0, 1024) == ERR_OUT_OF_MEMORY);
+	CHECK(limited.size() == 0);
+	CHECK(limited.get_capacity() <= 1024);
+	CHECK(encode_variant(state, limited, false, 0, len) == OK);
+	CHECK(limited.size() == (uint32_t)len);
+}
+
+TEST_CASE("[Stress][Marshalls] Variant encoding and decoding throughput") {
+	const int vector_count = 100000;
+	PackedVector3Array vectors;
+	vectors.resize(vector_count);
+	PackedFloat32Array floats;
+	floats.resize(vector_count);
+	for (int i = 0; i < vector_count; i++) {
+		vectors.write[i] = Vector3(i, i * 0.5, -i);
+		floats.write[i] = i * 0.25f;
+	}
+
+	Array sync_states;
+	for (int i = 0; i < 256; i++) {
+		Dictionary state;
+		state["id"] = i;
+		state["position"] = Vector3(i, 0, -i);
+		state["rotation"] = Quaternion();
+		state["velocity"] = Vector3(0, -9.8, 0);
+		state["animation"] = "run";
+		sync_states.push_back(state);
+	}
+
+	PackedStringArray strings;
+	for (int i = 0; i < 10000; i++) {
+		strings.push_back(vformat("entry_%d", i));
+	}
+
+	const char *names[] = { "PackedVector3Array", "PackedFloat32Array", "sync state dictionaries", "PackedStringArray" };
+	Variant payloads[] = { vectors, floats, sync_states, strings };
+	const int iterations = 20;
+
+	for (int p = 0; p < (int)(sizeof(payloads) / sizeof(payloads[0])); p++) {
+		const Variant &payload = payloads[p];
+
+		uint64_t t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			int len;
+			encode_variant(payload, nullptr, len);
+			Vector<uint8_t> data;
+			data.resize(len);
+			encode_variant(payload, data.ptrw(), len);
+		}
+		const uint64_t two_pass_usec = OS::get_singleton()->get_ticks_usec() - t;
+
+		LocalVector<uint8_t> buffer;
+		t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			buffer.clear();
+			encode_variant(payload, buffer);
+		}
+		const uint64_t single_pass_usec = OS::get_singleton()->get_ticks_usec() - t;
+
+		t = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			Variant decoded;
+			decode_variant(decoded, buffer.ptr(), buffer.size());
+		}
+		const uint64_t decode_usec = OS::get_singleton()->get_ticks_usec() - t;
+
+		MESSAGE(vformat("%s (%d bytes): two-pass encode %d usec, single-pass encode %d usec, decode %d usec (%d iterations).", names[p], buffer.size(), two_pass_usec, single_pass_usec, decode_usec, iterations));
+	}
+}
+
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
@@ -31,8 +31,11 @@
 #ifndef TEST_PCK_PACKER_H
 #define TEST_PCK_PACKER_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
+#include "core/math/random_pcg.h"
+#include "core/object/script_language.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -117,6 +120,283 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+// Text-like content, compressible like scenes and scripts are.
+static Vector<uint8_t> _make_test_text(int p_seed, int p_size) {
+	static const char *words[] = { "extends ", "Node3D", "func ", "_ready", "():\n", "\tvar ", "position", " = ", "Vector3(", "0.5, ", "1.0)\n", "[node name=\"", "\" type=\"", "MeshInstance3D", "\"]\n", "transform" };
+	RandomPCG rng(p_seed);
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	int ofs = 0;
+	while (ofs < p_size) {
+		const char *word = words[rng.rand(sizeof(words) / sizeof(words[0]))];
+		for (int i = 0; word[i] && ofs < p_size; i++) {
+			w[ofs++] = word[i];
+		}
+		if (rng.rand(8) == 0 && ofs < p_size) {
+			w[ofs++] = '0' + rng.rand(10);
+		}
+	}
+	return data;
+}
+
+static String _write_test_pack(const String &p_name, int p_file_count, int p_file_size, bool p_compress = false, bool p_text = false) {
+	const String source_path = TestUtils::get_temp_path(p_name + "_source.bin");
+	const String pck_path = TestUtils::get_temp_path(p_name + ".pck");
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	pck_packer.set_compression_enabled(p_compress);
+	for (int i = 0; i < p_file_count; i++) {
+		Ref<FileAccess> source = FileAccess::open(source_path + itos(i), FileAccess::WRITE);
+		REQUIRE(source.is_valid());
+		Vector<uint8_t> data;
+		if (p_text) {
+			data = _make_test_text(i, p_file_size);
+		} else {
+			data.resize(p_file_size);
+			for (int j = 0; j < p_file_size; j++) {
+				data.write[j] = uint8_t(i + j);
+			}
+		}
+		source->store_buffer(data);
+		source->close();
+		REQUIRE(pck_packer.add_file(vformat("res://%s/%d.bin", p_name, i), source_path + itos(i)) == OK);
+	}
+	REQUIRE(pck_packer.flush() == OK);
+
+	for (int i = 0; i < p_file_count; i++) {
+		DirAccess::remove_absolute(source_path + itos(i));
+	}
+	return pck_path;
+}
+
+TEST_CASE("[PCKPacker] Read files from a memory mapped pack") {
+	// The test runner doesn't always set up packed data.
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+	const bool was_disabled = PackedData::get_singleton()->is_disabled();
+	PackedData::get_singleton()->set_disabled(false);
+
+	const String pck_path = _write_test_pack("pck_mmap_test", 8, 1000);
+	REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+
+	for (int i = 0; i < 8; i++) {
+		Ref<FileAccess> f = FileAccess::open(vformat("res://pck_mmap_test/%d.bin", i), FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == 1000);
+
+		const Vector<uint8_t> data = f->get_buffer(1000);
+		REQUIRE(data.size() == 1000);
+		CHECK(data[0] == uint8_t(i));
+		CHECK(data[999] == uint8_t(i + 999));
+		CHECK(f->eof_reached() == false);
+		CHECK(f->get_buffer(1).size() == 0);
+
+		f->seek(500);
+		const uint8_t *span = f->get_mapped_buffer(500);
+#if defined(UNIX_ENABLED) && !defined(WEB_ENABLED)
+		REQUIRE_MESSAGE(span != nullptr, "Unencrypted files in a pack should be readable without copies.");
+		CHECK(span[0] == uint8_t(i + 500));
+		CHECK(span[499] == uint8_t(i + 999));
+#endif
+		if (span) {
+			CHECK(f->get_position() == 1000);
+			CHECK(f->get_mapped_buffer(1) == nullptr);
+		}
+	}
+
+	PackedData::get_singleton()->set_disabled(was_disabled);
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+	DirAccess::remove_absolute(pck_path);
+}
+
+TEST_CASE("[PCKPacker] Read files from a compressed pack") {
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+	const bool was_disabled = PackedData::get_singleton()->is_disabled();
+	PackedData::get_singleton()->set_disabled(false);
+
+	// Incompressible data first, so both raw and compressed blocks are read back.
+	RandomPCG rng(42);
+	Vector<uint8_t> data = _make_test_text(0, 300000);
+	for (int i = 0; i < 70000; i++) {
+		data.write[i] = rng.rand(256);
+	}
+	Vector<uint8_t> noise;
+	noise.resize(100);
+	for (int i = 0; i < noise.size(); i++) {
+		noise.write[i] = rng.rand(256);
+	}
+
+	const String source_path = TestUtils::get_temp_path("pck_compressed_source.bin");
+	const String noise_path = TestUtils::get_temp_path("pck_compressed_noise.bin");
+	const String pck_path = TestUtils::get_temp_path("pck_compressed_test.pck");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		f->store_buffer(data);
+		f = FileAccess::open(noise_path, FileAccess::WRITE);
+		f->store_buffer(noise);
+	}
+
+	// Encrypted files are read back with the engine's key.
+	String key;
+	for (int i = 0; i < 32; i++) {
+		key += String::num_int64(script_encryption_key[i], 16).lpad(2, "0");
+	}
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pck_path, 32, key) == OK);
+	pck_packer.set_compression_enabled(true);
+	REQUIRE(pck_packer.add_file("res://pck_compressed_test/text.txt", source_path) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_compressed_test/encrypted.txt", source_path, true) == OK);
+	REQUIRE(pck_packer.add_file("res://pck_compressed_test/noise.bin", noise_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	CHECK_MESSAGE(FileAccess::get_file_as_bytes(pck_path).size() < data.size() * 2, "Compressed files should take less space than the originals.");
+	REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+
+	const char *paths[] = { "res://pck_compressed_test/text.txt", "res://pck_compressed_test/encrypted.txt" };
+	for (const char *path : paths) {
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == (uint64_t)data.size());
+		CHECK(f->get_buffer(data.size()) == data);
+		CHECK(f->get_buffer(1).size() == 0);
+		CHECK(f->get_mapped_buffer(1) == nullptr);
+
+		for (int i = 0; i < 200; i++) {
+			const int pos = rng.rand(data.size());
+			const int length = rng.rand(i % 2 ? 300000 : 100);
+			f->seek(pos);
+			const Vector<uint8_t> read = f->get_buffer(length);
+			REQUIRE(read.size() == MIN(length, data.size() - pos));
+			CHECK_MESSAGE(memcmp(read.ptr(), data.ptr() + pos, read.size()) == 0, vformat("Reading %d bytes at %d should match the source.", length, pos));
+		}
+	}
+
+	Ref<FileAccess> f = FileAccess::open("res://pck_compressed_test/noise.bin", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(f->get_buffer(noise.size()) == noise, "Files that don't compress should be stored as is.");
+
+	PackedData::get_singleton()->set_disabled(was_disabled);
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+	DirAccess::remove_absolute(source_path);
+	DirAccess::remove_absolute(noise_path);
+	DirAccess::remove_absolute(pck_path);
+}
+
+static uint64_t _get_resident_memory() {
+	// Best effort, only available on Linux.
+	Ref<FileAccess> f = FileAccess::open("/proc/self/status", FileAccess::READ);
+	while (f.is_valid() && !f->eof_reached()) {
+		const String line = f->get_line();
+		if (line.begins_with("VmRSS:")) {
+			return line.trim_prefix("VmRSS:").strip_edges().to_int() * 1024;
+		}
+	}
+	return 0;
+}
+
+TEST_CASE("[Stress][PCKPacker] Load many files from a large pack") {
+	// 2,000 files of 128 KiB (~256 MiB). Raise the count to benchmark multi-GB packs.
+	const int file_count = 2000;
+	const int file_size = 128 * 1024;
+
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+	const bool was_disabled = PackedData::get_singleton()->is_disabled();
+	const bool was_using_mmap = PackedData::get_singleton()->is_using_mmap();
+	PackedData::get_singleton()->set_disabled(false);
+
+	const String pck_path = _write_test_pack("pck_mmap_stress", file_count, file_size);
+
+	const char *modes[] = { "buffered", "memory mapped" };
+	for (int mode = 0; mode < 2; mode++) {
+		PackedData::get_singleton()->set_use_mmap(mode == 1);
+		REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+
+		const uint64_t rss_begin = _get_resident_memory();
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		uint64_t checksum = 0;
+		Vector<uint8_t> buffer;
+		buffer.resize(file_size);
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open(vformat("res://pck_mmap_stress/%d.bin", i), FileAccess::READ);
+			REQUIRE(f.is_valid());
+			const uint8_t *data = f->get_mapped_buffer(file_size);
+			if (!data) {
+				f->get_buffer(buffer.ptrw(), file_size);
+				data = buffer.ptr();
+			}
+			for (int j = 0; j < file_size; j += 4096) {
+				checksum += data[j];
+			}
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		const uint64_t rss_end = _get_resident_memory();
+
+		CHECK(checksum > 0);
+		MESSAGE(modes[mode], ": ", usec / 1000, " msec for ", file_count, " files, resident memory +", (rss_end - MIN(rss_begin, rss_end)) / 1024, " KiB.");
+	}
+
+	PackedData::get_singleton()->set_use_mmap(was_using_mmap);
+	PackedData::get_singleton()->set_disabled(was_disabled);
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+	DirAccess::remove_absolute(pck_path);
+}
+
+TEST_CASE("[Stress][PCKPacker] Compressed pack size and load time") {
+	// 200 text-like files of 1 MiB, read whole and then in small chunks.
+	const int file_count = 200;
+	const int file_size = 1024 * 1024;
+
+	PackedData *packed_data = PackedData::get_singleton() ? nullptr : memnew(PackedData);
+	const bool was_disabled = PackedData::get_singleton()->is_disabled();
+	PackedData::get_singleton()->set_disabled(false);
+
+	const char *modes[] = { "uncompressed", "compressed" };
+	for (int mode = 0; mode < 2; mode++) {
+		const String name = mode == 0 ? "pck_raw_stress" : "pck_compressed_stress";
+		const String pck_path = _write_test_pack(name, file_count, file_size, mode == 1, true);
+		REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+
+		Vector<uint8_t> buffer;
+		buffer.resize(file_size);
+		uint64_t checksum = 0;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open(vformat("res://%s/%d.bin", name, i), FileAccess::READ);
+			REQUIRE(f.is_valid());
+			REQUIRE(f->get_buffer(buffer.ptrw(), file_size) == (uint64_t)file_size);
+			checksum += buffer[i];
+		}
+		const uint64_t whole_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open(vformat("res://%s/%d.bin", name, i), FileAccess::READ);
+			REQUIRE(f.is_valid());
+			while (!f->eof_reached()) {
+				checksum += f->get_buffer(buffer.ptrw(), 4096);
+			}
+		}
+		const uint64_t chunked_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK(checksum > 0);
+		MESSAGE(modes[mode], ": ", FileAccess::open(pck_path, FileAccess::READ)->get_length() / 1024, " KiB for ", file_count * (file_size / 1024), " KiB, ", whole_usec / 1000, " msec reading whole files, ", chunked_usec / 1000, " msec reading 4 KiB chunks.");
+		DirAccess::remove_absolute(pck_path);
+	}
+
+	PackedData::get_singleton()->set_disabled(was_disabled);
+	if (packed_data) {
+		memdelete(packed_data);
+	}
+}
 } // namespace TestPCKPacker
 
 #endif // TEST_PCK_PACKER_H
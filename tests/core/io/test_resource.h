@@ -34,7 +34,9 @@
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/templates/safe_refcount.h"
 
 #include "thirdparty/doctest/doctest.h"
 
@@ -166,6 +168,141 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading with sub-threads") {
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_name("Root");
+	Ref<Resource> shared_resource = memnew(Resource);
+	shared_resource->set_name("Shared");
+	shared_resource->set_meta("data", PackedInt32Array({ 1, 2, 3 }));
+	for (int i = 0; i < 4; i++) {
+		Ref<Resource> child_resource = memnew(Resource);
+		child_resource->set_name(vformat("Child %d", i));
+		child_resource->set_meta("shared", shared_resource);
+		resource->set_meta(vformat("child_%d", i), child_resource);
+	}
+
+	const String save_path_binary = TestUtils::get_temp_path("resource_sub_threads.res");
+	ResourceSaver::save(resource, save_path_binary);
+
+	// Sub-resources are set up concurrently when the load is allowed to use sub-threads.
+	REQUIRE(ResourceLoader::load_threaded_request(save_path_binary, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	const Ref<Resource> &loaded_resource = ResourceLoader::load_threaded_get(save_path_binary);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_name() == "Root");
+
+	Ref<Resource> loaded_shared_resource;
+	for (int i = 0; i < 4; i++) {
+		const Ref<Resource> &loaded_child_resource = loaded_resource->get_meta(vformat("child_%d", i));
+		REQUIRE(loaded_child_resource.is_valid());
+		CHECK(loaded_child_resource->get_name() == vformat("Child %d", i));
+
+		const Ref<Resource> &shared = loaded_child_resource->get_meta("shared");
+		REQUIRE(shared.is_valid());
+		if (loaded_shared_resource.is_null()) {
+			loaded_shared_resource = shared;
+		}
+		CHECK_MESSAGE(
+				shared == loaded_shared_resource,
+				"Sub-resources referenced several times should be loaded once.");
+	}
+	CHECK(loaded_shared_resource->get_name() == "Shared");
+	CHECK(loaded_shared_resource->get_meta("data") == Variant(PackedInt32Array({ 1, 2, 3 })));
+}
+
+// Stands for a resource whose state is updated by the resources using it, like a material asked for its shader.
+class _TestSharedResource : public Resource {
+	GDCLASS(_TestSharedResource, Resource);
+
+public:
+	SafeNumeric<int> users;
+	SafeFlag used_concurrently;
+
+	void use() {
+		if (users.increment() > 1) {
+			used_concurrently.set();
+		}
+		OS::get_singleton()->delay_usec(1000);
+		users.decrement();
+	}
+};
+
+class _TestUserResource : public Resource {
+	GDCLASS(_TestUserResource, Resource);
+
+	Ref<_TestSharedResource> shared;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_shared", "shared"), &_TestUserResource::set_shared);
+		ClassDB::bind_method(D_METHOD("get_shared"), &_TestUserResource::get_shared);
+		ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "shared", PROPERTY_HINT_RESOURCE_TYPE, "_TestSharedResource"), "set_shared", "get_shared");
+	}
+
+public:
+	inline static SafeNumeric<int> active_setters{ 0 };
+	inline static SafeNumeric<int> max_active_setters{ 0 };
+
+	void set_shared(const Ref<_TestSharedResource> &p_shared) {
+		max_active_setters.exchange_if_greater(active_setters.increment());
+		shared = p_shared;
+		if (shared.is_valid()) {
+			shared->use();
+		}
+		active_setters.decrement();
+	}
+	Ref<_TestSharedResource> get_shared() const { return shared; }
+};
+
+TEST_CASE("[Resource] Loading with sub-threads and shared dependencies") {
+	GDREGISTER_CLASS(_TestSharedResource);
+	GDREGISTER_CLASS(_TestUserResource);
+
+	Ref<Resource> resource = memnew(Resource);
+	Ref<_TestSharedResource> shared_resource = memnew(_TestSharedResource);
+	for (int i = 0; i < 8; i++) {
+		Ref<_TestUserResource> sharing_resource = memnew(_TestUserResource);
+		sharing_resource->set_shared(shared_resource);
+		resource->set_meta(vformat("sharing_%d", i), sharing_resource);
+
+		Ref<_TestUserResource> independent_resource = memnew(_TestUserResource);
+		independent_resource->set_shared(memnew(_TestSharedResource));
+		resource->set_meta(vformat("independent_%d", i), independent_resource);
+	}
+
+	const String save_path_binary = TestUtils::get_temp_path("resource_sub_threads_shared.res");
+	ResourceSaver::save(resource, save_path_binary);
+
+	_TestUserResource::max_active_setters.set(0);
+	REQUIRE(ResourceLoader::load_threaded_request(save_path_binary, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE) == OK);
+	const Ref<Resource> &loaded_resource = ResourceLoader::load_threaded_get(save_path_binary);
+	REQUIRE(loaded_resource.is_valid());
+
+	Ref<_TestSharedResource> loaded_shared_resource;
+	for (int i = 0; i < 8; i++) {
+		const Ref<_TestUserResource> &sharing_resource = loaded_resource->get_meta(vformat("sharing_%d", i));
+		REQUIRE(sharing_resource.is_valid());
+		REQUIRE(sharing_resource->get_shared().is_valid());
+		if (loaded_shared_resource.is_null()) {
+			loaded_shared_resource = sharing_resource->get_shared();
+		}
+		CHECK(sharing_resource->get_shared() == loaded_shared_resource);
+
+		const Ref<_TestUserResource> &independent_resource = loaded_resource->get_meta(vformat("independent_%d", i));
+		REQUIRE(independent_resource.is_valid());
+		CHECK(independent_resource->get_shared().is_valid());
+		CHECK(independent_resource->get_shared() != loaded_shared_resource);
+	}
+
+	CHECK_MESSAGE(
+			!loaded_shared_resource->used_concurrently.is_set(),
+			"Sub-resources referencing the same resource should never be set up at the same time.");
+	if (WorkerThreadPool::get_singleton()->get_thread_count() > 2) {
+		CHECK_MESSAGE(
+				_TestUserResource::max_active_setters.get() > 1,
+				"Sub-resources that share nothing should be set up in parallel.");
+	}
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
@@ -33,7 +33,9 @@
 
 #include "core/object/class_db.h"
 #include "core/object/object.h"
+#include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -466,6 +468,107 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalCounter : public Object {
+public:
+	int calls = 0;
+	Object *emitter = nullptr;
+	SignalCounter *to_disconnect = nullptr;
+	SignalCounter *to_connect = nullptr;
+
+	void on_signal() {
+		calls++;
+		if (to_disconnect) {
+			emitter->disconnect("my_custom_signal", callable_mp(to_disconnect, &SignalCounter::on_signal));
+			to_disconnect = nullptr;
+		}
+		if (to_connect) {
+			emitter->connect("my_custom_signal", callable_mp(to_connect, &SignalCounter::on_signal));
+			to_connect = nullptr;
+		}
+	}
+
+	void on_signal_bound(const Ref<RefCounted> &p_bound) {
+		calls++;
+	}
+};
+
+TEST_CASE("[Object] Connections changed during emission") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("my_custom_signal"));
+
+	SignalCounter first;
+	SignalCounter second;
+	SignalCounter third;
+	SignalCounter one_shot;
+	first.emitter = &emitter;
+	first.to_disconnect = &second;
+	first.to_connect = &third;
+
+	emitter.connect("my_custom_signal", callable_mp(&first, &SignalCounter::on_signal));
+	emitter.connect("my_custom_signal", callable_mp(&second, &SignalCounter::on_signal));
+	emitter.connect("my_custom_signal", callable_mp(&one_shot, &SignalCounter::on_signal), Object::CONNECT_ONE_SHOT);
+
+	// The emission in progress keeps calling the slots it started with.
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(first.calls == 1);
+	CHECK(second.calls == 1);
+	CHECK(third.calls == 0);
+	CHECK(one_shot.calls == 1);
+
+	// Later emissions see the changes.
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(first.calls == 2);
+	CHECK(second.calls == 1);
+	CHECK(third.calls == 1);
+	CHECK(one_shot.calls == 1);
+
+	emitter.disconnect("my_custom_signal", callable_mp(&first, &SignalCounter::on_signal));
+	emitter.disconnect("my_custom_signal", callable_mp(&third, &SignalCounter::on_signal));
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(first.calls == 2);
+	CHECK(third.calls == 1);
+}
+
+TEST_CASE("[Object] Disconnecting releases bound arguments") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("my_custom_signal"));
+
+	SignalCounter counter;
+	Ref<RefCounted> bound;
+	bound.instantiate();
+	emitter.connect("my_custom_signal", callable_mp(&counter, &SignalCounter::on_signal_bound).bind(bound));
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(counter.calls == 1);
+
+	emitter.disconnect("my_custom_signal", callable_mp(&counter, &SignalCounter::on_signal_bound));
+	CHECK_MESSAGE(bound->get_reference_count() == 1, "The disconnected callable should not be kept alive by the emitter.");
+}
+
+TEST_CASE("[Stress][Object] Signal emission") {
+	const int emissions = 10000000;
+	const int listener_counts[] = { 0, 1, 8 };
+	for (const int listener_count : listener_counts) {
+		Object emitter;
+		emitter.add_user_signal(MethodInfo("my_custom_signal"));
+		SignalCounter listeners[8];
+		for (int i = 0; i < listener_count; i++) {
+			emitter.connect("my_custom_signal", callable_mp(&listeners[i], &SignalCounter::on_signal));
+		}
+
+		const StringName signal_name = "my_custom_signal";
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emissions; i++) {
+			emitter.emit_signal(signal_name);
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		for (int i = 0; i < listener_count; i++) {
+			CHECK(listeners[i].calls == emissions);
+		}
+		MESSAGE(listener_count, " listeners: ", usec * 1000 / emissions, " ns/emission.");
+	}
+}
+
 class NotificationObject1 : public Object {
 	GDCLASS(NotificationObject1, Object);
 
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_FRAME_ARENA_H
+#define TEST_FRAME_ARENA_H
+
+#include "core/os/frame_arena.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations are aligned and don't overlap") {
+	FrameArena::Scope scope;
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(3);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(100);
+	uint8_t *c = (uint8_t *)FrameArena::alloc(1);
+	CHECK(((uintptr_t)a % alignof(max_align_t)) == 0);
+	CHECK(((uintptr_t)b % alignof(max_align_t)) == 0);
+	CHECK(((uintptr_t)c % alignof(max_align_t)) == 0);
+	CHECK(b >= a + 3);
+	CHECK(c >= b + 100);
+
+	memset(a, 0xAA, 3);
+	memset(b, 0xBB, 100);
+	memset(c, 0xCC, 1);
+	CHECK(a[2] == 0xAA);
+	CHECK(b[0] == 0xBB);
+	CHECK(b[99] == 0xBB);
+	CHECK(c[0] == 0xCC);
+}
+
+TEST_CASE("[FrameArena] Scopes release their memory") {
+	FrameArena::Scope outer;
+	void *before = FrameArena::alloc(16);
+
+	void *inner_first = nullptr;
+	{
+		FrameArena::Scope inner;
+		inner_first = FrameArena::alloc(16);
+		FrameArena::alloc(1024);
+	}
+
+	// Same spot as the first allocation of the inner scope, since it was released.
+	void *after = FrameArena::alloc(16);
+	CHECK(after == inner_first);
+	CHECK(after != before);
+
+	// Freeing the latest allocation gives it back right away.
+	FrameArena::free(after);
+	CHECK(FrameArena::alloc(16) == after);
+}
+
+TEST_CASE("[FrameArena] Realloc keeps contents, growing in place when possible") {
+	FrameArena::Scope scope;
+
+	uint32_t *data = (uint32_t *)FrameArena::alloc(sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		data[i] = i;
+	}
+	uint32_t *grown = (uint32_t *)FrameArena::realloc(data, sizeof(uint32_t) * 64);
+	CHECK(grown == data);
+
+	FrameArena::alloc(8); // No longer the latest allocation, so it has to move.
+	uint32_t *moved = (uint32_t *)FrameArena::realloc(grown, sizeof(uint32_t) * 128);
+	CHECK(moved != grown);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(moved[i] == i);
+	}
+}
+
+TEST_CASE("[FrameArena] Large allocations and statistics") {
+	{
+		FrameArena::Scope scope;
+		const size_t size = 1024 * 1024; // Bigger than the default chunk.
+		uint8_t *big = (uint8_t *)FrameArena::alloc(size);
+		REQUIRE(big);
+		big[0] = 1;
+		big[size - 1] = 2;
+		CHECK(big[0] == 1);
+		CHECK(big[size - 1] == 2);
+		CHECK(FrameArena::get_reserved() >= size);
+	}
+	CHECK(FrameArena::get_max_usage() >= 1024 * 1024);
+}
+
+TEST_CASE("[FrameArena] Backing a LocalVector") {
+	FrameArena::Scope scope;
+
+	LocalVector<int, uint32_t, false, false, FrameArena> vector;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 10000);
+	bool all_equal = true;
+	for (int i = 0; i < 10000; i++) {
+		all_equal &= vector[i] == i;
+	}
+	CHECK(all_equal);
+
+	vector.clear();
+	vector.push_back(7);
+	CHECK(vector[0] == 7);
+}
+
+} // namespace TestFrameArena
+
+#endif // TEST_FRAME_ARENA_H
@@ -0,0 +1,90 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/memory.h"
+#include "main/performance.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] Tag names") {
+	CHECK(String(Memory::get_tag_name(Memory::TAG_UNTAGGED)) == "untagged");
+	CHECK(String(Memory::get_tag_name(Memory::TAG_PHYSICS)) == "physics");
+	CHECK(String(Memory::get_tag_name(Memory::TAG_RENDERING)) == "rendering");
+}
+
+#ifdef MEMORY_TAGS_ENABLED
+TEST_CASE("[Memory] Allocations are attributed to the current tag") {
+	const uint64_t usage_before = Memory::get_tag_mem_usage(Memory::TAG_NAVIGATION);
+	const uint64_t count_before = Memory::get_tag_alloc_count(Memory::TAG_NAVIGATION);
+
+	void *ptr = nullptr;
+	{
+		MEMORY_TAG_SCOPE(Memory::TAG_NAVIGATION);
+		CHECK(Memory::get_current_tag() == Memory::TAG_NAVIGATION);
+		ptr = Memory::alloc_static(1000);
+	}
+	CHECK(Memory::get_current_tag() == Memory::TAG_UNTAGGED);
+	CHECK(Memory::get_tag_mem_usage(Memory::TAG_NAVIGATION) >= usage_before + 1000);
+	CHECK(Memory::get_tag_alloc_count(Memory::TAG_NAVIGATION) == count_before + 1);
+
+	// Growing outside the scope keeps the original attribution.
+	ptr = Memory::realloc_static(ptr, 2000);
+	CHECK(Memory::get_tag_mem_usage(Memory::TAG_NAVIGATION) >= usage_before + 2000);
+
+	Memory::free_static(ptr);
+	CHECK(Memory::get_tag_mem_usage(Memory::TAG_NAVIGATION) == usage_before);
+	CHECK(Memory::get_tag_alloc_count(Memory::TAG_NAVIGATION) == count_before);
+	CHECK(Memory::get_tag_mem_max_usage(Memory::TAG_NAVIGATION) >= usage_before + 2000);
+
+	// The same counters are exposed as custom performance monitors.
+	Performance *performance = Performance::get_singleton();
+	const bool own_performance = performance == nullptr;
+	if (own_performance) {
+		performance = memnew(Performance);
+	}
+	REQUIRE(performance->has_custom_monitor("memory_tags/navigation"));
+	REQUIRE(performance->has_custom_monitor("memory_tags/navigation_max"));
+	REQUIRE(performance->has_custom_monitor("memory_tags/navigation_count"));
+	CHECK(uint64_t(performance->get_custom_monitor("memory_tags/navigation")) == Memory::get_tag_mem_usage(Memory::TAG_NAVIGATION));
+	CHECK(uint64_t(performance->get_custom_monitor("memory_tags/navigation_count")) == Memory::get_tag_alloc_count(Memory::TAG_NAVIGATION));
+	if (own_performance) {
+		memdelete(performance);
+	}
+}
+#endif // MEMORY_TAGS_ENABLED
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
@@ -31,6 +31,8 @@
 #ifndef TEST_STRING_H
 #define TEST_STRING_H
 
+#include "core/os/os.h"
+#include "core/string/string_builder.h"
 #include "core/string/ustring.h"
 
 #include "tests/test_macros.h"
@@ -2043,6 +2045,174 @@ TEST_CASE("[String][URL] Parse URL") {
 #undef CHECK_URL
 }
 
+TEST_CASE("[String] Split ranges") {
+	const String s = "Mars,Jupiter,,Saturn";
+
+	const Vector<String> slices = s.split(",");
+	const Vector<StrRange> ranges = s.split_ranges(",");
+	REQUIRE(ranges.size() == slices.size());
+	for (int i = 0; i < ranges.size(); i++) {
+		CHECK(slices[i] == ranges[i]);
+		CHECK(String(ranges[i]) == slices[i]);
+		CHECK(ranges[i].hash() == slices[i].hash());
+	}
+
+	CHECK(s.split_ranges(",", false).size() == 3);
+
+	const Vector<StrRange> limited = s.split_ranges(",", true, 1);
+	REQUIRE(limited.size() == 2);
+	CHECK(String(limited[1]) == "Jupiter,,Saturn");
+
+	CHECK(String("test").split_ranges("").size() == 4);
+	CHECK(String().split_ranges(",").size() == 1);
+	CHECK(String().split_ranges(",", false).size() == 0);
+}
+
+TEST_CASE("[String] Substring ranges") {
+	const String s = "Hello World!";
+
+	const StrRange world = s.substr_range(6, 5);
+	CHECK(world.c_str == s.ptr() + 6);
+	CHECK(String(world) == "World");
+	CHECK(world == String("World").substr_range(0));
+	CHECK(world != s.substr_range(0, 5));
+	CHECK(world.substr(1, 2) == String("or").substr_range(0));
+	CHECK(world[4] == 'd');
+
+	CHECK(s.substr_range(6).length() == 6);
+	CHECK(s.substr_range(6, 100).length() == 6);
+	CHECK(s.substr_range(100).is_empty());
+	CHECK(s.substr_range(-1).is_empty());
+
+	String appended = "Hello";
+	appended += s.substr_range(5);
+	CHECK(appended == s);
+	// Appending a range of the string itself.
+	appended += appended.substr_range(0, 5);
+	CHECK(appended == "Hello World!Hello");
+}
+
+TEST_CASE("[String] Concatenation and path joining") {
+	const String a = "res://folder";
+	const String b = "file.tscn";
+
+	CHECK(a + b == "res://folderfile.tscn");
+	CHECK(a + String() == a);
+	CHECK(String() + b == b);
+	CHECK(a.path_join(b) == "res://folder/file.tscn");
+	CHECK(String("res://").path_join(b) == "res://file.tscn");
+	CHECK(a.path_join("/file.tscn") == "res://folder/file.tscn");
+	CHECK(String().path_join(b) == b);
+}
+
+TEST_CASE("[StringBuilder] Appending") {
+	const String source = "key=value";
+	StringBuilder builder;
+	CHECK(builder.as_string() == "");
+
+	builder.append(String("[section]"));
+	builder.append(U'\n');
+	builder.append(source.substr_range(0, 3));
+	builder += " = ";
+	builder += source.substr_range(4);
+
+	CHECK(builder.num_strings_appended() == 5);
+	CHECK(builder.get_string_length() == 21);
+	CHECK(builder.as_string() == "[section]\nkey = value");
+}
+
+TEST_CASE("[Stress][String] Concatenation") {
+	const int iterations = 200000;
+	const String base = "res://assets/characters";
+	const String file = "player.tscn";
+	uint64_t total_length = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		total_length += base.path_join(file).length();
+	}
+	const uint64_t path_join_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		total_length += (base + file).length();
+	}
+	const uint64_t plus_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations / 100; i++) {
+		StringBuilder builder;
+		for (int j = 0; j < 100; j++) {
+			builder.append(base);
+			builder.append(U'/');
+			builder.append(file.substr_range(0, 6));
+		}
+		total_length += builder.as_string().length();
+	}
+	const uint64_t builder_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations / 100; i++) {
+		String result;
+		for (int j = 0; j < 100; j++) {
+			result += base;
+			result += U'/';
+			result += file.substr(0, 6);
+		}
+		total_length += result.length();
+	}
+	const uint64_t append_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(total_length > 0);
+	MESSAGE("path_join: ", path_join_usec, " usec. operator+: ", plus_usec, " usec. StringBuilder with ranges: ", builder_usec, " usec. Repeated operator+=: ", append_usec, " usec.");
+}
+
+TEST_CASE("[Stress][String] Splitting") {
+	String csv;
+	for (int i = 0; i < 1000; i++) {
+		csv += itos(i) + ",";
+	}
+	const int iterations = 1000;
+	uint64_t total_slices = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		total_slices += csv.split(",").size();
+	}
+	const uint64_t split_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		total_slices += csv.split_ranges(",").size();
+	}
+	const uint64_t ranges_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(total_slices == uint64_t(iterations) * 1001 * 2);
+	MESSAGE("split: ", split_usec, " usec. split_ranges: ", ranges_usec, " usec.");
+}
+
+TEST_CASE("[Stress][String] Hashing") {
+	const String path = "res://assets/characters/player/animations/run.anim";
+	const int iterations = 1000000;
+	uint32_t hash_sum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		hash_sum += path.get_file().hash();
+	}
+	const uint64_t string_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	const int file_start = path.rfind("/") + 1;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		hash_sum -= path.substr_range(file_start).hash();
+	}
+	const uint64_t range_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(hash_sum == 0);
+	MESSAGE("Substring hash: ", string_usec, " usec. Substring range hash: ", range_usec, " usec.");
+}
+
 TEST_CASE("[Stress][String] Empty via ' == String()'") {
 	for (int i = 0; i < 100000; ++i) {
 		String str = "Hello World!";
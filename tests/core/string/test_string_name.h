@@ -0,0 +1,178 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_cstring = StringName("test_string_name_interning");
+	const StringName from_string = StringName(String("test_string_name_interning"));
+	const StringName from_static = _scs_create("test_string_name_interning");
+
+	CHECK(from_cstring.data_unique_pointer() == from_string.data_unique_pointer());
+	CHECK(from_cstring.data_unique_pointer() == from_static.data_unique_pointer());
+	CHECK(from_cstring == StringName::search("test_string_name_interning"));
+	CHECK(from_cstring == StringName::search(U"test_string_name_interning"));
+	CHECK(from_cstring == StringName::search(String("test_string_name_interning")));
+
+	CHECK(StringName::search("test_string_name_never_interned") == StringName());
+	CHECK(StringName("") == StringName());
+}
+
+TEST_CASE("[StringName] Table statistics") {
+	const uint32_t count = 1000;
+	const StringName::TableStats before = StringName::get_table_stats();
+
+	LocalVector<StringName> names;
+	for (uint32_t i = 0; i < count; i++) {
+		names.push_back(StringName("test_string_name_stats_" + itos(i)));
+	}
+
+	const StringName::TableStats during = StringName::get_table_stats();
+	CHECK(during.entry_count == before.entry_count + count);
+	CHECK(during.bucket_count >= during.entry_count);
+	CHECK((during.bucket_count & (during.bucket_count - 1)) == 0);
+	CHECK(during.used_buckets > 0);
+	CHECK(during.used_buckets <= during.entry_count);
+	CHECK(during.longest_chain >= 1);
+
+	names.clear();
+	const StringName::TableStats after = StringName::get_table_stats();
+	CHECK(after.entry_count == before.entry_count);
+}
+
+struct ConcurrentInterning {
+	static constexpr uint32_t THREADS = 4;
+	static constexpr uint32_t MAX_THREADS = 8;
+	static constexpr uint32_t SHARED_NAMES = 2000;
+
+	LocalVector<String> shared_strings;
+	LocalVector<const void *> shared_pointers;
+	uint32_t rounds = 0;
+	uint32_t transient_names = 0;
+	SafeNumeric<uint32_t> mismatches;
+	SafeNumeric<uint64_t> operations;
+
+	static void thread_func(void *p_userdata) {
+		Pair<ConcurrentInterning *, uint32_t> *args = static_cast<Pair<ConcurrentInterning *, uint32_t> *>(p_userdata);
+		ConcurrentInterning *state = args->first;
+		const uint32_t thread = args->second;
+		uint64_t operations = 0;
+
+		for (uint32_t round = 0; round < state->rounds; round++) {
+			for (uint32_t i = 0; i < SHARED_NAMES; i++) {
+				const uint32_t index = (i * 7 + thread * 13 + round) % SHARED_NAMES;
+				const String &string = state->shared_strings[index];
+				if (StringName(string).data_unique_pointer() != state->shared_pointers[index]) {
+					state->mismatches.increment();
+				}
+				if (StringName::search(string).data_unique_pointer() != state->shared_pointers[index]) {
+					state->mismatches.increment();
+				}
+				operations += 2;
+			}
+			// Names that are created and released concurrently, forcing insertions,
+			// removals and resizes while the other threads look up.
+			for (uint32_t i = 0; i < state->transient_names; i++) {
+				const String string = "transient_" + itos(thread) + "_" + itos(i);
+				const StringName name = StringName(string);
+				if (StringName::search(string) != name) {
+					state->mismatches.increment();
+				}
+				operations += 2;
+			}
+		}
+		state->operations.add(operations);
+	}
+
+	// Returns the time spent, in microseconds.
+	uint64_t run(uint32_t p_threads, uint32_t p_rounds, uint32_t p_transient_names) {
+		rounds = p_rounds;
+		transient_names = p_transient_names;
+		DEV_ASSERT(p_threads <= MAX_THREADS);
+
+		LocalVector<StringName> shared_names;
+		for (uint32_t i = 0; i < SHARED_NAMES; i++) {
+			shared_strings.push_back("shared_" + itos(i));
+			shared_names.push_back(StringName(shared_strings[i]));
+			shared_pointers.push_back(shared_names[i].data_unique_pointer());
+		}
+
+		Thread threads[MAX_THREADS];
+		Pair<ConcurrentInterning *, uint32_t> args[MAX_THREADS];
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < p_threads; i++) {
+			args[i] = Pair<ConcurrentInterning *, uint32_t>(this, i);
+			threads[i].start(&ConcurrentInterning::thread_func, &args[i]);
+		}
+		for (uint32_t i = 0; i < p_threads; i++) {
+			threads[i].wait_to_finish();
+		}
+		return OS::get_singleton()->get_ticks_usec() - begin;
+	}
+};
+
+TEST_CASE("[StringName] Concurrent interning and lookup") {
+	ConcurrentInterning state;
+	state.run(ConcurrentInterning::THREADS, 8, 2000);
+
+	CHECK_MESSAGE(state.mismatches.get() == 0, "All threads must resolve a string to the same StringName.");
+	CHECK(StringName::search("transient_0_0") == StringName());
+}
+
+TEST_CASE("[Stress][StringName] Concurrent interning and lookup throughput") {
+	const uint32_t thread_counts[] = { 1, 2, 4, 8 };
+	for (const uint32_t threads : thread_counts) {
+		ConcurrentInterning state;
+		const uint64_t usec = MAX(state.run(threads, 200, 0), (uint64_t)1);
+		CHECK(state.mismatches.get() == 0);
+		MESSAGE(threads, " threads, lookups only: ", state.operations.get() * 1000000 / usec, " operations/sec.");
+	}
+	for (const uint32_t threads : thread_counts) {
+		ConcurrentInterning state;
+		const uint64_t usec = MAX(state.run(threads, 20, 20000), (uint64_t)1);
+		CHECK(state.mismatches.get() == 0);
+		MESSAGE(threads, " threads, with interning: ", state.operations.get() * 1000000 / usec, " operations/sec.");
+	}
+}
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
@@ -446,6 +446,148 @@ TEST_CASE("[Stress][CommandQueue] Stress test command queue") {
 	ProjectSettings::get_singleton()->set_setting(COMMAND_QUEUE_SETTING,
 			ProjectSettings::get_singleton()->property_get_revert(COMMAND_QUEUE_SETTING));
 }
+template <typename TQueue>
+class MultiProducerState {
+public:
+	static constexpr uint32_t PRODUCERS = 3;
+
+	TQueue command_queue;
+	uint32_t messages_per_producer = 0;
+	uint32_t sync_every = 0;
+
+	SafeFlag exit_consumer;
+	SafeNumeric<uint64_t> received;
+	uint32_t last_sequence[PRODUCERS] = {};
+	int order_errors = 0;
+	int return_errors = 0;
+
+	void func(uint32_t p_producer, uint32_t p_sequence, Transform3D p_transform) {
+		if (p_sequence != last_sequence[p_producer] + 1) {
+			order_errors++;
+		}
+		last_sequence[p_producer] = p_sequence;
+		received.increment();
+	}
+
+	uint32_t func_ret(uint32_t p_value) {
+		received.increment();
+		return p_value * 2;
+	}
+
+	static void producer_thread(void *p_userdata) {
+		Pair<MultiProducerState *, uint32_t> *args = static_cast<Pair<MultiProducerState *, uint32_t> *>(p_userdata);
+		MultiProducerState *state = args->first;
+		for (uint32_t i = 1; i <= state->messages_per_producer; i++) {
+			state->command_queue.push(state, &MultiProducerState::func, args->second, i, Transform3D());
+			if (state->sync_every && i % state->sync_every == 0) {
+				uint32_t ret = 0;
+				state->command_queue.push_and_ret(state, &MultiProducerState::func_ret, i, &ret);
+				if (ret != i * 2) {
+					state->return_errors++;
+				}
+			}
+		}
+	}
+
+	static void consumer_thread(void *p_userdata) {
+		MultiProducerState *state = static_cast<MultiProducerState *>(p_userdata);
+		while (!state->exit_consumer.is_set()) {
+			state->command_queue.flush_all();
+		}
+		state->command_queue.flush_all();
+	}
+
+	// Returns the time spent pushing, in microseconds.
+	uint64_t run(uint32_t p_messages_per_producer, uint32_t p_sync_every) {
+		messages_per_producer = p_messages_per_producer;
+		sync_every = p_sync_every;
+
+		Thread consumer;
+		consumer.start(&MultiProducerState::consumer_thread, this);
+
+		Thread producers[PRODUCERS];
+		Pair<MultiProducerState *, uint32_t> args[PRODUCERS];
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < PRODUCERS; i++) {
+			args[i] = Pair<MultiProducerState *, uint32_t>(this, i);
+			producers[i].start(&MultiProducerState::producer_thread, &args[i]);
+		}
+		for (uint32_t i = 0; i < PRODUCERS; i++) {
+			producers[i].wait_to_finish();
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		exit_consumer.set();
+		consumer.wait_to_finish();
+		return elapsed;
+	}
+};
+
+TEST_CASE("[CommandQueue] Lock-free queue keeps per-thread order across chunks") {
+	MultiProducerState<CommandQueueMPSC> *state = memnew(MultiProducerState<CommandQueueMPSC>);
+	// Enough commands to go through several chunks of the queue.
+	const uint32_t messages = 20000;
+	const uint32_t sync_every = 1000;
+	state->run(messages, sync_every);
+
+	CHECK(state->received.get() == MultiProducerState<CommandQueueMPSC>::PRODUCERS * (messages + messages / sync_every));
+	CHECK_MESSAGE(state->order_errors == 0, "Commands from the same thread must be executed in order.");
+	CHECK(state->return_errors == 0);
+	memdelete(state);
+}
+
+TEST_CASE("[CommandQueue] Lock-free queue flush_if_pending and sync from the consumer") {
+	MultiProducerState<CommandQueueMPSC> *state = memnew(MultiProducerState<CommandQueueMPSC>);
+	state->command_queue.flush_if_pending();
+	CHECK(state->received.get() == 0);
+
+	state->command_queue.push(state, &MultiProducerState<CommandQueueMPSC>::func, 0u, 1u, Transform3D());
+	state->command_queue.push(state, &MultiProducerState<CommandQueueMPSC>::func, 0u, 2u, Transform3D());
+	CHECK(state->received.get() == 0);
+	state->command_queue.flush_if_pending();
+	CHECK(state->received.get() == 2);
+	CHECK(state->order_errors == 0);
+	memdelete(state);
+}
+
+TEST_CASE("[CommandQueue] Lock-free queue fills its ring with no consumer running") {
+	MultiProducerState<CommandQueueMPSC> *state = memnew(MultiProducerState<CommandQueueMPSC>);
+	// More than the 16 MiB the ring of chunks can hold, nothing flushes until the pushes are done.
+	const uint32_t messages = 400000;
+	for (uint32_t i = 1; i <= messages; i++) {
+		state->command_queue.push(state, &MultiProducerState<CommandQueueMPSC>::func, 0u, i, Transform3D());
+	}
+	CHECK(state->received.get() == 0);
+	state->command_queue.flush_all();
+	CHECK(state->received.get() == messages);
+	CHECK_MESSAGE(state->order_errors == 0, "Commands that spilled over should run after the ones in the ring.");
+
+	// The ring is used again afterwards.
+	state->command_queue.push(state, &MultiProducerState<CommandQueueMPSC>::func, 0u, messages + 1, Transform3D());
+	state->command_queue.flush_all();
+	CHECK(state->received.get() == messages + 1);
+	CHECK(state->order_errors == 0);
+	memdelete(state);
+}
+
+TEST_CASE("[Stress][CommandQueue] Push throughput, mutex vs. lock-free queue") {
+	const uint32_t messages = 1000000;
+	const uint32_t producers = MultiProducerState<CommandQueueMT>::PRODUCERS;
+
+	MultiProducerState<CommandQueueMT> *mt_state = memnew(MultiProducerState<CommandQueueMT>);
+	const uint64_t mt_usec = MAX(mt_state->run(messages, 0), (uint64_t)1);
+	CHECK(mt_state->received.get() == producers * messages);
+	memdelete(mt_state);
+
+	MultiProducerState<CommandQueueMPSC> *mpsc_state = memnew(MultiProducerState<CommandQueueMPSC>);
+	const uint64_t mpsc_usec = MAX(mpsc_state->run(messages, 0), (uint64_t)1);
+	CHECK(mpsc_state->received.get() == producers * messages);
+	CHECK(mpsc_state->order_errors == 0);
+	memdelete(mpsc_state);
+
+	MESSAGE("CommandQueueMT: ", uint64_t(producers) * messages * 1000000 / mt_usec, " pushes/sec. CommandQueueMPSC: ", uint64_t(producers) * messages * 1000000 / mpsc_usec, " pushes/sec.");
+}
+
 } // namespace TestCommandQueue
 
 #endif // TEST_COMMAND_QUEUE_H
@@ -31,7 +31,12 @@
 #ifndef TEST_RID_H
 #define TEST_RID_H
 
+#include "core/math/aabb.h"
+#include "core/math/transform_3d.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
+#include "core/templates/rid_owner.h"
 
 #include "tests/test_macros.h"
 
@@ -96,6 +101,162 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'295).get_local_index() == 4'294'967'295);
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
+
+struct HotPart {
+	int value = 0;
+};
+
+struct ColdPart {
+	String name;
+};
+
+TEST_CASE("[RID_HotColdAlloc] Allocation, lookup and freeing") {
+	RID_HotColdAlloc<HotPart, ColdPart> alloc;
+
+	HotPart hot;
+	hot.value = 42;
+	ColdPart cold;
+	cold.name = "cold";
+	RID rid = alloc.make_rid(hot, cold);
+
+	CHECK(alloc.owns(rid));
+	CHECK(alloc.get_rid_count() == 1);
+	REQUIRE(alloc.get_or_null(rid) != nullptr);
+	CHECK(alloc.get_or_null(rid)->value == 42);
+	REQUIRE(alloc.get_cold_or_null(rid) != nullptr);
+	CHECK(alloc.get_cold_or_null(rid)->name == "cold");
+
+	HotPart *hot_ptr = nullptr;
+	ColdPart *cold_ptr = nullptr;
+	CHECK(alloc.get_or_null(rid, hot_ptr, cold_ptr));
+	CHECK(hot_ptr == alloc.get_or_null(rid));
+	CHECK(cold_ptr == alloc.get_cold_or_null(rid));
+
+	alloc.free(rid);
+	CHECK_FALSE(alloc.owns(rid));
+	CHECK(alloc.get_or_null(rid) == nullptr);
+	CHECK(alloc.get_cold_or_null(rid) == nullptr);
+	CHECK(alloc.get_rid_count() == 0);
+}
+
+TEST_CASE("[RID_HotColdAlloc] Iteration skips free and uninitialized slots") {
+	RID_HotColdAlloc<HotPart, ColdPart> alloc(1024);
+
+	LocalVector<RID> rids;
+	for (int i = 0; i < 1000; i++) {
+		RID rid = alloc.make_rid();
+		alloc.get_or_null(rid)->value = i;
+		alloc.get_cold_or_null(rid)->name = itos(i);
+		rids.push_back(rid);
+	}
+	for (int i = 0; i < 1000; i += 3) {
+		alloc.free(rids[i]);
+	}
+	// Allocated but not initialized, must not be visited.
+	RID uninitialized = alloc.allocate_rid();
+
+	int visited = 0;
+	int previous = -1;
+	bool in_order = true;
+	bool valid = true;
+	alloc.for_each_with_cold([&](const RID &p_rid, HotPart &p_hot, ColdPart &p_cold) {
+		visited++;
+		valid = valid && p_hot.value % 3 != 0 && p_rid == rids[p_hot.value] && p_cold.name == itos(p_hot.value);
+		in_order = in_order && p_hot.value > previous;
+		previous = p_hot.value;
+	});
+	CHECK(visited == 666);
+	CHECK(valid);
+	CHECK(in_order);
+
+	alloc.initialize_rid(uninitialized);
+	visited = 0;
+	alloc.for_each([&](const RID &p_rid, HotPart &p_hot) {
+		visited++;
+	});
+	CHECK(visited == 667);
+
+	alloc.free(uninitialized);
+	for (int i = 0; i < 1000; i++) {
+		if (i % 3 != 0) {
+			alloc.free(rids[i]);
+		}
+	}
+	CHECK(alloc.get_rid_count() == 0);
+}
+
+struct FatInstance {
+	Transform3D transform;
+	AABB aabb;
+	uint32_t flags = 0;
+	uint8_t cold_data[512] = {};
+};
+
+struct InstanceHot {
+	Transform3D transform;
+	AABB aabb;
+	uint32_t flags = 0;
+};
+
+struct InstanceCold {
+	uint8_t cold_data[512] = {};
+};
+
+TEST_CASE("[Stress][RID_HotColdAlloc] Per-frame sweep, RID_Alloc vs. hot/cold split") {
+	const uint32_t count = 100000;
+	const uint32_t frames = 20;
+
+	RID_Alloc<FatInstance> fat_alloc(65536, count);
+	RID_HotColdAlloc<InstanceHot, InstanceCold> split_alloc(65536, count);
+	LocalVector<RID> fat_rids;
+	LocalVector<RID> split_rids;
+	for (uint32_t i = 0; i < count; i++) {
+		fat_rids.push_back(fat_alloc.make_rid());
+		split_rids.push_back(split_alloc.make_rid());
+	}
+	// Leave some holes, like a scene where instances come and go.
+	for (uint32_t i = 0; i < count; i += 7) {
+		fat_alloc.free(fat_rids[i]);
+		split_alloc.free(split_rids[i]);
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t fat_visible = 0;
+	LocalVector<RID> owned;
+	owned.resize(fat_alloc.get_rid_count());
+	for (uint32_t f = 0; f < frames; f++) {
+		fat_alloc.fill_owned_buffer(owned.ptr());
+		for (const RID &rid : owned) {
+			FatInstance *instance = fat_alloc.get_or_null(rid);
+			instance->transform.origin.x += 1.0;
+			instance->aabb.position = instance->transform.origin;
+			fat_visible += instance->flags == 0;
+		}
+	}
+	const uint64_t fat_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	uint32_t split_visible = 0;
+	for (uint32_t f = 0; f < frames; f++) {
+		split_alloc.for_each([&](const RID &p_rid, InstanceHot &p_instance) {
+			p_instance.transform.origin.x += 1.0;
+			p_instance.aabb.position = p_instance.transform.origin;
+			split_visible += p_instance.flags == 0;
+		});
+	}
+	const uint64_t split_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(fat_visible == split_visible);
+	MESSAGE("RID_Alloc: ", fat_usec / 1000, " ms. RID_HotColdAlloc: ", split_usec / 1000, " ms.");
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (i % 7 != 0) {
+			fat_alloc.free(fat_rids[i]);
+			split_alloc.free(split_rids[i]);
+		}
+	}
+}
+
 } // namespace TestRID
 
 #endif // TEST_RID_H
@@ -0,0 +1,266 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SWISS_HASH_MAP_H
+#define TEST_SWISS_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] Insert element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Overwrite element") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[SwissHashMap] Erase via element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Erase via key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Iteration keeps insertion order") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+	map.insert(7, 7, true);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(7, 7));
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	const SwissHashMap<int, int> const_map = map;
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == expected.size());
+}
+
+TEST_CASE("[SwissHashMap] Replace key") {
+	SwissHashMap<int, int> map;
+	map.insert(1, 10);
+	map.insert(2, 20);
+	map.insert(3, 30);
+
+	CHECK(map.replace_key(2, 5));
+	CHECK(!map.has(2));
+	CHECK(map[5] == 20);
+
+	// Position in the iteration order is preserved.
+	SwissHashMap<int, int>::Iterator E = map.begin();
+	++E;
+	CHECK(E->key == 5);
+}
+
+TEST_CASE("[SwissHashMap] Many insertions and erasures match HashMap") {
+	SwissHashMap<uint32_t, uint32_t> map;
+	HashMap<uint32_t, uint32_t> reference;
+
+	// Repeated churn on a small key range fills the table with tombstones,
+	// which must be reclaimed without losing elements.
+	for (uint32_t i = 0; i < 20000; i++) {
+		const uint32_t key = hash_murmur3_one_32(i) % 500;
+		if (reference.has(key)) {
+			CHECK(map.erase(key));
+			reference.erase(key);
+		} else {
+			map.insert(key, i);
+			reference.insert(key, i);
+		}
+	}
+
+	CHECK(map.size() == reference.size());
+	for (const KeyValue<uint32_t, uint32_t> &E : reference) {
+		const uint32_t *value = map.getptr(E.key);
+		REQUIRE(value != nullptr);
+		CHECK(*value == E.value);
+	}
+	for (uint32_t key = 500; key < 1000; key++) {
+		CHECK(!map.has(key));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Reserve and clear") {
+	SwissHashMap<int, int> map;
+	map.reserve(1000);
+	const uint32_t capacity = map.get_capacity();
+	CHECK(capacity >= 1000);
+
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map.size() == 1000);
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK(!map.has(10));
+	CHECK(map.begin() == map.end());
+
+	map.insert(10, 20);
+	CHECK(map[10] == 20);
+}
+
+// Benchmarks comparing the different hash maps.
+
+template <typename TMap>
+struct BenchmarkOps {
+	static void insert(TMap &p_map, uint32_t p_key, uint32_t p_value) { p_map.insert(p_key, p_value); }
+	static bool lookup(const TMap &p_map, uint32_t p_key, uint32_t &r_value) {
+		const uint32_t *value = p_map.getptr(p_key);
+		if (value) {
+			r_value = *value;
+		}
+		return value != nullptr;
+	}
+	static void erase(TMap &p_map, uint32_t p_key) { p_map.erase(p_key); }
+	static uint64_t iterate(const TMap &p_map) {
+		uint64_t sum = 0;
+		for (const KeyValue<uint32_t, uint32_t> &E : p_map) {
+			sum += E.value;
+		}
+		return sum;
+	}
+};
+
+template <>
+struct BenchmarkOps<OAHashMap<uint32_t, uint32_t>> {
+	typedef OAHashMap<uint32_t, uint32_t> TMap;
+	static void insert(TMap &p_map, uint32_t p_key, uint32_t p_value) { p_map.insert(p_key, p_value); }
+	static bool lookup(const TMap &p_map, uint32_t p_key, uint32_t &r_value) { return p_map.lookup(p_key, r_value); }
+	static void erase(TMap &p_map, uint32_t p_key) { p_map.remove(p_key); }
+	static uint64_t iterate(const TMap &p_map) {
+		uint64_t sum = 0;
+		for (TMap::Iterator it = p_map.iter(); it.valid; it = p_map.next_iter(it)) {
+			sum += *it.value;
+		}
+		return sum;
+	}
+};
+
+template <typename TMap>
+void benchmark_map(const char *p_name, uint32_t p_count) {
+	typedef BenchmarkOps<TMap> Ops;
+	TMap *map = memnew(TMap);
+	uint64_t checksum = 0;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_count; i++) {
+		Ops::insert(*map, hash_murmur3_one_32(i), i);
+	}
+	const uint64_t insert_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_count; i++) {
+		uint32_t value = 0;
+		if (Ops::lookup(*map, hash_murmur3_one_32(i), value)) {
+			checksum += value;
+		}
+	}
+	const uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = p_count; i < p_count * 2; i++) {
+		uint32_t value = 0;
+		if (Ops::lookup(*map, hash_murmur3_one_32(i), value)) {
+			checksum += value;
+		}
+	}
+	const uint64_t miss_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	checksum += Ops::iterate(*map);
+	const uint64_t iterate_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < p_count; i++) {
+		Ops::erase(*map, hash_murmur3_one_32(i));
+	}
+	const uint64_t erase_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	memdelete(map);
+
+	MESSAGE(p_name, " (", p_count, " entries): insert ", insert_usec / 1000, " ms, lookup ", lookup_usec / 1000, " ms, miss ", miss_usec / 1000,
+			" ms, iterate ", iterate_usec / 1000, " ms, erase ", erase_usec / 1000, " ms. Checksum: ", checksum);
+}
+
+TEST_CASE("[Stress][SwissHashMap] Benchmark against HashMap and OAHashMap") {
+	const uint32_t counts[] = { 1000, 10000, 100000, 1000000, 10000000 };
+	for (const uint32_t count : counts) {
+		benchmark_map<HashMap<uint32_t, uint32_t>>("HashMap", count);
+		benchmark_map<OAHashMap<uint32_t, uint32_t>>("OAHashMap", count);
+		benchmark_map<SwissHashMap<uint32_t, uint32_t>>("SwissHashMap", count);
+	}
+}
+
+} // namespace TestSwissHashMap
+
+#endif // TEST_SWISS_HASH_MAP_H
@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_swiss_hash_set.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SWISS_HASH_SET_H
+#define TEST_SWISS_HASH_SET_H
+
+#include "core/templates/hash_set.h"
+#include "core/templates/swiss_hash_set.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashSet {
+
+TEST_CASE("[SwissHashSet] Insert, find and erase") {
+	SwissHashSet<int> set;
+	SwissHashSet<int>::Iterator e = set.insert(42);
+
+	CHECK(e);
+	CHECK(*e == 42);
+	CHECK(set.has(42));
+	CHECK(set.find(42));
+	CHECK(set.size() == 1);
+
+	set.insert(42);
+	CHECK(set.size() == 1);
+
+	CHECK(set.erase(42));
+	CHECK(!set.erase(42));
+	CHECK(!set.has(42));
+	CHECK(set.is_empty());
+}
+
+TEST_CASE("[SwissHashSet] Iteration and erasing keeps keys dense") {
+	SwissHashSet<int> set;
+	set.insert(1);
+	set.insert(2);
+	set.insert(3);
+	set.insert(4);
+
+	// The last key takes the place of the erased one.
+	set.erase(2);
+	Vector<int> expected = { 1, 4, 3 };
+
+	int idx = 0;
+	for (const int &E : set) {
+		CHECK(E == expected[idx]);
+		++idx;
+	}
+	CHECK(idx == expected.size());
+	CHECK(set.has(4));
+	CHECK(*set.find(4) == 4);
+}
+
+TEST_CASE("[SwissHashSet] Copy and reset") {
+	SwissHashSet<String> set;
+	for (int i = 0; i < 100; i++) {
+		set.insert(itos(i));
+	}
+
+	SwissHashSet<String> copy = set;
+	set.reset();
+	CHECK(set.is_empty());
+	CHECK(!set.has("1"));
+
+	CHECK(copy.size() == 100);
+	for (int i = 0; i < 100; i++) {
+		CHECK(copy.has(itos(i)));
+	}
+	CHECK(!copy.has("100"));
+}
+
+TEST_CASE("[SwissHashSet] Many insertions and erasures match HashSet") {
+	SwissHashSet<uint32_t> set;
+	HashSet<uint32_t> reference;
+
+	for (uint32_t i = 0; i < 20000; i++) {
+		const uint32_t key = hash_murmur3_one_32(i) % 500;
+		if (reference.has(key)) {
+			CHECK(set.erase(key));
+			reference.erase(key);
+		} else {
+			set.insert(key);
+			reference.insert(key);
+		}
+	}
+
+	CHECK(set.size() == reference.size());
+	for (const uint32_t &E : reference) {
+		CHECK(set.has(E));
+	}
+	for (uint32_t key = 500; key < 1000; key++) {
+		CHECK(!set.has(key));
+	}
+}
+
+} // namespace TestSwissHashSet
+
+#endif // TEST_SWISS_HASH_SET_H
@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_WORK_STEALING_DEQUE_H
+#define TEST_WORK_STEALING_DEQUE_H
+
+#include "core/os/thread.h"
+#include "core/templates/work_stealing_deque.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops LIFO, thieves steal FIFO") {
+	WorkStealingDeque<int, 8> deque;
+	CHECK(deque.is_empty());
+
+	for (int i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK(deque.size() == 4);
+
+	int value = -1;
+	CHECK(deque.pop(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.pop(value));
+	CHECK(value == 2);
+	CHECK(deque.steal(value));
+	CHECK(value == 1);
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<int, 4> deque;
+	for (int i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(4));
+
+	int value = -1;
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.push(4)); // Wraps around the ring.
+
+	for (int i = 4; i >= 1; i--) {
+		CHECK(deque.pop(value));
+		CHECK(value == i);
+	}
+	CHECK(deque.is_empty());
+}
+
+static WorkStealingDeque<uint32_t, 64> shared_deque;
+static SafeNumeric<uint64_t> stolen_sum;
+static SafeNumeric<uint32_t> stolen_count;
+static SafeFlag owner_done;
+
+static void thief_func(void *p_userdata) {
+	uint32_t value;
+	while (!owner_done.is_set()) {
+		if (shared_deque.steal(value)) {
+			stolen_sum.add(value);
+			stolen_count.increment();
+		}
+	}
+	while (shared_deque.steal(value)) {
+		stolen_sum.add(value);
+		stolen_count.increment();
+	}
+}
+
+TEST_CASE("[WorkStealingDeque] Every element is taken exactly once under contention") {
+	const uint32_t count = 100000;
+	stolen_sum.set(0);
+	stolen_count.set(0);
+	owner_done.clear();
+
+	Thread thieves[3];
+	for (Thread &thief : thieves) {
+		thief.start(thief_func, nullptr);
+	}
+
+	uint64_t popped_sum = 0;
+	uint32_t popped_count = 0;
+	uint32_t value;
+	for (uint32_t i = 1; i <= count; i++) {
+		while (!shared_deque.push(i)) {
+			if (shared_deque.pop(value)) {
+				popped_sum += value;
+				popped_count++;
+			}
+		}
+		if (i % 3 == 0 && shared_deque.pop(value)) {
+			popped_sum += value;
+			popped_count++;
+		}
+	}
+	while (shared_deque.pop(value)) {
+		popped_sum += value;
+		popped_count++;
+	}
+
+	owner_done.set();
+	for (Thread &thief : thieves) {
+		thief.wait_to_finish();
+	}
+
+	CHECK(popped_count + stolen_count.get() == count);
+	CHECK(popped_sum + stolen_sum.get() == (uint64_t)count * (count + 1) / 2);
+}
+
+} // namespace TestWorkStealingDeque
+
+#endif // TEST_WORK_STEALING_DEQUE_H
@@ -107,6 +107,130 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static SafeNumeric<uint32_t> graph_stage;
+static SafeFlag graph_order_ok;
+
+static void static_graph_first(void *p_arg) {
+	if (graph_stage.get() != 0) {
+		graph_order_ok.clear();
+	}
+	counter[0].increment();
+}
+
+static void static_graph_middle_group(void *p_arg, uint32_t p_index) {
+	if (counter[0].get() != 1) {
+		graph_order_ok.clear();
+	}
+	counter[p_index + 1].increment();
+	graph_stage.increment();
+}
+
+static void static_graph_middle_task(void *p_arg) {
+	if (counter[0].get() != 1) {
+		graph_order_ok.clear();
+	}
+	graph_stage.increment();
+}
+
+static void static_graph_last(void *p_arg) {
+	// Both branches of the diamond must be done.
+	if (graph_stage.get() != (uint32_t)(uintptr_t)p_arg + 1) {
+		graph_order_ok.clear();
+	}
+	counter[0].increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Run a task graph, respecting dependencies") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int elements = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+
+		counter.clear();
+		counter.resize(elements + 1);
+		graph_stage.set(0);
+		graph_order_ok.set();
+
+		WorkerThreadPool::TaskGraph graph;
+		WorkerThreadPool::TaskGraph::NodeID first = graph.add_native_task(static_graph_first, nullptr);
+		WorkerThreadPool::TaskGraph::NodeID group = graph.add_native_group_task(static_graph_middle_group, nullptr, elements, tasks, { first });
+		WorkerThreadPool::TaskGraph::NodeID task = graph.add_native_task(static_graph_middle_task, nullptr, { first });
+		graph.add_native_task(static_graph_last, (void *)(uintptr_t)elements, { group, task });
+		CHECK(graph.get_node_count() == 4);
+
+		WorkerThreadPool::TaskGraphID graph_id = WorkerThreadPool::get_singleton()->add_task_graph(graph, Math::rand() % 2);
+		CHECK(graph.get_node_count() == 0);
+		WorkerThreadPool::get_singleton()->wait_for_task_graph_completion(graph_id);
+
+		CHECK(graph_order_ok.is_set());
+		CHECK(counter[0].get() == 2);
+		bool all_run_once = true;
+		for (int i = 1; i <= elements; i++) {
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph corner cases") {
+	WorkerThreadPool::TaskGraph graph;
+
+	SUBCASE("Empty graph") {
+		WorkerThreadPool::TaskGraphID graph_id = WorkerThreadPool::get_singleton()->add_task_graph(graph);
+		CHECK(WorkerThreadPool::get_singleton()->is_task_graph_completed(graph_id));
+		WorkerThreadPool::get_singleton()->wait_for_task_graph_completion(graph_id);
+	}
+
+	SUBCASE("Empty group in a chain") {
+		counter.clear();
+		counter.resize(1);
+		WorkerThreadPool::TaskGraph::NodeID group = graph.add_native_group_task(static_group_test, (void *)1, 0);
+		graph.add_native_task(static_test, (void *)0, { group });
+		WorkerThreadPool::TaskGraphID graph_id = WorkerThreadPool::get_singleton()->add_task_graph(graph);
+		WorkerThreadPool::get_singleton()->wait_for_task_graph_completion(graph_id);
+		CHECK(counter[0].get() == 3);
+	}
+
+	SUBCASE("Predecessors must already be in the graph") {
+		ERR_PRINT_OFF;
+		graph.add_native_task(static_test, (void *)0, { 5 });
+		ERR_PRINT_ON;
+		CHECK(graph.get_node_count() == 1);
+		graph.clear();
+		CHECK(graph.get_node_count() == 0);
+	}
+}
+
+static void static_graph_chain_link(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+
+static void static_graph_waiter(void *p_arg, uint32_t p_index) {
+	// The nodes are posted to this thread's local queue, so it has to run them itself
+	// unless another thread steals them.
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID previous = graph.add_native_task(static_graph_chain_link, (void *)(uint64_t)(p_index + 1));
+	for (int i = 0; i < 8; i++) {
+		previous = graph.add_native_task(static_graph_chain_link, (void *)(uint64_t)(p_index + 1), { previous });
+	}
+	WorkerThreadPool::TaskGraphID graph_id = WorkerThreadPool::get_singleton()->add_task_graph(graph, true);
+	WorkerThreadPool::get_singleton()->wait_for_task_graph_completion(graph_id);
+	if (counter[p_index + 1].get() == 9) {
+		counter[0].increment();
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Await task graphs from every pool thread") {
+	// All threads wait at once, so none would be left to run the graphs if waiting blocked them.
+	const int waiters = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	counter.clear();
+	counter.resize(waiters + 1);
+
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_graph_waiter, nullptr, waiters, waiters, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	CHECK(counter[0].get() == waiters);
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -173,6 +297,59 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static SafeNumeric<uint32_t> bench_counter;
+
+static void static_bench_small_task(void *p_arg) {
+	bench_counter.increment();
+}
+
+static void static_bench_poster(void *p_arg, uint32_t p_index) {
+	const uint32_t count = *(const uint32_t *)p_arg;
+	// Batches fit in the local queue of the thread, so tasks don't overflow to the shared one.
+	const uint32_t batch_size = WorkStealingDeque<WorkerThreadPool::TaskID>::get_capacity();
+	LocalVector<WorkerThreadPool::TaskID> task_ids;
+	task_ids.resize(batch_size);
+	for (uint32_t posted = 0; posted < count; posted += batch_size) {
+		const uint32_t batch = MIN(batch_size, count - posted);
+		for (uint32_t i = 0; i < batch; i++) {
+			task_ids[i] = WorkerThreadPool::get_singleton()->add_native_task(static_bench_small_task, nullptr, true);
+		}
+		for (uint32_t i = 0; i < batch; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(task_ids[i]);
+		}
+	}
+}
+
+// Returns the elapsed time in microseconds.
+static uint64_t post_small_tasks_from_pool_threads(uint32_t p_total_tasks, bool p_work_stealing) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const bool work_stealing_backup = pool->is_work_stealing_enabled();
+	pool->set_work_stealing_enabled(p_work_stealing);
+
+	const uint32_t posters = MAX(1, pool->get_thread_count());
+	uint32_t tasks_per_poster = p_total_tasks / posters;
+	bench_counter.set(0);
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_bench_poster, &tasks_per_poster, posters, posters, true);
+	pool->wait_for_group_task_completion(group);
+	const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(bench_counter.get() == tasks_per_poster * posters);
+
+	pool->set_work_stealing_enabled(work_stealing_backup);
+	return elapsed;
+}
+
+TEST_CASE("[Stress][WorkerThreadPool] Post 1M small tasks from pool threads, shared queue vs. work stealing") {
+	const uint32_t total_tasks = 1000000;
+
+	const uint64_t shared_queue_usec = post_small_tasks_from_pool_threads(total_tasks, false);
+	const uint64_t work_stealing_usec = post_small_tasks_from_pool_threads(total_tasks, true);
+
+	MESSAGE("Shared queue: ", shared_queue_usec / 1000, " ms. Work stealing: ", work_stealing_usec / 1000, " ms.");
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H